@@ -0,0 +1,262 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace Benchmarks
+{
+	using BenchmarkClock = std::chrono::steady_clock;
+
+	void UseCharPointer(const volatile char* pointer)
+	{
+		(void)pointer;
+	}
+
+	static double RunTimed(const BenchmarkFunc& func, uint64_t iterations,
+		uint64_t& itemsPerIteration)
+	{
+		BenchmarkState state(iterations);
+		auto begin = BenchmarkClock::now();
+		func(state);
+		auto end = BenchmarkClock::now();
+		itemsPerIteration = state.GetItemsPerIteration();
+		return std::chrono::duration<double, std::nano>(end - begin).count();
+	}
+
+	static double Median(std::vector<double> values)
+	{
+		if (values.empty())
+		{
+			return 0.0;
+		}
+		std::sort(values.begin(), values.end());
+		size_t middle = values.size() / 2;
+		if (values.size() % 2 == 0)
+		{
+			return (values[middle - 1] + values[middle]) * 0.5;
+		}
+		return values[middle];
+	}
+
+	BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings& settings)
+		: m_settings(settings),
+		m_benchmarks(),
+		m_results(),
+		m_filter()
+	{
+	}
+
+	void BenchmarkRunner::Add(const std::string& name, const BenchmarkFunc& func)
+	{
+		m_benchmarks.push_back({ name, func });
+	}
+
+	void BenchmarkRunner::Run()
+	{
+		m_results.clear();
+		for (const auto& benchmark : m_benchmarks)
+		{
+			if (!m_filter.empty()
+				&& benchmark.name.find(m_filter) == std::string::npos)
+			{
+				continue;
+			}
+			std::printf("Running %s...\n", benchmark.name.c_str());
+			m_results.push_back(RunBenchmark(benchmark.name, benchmark.func));
+		}
+	}
+
+	BenchmarkResult BenchmarkRunner::RunBenchmark(const std::string& name, const BenchmarkFunc& func) const
+	{
+		const double minSampleTimeNs = m_settings.minSampleTimeMs * 1000000.0;
+		const double warmupTimeNs = m_settings.warmupTimeMs * 1000000.0;
+
+		BenchmarkResult result;
+		result.name = name;
+
+		// Calibrates the iteration count so that a sample takes at least the minimum sample time,
+		// this also serves as the warmup for the caches & branch predictors.
+		uint64_t iterations = 1;
+		double elapsed = 0.0;
+		double totalElapsed = 0.0;
+		while (true)
+		{
+			elapsed = RunTimed(func, iterations, result.itemsPerIteration);
+			totalElapsed += elapsed;
+			if (elapsed >= minSampleTimeNs)
+			{
+				break;
+			}
+			// Grows by the estimated amount needed, but at most 10x at a time.
+			double multiplier = elapsed > 0.0 ? (minSampleTimeNs * 1.2) / elapsed : 10.0;
+			multiplier = std::min(std::max(multiplier, 1.5), 10.0);
+			iterations = (uint64_t)((double)iterations * multiplier) + 1;
+		}
+		while (totalElapsed < warmupTimeNs)
+		{
+			totalElapsed += RunTimed(func, iterations, result.itemsPerIteration);
+		}
+
+		// Collects the samples.
+		std::vector<double> samples;
+		samples.reserve(m_settings.numSamples);
+		for (uint32_t i = 0; i < m_settings.numSamples; i++)
+		{
+			double sample = RunTimed(func, iterations, result.itemsPerIteration);
+			samples.push_back(sample / (double)iterations);
+		}
+
+		result.iterations = iterations;
+		result.numSamples = (uint32_t)samples.size();
+		if (samples.empty())
+		{
+			return result;
+		}
+
+		double sum = 0.0;
+		result.min = samples[0];
+		result.max = samples[0];
+		for (double sample : samples)
+		{
+			sum += sample;
+			result.min = std::min(result.min, sample);
+			result.max = std::max(result.max, sample);
+		}
+		result.mean = sum / (double)samples.size();
+
+		double variance = 0.0;
+		for (double sample : samples)
+		{
+			double difference = sample - result.mean;
+			variance += difference * difference;
+		}
+		if (samples.size() > 1)
+		{
+			variance /= (double)(samples.size() - 1);
+		}
+		result.standardDeviation = std::sqrt(variance);
+		result.confidenceInterval95 = 1.96 * result.standardDeviation
+			/ std::sqrt((double)samples.size());
+
+		result.median = Median(samples);
+		std::vector<double> deviations;
+		deviations.reserve(samples.size());
+		for (double sample : samples)
+		{
+			deviations.push_back(std::abs(sample - result.median));
+		}
+		result.medianAbsoluteDeviation = Median(deviations);
+
+		for (double deviation : deviations)
+		{
+			if (deviation > 3.0 * result.medianAbsoluteDeviation * 1.4826)
+			{
+				result.numOutliers++;
+			}
+		}
+		return result;
+	}
+
+	void BenchmarkRunner::PrintResults() const
+	{
+		std::printf("\n%-48s %14s %14s %12s %10s %14s %8s\n",
+			"Benchmark", "Median (ns)", "Mean (ns)", "+/- 95%", "MAD %", "Items/s", "Outliers");
+		for (const auto& result : m_results)
+		{
+			double madPercent = result.median > 0.0 ?
+				(result.medianAbsoluteDeviation / result.median) * 100.0 : 0.0;
+			double itemsPerSecond = result.median > 0.0 ?
+				(double)result.itemsPerIteration * 1000000000.0 / result.median : 0.0;
+			std::printf("%-48s %14.3f %14.3f %12.3f %9.2f%% %14.4g %4u/%-3u\n",
+				result.name.c_str(), result.median, result.mean, result.confidenceInterval95,
+				madPercent, itemsPerSecond, result.numOutliers, result.numSamples);
+		}
+	}
+
+	bool BenchmarkRunner::WriteResults(const std::string& csvFile) const
+	{
+		std::ofstream file(csvFile);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		file << "name,iterations,items_per_iteration,samples,min,max,mean,median,stddev,mad,ci95\n";
+		for (const auto& result : m_results)
+		{
+			file << result.name << ","
+				<< result.iterations << ","
+				<< result.itemsPerIteration << ","
+				<< result.numSamples << ","
+				<< result.min << ","
+				<< result.max << ","
+				<< result.mean << ","
+				<< result.median << ","
+				<< result.standardDeviation << ","
+				<< result.medianAbsoluteDeviation << ","
+				<< result.confidenceInterval95 << "\n";
+		}
+		return true;
+	}
+
+	bool BenchmarkRunner::CompareResults(const std::string& baselineCsvFile) const
+	{
+		std::ifstream file(baselineCsvFile);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		struct BaselineEntry
+		{
+			double median;
+			double mad;
+		};
+		std::unordered_map<std::string, BaselineEntry> baseline;
+
+		std::string line;
+		// Skips the header.
+		std::getline(file, line);
+		while (std::getline(file, line))
+		{
+			std::vector<std::string> columns;
+			std::stringstream stream(line);
+			std::string column;
+			while (std::getline(stream, column, ','))
+			{
+				columns.push_back(column);
+			}
+			if (columns.size() < 11)
+			{
+				continue;
+			}
+			baseline[columns[0]] = { std::stod(columns[7]), std::stod(columns[9]) };
+		}
+
+		std::printf("\n%-48s %14s %14s %10s\n", "Benchmark", "Baseline (ns)", "Current (ns)", "Change");
+		for (const auto& result : m_results)
+		{
+			const auto& found = baseline.find(result.name);
+			if (found == baseline.end())
+			{
+				continue;
+			}
+			const BaselineEntry& entry = found->second;
+			double change = entry.median > 0.0 ?
+				((result.median - entry.median) / entry.median) * 100.0 : 0.0;
+
+			// A change is only reported as significant when the medians differ
+			// by more than the noise (MAD) of both of the runs combined.
+			double noise = 1.4826 * (entry.mad + result.medianAbsoluteDeviation);
+			bool significant = std::abs(result.median - entry.median) > noise;
+			std::printf("%-48s %14.3f %14.3f %+9.2f%% %s\n",
+				result.name.c_str(), entry.median, result.median, change,
+				significant ? (change < 0.0 ? "faster" : "slower") : "~");
+		}
+		return true;
+	}
+}
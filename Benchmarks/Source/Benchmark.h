@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Benchmarks
+{
+
+	// Used so that the compiler can't discard the value being benchmarked.
+	void UseCharPointer(const volatile char* pointer);
+
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(_MSC_VER)
+		UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	// Forces all pending writes to memory.
+	inline void ClobberMemory()
+	{
+#if defined(_MSC_VER)
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	// The state passed to each benchmark, the benchmark must run its
+	// operation exactly GetIterations() times.
+	class BenchmarkState
+	{
+	public:
+		explicit BenchmarkState(uint64_t iterations)
+			: m_iterations(iterations), m_itemsPerIteration(1) { }
+
+		uint64_t GetIterations() const { return m_iterations; }
+
+		// The number of items processed for each iteration (Batches, Entities, etc...)
+		void SetItemsPerIteration(uint64_t items) { m_itemsPerIteration = items; }
+		uint64_t GetItemsPerIteration() const { return m_itemsPerIteration; }
+
+	private:
+		uint64_t m_iterations;
+		uint64_t m_itemsPerIteration;
+	};
+
+	using BenchmarkFunc = std::function<void(BenchmarkState&)>;
+
+	struct BenchmarkSettings
+	{
+		// The minimum amount of time that each sample should take.
+		double minSampleTimeMs = 10.0;
+		// The amount of time spent running the benchmark before sampling.
+		double warmupTimeMs = 50.0;
+		// The number of samples used to compute the statistics.
+		uint32_t numSamples = 30;
+	};
+
+	// The statistics of the samples, all in nanoseconds per iteration.
+	struct BenchmarkResult
+	{
+		std::string name;
+		uint64_t iterations = 0;
+		uint64_t itemsPerIteration = 1;
+		uint32_t numSamples = 0;
+		double min = 0.0;
+		double max = 0.0;
+		double mean = 0.0;
+		double median = 0.0;
+		double standardDeviation = 0.0;
+		// The median absolute deviation, which is resistant to outliers.
+		double medianAbsoluteDeviation = 0.0;
+		// The half-width of the 95% confidence interval of the mean.
+		double confidenceInterval95 = 0.0;
+		// The number of samples that are over 3 MADs from the median.
+		uint32_t numOutliers = 0;
+	};
+
+	class BenchmarkRunner
+	{
+	public:
+		explicit BenchmarkRunner(const BenchmarkSettings& settings = BenchmarkSettings());
+
+		void Add(const std::string& name, const BenchmarkFunc& func);
+
+		// Only runs benchmarks that contain the filter in their name.
+		void SetFilter(const std::string& filter) { m_filter = filter; }
+
+		void Run();
+
+		void PrintResults() const;
+		bool WriteResults(const std::string& csvFile) const;
+		// Compares the results against the results of a previous run.
+		bool CompareResults(const std::string& baselineCsvFile) const;
+
+		const std::vector<BenchmarkResult>& GetResults() const { return m_results; }
+
+	private:
+		BenchmarkResult RunBenchmark(const std::string& name, const BenchmarkFunc& func) const;
+
+	private:
+		struct BenchmarkEntry
+		{
+			std::string name;
+			BenchmarkFunc func;
+		};
+
+		BenchmarkSettings m_settings;
+		std::vector<BenchmarkEntry> m_benchmarks;
+		std::vector<BenchmarkResult> m_results;
+		std::string m_filter;
+	};
+}
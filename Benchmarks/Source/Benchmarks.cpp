@@ -0,0 +1,127 @@
+// Benchmarks.cpp : This file contains the 'main' function. Program execution begins and ends there.
+//
+// Usage: Benchmarks [--filter <name>] [--samples <count>] [--out <results.csv>] [--baseline <results.csv>]
+//                   [--single-threaded]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "Benchmark.h"
+#include "MathBenchmarks.h"
+#include "SceneBenchmarks.h"
+
+#include "Profiler.h"
+#include "SceneManager.h"
+#include "JobManager.h"
+
+#if defined(GRAPHICS_API_NULL)
+#include "GraphicsRenderer.h"
+#include "GraphicsRenderer2D.h"
+#include "GraphicsRenderer3D.h"
+#endif
+
+int main(int argsc, char** argsv)
+{
+	Benchmarks::BenchmarkSettings settings;
+	std::string filter;
+	std::string outputFile;
+	std::string baselineFile;
+	bool singleThreaded = false;
+
+	for (int i = 1; i < argsc; i++)
+	{
+		std::string arg(argsv[i]);
+		bool hasValue = i + 1 < argsc;
+		if (arg == "--filter" && hasValue)
+		{
+			filter = argsv[++i];
+		}
+		else if (arg == "--samples" && hasValue)
+		{
+			settings.numSamples = (uint32_t)std::atoi(argsv[++i]);
+		}
+		else if (arg == "--min-sample-time" && hasValue)
+		{
+			settings.minSampleTimeMs = std::atof(argsv[++i]);
+		}
+		else if (arg == "--out" && hasValue)
+		{
+			outputFile = argsv[++i];
+		}
+		else if (arg == "--baseline" && hasValue)
+		{
+			baselineFile = argsv[++i];
+		}
+		else if (arg == "--single-threaded")
+		{
+			singleThreaded = true;
+		}
+		else
+		{
+			std::printf("Unknown argument: %s\n", arg.c_str());
+			return 1;
+		}
+	}
+
+	// Without a frame budget monitor the profiler only records the session trace in debug,
+	// release builds don't keep any events, so the benchmarks should be run in release.
+	Engine::Profiler::SetOutputFile("BenchmarkProfile.json");
+	Engine::Profiler::Init();
+	// Without the job manager the parallel scene work runs on the main thread.
+	if (!singleThreaded)
+	{
+		Engine::JobManager::Init();
+	}
+
+#if defined(GRAPHICS_API_NULL)
+	// The null rendering api doesn't need a window.
+	if (!Engine::GraphicsRenderer::Init(nullptr))
+	{
+		std::printf("Failed to initialize the null rendering api\n");
+		return 1;
+	}
+	Engine::GraphicsRenderer2D::Init();
+	Engine::GraphicsRenderer3D::Init();
+#endif
+
+	Benchmarks::BenchmarkRunner runner(settings);
+	runner.SetFilter(filter);
+
+	Benchmarks::AddMatrixBenchmarks(runner);
+	Benchmarks::AddQuaternionBenchmarks(runner);
+	Benchmarks::AddTransformBenchmarks(runner);
+	Benchmarks::Add2DIntersectionBenchmarks(runner);
+	Benchmarks::Add3DIntersectionBenchmarks(runner);
+#if defined(GRAPHICS_API_NULL)
+	Benchmarks::AddSceneBenchmarks(runner);
+#endif
+
+	runner.Run();
+	runner.PrintResults();
+
+	Engine::SceneManager::Release();
+#if defined(GRAPHICS_API_NULL)
+	Engine::GraphicsRenderer3D::Release();
+	Engine::GraphicsRenderer2D::Release();
+	Engine::GraphicsRenderer::Release();
+#endif
+	Engine::JobManager::Release();
+	Engine::Profiler::Release();
+
+	if (!outputFile.empty()
+		&& !runner.WriteResults(outputFile))
+	{
+		std::printf("Failed to write the results to %s\n", outputFile.c_str());
+		return 1;
+	}
+
+	if (!baselineFile.empty()
+		&& !runner.CompareResults(baselineFile))
+	{
+		std::printf("Failed to read the baseline %s\n", baselineFile.c_str());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,728 @@
+#include "MathBenchmarks.h"
+#include "Benchmark.h"
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "Transform.h"
+#include "Shape2D.h"
+#include "Shape3D.h"
+#include "Geometry2D.h"
+#include "Geometry3D.h"
+#include "BatchTransform.h"
+#include "ShapePacket3D.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Benchmarks
+{
+	// The inputs are cycled through so that the compiler
+	// can't constant fold the benchmarked operation.
+	const uint32_t c_numInputs = 1024;
+	const uint32_t c_inputMask = c_numInputs - 1;
+
+	static std::mt19937& GetRandomEngine()
+	{
+		static std::mt19937 s_engine(0x6a6b6f72);
+		return s_engine;
+	}
+
+	static float RandomFloat(float min, float max)
+	{
+		std::uniform_real_distribution<float> distribution(min, max);
+		return distribution(GetRandomEngine());
+	}
+
+	static MathLib::Vector2 RandomVector2(float min, float max)
+	{
+		return MathLib::Vector2(RandomFloat(min, max), RandomFloat(min, max));
+	}
+
+	static MathLib::Vector3 RandomVector3(float min, float max)
+	{
+		return MathLib::Vector3(RandomFloat(min, max),
+			RandomFloat(min, max), RandomFloat(min, max));
+	}
+
+	static MathLib::Vector3 RandomDirection3()
+	{
+		MathLib::Vector3 direction = RandomVector3(-1.0f, 1.0f);
+		if (direction.LengthSquared() <= 0.0001f)
+		{
+			return MathLib::Vector3::UnitZ;
+		}
+		direction.Normalize();
+		return direction;
+	}
+
+	static MathLib::Quaternion RandomQuaternion()
+	{
+		return MathLib::Quaternion::FromEuler(
+			RandomVector3(-180.0f, 180.0f), true);
+	}
+
+	static MathLib::Transform3D RandomTransform3D()
+	{
+		return MathLib::Transform3D(RandomVector3(-100.0f, 100.0f),
+			RandomQuaternion(), RandomVector3(0.5f, 2.0f));
+	}
+
+	static MathLib::Matrix4x4 RandomTRSMatrix()
+	{
+		return RandomTransform3D().GetLocalTransformMatrix();
+	}
+
+	template<typename T, typename TFunc>
+	static std::vector<T> GenerateInputs(TFunc&& func)
+	{
+		std::vector<T> inputs;
+		inputs.reserve(c_numInputs);
+		for (uint32_t i = 0; i < c_numInputs; i++)
+		{
+			inputs.push_back(func());
+		}
+		return inputs;
+	}
+
+	void AddMatrixBenchmarks(BenchmarkRunner& runner)
+	{
+		auto matrices = std::make_shared<std::vector<MathLib::Matrix4x4>>(
+			GenerateInputs<MathLib::Matrix4x4>(RandomTRSMatrix));
+
+		runner.Add("Matrix4x4/Multiply", [matrices](BenchmarkState& state)
+			{
+				const auto& inputs = *matrices;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Matrix4x4 result = inputs[i & c_inputMask]
+						* inputs[(i + 1) & c_inputMask];
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Matrix4x4/Invert", [matrices](BenchmarkState& state)
+			{
+				const auto& inputs = *matrices;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Matrix4x4 result = MathLib::Matrix4x4::Invert(inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Matrix4x4/InvertAffine", [matrices](BenchmarkState& state)
+			{
+				const auto& inputs = *matrices;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Matrix4x4 result = MathLib::Matrix4x4::InvertAffine(inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		// The view projections aren't affine, so these take the general inverse (ex: Camera::ScreenToWorld).
+		auto viewProjections = std::make_shared<std::vector<MathLib::Matrix4x4>>(
+			GenerateInputs<MathLib::Matrix4x4>([]()
+				{
+					return MathLib::Matrix4x4::InvertAffine(RandomTRSMatrix())
+						* MathLib::Matrix4x4::CreatePersp(RandomFloat(30.0f, 90.0f),
+							RandomFloat(1.0f, 2.0f), 0.1f, 1000.0f);
+				}));
+		runner.Add("Matrix4x4/InvertViewProjection", [viewProjections](BenchmarkState& state)
+			{
+				const auto& inputs = *viewProjections;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Matrix4x4 result = MathLib::Matrix4x4::Invert(inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Matrix4x4/Transpose", [matrices](BenchmarkState& state)
+			{
+				const auto& inputs = *matrices;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Matrix4x4 result = MathLib::Matrix4x4::Transpose(inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		auto points = std::make_shared<std::vector<MathLib::Vector4>>(
+			GenerateInputs<MathLib::Vector4>([]() { return MathLib::Vector4(RandomVector3(-100.0f, 100.0f), 1.0f); }));
+		runner.Add("Matrix4x4/TransformVector4", [matrices, points](BenchmarkState& state)
+			{
+				const auto& inputs = *matrices;
+				const auto& vectors = *points;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector4 result = vectors[i & c_inputMask] * inputs[(i + 7) & c_inputMask];
+					DoNotOptimize(result);
+				}
+			});
+	}
+
+	void AddQuaternionBenchmarks(BenchmarkRunner& runner)
+	{
+		auto quaternions = std::make_shared<std::vector<MathLib::Quaternion>>(
+			GenerateInputs<MathLib::Quaternion>(RandomQuaternion));
+		auto directions = std::make_shared<std::vector<MathLib::Vector3>>(
+			GenerateInputs<MathLib::Vector3>(RandomDirection3));
+		auto eulers = std::make_shared<std::vector<MathLib::Vector3>>(
+			GenerateInputs<MathLib::Vector3>([]() { return RandomVector3(-180.0f, 180.0f); }));
+
+		runner.Add("Quaternion/Concatenate", [quaternions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Quaternion result = Concatenate(inputs[i & c_inputMask],
+						inputs[(i + 1) & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Quaternion/Normalize", [quaternions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Quaternion result = MathLib::Quaternion::Normalize(inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Quaternion/Lerp", [quaternions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Quaternion result = Lerp(inputs[i & c_inputMask],
+						inputs[(i + 1) & c_inputMask], 0.35f);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Quaternion/Slerp", [quaternions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Quaternion result = Slerp(inputs[i & c_inputMask],
+						inputs[(i + 1) & c_inputMask], 0.35f);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Quaternion/SlerpApproximate", [quaternions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Quaternion result = Slerp(inputs[i & c_inputMask],
+						inputs[(i + 1) & c_inputMask], 0.35f, true);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Quaternion/RotateVector", [quaternions, directions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				const auto& vectors = *directions;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector3 result = MathLib::Vector3::Rotate(inputs[i & c_inputMask],
+						vectors[(i + 3) & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Quaternion/FromEuler", [eulers](BenchmarkState& state)
+			{
+				const auto& inputs = *eulers;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Quaternion result = MathLib::Quaternion::FromEuler(inputs[i & c_inputMask], true);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Quaternion/ToMatrix", [quaternions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Matrix4x4 result = MathLib::Matrix4x4::CreateFromQuaternion(inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		// The batch versions convert all of the inputs per iteration.
+		runner.Add("Quaternion/RotateVectors", [quaternions, directions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				const auto& vectors = *directions;
+				std::vector<MathLib::Vector3> results(c_numInputs);
+				state.SetItemsPerIteration(c_numInputs);
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::RotateVectors(inputs.data(), vectors.data(), results.data(), c_numInputs);
+					DoNotOptimize(results.data());
+					ClobberMemory();
+				}
+			});
+
+		runner.Add("Quaternion/ToMatrices", [quaternions](BenchmarkState& state)
+			{
+				const auto& inputs = *quaternions;
+				std::vector<MathLib::Matrix4x4> results(c_numInputs);
+				state.SetItemsPerIteration(c_numInputs);
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::QuaternionsToMatrices(inputs.data(), results.data(), c_numInputs);
+					DoNotOptimize(results.data());
+					ClobberMemory();
+				}
+			});
+	}
+
+	void AddTransformBenchmarks(BenchmarkRunner& runner)
+	{
+		auto transforms = std::make_shared<std::vector<MathLib::Transform3D>>(
+			GenerateInputs<MathLib::Transform3D>(RandomTransform3D));
+		// Half of the transforms have parents.
+		auto parentMatrices = std::make_shared<std::vector<MathLib::Matrix4x4>>(
+			c_numInputs, MathLib::Matrix4x4::Identity);
+		for (uint32_t i = 0; i < c_numInputs; i += 2)
+		{
+			(*parentMatrices)[i] = RandomTRSMatrix();
+		}
+
+		runner.Add("Transform3D/GetLocalTransformMatrix", [transforms](BenchmarkState& state)
+			{
+				const auto& inputs = *transforms;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Matrix4x4 result = inputs[i & c_inputMask].GetLocalTransformMatrix();
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Transform3D/GetTransformMatrix", [transforms, parentMatrices](BenchmarkState& state)
+			{
+				const auto& inputs = *transforms;
+				const auto& parents = *parentMatrices;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Matrix4x4 result = inputs[i & c_inputMask].GetTransformMatrix(parents[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		// The euler angles are calculated from the rotation.
+		runner.Add("Transform3D/GetLocalEulerAngles", [transforms](BenchmarkState& state)
+			{
+				const auto& inputs = *transforms;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector3 result = inputs[i & c_inputMask].GetLocalEulerAngles();
+					DoNotOptimize(result);
+				}
+			});
+	}
+
+	void Add2DIntersectionBenchmarks(BenchmarkRunner& runner)
+	{
+		auto rects = std::make_shared<std::vector<MathLib::Rect2D>>(
+			GenerateInputs<MathLib::Rect2D>([]()
+				{
+					return MathLib::Rect2D(RandomVector2(-10.0f, 10.0f),
+						RandomFloat(0.5f, 5.0f), RandomFloat(0.5f, 5.0f));
+				}));
+		auto circles = std::make_shared<std::vector<MathLib::Circle2D>>(
+			GenerateInputs<MathLib::Circle2D>([]()
+				{
+					return MathLib::Circle2D(RandomVector2(-10.0f, 10.0f), RandomFloat(0.5f, 5.0f));
+				}));
+		auto triangles = std::make_shared<std::vector<MathLib::Triangle2D>>(
+			GenerateInputs<MathLib::Triangle2D>([]()
+				{
+					MathLib::Vector2 center = RandomVector2(-10.0f, 10.0f);
+					return MathLib::Triangle2D(center + RandomVector2(-3.0f, 3.0f),
+						center + RandomVector2(-3.0f, 3.0f), center + RandomVector2(-3.0f, 3.0f));
+				}));
+		auto segments = std::make_shared<std::vector<MathLib::LineSegment2D>>(
+			GenerateInputs<MathLib::LineSegment2D>([]()
+				{
+					return MathLib::LineSegment2D(RandomVector2(-15.0f, 15.0f), RandomVector2(-15.0f, 15.0f));
+				}));
+		auto rays = std::make_shared<std::vector<MathLib::Ray2D>>(
+			GenerateInputs<MathLib::Ray2D>([]()
+				{
+					MathLib::Vector2 direction = RandomVector2(-1.0f, 1.0f);
+					direction.Normalize();
+					return MathLib::Ray2D(RandomVector2(-15.0f, 15.0f), direction);
+				}));
+
+		runner.Add("Rect2D/Intersects/Rect2D", [rects](BenchmarkState& state)
+			{
+				const auto& inputs = *rects;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					bool result = inputs[i & c_inputMask].Intersects(inputs[(i + 1) & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Rect2D/Intersects/LineSegment2D", [rects, segments](BenchmarkState& state)
+			{
+				const auto& inputs = *rects;
+				const auto& lineSegments = *segments;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector2 point;
+					bool result = inputs[i & c_inputMask].Intersects(lineSegments[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		runner.Add("Rect2D/Intersects/Ray2D", [rects, rays](BenchmarkState& state)
+			{
+				const auto& inputs = *rects;
+				const auto& ray2Ds = *rays;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector2 point;
+					bool result = inputs[i & c_inputMask].Intersects(ray2Ds[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		runner.Add("Circle2D/Intersects/Circle2D", [circles](BenchmarkState& state)
+			{
+				const auto& inputs = *circles;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					bool result = inputs[i & c_inputMask].Intersects(inputs[(i + 1) & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Circle2D/Intersects/Ray2D", [circles, rays](BenchmarkState& state)
+			{
+				const auto& inputs = *circles;
+				const auto& ray2Ds = *rays;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector2 point;
+					bool result = inputs[i & c_inputMask].Intersects(ray2Ds[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		runner.Add("Triangle2D/Intersects/LineSegment2D", [triangles, segments](BenchmarkState& state)
+			{
+				const auto& inputs = *triangles;
+				const auto& lineSegments = *segments;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector2 point;
+					bool result = inputs[i & c_inputMask].Intersects(lineSegments[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		runner.Add("Triangle2D/IsPointWithin", [triangles, segments](BenchmarkState& state)
+			{
+				const auto& inputs = *triangles;
+				const auto& lineSegments = *segments;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					bool result = inputs[i & c_inputMask].IsPointWithin(lineSegments[(i + 5) & c_inputMask].start);
+					DoNotOptimize(result);
+				}
+			});
+	}
+
+	void Add3DIntersectionBenchmarks(BenchmarkRunner& runner)
+	{
+		auto rects = std::make_shared<std::vector<MathLib::Rect3D>>(
+			GenerateInputs<MathLib::Rect3D>([]()
+				{
+					return MathLib::Rect3D(RandomVector3(-10.0f, 10.0f),
+						RandomFloat(0.5f, 5.0f), RandomFloat(0.5f, 5.0f), RandomFloat(0.5f, 5.0f));
+				}));
+		auto spheres = std::make_shared<std::vector<MathLib::Sphere3D>>(
+			GenerateInputs<MathLib::Sphere3D>([]()
+				{
+					return MathLib::Sphere3D(RandomVector3(-10.0f, 10.0f), RandomFloat(0.5f, 5.0f));
+				}));
+		auto triangles = std::make_shared<std::vector<MathLib::Triangle3D>>(
+			GenerateInputs<MathLib::Triangle3D>([]()
+				{
+					MathLib::Vector3 center = RandomVector3(-10.0f, 10.0f);
+					return MathLib::Triangle3D(center + RandomVector3(-3.0f, 3.0f),
+						center + RandomVector3(-3.0f, 3.0f), center + RandomVector3(-3.0f, 3.0f));
+				}));
+		auto planes = std::make_shared<std::vector<MathLib::Plane3D>>(
+			GenerateInputs<MathLib::Plane3D>([]()
+				{
+					return MathLib::Plane3D(RandomDirection3(), RandomFloat(-10.0f, 10.0f));
+				}));
+		auto segments = std::make_shared<std::vector<MathLib::LineSegment3D>>(
+			GenerateInputs<MathLib::LineSegment3D>([]()
+				{
+					return MathLib::LineSegment3D(RandomVector3(-15.0f, 15.0f), RandomVector3(-15.0f, 15.0f));
+				}));
+		auto rays = std::make_shared<std::vector<MathLib::Ray3D>>(
+			GenerateInputs<MathLib::Ray3D>([]()
+				{
+					// Aims the rays towards the origin so that a good portion of them hit.
+					MathLib::Vector3 start = RandomVector3(-15.0f, 15.0f);
+					MathLib::Vector3 direction = RandomVector3(-5.0f, 5.0f) - start;
+					direction.Normalize();
+					return MathLib::Ray3D(start, direction);
+				}));
+
+		runner.Add("Rect3D/Intersects/Ray3D", [rects, rays](BenchmarkState& state)
+			{
+				const auto& inputs = *rects;
+				const auto& ray3Ds = *rays;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector3 point;
+					bool result = inputs[i & c_inputMask].Intersects(ray3Ds[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		// The same boxes packed eight at a time, the time is per box.
+		auto rectPackets = std::make_shared<std::vector<MathLib::Rect3DPacket>>(c_numInputs / MathLib::c_numPacketLanes);
+		for (uint32_t i = 0; i < c_numInputs; i++)
+		{
+			(*rectPackets)[i / MathLib::c_numPacketLanes].Set(i % MathLib::c_numPacketLanes, (*rects)[i]);
+		}
+		runner.Add("Rect3D/Intersects/Ray3D/Packet8", [rectPackets, rays](BenchmarkState& state)
+			{
+				const auto& inputs = *rectPackets;
+				const auto& ray3Ds = *rays;
+				const uint64_t packetMask = inputs.size() - 1;
+				state.SetItemsPerIteration(MathLib::c_numPacketLanes);
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					float distances[MathLib::c_numPacketLanes];
+					uint32_t result = MathLib::Intersects(ray3Ds[(i + 5) & c_inputMask], inputs[i & packetMask], distances);
+					DoNotOptimize(result);
+					DoNotOptimize(distances);
+				}
+			});
+
+		runner.Add("Rect3D/Intersects/LineSegment3D", [rects, segments](BenchmarkState& state)
+			{
+				const auto& inputs = *rects;
+				const auto& lineSegments = *segments;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector3 point;
+					bool result = inputs[i & c_inputMask].Intersects(lineSegments[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		runner.Add("Sphere3D/Intersects/Ray3D", [spheres, rays](BenchmarkState& state)
+			{
+				const auto& inputs = *spheres;
+				const auto& ray3Ds = *rays;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector3 point;
+					bool result = inputs[i & c_inputMask].Intersects(ray3Ds[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		runner.Add("Triangle3D/Intersects/Ray3D", [triangles, rays](BenchmarkState& state)
+			{
+				const auto& inputs = *triangles;
+				const auto& ray3Ds = *rays;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector3 point;
+					bool result = inputs[i & c_inputMask].Intersects(ray3Ds[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		auto trianglePackets = std::make_shared<std::vector<MathLib::Triangle3DPacket>>(c_numInputs / MathLib::c_numPacketLanes);
+		for (uint32_t i = 0; i < c_numInputs; i++)
+		{
+			(*trianglePackets)[i / MathLib::c_numPacketLanes].Set(i % MathLib::c_numPacketLanes, (*triangles)[i]);
+		}
+		runner.Add("Triangle3D/Intersects/Ray3D/Packet8", [trianglePackets, rays](BenchmarkState& state)
+			{
+				const auto& inputs = *trianglePackets;
+				const auto& ray3Ds = *rays;
+				const uint64_t packetMask = inputs.size() - 1;
+				state.SetItemsPerIteration(MathLib::c_numPacketLanes);
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					float distances[MathLib::c_numPacketLanes];
+					uint32_t result = MathLib::Intersects(ray3Ds[(i + 5) & c_inputMask], inputs[i & packetMask], distances);
+					DoNotOptimize(result);
+					DoNotOptimize(distances);
+				}
+			});
+
+		runner.Add("Triangle3D/Intersects/LineSegment3D", [triangles, segments](BenchmarkState& state)
+			{
+				const auto& inputs = *triangles;
+				const auto& lineSegments = *segments;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector3 point;
+					bool result = inputs[i & c_inputMask].Intersects(lineSegments[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		runner.Add("Plane3D/Intersects/Ray3D", [planes, rays](BenchmarkState& state)
+			{
+				const auto& inputs = *planes;
+				const auto& ray3Ds = *rays;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					MathLib::Vector3 point;
+					bool result = inputs[i & c_inputMask].Intersects(ray3Ds[(i + 5) & c_inputMask], point);
+					DoNotOptimize(result);
+					DoNotOptimize(point);
+				}
+			});
+
+		auto boxes = std::make_shared<std::vector<MathLib::OBB3D>>(
+			GenerateInputs<MathLib::OBB3D>([]()
+				{
+					return MathLib::OBB3D(RandomVector3(-10.0f, 10.0f), RandomVector3(0.5f, 5.0f),
+						MathLib::Quaternion(RandomDirection3(), RandomFloat(0.0f, 360.0f)));
+				}));
+		runner.Add("OBB3D/Intersects/OBB3D", [boxes](BenchmarkState& state)
+			{
+				const auto& inputs = *boxes;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					bool result = MathLib::Intersects(inputs[i & c_inputMask], inputs[(i + 5) & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		auto capsules = std::make_shared<std::vector<MathLib::Capsule3D>>(
+			GenerateInputs<MathLib::Capsule3D>([]()
+				{
+					return MathLib::Capsule3D(RandomVector3(-10.0f, 10.0f),
+						RandomVector3(-10.0f, 10.0f), RandomFloat(0.5f, 2.0f));
+				}));
+		runner.Add("Capsule3D/Intersects/Capsule3D", [capsules](BenchmarkState& state)
+			{
+				const auto& inputs = *capsules;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					bool result = MathLib::Intersects(inputs[i & c_inputMask], inputs[(i + 5) & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		// A camera in the middle of the shapes, so that around half of them are visible.
+		auto frustum = std::make_shared<MathLib::Frustum3D>(MathLib::Frustum3D::FromViewProjection(
+			MathLib::Matrix4x4::CreateTranslation(0.0f, 0.0f, 10.0f)
+				* MathLib::Matrix4x4::CreatePersp(90.0f, 1.0f, 0.1f, 30.0f)));
+		auto spherePackets = std::make_shared<std::vector<MathLib::Sphere3DPacket>>(c_numInputs / MathLib::c_numPacketLanes);
+		auto boxPackets = std::make_shared<std::vector<MathLib::OBB3DPacket>>(c_numInputs / MathLib::c_numPacketLanes);
+		for (uint32_t i = 0; i < c_numInputs; i++)
+		{
+			(*spherePackets)[i / MathLib::c_numPacketLanes].Set(i % MathLib::c_numPacketLanes, (*spheres)[i]);
+			(*boxPackets)[i / MathLib::c_numPacketLanes].Set(i % MathLib::c_numPacketLanes, (*boxes)[i]);
+		}
+
+		runner.Add("Frustum3D/Intersects/Sphere3D", [frustum, spheres](BenchmarkState& state)
+			{
+				const auto& inputs = *spheres;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					bool result = MathLib::Intersects(*frustum, inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Frustum3D/Intersects/Sphere3D/Packet8", [frustum, spherePackets](BenchmarkState& state)
+			{
+				const auto& inputs = *spherePackets;
+				const uint64_t packetMask = inputs.size() - 1;
+				state.SetItemsPerIteration(MathLib::c_numPacketLanes);
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					uint32_t containedMask;
+					uint32_t result = MathLib::Intersects(*frustum, inputs[i & packetMask], containedMask);
+					DoNotOptimize(result);
+					DoNotOptimize(containedMask);
+				}
+			});
+
+		runner.Add("Frustum3D/Intersects/Rect3D", [frustum, rects](BenchmarkState& state)
+			{
+				const auto& inputs = *rects;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					bool result = MathLib::Intersects(*frustum, inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Frustum3D/Intersects/Rect3D/Packet8", [frustum, rectPackets](BenchmarkState& state)
+			{
+				const auto& inputs = *rectPackets;
+				const uint64_t packetMask = inputs.size() - 1;
+				state.SetItemsPerIteration(MathLib::c_numPacketLanes);
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					uint32_t containedMask;
+					uint32_t result = MathLib::Intersects(*frustum, inputs[i & packetMask], containedMask);
+					DoNotOptimize(result);
+					DoNotOptimize(containedMask);
+				}
+			});
+
+		runner.Add("Frustum3D/Intersects/OBB3D", [frustum, boxes](BenchmarkState& state)
+			{
+				const auto& inputs = *boxes;
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					bool result = MathLib::Intersects(*frustum, inputs[i & c_inputMask]);
+					DoNotOptimize(result);
+				}
+			});
+
+		runner.Add("Frustum3D/Intersects/OBB3D/Packet8", [frustum, boxPackets](BenchmarkState& state)
+			{
+				const auto& inputs = *boxPackets;
+				const uint64_t packetMask = inputs.size() - 1;
+				state.SetItemsPerIteration(MathLib::c_numPacketLanes);
+				for (uint64_t i = 0; i < state.GetIterations(); i++)
+				{
+					uint32_t containedMask;
+					uint32_t result = MathLib::Intersects(*frustum, inputs[i & packetMask], containedMask);
+					DoNotOptimize(result);
+					DoNotOptimize(containedMask);
+				}
+			});
+	}
+}
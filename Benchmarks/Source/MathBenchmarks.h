@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Benchmarks
+{
+	class BenchmarkRunner;
+
+	void AddMatrixBenchmarks(BenchmarkRunner& runner);
+	void AddQuaternionBenchmarks(BenchmarkRunner& runner);
+	void AddTransformBenchmarks(BenchmarkRunner& runner);
+	void Add2DIntersectionBenchmarks(BenchmarkRunner& runner);
+	void Add3DIntersectionBenchmarks(BenchmarkRunner& runner);
+}
@@ -0,0 +1,328 @@
+#include "SceneBenchmarks.h"
+#include "Benchmark.h"
+
+// The scene culls & picks through the mesh bounds, so it needs the real meshes
+// that only get created with a rendering api. The null api keeps it headless.
+#if defined(GRAPHICS_API_NULL)
+
+#include "Scene.h"
+#include "SceneManager.h"
+#include "SceneRenderList.h"
+#include "Entity.h"
+#include "Components.h"
+#include "EntityHierarchyComponent.h"
+#include "EntityHierarchySystem.h"
+#include "SpatialIndexSystem.h"
+#include "FrustumCulling.h"
+#include "IUpdateSystem.h"
+#include "EventInvoker.h"
+#include "EngineTime.h"
+#include "Mesh.h"
+#include "GraphicsRenderer.h"
+#include "GraphicsRenderer2D.h"
+#include "GraphicsRenderer3D.h"
+#include "ConstantBuffer.h"
+#include "NullRenderingAPI.h"
+#include "RenderThread.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Benchmarks
+{
+	// The number of entities in each of the root entity's subtree.
+	const uint32_t c_entitiesPerRoot = 16;
+
+	/**
+	 * Creates a scene where every root has a binary tree of children,
+	 * each of the entities has a transform, hierarchy and mesh.
+	 */
+	static Engine::Scene* CreateBenchmarkScene(uint32_t numEntities)
+	{
+		Engine::Scene* scene = new Engine::Scene(L"BenchmarkScene");
+
+		// The root entities are tracked through the hierarchy changed events.
+		Engine::SceneManager::SetActiveScene(scene);
+		Engine::EventInvoker::Global().SetEventFunc(
+			[](Engine::IEvent& event) { Engine::SceneManager::OnEvent(event); });
+
+		std::mt19937 randomEngine(0x6a6b6f72);
+		std::uniform_real_distribution<float> positions(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> angles(-180.0f, 180.0f);
+
+		// The scene camera.
+		{
+			Engine::EntityRef entity = scene->CreateEntity("Main Camera");
+			Engine::Transform3DComponent& cameraTransform
+				= entity.AddComponent<Engine::Transform3DComponent>();
+			cameraTransform.SetLocalPosition(MathLib::Vector3{ 0.0f, 0.0f, -10.0f });
+			entity.AddComponent<Engine::SceneCameraComponent>(true,
+				Engine::SceneCameraType::TYPE_PERSPECTIVE);
+		}
+
+		std::vector<Engine::Entity> subtree;
+		subtree.reserve(c_entitiesPerRoot);
+		for (uint32_t i = 0; i < numEntities; i++)
+		{
+			uint32_t indexInSubtree = i % c_entitiesPerRoot;
+			if (indexInSubtree == 0)
+			{
+				subtree.clear();
+			}
+
+			Engine::Entity parent = indexInSubtree > 0 ?
+				subtree[(indexInSubtree - 1) / 2] : Engine::Entity();
+			Engine::EntityRef entity = scene->CreateEntity("Entity", parent);
+			subtree.push_back(entity.GetEntity());
+
+			Engine::Transform3DComponent& transform
+				= entity.AddComponent<Engine::Transform3DComponent>();
+			transform.SetLocalPosition(MathLib::Vector3(positions(randomEngine),
+				positions(randomEngine), positions(randomEngine)));
+			transform.SetLocalEulerAngles(MathLib::Vector3(angles(randomEngine),
+				angles(randomEngine), angles(randomEngine)));
+
+			Engine::MeshComponent& mesh = entity.AddComponent<Engine::MeshComponent>();
+			mesh.mesh = &Engine::GraphicsRenderer3D::GetCubeMesh();
+			mesh.enabled = true;
+		}
+		return scene;
+	}
+
+	struct SceneBenchmarkContext
+	{
+		uint32_t numEntities = 0;
+		Engine::Scene* scene = nullptr;
+		Engine::EntityHierarchySystem hierarchySystem;
+		Engine::SpatialIndexSystem spatialIndexSystem;
+		Engine::SceneRenderList renderList;
+
+		Engine::Scene& GetScene();
+	};
+
+	// The scene manager owns the active scene, so only one benchmark scene is alive at a time.
+	static SceneBenchmarkContext* s_activeContext = nullptr;
+
+	Engine::Scene& SceneBenchmarkContext::GetScene()
+	{
+		// Creates the scene on first use, so filtered benchmarks don't pay for it.
+		if (s_activeContext != this)
+		{
+			if (s_activeContext != nullptr)
+			{
+				// The previous scene gets deleted when the new scene becomes active.
+				s_activeContext->scene = nullptr;
+			}
+			scene = CreateBenchmarkScene(numEntities);
+			s_activeContext = this;
+
+			// Fills the world matrices, for the benchmarks that don't update the hierarchy.
+			Engine::Timestep ts(1.0f / 60.0f);
+			Engine::UpdateSystemContext updateContext(*scene, ts, false);
+			hierarchySystem.InvokeOnUpdate(updateContext);
+		}
+		return *scene;
+	}
+
+	/**
+	 * Updates & renders a frame per iteration, with a frame latency of 1 the
+	 * scene is updated while the previous frame is rendered on the render thread.
+	 */
+	static void RunUpdateAndRender(SceneBenchmarkContext& context,
+		BenchmarkState& state, uint32_t frameLatency)
+	{
+		Engine::Scene& scene = context.GetScene();
+		state.SetItemsPerIteration(context.numEntities);
+
+		Engine::NullCommandLog& commandLog = Engine::NullRenderingAPI::GetActiveCommandLog();
+		commandLog.SetRecordCommands(false);
+
+		Engine::ConstantBuffer* cameraBuffer = nullptr;
+		Engine::RenderThread renderThread(frameLatency);
+		renderThread.Start([&](const Engine::FramePacket& framePacket)
+			{
+				commandLog.Clear();
+				scene.RenderFramePacket(framePacket, &cameraBuffer);
+			});
+
+		Engine::Timestep ts(1.0f / 60.0f);
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Engine::SceneManager::OnUpdate(ts);
+
+			Engine::FramePacket& framePacket = renderThread.BeginFrame();
+			scene.GatherFramePacket(scene.GetCameraConstants(), framePacket);
+			scene.StoreMeshLODs(framePacket);
+			renderThread.EndFrame();
+		}
+		renderThread.Stop();
+		delete cameraBuffer;
+	}
+
+	void AddSceneBenchmarks(BenchmarkRunner& runner)
+	{
+		const uint32_t entityCounts[] = { 10000, 100000, 1000000 };
+
+		for (uint32_t numEntities : entityCounts)
+		{
+			auto context = std::make_shared<SceneBenchmarkContext>();
+			context->numEntities = numEntities;
+			const std::string prefix = "Scene/" + std::to_string(numEntities) + "/";
+
+			runner.Add(prefix + "OnUpdate", [context](BenchmarkState& state)
+				{
+					context->GetScene();
+					state.SetItemsPerIteration(context->numEntities);
+
+					Engine::Timestep ts(1.0f / 60.0f);
+					for (uint64_t i = 0; i < state.GetIterations(); i++)
+					{
+						Engine::SceneManager::OnUpdate(ts);
+						ClobberMemory();
+					}
+				});
+
+			runner.Add(prefix + "HierarchyUpdate", [context](BenchmarkState& state)
+				{
+					Engine::Scene& scene = context->GetScene();
+					state.SetItemsPerIteration(context->numEntities);
+
+					Engine::Timestep ts(1.0f / 60.0f);
+					Engine::UpdateSystemContext updateContext(scene, ts, false);
+					for (uint64_t i = 0; i < state.GetIterations(); i++)
+					{
+						context->hierarchySystem.InvokeOnUpdate(updateContext);
+						ClobberMemory();
+					}
+				});
+
+			// Rebuilds the flattened hierarchy every iteration, as if an entity's parent changed each frame.
+			runner.Add(prefix + "HierarchyRebuild", [context](BenchmarkState& state)
+				{
+					Engine::Scene& scene = context->GetScene();
+					state.SetItemsPerIteration(context->numEntities);
+
+					Engine::Timestep ts(1.0f / 60.0f);
+					Engine::UpdateSystemContext updateContext(scene, ts, false);
+					for (uint64_t i = 0; i < state.GetIterations(); i++)
+					{
+						scene.GetTransforms().SetHierarchyDirty();
+						context->hierarchySystem.InvokeOnUpdate(updateContext);
+						ClobberMemory();
+					}
+				});
+
+			runner.Add(prefix + "GatherRenderList", [context](BenchmarkState& state)
+				{
+					Engine::Scene& scene = context->GetScene();
+					state.SetItemsPerIteration(context->numEntities);
+
+					for (uint64_t i = 0; i < state.GetIterations(); i++)
+					{
+						context->renderList.Clear();
+						scene.GatherRenderList(context->renderList);
+						DoNotOptimize(context->renderList.meshes.data());
+						ClobberMemory();
+					}
+				});
+
+			runner.Add(prefix + "SpatialIndexUpdate", [context](BenchmarkState& state)
+				{
+					Engine::Scene& scene = context->GetScene();
+					state.SetItemsPerIteration(context->numEntities);
+
+					Engine::Timestep ts(1.0f / 60.0f);
+					Engine::UpdateSystemContext updateContext(scene, ts, false);
+					for (uint64_t i = 0; i < state.GetIterations(); i++)
+					{
+						context->spatialIndexSystem.InvokeOnUpdate(updateContext);
+						ClobberMemory();
+					}
+				});
+
+			runner.Add(prefix + "SpatialIndexFrustumQuery", [context](BenchmarkState& state)
+				{
+					Engine::Scene& scene = context->GetScene();
+					state.SetItemsPerIteration(context->numEntities);
+
+					Engine::Timestep ts(1.0f / 60.0f);
+					Engine::UpdateSystemContext updateContext(scene, ts, false);
+					// Updates the camera & the entity hierarchies before the bounds.
+					Engine::SceneManager::OnUpdate(ts);
+					context->hierarchySystem.InvokeOnUpdate(updateContext);
+					context->spatialIndexSystem.InvokeOnUpdate(updateContext);
+
+					Engine::CullingFrustum frustum = Engine::CullingFrustum::FromViewProjection(
+						scene.GetCameraConstants().c_viewProjection);
+					std::vector<Engine::Entity> entities;
+					for (uint64_t i = 0; i < state.GetIterations(); i++)
+					{
+						entities.clear();
+						scene.GetSpatialIndex().QueryFrustum(frustum, entities);
+						DoNotOptimize(entities.data());
+					}
+				});
+
+			runner.Add(prefix + "Render", [context](BenchmarkState& state)
+				{
+					Engine::Scene& scene = context->GetScene();
+					state.SetItemsPerIteration(context->numEntities);
+
+					// Only count the commands, otherwise the log grows with every iteration.
+					Engine::NullCommandLog& commandLog = Engine::NullRenderingAPI::GetActiveCommandLog();
+					commandLog.SetRecordCommands(false);
+
+					// Gathers & renders on the calling thread, the same work as a frame without the render thread.
+					Engine::FramePacket framePacket;
+					Engine::ConstantBuffer* cameraBuffer = nullptr;
+					for (uint64_t i = 0; i < state.GetIterations(); i++)
+					{
+						commandLog.Clear();
+						scene.GatherFramePacket(scene.GetCameraConstants(), framePacket);
+						scene.StoreMeshLODs(framePacket);
+						scene.RenderFramePacket(framePacket, &cameraBuffer);
+						DoNotOptimize(commandLog.GetTotalBytes());
+					}
+					delete cameraBuffer;
+				});
+
+			runner.Add(prefix + "UpdateAndRender", [context](BenchmarkState& state)
+				{
+					RunUpdateAndRender(*context, state, 0);
+				});
+
+			runner.Add(prefix + "UpdateAndRenderPipelined", [context](BenchmarkState& state)
+				{
+					RunUpdateAndRender(*context, state, 1);
+				});
+
+			runner.Add(prefix + "DrawSprites", [context](BenchmarkState& state)
+				{
+					// Draws a sprite for each entity, these get batched by the 2d renderer.
+					Engine::Scene& scene = context->GetScene();
+					state.SetItemsPerIteration(context->numEntities);
+
+					context->renderList.Clear();
+					scene.GatherRenderList(context->renderList);
+
+					Engine::NullCommandLog& commandLog = Engine::NullRenderingAPI::GetActiveCommandLog();
+					commandLog.SetRecordCommands(false);
+					for (uint64_t i = 0; i < state.GetIterations(); i++)
+					{
+						commandLog.Clear();
+						for (const Engine::MeshRenderItem& item : context->renderList.meshes)
+						{
+							Engine::GraphicsRenderer2D::DrawRect(item.objectToWorld,
+								MathLib::Vector4::One, nullptr, item.entityID);
+						}
+						Engine::GraphicsRenderer2D::Flush();
+						DoNotOptimize(commandLog.GetNumDrawCalls());
+					}
+				});
+		}
+	}
+}
+
+#endif
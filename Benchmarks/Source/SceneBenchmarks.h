@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Benchmarks
+{
+	class BenchmarkRunner;
+
+	/**
+	 * Headless scene benchmarks, these don't need a window but they do need
+	 * real meshes, so they only exist with the null rendering api.
+	 */
+	void AddSceneBenchmarks(BenchmarkRunner& runner);
+}
@@ -0,0 +1,72 @@
+--premake5.lua
+
+project "Benchmarks"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "off"
+
+	targetdir "%{wks.location}/%{prj.name}/Builds/%{cfg.buildcfg}/%{cfg.platform}/"
+	objdir "%{wks.location}/%{prj.name}/Builds-Int/%{cfg.buildcfg}/%{cfg.platform}/"
+
+	files
+	{
+		"%{prj.location}/Source/",
+		"%{prj.location}/Source/**.h",
+		"%{prj.location}/Source/**.cpp",
+		"%{prj.location}/Source/**.hpp",
+	}
+
+	includedirs
+	{
+		"%{prj.location}/Source/",
+		"%{prj.location}/Source/**"
+	}
+
+	-- Benchmarks are always built optimized, the debug
+	-- configuration only keeps the symbols around.
+	filter "configurations:Debug"
+		defines { "DEBUG", "_DEBUG" }
+		symbols "On"
+		optimize "On"
+		runtime "Debug"
+	filter "configurations:Release"
+		defines { "RELEASE", "NDEBUG" }
+		optimize "Full"
+		runtime "Release"
+	filter { }
+
+	-- Compiles the AVX2 paths when built with --simd=avx2.
+	filter { "options:simd=avx2" }
+		vectorextensions "AVX2"
+	filter { }
+
+	--================================= BEGIN ENGINE DEPENDENCIES ===========================--
+
+	includedirs
+	{
+		"%{wks.location}/Engine/Source/",
+		"%{wks.location}/Engine/Source/**",
+
+		-- Engine Dependencies
+		"%{IncludeDirectories.entt}",
+		"%{IncludeDirectories.ImGui}",
+		"%{IncludeDirectories.spdlog}",
+		"%{IncludeDirectories.ImGuizmo}",
+		"%{IncludeDirectories.rapidjson}",
+		"%{IncludeDirectories.MathLib}"
+	}
+
+	links
+	{
+		"Engine",
+		"%{LibraryNames.MathLib}"
+	}
+
+	libdirs
+	{
+		"%{wks.location}/Engine/Builds/%{cfg.buildcfg}/%{cfg.platform}/",
+		"%{BuildDirectories.MathLib}%{cfg.buildcfg}/%{cfg.platform}/"
+	}
+
+	--================================= END ENGINE DEPENDENCIES =============================--
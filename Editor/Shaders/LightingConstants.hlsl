@@ -3,11 +3,17 @@
 struct GraphicsPointLightData
 {
     float3 position;
-    float3 lightColor;
     float innerRadius;
+    float3 lightColor;
     float outerRadius;
     float intensity;
-    bool isEnabled;
+};
+
+// The range of a cluster's lights in the light index list.
+struct LightCluster
+{
+    uint offset;
+    uint count;
 };
 
 struct GraphicsDirectionalLightData
@@ -18,15 +24,41 @@ struct GraphicsDirectionalLightData
     bool isEnabled;
 };
 
-#define MAX_POINT_LIGHTS 32
+// Matches the light cluster grid of LightClusterList.
+#define NUM_LIGHT_CLUSTER_TILES_X 16
+#define NUM_LIGHT_CLUSTER_TILES_Y 8
+#define NUM_LIGHT_CLUSTER_SLICES 24
 
 cbuffer LightingConstantBuffer : register(b4)
 {
     float3 c_ambientLight;
     GraphicsDirectionalLightData c_directionalLight;
-    GraphicsPointLightData c_pointLights[MAX_POINT_LIGHTS];
+    float c_clusterDepthScale;
+    float c_clusterDepthBias;
+    uint c_numPointLights;
 };
 
+StructuredBuffer<GraphicsPointLightData> PointLights : register(t8);
+StructuredBuffer<LightCluster> LightClusters : register(t9);
+StructuredBuffer<uint> LightIndices : register(t10);
+
+// Gets the light cluster of the world position, needs the camera constants.
+LightCluster GetLightCluster(float3 worldPos)
+{
+    float4 clip = mul(float4(worldPos, 1.0), c_viewProjection);
+    float2 tile = floor((clip.xy / clip.w * 0.5 + 0.5)
+        * float2(NUM_LIGHT_CLUSTER_TILES_X, NUM_LIGHT_CLUSTER_TILES_Y));
+    tile = clamp(tile, float2(0.0, 0.0),
+        float2(NUM_LIGHT_CLUSTER_TILES_X - 1, NUM_LIGHT_CLUSTER_TILES_Y - 1));
+    // Orthographic cameras have a depth scale & bias of 0, so they only use the first slice.
+    float slice = floor(log(max(clip.w, 0.0001)) * c_clusterDepthScale + c_clusterDepthBias);
+    slice = clamp(slice, 0.0, NUM_LIGHT_CLUSTER_SLICES - 1);
+
+    uint clusterIndex = ((uint)slice * NUM_LIGHT_CLUSTER_TILES_Y + (uint)tile.y)
+        * NUM_LIGHT_CLUSTER_TILES_X + (uint)tile.x;
+    return LightClusters[clusterIndex];
+}
+
 float3 CalculateDiffuseLighting(float3 normal, float3 directionToLightFromPixel, float3 diffuseColor,
     float3 lightColor, float lightIntensity)
 {
@@ -56,6 +56,7 @@ namespace Editor
 		// Sets the camera system.
 		Engine::SystemManager::AddSystem<Editor::CameraControllerSystem>();
 		Engine::SystemManager::AddSystem<Engine::EntityHierarchySystem>();
+		Engine::SystemManager::AddSystem<Engine::SpatialIndexSystem>();
 
 		Engine::GraphicsRenderer::GetRenderingAPI().SetClearColor(
 			MathLib::Vector4(0.0f, 0.0f, 1.0f, 1.0f));
@@ -22,8 +22,7 @@ namespace Editor
 		m_windowSize(),
 		m_windowPosition(),
 		m_windowBarSpacing(0.0f),
-		m_transformationWidget(),
-		m_sceneViewEntityIDs()
+		m_transformationWidget()
 	{
 		m_transformationWidget.SetEnabled(false);
 
@@ -174,9 +173,7 @@ namespace Editor
 
 		MathLib::Vector2 windowSize = GetResizedWindow();
 		if (windowSize.x <= 0 || windowSize.y <= 0) return;
-		Engine::Texture* entityIDsTexture = m_frameBuffer->GetRenderTargetTexture(1);
-		if (entityIDsTexture != nullptr
-			&& m_focused
+		if (m_focused
 			&& ImGui::IsMouseClicked(ImGuiMouseButton_Left))
 		{
 			MathLib::Vector2 localMousePos = m_currMousePos - m_windowPosition;
@@ -187,30 +184,26 @@ namespace Editor
 			{
 				return;
 			}
-			entityIDsTexture->CopyPixels(m_sceneViewEntityIDs);
 
-			uint32_t pixelX = (uint32_t)localMousePos.x;
-			uint32_t pixelY = (uint32_t)localMousePos.y;
-			int32_t entityID;
-			uint32_t index = pixelX + pixelY * entityIDsTexture->GetWidth();
-			if (m_sceneViewEntityIDs.GetViaIndex((size_t)index, entityID))
+			// Picks the entity on the CPU through the scene's spatial index, rather
+			// than waiting on the GPU to copy back the entity ID render target.
+			const EditorCamera& editorCamera = EditorSceneManager::GetEditorCamera();
+			MathLib::Ray3D ray = editorCamera.ViewportToRay(MathLib::Vector2(
+				localMousePos.x / windowSize.x, localMousePos.y / windowSize.y));
+
+			Engine::Scene* scenePtr = &Engine::SceneManager::GetActiveScene();
+			Engine::SceneRayCastHit hit;
+			if (scenePtr->RayCast(ray, hit))
 			{
-				int32_t currentEntityID = entityID - 1;
-				if (currentEntityID < 0)
-				{
-					EditorSelection::SetSelectedEntity(Engine::Entity::None);
-					return;
-				}
-				Engine::Scene* scenePtr = &Engine::SceneManager::GetActiveScene();
-				auto selectedEntity = scenePtr->CreateEntityRef((entt::entity)currentEntityID);
+				auto selectedEntity = scenePtr->CreateEntityRef(hit.entity);
 				// Sets the selected entity to the one picked by the scene.
 				if (selectedEntity.IsValid())
 				{
 					EditorSelection::SetSelectedEntity(selectedEntity);
 					return;
 				}
-				EditorSelection::SetSelectedEntity(Engine::Entity::None);
 			}
+			EditorSelection::SetSelectedEntity(Engine::Entity::None);
 		}
 	}
 
@@ -220,6 +213,12 @@ namespace Editor
 		if (m_transformationWidget.IsEnabled())
 		{
 			auto entity = EditorSelection::GetSelectedEntity();
+			if (entity.HasComponent<Engine::EntityHierarchyComponent>())
+			{
+				const Engine::Scene& scene = Engine::SceneManager::GetActiveScene();
+				m_transformationWidget.SetParentTransformMatrix(scene.GetTransforms().GetWorldMatrix(
+					entity.GetComponent<Engine::EntityHierarchyComponent>().GetParent()));
+			}
 			if (entity.HasComponent<Engine::Transform3DComponent>())
 			{
 				Engine::Transform3DComponent& transform3D
@@ -50,7 +50,6 @@ namespace Editor
 
 	private:
 		Engine::FrameBuffer* m_frameBuffer;
-		Engine::FixedRuntimeBuffer<Engine::DefaultAllocator> m_sceneViewEntityIDs;
 
 		TransformationWidget m_transformationWidget;
 
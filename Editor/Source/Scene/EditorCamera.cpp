@@ -131,22 +131,23 @@ namespace Editor
 		if (EditorSelection::HasSelectedEntity())
 		{
 			auto selectedEntity = EditorSelection::GetSelectedEntity();
+			const MathLib::Matrix4x4& worldMatrix = Engine::SceneManager::GetActiveScene()
+				.GetTransforms().GetWorldMatrix(selectedEntity.GetEntity(),
+					Engine::SceneTransforms::TransformType::Transform3D);
 			if (selectedEntity.HasComponent<Engine::Transform3DComponent>())
 			{
-				Engine::Transform3DComponent& transform3D =
-					selectedEntity.GetComponent<Engine::Transform3DComponent>();
-				MathLib::Vector3 eyePos = transform3D.GetWorldPosition()
+				MathLib::Vector3 lookAtPos = worldMatrix.GetTranslation();
+				MathLib::Vector3 eyePos = lookAtPos
 					- MathLib::Vector3::UnitZ * FOCUSED_NEAR_DISTANCE;
-				if (LookAt(transform3D.GetWorldPosition(), eyePos))
+				if (LookAt(lookAtPos, eyePos))
 				{
 					return;
 				}
 			}
 			if (selectedEntity.HasComponent<Engine::Transform2DComponent>())
 			{
-				Engine::Transform2DComponent& transform2D =
-					selectedEntity.GetComponent<Engine::Transform2DComponent>();
-				MathLib::Vector3 lookAtPos = MathLib::Vector3(transform2D.GetWorldPosition(), 0.0f);
+				MathLib::Vector3 lookAtPos = worldMatrix.GetTranslation();
+				lookAtPos.z = 0.0f;
 				MathLib::Vector3 eyePos = lookAtPos
 					- MathLib::Vector3::UnitZ * FOCUSED_NEAR_DISTANCE;
 				if (LookAt(lookAtPos, eyePos))
@@ -201,7 +202,7 @@ namespace Editor
 		// If we want to make forward x axis, left y axis, anx up z axis, need to create
 		// a rotation matrix around y axis & z axis.
 		m_viewMatrix = GetTransformMatrix();
-		m_viewMatrix.Invert();
+		m_viewMatrix.InvertAffine();
 
 		switch (m_editorCameraProperties.cameraType)
 		{
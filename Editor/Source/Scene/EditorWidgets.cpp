@@ -35,7 +35,7 @@ namespace Editor
         ImGuizmo::SetRect(displayPos.x, displayPos.y, displayBounds.x, displayBounds.y);
 
         MathLib::Matrix4x4 transformMatrix
-            = m_transform.GetTransformMatrix();
+            = m_transform.GetTransformMatrix(m_parentTransformMatrix);
         
         bool manipulated = ImGuizmo::Manipulate(
             reinterpret_cast<const float*>(&camera.GetViewMatrix()),
@@ -52,10 +52,10 @@ namespace Editor
 
         if (manipulated)
         {
-            if (m_transform.HasParentTransformMatrix())
+            if (m_parentTransformMatrix != MathLib::Matrix4x4::Identity)
             {
-                MathLib::Matrix4x4 inverted = MathLib::Matrix4x4::Invert(m_transform.GetParentTransformMatrix());
-                transformMatrix = inverted * transformMatrix;
+                MathLib::Matrix4x4 inverted = MathLib::Matrix4x4::InvertAffine(m_parentTransformMatrix);
+                transformMatrix = transformMatrix * inverted;
             }
 
             MathLib::Vector3 rotation;
@@ -28,6 +28,9 @@ namespace Editor
 
 		const MathLib::Transform3D& GetTransform() const { return m_transform; }
 
+		// The world matrix of the transform's parent, the widget is drawn in world space.
+		void SetParentTransformMatrix(const MathLib::Matrix4x4& matrix) { m_parentTransformMatrix = matrix; }
+
 		bool IsMouseUsing() const { return m_transformationWidgetEnabled & Type_Using; }
 		bool IsMouseOver() const { return m_transformationWidgetEnabled & Type_Over; }
 
@@ -63,6 +66,7 @@ namespace Editor
 
 	private:
 		MathLib::Transform3D m_transform;
+		MathLib::Matrix4x4 m_parentTransformMatrix = MathLib::Matrix4x4::Identity;
 		uint8_t m_transformationWidgetEnabled = Type_Enabled | Type_Movable;
 
 	public:
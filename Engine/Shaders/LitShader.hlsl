@@ -63,14 +63,11 @@ float4 PhongLightingCalculation(VertexShaderOut psIn)
         lightColor = diffuse + specular;
     }
     
-    // Point Light Implementation
-    for (int i = 0; i < MAX_POINT_LIGHTS; i++)
+    // Point Light Implementation, only the lights of the pixel's cluster are shaded.
+    LightCluster cluster = GetLightCluster(psIn.worldPos);
+    for (uint i = 0; i < cluster.count; i++)
     {
-        GraphicsPointLightData pointLight = c_pointLights[i];
-        if (!pointLight.isEnabled)
-        {
-            break;
-        }
+        GraphicsPointLightData pointLight = PointLights[LightIndices[cluster.offset + i]];
         
         float3 difference = pointLight.position - psIn.worldPos;
         float3 diffuseCalculation = CalculateDiffuseLighting(psIn.normal,
@@ -2,6 +2,9 @@ struct VertexShaderIn
 {
     float3 position : POSITION0;
     float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
+    int textureIndex : TEXINDEX0;
+    int entityID : ENTITYID0;
 };
 
 struct VertexShaderOut
@@ -9,46 +12,59 @@ struct VertexShaderOut
     float4 position : SV_POSITION;
     float3 worldPosition : POSITION0;
     float2 uv : TEXCOORD0;
-    int entityID : ENTITYID;
+    float4 color : COLOR0;
+    nointerpolation int textureIndex : TEXINDEX0;
+    nointerpolation int entityID : ENTITYID;
 };
 
-#include "TextureConstants.hlsl"
 #include "CameraConstants.hlsl"
-#include "ObjectConstants.hlsl"
-#include "MaterialConstants.hlsl"
 
-cbuffer SpriteConstants : register(b3)
+// The sprites are batched, so the vertices are already in world space.
+SamplerState DefaultSampler : register(s0);
+Texture2D SpriteTextures[8] : register(t0);
+
+float4 SampleSpriteTexture(int textureIndex, float2 uv)
 {
-    float4 c_spriteColor;
-};
+    // Shader model 5 can't index a texture array with a dynamic index.
+    switch (textureIndex)
+    {
+        case 0: return SpriteTextures[0].Sample(DefaultSampler, uv);
+        case 1: return SpriteTextures[1].Sample(DefaultSampler, uv);
+        case 2: return SpriteTextures[2].Sample(DefaultSampler, uv);
+        case 3: return SpriteTextures[3].Sample(DefaultSampler, uv);
+        case 4: return SpriteTextures[4].Sample(DefaultSampler, uv);
+        case 5: return SpriteTextures[5].Sample(DefaultSampler, uv);
+        case 6: return SpriteTextures[6].Sample(DefaultSampler, uv);
+        case 7: return SpriteTextures[7].Sample(DefaultSampler, uv);
+    }
+    return float4(1.0, 1.0, 1.0, 1.0);
+}
 
 VertexShaderOut VS(VertexShaderIn input)
 {
     VertexShaderOut output;
     
-    float4 worldPos = mul(float4(input.position, 1.0), c_objectToWorld);
-    output.worldPosition = worldPos.xyz;
-    output.position = mul(worldPos, c_viewProjection);
+    output.worldPosition = input.position;
+    output.position = mul(float4(input.position, 1.0), c_viewProjection);
     output.uv = input.uv;
-    output.entityID = GetEntityID();
+    output.color = input.color;
+    output.textureIndex = input.textureIndex;
+    output.entityID = input.entityID + 1;
+    
     return output;
 }
 
-struct PixelShaderOut
+struct PSOut
 {
-    float4 color : SV_Target0;
+    float4 outputColor : SV_Target0;
     int entityID : SV_Target1;
 };
 
-PixelShaderOut PS(VertexShaderOut input) : SV_TARGET
+PSOut PS(VertexShaderOut input) : SV_TARGET
 {
-    PixelShaderOut psOutput;
-    float4 textureColor = float4(1.0, 1.0, 1.0, 1.0);
-    if (HAS_MATERIAL_FLAG(MaterialFlag_DefaultTexture))
-    {
-        textureColor = DefaultTexture.Sample(DefaultSampler, input.uv);
-    }
-    psOutput.color = textureColor * c_spriteColor;
-    psOutput.entityID = input.entityID;
-    return psOutput;
+    PSOut psOut;
+    float4 textureColor = SampleSpriteTexture(input.textureIndex, input.uv);
+    psOut.outputColor = textureColor * input.color;
+    psOut.entityID = input.entityID;
+    return psOut;
 }
@@ -3,6 +3,7 @@
 
 #include "JsonFileReader.h"
 #include "JsonUtils.h"
+#include "RenderThread.h"
 
 #include <rapidjson/stringbuffer.h>
 
@@ -22,7 +23,8 @@ namespace Engine
 		m_materialConstants(materialConstants),
 		m_internalMaterialConstants({}),
 		m_buffer(materialConstants.GetLayoutBufferSize()),
-		m_numTextures(1)
+		m_numTextures(1),
+		m_renderQueueLayer(RenderQueueLayer_Opaque)
 	{
 		if (s_numMaterials <= 0 && !s_internalMaterialConstantBuffer)
 		{
@@ -40,7 +42,8 @@ namespace Engine
 		m_materialConstants(material.m_materialConstants),
 		m_internalMaterialConstants(material.m_internalMaterialConstants),
 		m_buffer(material.m_materialConstants.GetLayoutBufferSize()),
-		m_numTextures(material.m_numTextures)
+		m_numTextures(material.m_numTextures),
+		m_renderQueueLayer(material.m_renderQueueLayer)
 	{
 		// Copy over the textures.
 		for (uint32_t i = 0; i < m_numTextures; i++)
@@ -60,10 +63,14 @@ namespace Engine
 
 	Material::~Material()
 	{
+		// The frames in flight could still bind the material.
+		RenderThread::FlushActive();
+
 		s_numMaterials--;
 		if (s_numMaterials <= 0)
 		{
 			delete s_internalMaterialConstantBuffer;
+			s_internalMaterialConstantBuffer = nullptr;
 		}
 		delete m_materialConstantBuffer;
 	}
@@ -74,6 +81,7 @@ namespace Engine
 
 		m_shader = material.m_shader;
 		m_numTextures = material.m_numTextures;
+		m_renderQueueLayer = material.m_renderQueueLayer;
 		m_materialConstants = material.m_materialConstants;
 		m_internalMaterialConstants = material.m_internalMaterialConstants;
 		m_buffer = Buffer(m_materialConstants.GetLayoutBufferSize());
@@ -10,6 +10,7 @@
 #include "MaterialConstants.h"
 #include "EngineMacros.h"
 #include "GUID.h"
+#include "RenderQueue.h"
 
 #include "Allocator.h"
 #include "Buffer.h"
@@ -74,6 +75,9 @@ namespace Engine
 
 		const MaterialTextureData& GetTextureData(uint32_t slot) const { return m_textures[slot]; }
 
+		void SetRenderQueueLayer(RenderQueueLayer layer) { m_renderQueueLayer = layer; }
+		RenderQueueLayer GetRenderQueueLayer() const { return m_renderQueueLayer; }
+
 		template<typename T>
 		T* GetConstantValue(const std::string& name) const
 		{
@@ -113,5 +117,6 @@ namespace Engine
 		InternalMaterialConstants m_internalMaterialConstants;
 		Buffer m_buffer;
 		uint32_t m_numTextures;
+		RenderQueueLayer m_renderQueueLayer;
 	};
 }
@@ -5,6 +5,7 @@
 #include "IndexBuffer.h"
 #include "VertexArray.h"
 #include "JsonFileWriter.h"
+#include "RenderThread.h"
 
 #include "Memory.h"
 
@@ -38,6 +39,8 @@ namespace Engine
 		m_indices(nullptr),
 		m_vertexCount(0),
 		m_indexCount(0),
+		m_localBounds(),
+		m_hasLocalBounds(false),
 		m_skinned(false),
 		m_vertexArray(nullptr)
 	{
@@ -46,6 +49,9 @@ namespace Engine
 
 	Mesh::~Mesh()
 	{
+		// The frames in flight could still draw the mesh.
+		RenderThread::FlushActive();
+
 		m_positions.Release();
 		m_normals.Release();
 		m_binormals.Release();
@@ -96,6 +102,9 @@ namespace Engine
 	{
 		if (m_vertexCount != vertexCount)
 		{
+			// The positions get reset, so the bounds are no longer valid.
+			m_hasLocalBounds = false;
+
 			// Sets the vertex count.
 			for (uint32_t i = 0; i < c_maxUVsCount; ++i)
 			{
@@ -180,6 +189,23 @@ namespace Engine
 	{
 		m_positions.SetVertices(vertices, (uint32_t)verticesCount);
 
+		// Updates the bounds, used for culling.
+		m_hasLocalBounds = verticesCount > 0;
+		if (m_hasLocalBounds)
+		{
+			MathLib::Vector3 min = vertices[0];
+			MathLib::Vector3 max = vertices[0];
+			for (size_t i = 1; i < verticesCount; i++)
+			{
+				const MathLib::Vector3& position = vertices[i];
+				min = MathLib::Vector3(std::min(min.x, position.x),
+					std::min(min.y, position.y), std::min(min.z, position.z));
+				max = MathLib::Vector3(std::max(max.x, position.x),
+					std::max(max.y, position.y), std::max(max.z, position.z));
+			}
+			m_localBounds = MathLib::Rect3D(min, max);
+		}
+
 		// Sets the buffer layout parameters.
 		const auto& buffer = m_vertexColors.GetVertexBuffer();
 		buffer->SetBufferLayoutParameters(BufferLayoutParameterSet::Position);
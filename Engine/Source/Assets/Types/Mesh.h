@@ -3,6 +3,7 @@
 #include "EngineMacros.h"
 
 #include "Vector.h"
+#include "Shape3D.h"
 #include "GUID.h"
 #include "VertexBuffer.h"
 
@@ -191,6 +192,10 @@ namespace Engine
 		void SetPositions(const MathLib::Vector3* vertices, size_t verticesSize);
 		void SetPositions(const std::vector<MathLib::Vector3>& vertices);
 		const MathLib::Vector3* GetPositions() const { return m_positions.GetRawBuffer(); }
+
+		// The axis aligned bounds of the positions, updated when the positions are set.
+		const MathLib::Rect3D& GetLocalBounds() const { return m_localBounds; }
+		bool HasLocalBounds() const { return m_hasLocalBounds; }
 		
 		void SetNormals(const MathLib::Vector3* normals, size_t normalsSize);
 		void SetNormals(const std::vector<MathLib::Vector3>& normals);
@@ -234,6 +239,9 @@ namespace Engine
 		uint32_t m_vertexCount;
 		uint32_t m_indexCount;
 
+		MathLib::Rect3D m_localBounds;
+		bool m_hasLocalBounds;
+
 		bool m_skinned;
 	};
 }
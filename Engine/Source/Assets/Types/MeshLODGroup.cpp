@@ -0,0 +1,84 @@
+#include "EnginePCH.h"
+#include "MeshLODGroup.h"
+
+#include "Mesh.h"
+
+#include <cfloat>
+
+namespace Engine
+{
+	MeshLODGroup::MeshLODGroup()
+		: m_lods(),
+		m_boundsCenter(),
+		m_boundsRadius(0.0f),
+		m_hysteresis(0.1f)
+	{
+	}
+
+	void MeshLODGroup::AddLOD(Mesh* mesh, float screenSize)
+	{
+		JKORN_ENGINE_ASSERT(m_lods.size() < c_maxLODs, "The LOD group has too many LODs.");
+		JKORN_ENGINE_ASSERT(m_lods.empty() || screenSize <= m_lods.back().screenSize,
+			"The screen sizes of the LODs should decrease.");
+		m_lods.push_back({ mesh, screenSize });
+		RecalculateBounds();
+	}
+
+	void MeshLODGroup::Clear()
+	{
+		m_lods.clear();
+		RecalculateBounds();
+	}
+
+	void MeshLODGroup::RecalculateBounds()
+	{
+		MathLib::Vector3 min, max;
+		bool hasBounds = false;
+		for (const MeshLOD& lod : m_lods)
+		{
+			if (lod.mesh == nullptr || !lod.mesh->HasLocalBounds())
+			{
+				continue;
+			}
+			const MathLib::Rect3D& bounds = lod.mesh->GetLocalBounds();
+			min = hasBounds ? Min(min, bounds.GetMin()) : bounds.GetMin();
+			max = hasBounds ? Max(max, bounds.GetMax()) : bounds.GetMax();
+			hasBounds = true;
+		}
+
+		if (!hasBounds)
+		{
+			m_boundsCenter = MathLib::Vector3::Zero;
+			m_boundsRadius = 0.0f;
+			return;
+		}
+		m_boundsCenter = (min + max) * 0.5f;
+		m_boundsRadius = (max - min).Length() * 0.5f;
+	}
+
+	uint32_t MeshLODGroup::SelectLOD(float screenSize, uint32_t currentLOD) const
+	{
+		uint32_t numLODs = (uint32_t)m_lods.size();
+		if (currentLOD <= numLODs)
+		{
+			// The range of the current LOD, widened by the hysteresis.
+			float lower = currentLOD < numLODs
+				? m_lods[currentLOD].screenSize * (1.0f - m_hysteresis) : -FLT_MAX;
+			float upper = currentLOD > 0
+				? m_lods[currentLOD - 1].screenSize * (1.0f + m_hysteresis) : FLT_MAX;
+			if (screenSize >= lower && screenSize < upper)
+			{
+				return currentLOD;
+			}
+		}
+
+		for (uint32_t lod = 0; lod < numLODs; lod++)
+		{
+			if (screenSize >= m_lods[lod].screenSize)
+			{
+				return lod;
+			}
+		}
+		return numLODs;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+	class Mesh;
+
+	// A mesh of a LOD group & the smallest screen size that it's drawn at.
+	struct MeshLOD
+	{
+		Mesh* mesh = nullptr;
+		// The diameter of the group's bounding sphere on screen, relative to the screen height.
+		float screenSize = 0.0f;
+	};
+
+	/**
+	 * Meshes of decreasing detail that are swapped based on how large the group's bounding
+	 * sphere is on screen. The LODs go from the most to the least detailed mesh with decreasing
+	 * screen sizes, the group isn't drawn when it's smaller than the last LOD's screen size.
+	 */
+	class MeshLODGroup
+	{
+	public:
+		static const uint32_t c_maxLODs = 8;
+
+	public:
+		explicit MeshLODGroup();
+
+		// Adds a less detailed LOD, the screen size should be smaller than the previous LOD's.
+		void AddLOD(Mesh* mesh, float screenSize);
+		void Clear();
+
+		uint32_t GetNumLODs() const { return (uint32_t)m_lods.size(); }
+		const MeshLOD& GetLOD(uint32_t lod) const { return m_lods[lod]; }
+		Mesh* GetMesh(uint32_t lod) const { return lod < m_lods.size() ? m_lods[lod].mesh : nullptr; }
+
+		/**
+		 * The fraction of a LOD's screen size that the group has to pass it by before
+		 * the LOD changes, which stops the meshes from popping back & forth at the threshold.
+		 */
+		void SetHysteresis(float hysteresis) { m_hysteresis = hysteresis; }
+		float GetHysteresis() const { return m_hysteresis; }
+
+		// Recalculates the bounding sphere from the LOD meshes, needed when their positions change.
+		void RecalculateBounds();
+		const MathLib::Vector3& GetBoundsCenter() const { return m_boundsCenter; }
+		float GetBoundsRadius() const { return m_boundsRadius; }
+
+		/**
+		 * Selects the LOD for the screen size of the bounding sphere. The current LOD is
+		 * kept while the screen size is within the hysteresis of its range. Returns the
+		 * number of LODs when the group is too small to be drawn.
+		 */
+		uint32_t SelectLOD(float screenSize, uint32_t currentLOD) const;
+
+	private:
+		std::vector<MeshLOD> m_lods;
+		MathLib::Vector3 m_boundsCenter;
+		float m_boundsRadius;
+		float m_hysteresis;
+	};
+}
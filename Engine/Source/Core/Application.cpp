@@ -19,6 +19,7 @@
 #include "Entity.h"
 #include "EntityHierarchyComponent.h"
 #include "JobManager.h"
+#include "RenderThread.h"
 #include "Logger.h"
 
 namespace Engine
@@ -42,10 +43,13 @@ namespace Engine
 		: m_window(nullptr), 
 		m_running(true), 
 		m_windowLayerStack(),
+		m_frameBudgetMonitor(),
 		m_prevTime(std::chrono::high_resolution_clock::now()),
 		m_graphicsRenderer(nullptr),
+		m_renderThread(nullptr),
 		m_imguiLayer(nullptr),
-		m_rootPath(rootPath)
+		m_rootPath(rootPath),
+		m_useRenderThread(false)
 	{
         JKORN_ENGINE_ASSERT(s_instance == nullptr, "Application is already running.");
 		s_instance = this;
@@ -54,7 +58,7 @@ namespace Engine
 		Profiler::Init();
 
 #if ENABLE_THREADING
-		// Job Manager is removed for now, should add it when lock-free queues are implemented.
+		// The scene records its command lists across the job manager's workers.
 		JobManager::Init();
 #endif
 		WindowProperties properties = 
@@ -99,49 +103,85 @@ namespace Engine
 
 	void Application::Run()
 	{
+		if (m_useRenderThread)
+		{
+			m_renderThread = std::make_unique<RenderThread>();
+			m_renderThread->Start(BIND_STATIC_FUNCTION(SceneManager::RenderFramePacket));
+		}
+
 		while (m_running)
 		{
-			PROFILE_SCOPE(ApplicationUpdate, Application);
+			m_frameBudgetMonitor.BeginFrame();
+			{
+				PROFILE_SCOPE(ApplicationUpdate, Application);
 
-			// Gets the time step.
-			time_point currentTime = std::chrono::high_resolution_clock::now();
-			std::chrono::nanoseconds diff =
-				std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - m_prevTime);
-			m_prevTime = currentTime;
-			float timestep = (float)diff.count() * 0.000000001f;
-			Timestep ts = { timestep, Time::GetTimeScale() };
+				// Gets the time step.
+				time_point currentTime = std::chrono::high_resolution_clock::now();
+				std::chrono::nanoseconds diff =
+					std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - m_prevTime);
+				m_prevTime = currentTime;
+				float timestep = (float)diff.count() * 0.000000001f;
+				Timestep ts = { timestep, Time::GetTimeScale() };
 
-			if (!m_window->IsMinimized())
-			{
+				if (!m_window->IsMinimized())
 				{
-					PROFILE_SCOPE(LayerUpdate, Layers);
-
-					// Update the window layer stack.
-					for (Layer* layer : m_windowLayerStack)
 					{
-						layer->OnUpdate(ts);
+						PROFILE_SCOPE(LayerUpdate, Layers);
+
+						// Update the window layer stack.
+						for (Layer* layer : m_windowLayerStack)
+						{
+							layer->OnUpdate(ts);
+						}
 					}
-				}
 
 
-				// Allows for the job manager to catch up.
-				JobManager::Wait();
+					// Allows for the job manager to catch up.
+					JobManager::Wait();
 
-				{
-					PROFILE_SCOPE(ImGuiLayerUpdates, ImGui);
+					// The previous frame's scene is rendered while the layers update,
+					// it has to finish before ImGui & the window use the graphics api.
+					if (m_renderThread != nullptr)
+					{
+						m_renderThread->Flush();
+					}
 
-					// Update ImGui Layer.
-					m_imguiLayer->BeginRender();
 					{
-						for (Layer* layer : m_windowLayerStack)
+						PROFILE_SCOPE(ImGuiLayerUpdates, ImGui);
+
+						// Update ImGui Layer.
+						m_imguiLayer->BeginRender();
 						{
-							layer->OnImGuiRender();
+							for (Layer* layer : m_windowLayerStack)
+							{
+								layer->OnImGuiRender();
+							}
 						}
+						m_imguiLayer->EndRender();
 					}
-					m_imguiLayer->EndRender();
+				}
+				else if (m_renderThread != nullptr)
+				{
+					// The window presents & handles the resizes, so the render thread has to be idle.
+					m_renderThread->Flush();
+				}
+				m_window->OnUpdate();
+
+				// Gathers this frame's scene, it's rendered during the next frame's update.
+				if (m_renderThread != nullptr
+					&& !m_window->IsMinimized())
+				{
+					SceneManager::GatherFramePacket(m_renderThread->BeginFrame());
+					m_renderThread->EndFrame();
 				}
 			}
-			m_window->OnUpdate();
+			m_frameBudgetMonitor.EndFrame();
+		}
+
+		if (m_renderThread != nullptr)
+		{
+			m_renderThread->Stop();
+			m_renderThread.reset();
 		}
 	}
 
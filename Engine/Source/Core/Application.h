@@ -6,6 +6,7 @@
 #include <filesystem>
 
 #include "LayerStack.h"
+#include "FrameBudgetMonitor.h"
 
 // Forward Declare the Main Function
 int main(int argsc, char** argsv);
@@ -36,6 +37,17 @@ namespace Engine
 		const std::filesystem::path& GetRootPath() const { return m_rootPath; }
 		class Window& GetWindow() const;
 
+		FrameBudgetMonitor& GetFrameBudgetMonitor() { return m_frameBudgetMonitor; }
+
+	protected:
+		/**
+		 * Renders the active scene on a render thread, a frame behind the layers' update.
+		 * Only for applications whose layers render through the scene, the layers must not
+		 * use the graphics api or change the scene's meshes, materials & textures in OnUpdate.
+		 * Destroying them, the entities or the scene flushes the render thread. Must be set before Run.
+		 */
+		void SetUseRenderThread(bool useRenderThread) { m_useRenderThread = useRenderThread; }
+
 	private:
 		void OnEvent(IEvent& event);
 
@@ -46,12 +58,15 @@ namespace Engine
 		std::unique_ptr<class Window> m_window;
 		class ImGuiLayer* m_imguiLayer;
 		class GraphicsRenderer* m_graphicsRenderer;
+		std::unique_ptr<class RenderThread> m_renderThread;
 
 		LayerStack m_windowLayerStack;
+		FrameBudgetMonitor m_frameBudgetMonitor;
 		std::filesystem::path m_rootPath;
 		std::chrono::high_resolution_clock::time_point m_prevTime;
 
 		bool m_running;
+		bool m_useRenderThread;
 
 	private:
 		static class Application* s_instance;
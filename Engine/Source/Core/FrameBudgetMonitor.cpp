@@ -0,0 +1,77 @@
+#include "EnginePCH.h"
+#include "FrameBudgetMonitor.h"
+
+#include "Profiler.h"
+#include "Logger.h"
+
+namespace Engine
+{
+
+	FrameBudgetMonitor::FrameBudgetMonitor(double budgetMilliseconds, uint32_t capturedFrames)
+		: m_frameBeginTime(std::chrono::high_resolution_clock::now()),
+		m_outputFilePrefix("Spike"),
+		m_budget(budgetMilliseconds),
+		m_prevFrameTime(0.0),
+		m_frameCount(0),
+		m_nextCaptureFrame(0),
+		m_capturedFrames(capturedFrames),
+		m_spikeCount(0),
+		m_enabled(false)
+	{
+	}
+
+	void FrameBudgetMonitor::SetEnabled(bool enabled)
+	{
+		m_enabled = enabled;
+		Profiler::SetCapturedFrameCount(enabled ? m_capturedFrames : 0);
+	}
+
+	void FrameBudgetMonitor::SetCapturedFrames(uint32_t capturedFrames)
+	{
+		m_capturedFrames = capturedFrames;
+		if (m_enabled)
+		{
+			Profiler::SetCapturedFrameCount(capturedFrames);
+		}
+	}
+
+	void FrameBudgetMonitor::BeginFrame()
+	{
+		if (m_enabled)
+		{
+			Profiler::BeginCapturedFrame();
+		}
+		m_frameBeginTime = std::chrono::high_resolution_clock::now();
+	}
+
+	void FrameBudgetMonitor::EndFrame()
+	{
+		std::chrono::microseconds duration = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::high_resolution_clock::now() - m_frameBeginTime);
+		m_prevFrameTime = (double)duration.count() / 1000.0;
+		m_frameCount++;
+
+		if (m_enabled
+			&& m_prevFrameTime > m_budget
+			&& m_frameCount >= m_nextCaptureFrame)
+		{
+			CaptureSpike();
+		}
+	}
+
+	void FrameBudgetMonitor::CaptureSpike()
+	{
+		std::string file = m_outputFilePrefix + "_" + std::to_string(m_spikeCount)
+			+ "_Frame" + std::to_string(m_frameCount) + ".json";
+		if (!Profiler::WriteCapturedFrames(file))
+		{
+			WARN_LOG_CORE("Failed to write the frame spike trace to {0}.", file);
+			return;
+		}
+		WARN_LOG_CORE("Frame {0} took {1}ms (budget {2}ms), trace written to {3}.",
+			m_frameCount, m_prevFrameTime, m_budget, file);
+
+		m_spikeCount++;
+		m_nextCaptureFrame = m_frameCount + GetCapturedFrames();
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace Engine
+{
+
+	/**
+	 * Tracks the frame time against a budget. When a frame goes
+	 * over the budget, the profiler events of the last captured frames
+	 * are written to a spike trace file. Disabled by default, applications
+	 * opt in with SetEnabled, which also enables the profiler's captured frames.
+	 */
+	class FrameBudgetMonitor
+	{
+	public:
+		// The default budget is 1.5x a 60hz frame, so that ordinary jitter isn't reported.
+		explicit FrameBudgetMonitor(double budgetMilliseconds = 1.5 * 1000.0 / 60.0,
+			uint32_t capturedFrames = 8);
+
+		void BeginFrame();
+		void EndFrame();
+
+		// Also enables or disables the profiler's captured frames.
+		void SetEnabled(bool enabled);
+		bool IsEnabled() const { return m_enabled; }
+
+		void SetBudget(double budgetMilliseconds) { m_budget = budgetMilliseconds; }
+		double GetBudget() const { return m_budget; }
+
+		// Also resizes the profiler's captured frames while enabled.
+		void SetCapturedFrames(uint32_t capturedFrames);
+		uint32_t GetCapturedFrames() const { return m_capturedFrames; }
+
+		void SetOutputFilePrefix(const std::string& prefix) { m_outputFilePrefix = prefix; }
+		const std::string& GetOutputFilePrefix() const { return m_outputFilePrefix; }
+
+		double GetPrevFrameTime() const { return m_prevFrameTime; }
+		uint64_t GetFrameCount() const { return m_frameCount; }
+		uint32_t GetSpikeCount() const { return m_spikeCount; }
+
+	private:
+		void CaptureSpike();
+
+	private:
+		std::chrono::high_resolution_clock::time_point m_frameBeginTime;
+		std::string m_outputFilePrefix;
+		double m_budget;
+		double m_prevFrameTime;
+		uint64_t m_frameCount;
+		// The frame at which the next spike can be captured, so that
+		// back to back spikes don't write overlapping traces.
+		uint64_t m_nextCaptureFrame;
+		uint32_t m_capturedFrames;
+		uint32_t m_spikeCount;
+		bool m_enabled;
+	};
+}
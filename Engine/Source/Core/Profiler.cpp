@@ -10,7 +10,10 @@
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 
+#include <atomic>
+#include <memory>
 #include <thread>
+#include <mutex>
 
 namespace Engine
 {
@@ -105,13 +108,85 @@ namespace Engine
 
 	// Profiler Implementation
 
-	static std::unordered_map<std::string, ProfileTimer*> s_timers;
+	// The timers of each thread, so that the same scope running on several threads doesn't share a timer.
+	static std::unordered_map<uint64_t, std::unordered_map<std::string, ProfileTimer>> s_timers;
 	static bool s_profilerInitialized = false;
 
 	static std::string s_outputFile("Profile.json");
 
 	static rapidjson::StringBuffer s_jsonStringBuffer;
 	static rapidjson::PrettyWriter<rapidjson::StringBuffer> s_jsonStringWriter(s_jsonStringBuffer);
+	// Guards the timers & the json writer of the debug session trace.
+	static std::mutex s_sessionMutex;
+
+	// Ring buffer of the most recent frames' events recorded by a single thread,
+	// the job workers record into their own buffers so that they don't contend on a lock.
+	struct ThreadCapturedFrames
+	{
+		// Only contended while a frame begins or the frames are written.
+		std::mutex mutex;
+		std::vector<std::vector<ProfileEvent>> frames;
+	};
+
+	// Bounds the memory of a frame that never ends, e.g. when nothing calls BeginCapturedFrame.
+	static const size_t c_maxCapturedEventsPerThreadFrame = 1 << 16;
+
+	// Zero until a frame budget monitor enables the capture, no events are kept until then.
+	static std::atomic<uint32_t> s_capturedFrameCount(0);
+	static std::atomic<uint32_t> s_currentCapturedFrame(0);
+	// Guards the list of thread buffers & changes to the captured frame count.
+	static std::mutex s_capturedFramesMutex;
+	static std::vector<std::shared_ptr<ThreadCapturedFrames>> s_threadCapturedFrames;
+
+	static uint64_t GetCurrentThreadID()
+	{
+		static thread_local uint64_t threadID = std::hash<std::thread::id>{}(
+			std::this_thread::get_id());
+		return threadID;
+	}
+
+	static ThreadCapturedFrames& GetThreadCapturedFrames()
+	{
+		// Shared with the list, so the events outlive the thread that recorded them.
+		static thread_local std::shared_ptr<ThreadCapturedFrames> threadCapturedFrames;
+		if (threadCapturedFrames == nullptr)
+		{
+			threadCapturedFrames = std::make_shared<ThreadCapturedFrames>();
+			std::lock_guard<std::mutex> lock(s_capturedFramesMutex);
+			threadCapturedFrames->frames.resize(s_capturedFrameCount.load());
+			s_threadCapturedFrames.push_back(threadCapturedFrames);
+		}
+		return *threadCapturedFrames;
+	}
+
+	static void WriteEventToJSON(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+		const ProfileEvent& profileEvent)
+	{
+		writer.StartObject();
+
+		if (profileEvent.begin)
+		{
+			writer.String("name", 4);
+			writer.String(profileEvent.name.c_str(), (rapidjson::SizeType)profileEvent.name.size());
+
+			writer.String("cat", 3);
+			writer.String(profileEvent.category.c_str(), (rapidjson::SizeType)profileEvent.category.size());
+		}
+
+		writer.String("ph", 2);
+		writer.String(profileEvent.begin ? "B" : "E", 1);
+
+		writer.String("ts", 2);
+		writer.Uint64(profileEvent.timeStamp);
+
+		writer.String("pid", 3);
+		writer.Int(1);
+
+		writer.String("tid", 3);
+		writer.Uint64(profileEvent.threadID);
+
+		writer.EndObject();
+	}
 	
 	void Profiler::Init()
 	{
@@ -132,19 +207,32 @@ namespace Engine
         JKORN_ENGINE_ASSERT(outputFile, "File failed to open/write.");
 		fclose(outputFile);
 
-		for (const auto& timer : s_timers)
 		{
-			delete timer.second;
+			std::lock_guard<std::mutex> lock(s_sessionMutex);
+			s_timers.clear();
+		}
+
+		std::lock_guard<std::mutex> lock(s_capturedFramesMutex);
+		for (auto& threadCapturedFrames : s_threadCapturedFrames)
+		{
+			std::lock_guard<std::mutex> threadLock(threadCapturedFrames->mutex);
+			for (auto& frameEvents : threadCapturedFrames->frames)
+			{
+				frameEvents.clear();
+			}
 		}
-		s_timers.clear();
 		s_profilerInitialized = false;
 	}
 
 	void Profiler::Reset()
 	{
-		for (const auto& timer : s_timers)
+		std::lock_guard<std::mutex> lock(s_sessionMutex);
+		for (auto& threadTimers : s_timers)
 		{
-			timer.second->Reset();
+			for (auto& timer : threadTimers.second)
+			{
+				timer.second.Reset();
+			}
 		}
 	}
 
@@ -156,66 +244,146 @@ namespace Engine
 	void Profiler::BeginProfile(const std::string& name,
 		const std::string& category)
 	{
-#ifdef DEBUG
-		const auto& found = s_timers.find(name);
-		if (found != s_timers.end())
-		{
-			ProfileTimer* timer = found->second;
-			timer->Begin();
-			EmplaceToJSON(name, category,
-				*timer, true);
-			return;
-		}
-		ProfileTimer* timer = new ProfileTimer();
-		timer->Begin();
-		s_timers.emplace(name, timer);
-		EmplaceToJSON(name, category, *timer, true);
-#endif
+		RecordEvent(name, category, true);
 	}
 
 	void Profiler::EndProfile(const std::string& name,
 		const std::string& category)
 	{
+		RecordEvent(name, category, false);
+	}
+	
+	void Profiler::RecordEvent(const std::string& name, const std::string& category, bool begin)
+	{
+		// The full session trace is only written in debug, the captured frames
+		// are only kept while a frame budget monitor has enabled them.
+		uint32_t capturedFrameCount = s_capturedFrameCount.load(std::memory_order_relaxed);
+#ifndef DEBUG
+		if (capturedFrameCount == 0)
+		{
+			return;
+		}
+#endif
+
+		ProfileEvent profileEvent;
+		profileEvent.name = name;
+		profileEvent.category = category;
+		profileEvent.timeStamp = GetNowInMicroSeconds();
+		profileEvent.threadID = GetCurrentThreadID();
+		profileEvent.begin = begin;
+
 #ifdef DEBUG
-		const auto& found = s_timers.find(name);
-		if (found != s_timers.end())
 		{
-			ProfileTimer* timer = found->second;
-			timer->End();
-			EmplaceToJSON(name, category,
-				*timer, false);
+			std::lock_guard<std::mutex> lock(s_sessionMutex);
+			auto& threadTimers = s_timers[profileEvent.threadID];
+			if (begin)
+			{
+				threadTimers[name].Begin();
+			}
+			else
+			{
+				const auto& found = threadTimers.find(name);
+				if (found != threadTimers.end())
+				{
+					found->second.End();
+				}
+			}
+			WriteEventToJSON(s_jsonStringWriter, profileEvent);
+		}
+		if (capturedFrameCount == 0)
+		{
+			return;
 		}
 #endif
+
+		ThreadCapturedFrames& threadCapturedFrames = GetThreadCapturedFrames();
+		std::lock_guard<std::mutex> lock(threadCapturedFrames.mutex);
+		// The capture could have been resized or disabled since the count was read.
+		uint32_t frameCount = (uint32_t)threadCapturedFrames.frames.size();
+		if (frameCount == 0)
+		{
+			return;
+		}
+		auto& frameEvents = threadCapturedFrames.frames[
+			s_currentCapturedFrame.load(std::memory_order_relaxed) % frameCount];
+		if (frameEvents.size() < c_maxCapturedEventsPerThreadFrame)
+		{
+			frameEvents.push_back(std::move(profileEvent));
+		}
 	}
-	
-	void Profiler::EmplaceToJSON(const std::string& name, const std::string& category,
-		const ProfileTimer& timer, bool begin)
+
+	void Profiler::BeginCapturedFrame()
 	{
-		s_jsonStringWriter.StartObject();
-		
-		if (begin)
+		std::lock_guard<std::mutex> lock(s_capturedFramesMutex);
+		uint32_t frameCount = s_capturedFrameCount.load();
+		if (frameCount == 0)
 		{
-			s_jsonStringWriter.String("name", 4);
-			s_jsonStringWriter.String(name.c_str(), (rapidjson::SizeType)name.size());
-
-			s_jsonStringWriter.String("cat", 3);
-			s_jsonStringWriter.String(category.c_str(), (rapidjson::SizeType)category.size());
+			return;
 		}
 
-		s_jsonStringWriter.String("ph", 2);
-		s_jsonStringWriter.String(begin ? "B" : "E", 1);
+		uint32_t nextFrame = (s_currentCapturedFrame.load() + 1) % frameCount;
+		for (auto& threadCapturedFrames : s_threadCapturedFrames)
+		{
+			std::lock_guard<std::mutex> threadLock(threadCapturedFrames->mutex);
+			// Clear keeps the capacity, so steady state frames don't allocate.
+			threadCapturedFrames->frames[nextFrame].clear();
+		}
+		s_currentCapturedFrame.store(nextFrame);
+	}
 
-		s_jsonStringWriter.String("ts", 2);
-		s_jsonStringWriter.Uint64(GetNowInMicroSeconds());
+	void Profiler::SetCapturedFrameCount(uint32_t frameCount)
+	{
+		std::lock_guard<std::mutex> lock(s_capturedFramesMutex);
+		for (auto& threadCapturedFrames : s_threadCapturedFrames)
+		{
+			std::lock_guard<std::mutex> threadLock(threadCapturedFrames->mutex);
+			threadCapturedFrames->frames.clear();
+			threadCapturedFrames->frames.resize(frameCount);
+		}
+		s_currentCapturedFrame.store(0);
+		s_capturedFrameCount.store(frameCount);
+	}
 
-		s_jsonStringWriter.String("pid", 3);
-		s_jsonStringWriter.Int(1);
+	uint32_t Profiler::GetCapturedFrameCount()
+	{
+		return s_capturedFrameCount.load();
+	}
 
-		s_jsonStringWriter.String("tid", 3);
-		s_jsonStringWriter.Uint64(std::hash<std::thread::id>{}(
-			std::this_thread::get_id()));
+	bool Profiler::WriteCapturedFrames(const std::string& file)
+	{
+		rapidjson::StringBuffer stringBuffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(stringBuffer);
+		writer.StartArray();
+		{
+			std::lock_guard<std::mutex> lock(s_capturedFramesMutex);
+
+			// Starts at the frame after the current one, which is the oldest.
+			uint32_t frameCount = s_capturedFrameCount.load();
+			uint32_t currentFrame = s_currentCapturedFrame.load();
+			for (uint32_t i = 1; i <= frameCount; i++)
+			{
+				uint32_t frame = (currentFrame + i) % frameCount;
+				for (auto& threadCapturedFrames : s_threadCapturedFrames)
+				{
+					std::lock_guard<std::mutex> threadLock(threadCapturedFrames->mutex);
+					for (const auto& profileEvent : threadCapturedFrames->frames[frame])
+					{
+						WriteEventToJSON(writer, profileEvent);
+					}
+				}
+			}
+		}
+		writer.EndArray();
 
-		s_jsonStringWriter.EndObject();
+		FILE* outputFile = nullptr;
+		Platform::File::FOpenFile(&outputFile, file.c_str(), "w");
+		if (outputFile == nullptr)
+		{
+			return false;
+		}
+		FPrintFile(outputFile, "%s", stringBuffer.GetString());
+		fclose(outputFile);
+		return true;
 	}
 
 	void Profiler::BeginScope(const ProfileScope& scope)
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 namespace Engine
 {
@@ -58,6 +59,16 @@ namespace Engine
 		std::string m_category;
 	};
 
+	// A single begin/end event recorded by the profiler.
+	struct ProfileEvent
+	{
+		std::string name;
+		std::string category;
+		uint64_t timeStamp = 0;
+		uint64_t threadID = 0;
+		bool begin = false;
+	};
+
 	class Profiler
 	{
 	public:
@@ -72,10 +83,27 @@ namespace Engine
 		static void EndProfile(const std::string& name,
 			const std::string& category);
 
+		/**
+		 * Starts a new frame in the captured frames ring buffer,
+		 * overwriting the oldest captured frame.
+		 */
+		static void BeginCapturedFrame();
+
+		/**
+		 * Sets the number of frames of events that are kept in memory,
+		 * zero (the default) disables the capture and no events are kept.
+		 */
+		static void SetCapturedFrameCount(uint32_t frameCount);
+		static uint32_t GetCapturedFrameCount();
+
+		/**
+		 * Writes the captured frames, oldest first, to a trace file.
+		 */
+		static bool WriteCapturedFrames(const std::string& file);
+
 	private:
-		static void EmplaceToJSON(const std::string& name,
-			const std::string& category,
-			const ProfileTimer& timer, bool begin);
+		static void RecordEvent(const std::string& name,
+			const std::string& category, bool begin);
 
 		static void BeginScope(const ProfileScope& scope);
 		static void EndScope(const ProfileScope& scope);
@@ -7,6 +7,8 @@ namespace Engine
 	class Job
 	{
 	public:
+		virtual ~Job() { }
+
 		virtual void OnRun() =0;
 	};
 }
\ No newline at end of file
@@ -5,15 +5,60 @@
 #include "Job.h"
 #include "Profiler.h"
 
+#include <thread>
+
 namespace Engine
 {
 	static const uint32_t MAX_NUM_WORKERS = 8;
 
 	static bool s_initialized = false;
 	static Worker* s_workers = nullptr;
+	static uint32_t s_numWorkers = 0;
 
 	std::atomic<uint32_t> JobManager::s_numJobs = 0;
 	std::queue<Job*> JobManager::s_jobs = std::queue<Job*>();
+	std::mutex JobManager::s_jobsMutex;
+	std::condition_variable JobManager::s_jobsAvailable;
+	std::condition_variable JobManager::s_jobsFinished;
+
+	namespace
+	{
+		// The indices of a parallel for that haven't finished, lives on the caller's stack.
+		struct ParallelForCounter
+		{
+			uint32_t numRemaining = 0;
+			std::mutex mutex;
+			std::condition_variable finished;
+		};
+
+		/**
+		 * Runs a single index of a parallel for.
+		 */
+		class ParallelForJob : public Job
+		{
+		public:
+			ParallelForJob(const std::function<void(uint32_t)>& func,
+				uint32_t index, ParallelForCounter& counter)
+				: m_func(func), m_index(index), m_counter(counter) { }
+
+			void OnRun() override
+			{
+				m_func(m_index);
+				// Counts down under the lock, so the caller can't return & destroy
+				// the counter until this job is done touching it.
+				std::lock_guard<std::mutex> lock(m_counter.mutex);
+				if (--m_counter.numRemaining == 0)
+				{
+					m_counter.finished.notify_all();
+				}
+			}
+
+		private:
+			const std::function<void(uint32_t)>& m_func;
+			uint32_t m_index;
+			ParallelForCounter& m_counter;
+		};
+	}
 
 	void JobManager::Init()
 	{
@@ -23,10 +68,16 @@ namespace Engine
 		{
 			return;
 		}
-		s_workers = new Worker[MAX_NUM_WORKERS];
+
+		// Leaves a core for the main thread, which also runs jobs in a parallel for.
+		uint32_t numCores = (uint32_t)std::thread::hardware_concurrency();
+		s_numWorkers = numCores > 1 ? numCores - 1 : 1;
+		s_numWorkers = s_numWorkers < MAX_NUM_WORKERS ? s_numWorkers : MAX_NUM_WORKERS;
+
+		s_workers = new Worker[s_numWorkers];
 		s_initialized = true;
 
-		for (uint32_t i = 0; i < MAX_NUM_WORKERS; i++)
+		for (uint32_t i = 0; i < s_numWorkers; i++)
 		{
 			s_workers[i].Begin();
 		}
@@ -35,29 +86,131 @@ namespace Engine
 	void JobManager::Release()
 	{
 		if (!s_initialized) return;
-		for (uint32_t i = 0; i < MAX_NUM_WORKERS; i++)
+		for (uint32_t i = 0; i < s_numWorkers; i++)
 		{
 			s_workers[i].End();
 		}
 		delete[] s_workers;
+		s_workers = nullptr;
+		s_numWorkers = 0;
 		s_initialized = false;
+
+		// Deletes the jobs that never ran.
+		while (Job* job = PopJob())
+		{
+			delete job;
+			s_numJobs--;
+		}
 	}
 
 	void JobManager::Wait()
 	{
 		if (!s_initialized) return;
 
-		while (s_numJobs > 0)
+		std::unique_lock<std::mutex> lock(s_jobsMutex);
+		s_jobsFinished.wait(lock, []() { return s_numJobs == 0; });
+	}
+
+	void JobManager::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& func)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+
+		if (!s_initialized || count == 1)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				func(i);
+			}
+			return;
+		}
+
+		ParallelForCounter counter;
+		counter.numRemaining = count - 1;
+		for (uint32_t i = 1; i < count; i++)
+		{
+			InternalAddJob(new ParallelForJob(func, i, counter));
+		}
+		func(0);
+
+		// Helps the workers with the queued jobs, they could be this parallel for's
+		// or ones that a nested parallel for on a worker is waiting on.
+		while (Job* job = PopJob())
 		{
-			std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+			RunJob(job);
 		}
+
+		// The remaining indices are all running on other threads by now.
+		std::unique_lock<std::mutex> lock(counter.mutex);
+		counter.finished.wait(lock, [&counter]() { return counter.numRemaining == 0; });
+	}
+
+	uint32_t JobManager::GetNumWorkers()
+	{
+		return s_numWorkers;
 	}
 	
 	void JobManager::InternalAddJob(Job* job)
 	{
-		if (!s_initialized) return;
+		if (!s_initialized)
+		{
+			// Runs the job on the calling thread so that it doesn't get lost.
+			job->OnRun();
+			delete job;
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_jobsMutex);
+			s_numJobs++;
+			s_jobs.push(job);
+		}
+		s_jobsAvailable.notify_one();
+	}
+
+	Job* JobManager::PopJob()
+	{
+		std::lock_guard<std::mutex> lock(s_jobsMutex);
+		if (s_jobs.empty())
+		{
+			return nullptr;
+		}
+		Job* job = s_jobs.front();
+		s_jobs.pop();
+		return job;
+	}
+
+	Job* JobManager::WaitForJob(const std::atomic<bool>& running)
+	{
+		std::unique_lock<std::mutex> lock(s_jobsMutex);
+		s_jobsAvailable.wait(lock, [&running]() { return !s_jobs.empty() || !running; });
+		if (s_jobs.empty())
+		{
+			return nullptr;
+		}
+		Job* job = s_jobs.front();
+		s_jobs.pop();
+		return job;
+	}
 
-		s_numJobs++;
-		s_jobs.push(job);
+	void JobManager::RunJob(Job* job)
+	{
+		job->OnRun();
+		delete job;
+		if (--s_numJobs == 0)
+		{
+			// Takes the lock so that a waiting thread can't miss the notify between checking & waiting.
+			std::lock_guard<std::mutex> lock(s_jobsMutex);
+			s_jobsFinished.notify_all();
+		}
+	}
+
+	void JobManager::WakeWorkers()
+	{
+		// Takes the lock so that a worker can't miss the wake up between checking & waiting.
+		std::lock_guard<std::mutex> lock(s_jobsMutex);
+		s_jobsAvailable.notify_all();
 	}
 }
\ No newline at end of file
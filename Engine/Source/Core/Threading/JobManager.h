@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <queue>
 
@@ -37,17 +39,46 @@ namespace Engine
 			delete job;
 		}
 
-	private:
+		/**
+		 * Calls the function for each index in [0, count) across the workers
+		 * & the calling thread, returns once all of them have finished.
+		 * Runs on the calling thread if the job manager isn't initialized.
+		 * Can be called from several threads at once, e.g. the game & render threads.
+		 * The queued jobs reference the function & a counter on the caller's stack.
+		 */
+		static void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& func);
+
+		// The number of worker threads, 0 if the job manager isn't initialized.
+		static uint32_t GetNumWorkers();
+
+		// Headless runs, such as benchmarks & tests, initialize the job manager themselves.
 		static void Init();
+		/**
+		 * Stops the workers & deletes the jobs that never ran. Must not race with a
+		 * ParallelFor on another thread, its deleted jobs would never count down.
+		 */
 		static void Release();
+
+	private:
+		// Blocks until all of the queued jobs have finished.
 		static void Wait();
 
 		static void InternalAddJob(Job* job);
 
+		static Job* PopJob();
+		// Blocks until there is a job or the worker is stopped.
+		static Job* WaitForJob(const std::atomic<bool>& running);
+		static void RunJob(Job* job);
+		static void WakeWorkers();
+
 	private:
 		static std::atomic<uint32_t> s_numJobs;
 		// TODO: Need to turn these into lock-free queue.
 		static std::queue<Job*> s_jobs;
+		static std::mutex s_jobsMutex;
+		static std::condition_variable s_jobsAvailable;
+		// Notified when the last queued job finishes.
+		static std::condition_variable s_jobsFinished;
 
 		friend class Application;
 		friend class Worker;
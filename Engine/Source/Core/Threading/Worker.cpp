@@ -20,23 +20,18 @@ namespace Engine
 	void Worker::End()
 	{
 		m_running = false;
+		JobManager::WakeWorkers();
 		m_workerThread.join();
 	}
 
 	void Worker::Run()
 	{
-		bool isLocked;
 		while (m_running)
 		{
-			if (JobManager::s_numJobs > 0
-				&& !JobManager::s_jobs.empty())
+			Job* currentJob = JobManager::WaitForJob(m_running);
+			if (currentJob != nullptr)
 			{
-				Job* currentJob = JobManager::s_jobs.front();
-				JobManager::s_jobs.pop();
-				isLocked = false;
-				currentJob->OnRun();
-				JobManager::s_numJobs--;
-				delete currentJob;
+				JobManager::RunJob(currentJob);
 			}
 		}
 	}
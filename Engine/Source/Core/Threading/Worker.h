@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <queue>
+#include <thread>
 
 namespace Engine
 {
@@ -20,6 +22,6 @@ namespace Engine
 
 	private:
 		std::thread m_workerThread;
-		bool m_running;
+		std::atomic<bool> m_running;
 	};
 }
\ No newline at end of file
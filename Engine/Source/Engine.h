@@ -50,6 +50,7 @@
 #include "IEventSystem.h"
 
 #include "EntityHierarchySystem.h"
+#include "SpatialIndexSystem.h"
 
 #include "Components.h"
 #include "Entity.h"
@@ -8,7 +8,7 @@ namespace Engine
 // Define Template Dependent Name
 #ifndef DECLTDEPNAME
 
-#if defined(PLATFORM_MACOSX)
+#if defined(PLATFORM_MACOSX) || defined(PLATFORM_LINUX)
 #define DECLTDEPNAME template
 #else
 #define DECLTDEPNAME
@@ -18,7 +18,7 @@ namespace Engine
 
 
 #ifndef ENABLE_THREADING
-#define ENABLE_THREADING 0
+#define ENABLE_THREADING 1
 #endif
 
 // Default Macros.
@@ -84,8 +84,8 @@ namespace Engine
 
 #endif
 
-// The MacOS Platform
-#if defined(PLATFORM_MACOSX)
+// The MacOS & Linux Platforms
+#if defined(PLATFORM_MACOSX) || defined(PLATFORM_LINUX)
 
 // Defines the serializable asset macro along with functions.
 // Must forward declare the AssetSerializer & AssetCache classes as a template before using this macro.
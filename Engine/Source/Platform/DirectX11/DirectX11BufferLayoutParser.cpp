@@ -238,9 +238,17 @@ namespace Engine
 
 				description.SemanticIndex = param.semanticIndex;
 				description.InputSlot = inputSlot;
-				description.InstanceDataStepRate = 0;
 
-				description.InputSlotClass = D3D11_INPUT_CLASSIFICATION::D3D11_INPUT_PER_VERTEX_DATA;
+				if (params.perInstance)
+				{
+					description.InstanceDataStepRate = 1;
+					description.InputSlotClass = D3D11_INPUT_CLASSIFICATION::D3D11_INPUT_PER_INSTANCE_DATA;
+				}
+				else
+				{
+					description.InstanceDataStepRate = 0;
+					description.InputSlotClass = D3D11_INPUT_CLASSIFICATION::D3D11_INPUT_PER_VERTEX_DATA;
+				}
 				description.Format = GetFormatFromParam(param);
 				description.AlignedByteOffset = currentOffset;
 				m_inputElementDesc[descSlot] = description;
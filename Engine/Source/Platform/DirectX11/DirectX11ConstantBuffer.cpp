@@ -18,7 +18,7 @@ namespace Engine
 			GraphicsRenderer::GetRenderingAPI());
 		m_constantBuffer = DirectX11Utils::CreateConstantBuffer(renderingAPI.m_device,
 			buffer, stride);
-		SetData((void*)buffer, stride);
+		SetData_Internal(buffer, stride);
 	}
 
 	DirectX11ConstantBuffer::~DirectX11ConstantBuffer()
@@ -29,7 +29,7 @@ namespace Engine
 		}
 	}
 
-	void DirectX11ConstantBuffer::SetData(void* buffer, std::size_t stride)
+	void DirectX11ConstantBuffer::SetData_Internal(const void* buffer, std::size_t stride)
 	{
 		if (m_constantBuffer != nullptr
 			&& buffer != nullptr)
@@ -47,7 +47,7 @@ namespace Engine
 		}
 	}
 
-	void DirectX11ConstantBuffer::Bind(const std::uint32_t& slot, int flags) const
+	void DirectX11ConstantBuffer::Bind_Internal(const std::uint32_t& slot, int flags) const
 	{
 		if (m_constantBuffer == nullptr)
 		{
@@ -13,8 +13,9 @@ namespace Engine
 		explicit DirectX11ConstantBuffer(const void* buffer, std::size_t stride);
 		~DirectX11ConstantBuffer();
 
-		void SetData(void* buffer, std::size_t stride) override;
-		void Bind(const std::uint32_t& slot, int flags) const override;
+	protected:
+		void SetData_Internal(const void* buffer, std::size_t stride) override;
+		void Bind_Internal(const std::uint32_t& slot, int flags) const override;
 
 	private:
 		ID3D11Buffer* m_constantBuffer;
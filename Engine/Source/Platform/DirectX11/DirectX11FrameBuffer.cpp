@@ -182,6 +182,9 @@ namespace Engine
 		}
 		renderingAPI.SetViewport(0.0f, 0.0f,
 			(float)m_frameBufferSpecification.width, (float)m_frameBufferSpecification.height);
+
+		// Binding a render target unbinds its shader resource views.
+		GraphicsRenderer::InvalidateRenderState();
 	}
 	
 	void DirectX11FrameBuffer::UnBind() const
@@ -340,6 +340,26 @@ namespace Engine
 			vertexArray->GetIndexBuffer()->GetNumIndices(), 0, 0);
 	}
 
+	void DirectX11RenderingAPI::DrawInstanced(VertexArray* vertexArray,
+		VertexBuffer* instanceBuffer, uint32_t numInstances)
+	{
+		if (!vertexArray->IsValid() || numInstances <= 0) return;
+
+		vertexArray->Bind();
+
+		// Binds the instance buffer after the vertex array's buffers.
+		DirectX11VertexBuffer* iBuffer = dynamic_cast<DirectX11VertexBuffer*>(
+			instanceBuffer);
+		ID3D11Buffer* buffer = iBuffer->GetID3D11Buffer();
+		UINT stride = iBuffer->GetStride();
+		UINT offset = 0;
+		m_deviceContext->IASetVertexBuffers((UINT)vertexArray->GetNumVertexBuffers(),
+			1, &buffer, &stride, &offset);
+
+		m_deviceContext->DrawIndexedInstanced(
+			vertexArray->GetIndexBuffer()->GetNumIndices(), numInstances, 0, 0, 0);
+	}
+
 	void DirectX11RenderingAPI::Present()
 	{
 		// For GLFW & OpenGL, use this:
@@ -41,6 +41,8 @@ namespace Engine
 		void Draw(VertexArray* vertexArray) override;
 		void Draw(VertexBuffer* buffer, 
 			IndexBuffer* indexBuffer = nullptr) override;
+		void DrawInstanced(VertexArray* vertexArray,
+			VertexBuffer* instanceBuffer, uint32_t numInstances) override;
 
         /**
          * Clears the render target view colors.
@@ -84,6 +86,7 @@ namespace Engine
 		friend class DirectX11Texture;
 		friend class DirectX11Texture2D;
 		friend class DirectX11ConstantBuffer;
+		friend class DirectX11StructuredBuffer;
 		friend class DirectX11Shader;
 		friend class DirectX11ComputeShader;
 		friend class DirectX11RenderTexture;
@@ -52,7 +52,7 @@ namespace Engine
 			&& m_inputLayout != nullptr;
 	}
 
-	void DirectX11Shader::Bind() const
+	void DirectX11Shader::Bind_Internal() const
 	{
 		if (!IsValid())
 		{
@@ -14,9 +14,9 @@ namespace Engine
 		~DirectX11Shader();
 
 		bool IsValid() const override;
-		void Bind() const;
 
 	protected:
+		void Bind_Internal() const override;
 		bool LoadFromFile_Internal(const wchar_t* shaderPath) override;
 
 	private:
@@ -0,0 +1,108 @@
+#include "EnginePCH.h"
+#include "DirectX11StructuredBuffer.h"
+
+#include "Memory.h"
+#include "GraphicsRenderer.h"
+#include "DirectX11RenderingAPI.h"
+#include "DirectX11Utils.h"
+
+#include <d3d11.h>
+
+namespace Engine
+{
+	DirectX11StructuredBuffer::DirectX11StructuredBuffer(std::size_t stride, std::uint32_t capacity)
+		: StructuredBuffer(stride, capacity),
+		m_buffer(nullptr),
+		m_shaderResourceView(nullptr)
+	{
+		Resize_Internal(GetCapacity());
+	}
+
+	DirectX11StructuredBuffer::~DirectX11StructuredBuffer()
+	{
+		Release();
+	}
+
+	void DirectX11StructuredBuffer::Release()
+	{
+		if (m_shaderResourceView != nullptr)
+		{
+			m_shaderResourceView->Release();
+			m_shaderResourceView = nullptr;
+		}
+		if (m_buffer != nullptr)
+		{
+			m_buffer->Release();
+			m_buffer = nullptr;
+		}
+	}
+
+	void DirectX11StructuredBuffer::Resize_Internal(std::uint32_t capacity)
+	{
+		Release();
+
+		DirectX11RenderingAPI& renderingAPI = (DirectX11RenderingAPI&)(
+			GraphicsRenderer::GetRenderingAPI());
+		m_buffer = DirectX11Utils::CreateStructuredBuffer(renderingAPI.m_device,
+			nullptr, GetStride(), capacity, DirectX11BufferType::Type_StructuredBuffer);
+		if (m_buffer != nullptr)
+		{
+			m_shaderResourceView = DirectX11Utils::CreateBufferShaderResourceView(
+				renderingAPI.m_device, m_buffer);
+		}
+	}
+
+	void DirectX11StructuredBuffer::SetData_Internal(const void* elements, std::uint32_t numElements)
+	{
+		if (m_buffer == nullptr)
+		{
+			return;
+		}
+
+		DirectX11RenderingAPI& renderingAPI = (DirectX11RenderingAPI&)(
+			GraphicsRenderer::GetRenderingAPI());
+
+		D3D11_MAPPED_SUBRESOURCE mapResource;
+		HRESULT result = renderingAPI.m_deviceContext->Map(
+			m_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapResource);
+		JKORN_ENGINE_ASSERT(result == S_OK, "Failed to map the structured buffer resource.");
+		Memory::Memcpy(mapResource.pData, elements, GetStride() * numElements);
+		renderingAPI.m_deviceContext->Unmap(m_buffer, 0);
+	}
+
+	void DirectX11StructuredBuffer::Bind_Internal(std::uint32_t slot, int flags) const
+	{
+		if (m_shaderResourceView == nullptr)
+		{
+			return;
+		}
+
+		DirectX11RenderingAPI& renderingAPI = (DirectX11RenderingAPI&)(
+			GraphicsRenderer::GetRenderingAPI());
+		ID3D11ShaderResourceView* shaderResourceView = m_shaderResourceView;
+
+		if (flags & ConstantBufferFlags::VERTEX_SHADER)
+		{
+			renderingAPI.m_deviceContext->VSSetShaderResources(
+				slot, 1, &shaderResourceView);
+		}
+
+		if (flags & ConstantBufferFlags::PIXEL_SHADER)
+		{
+			renderingAPI.m_deviceContext->PSSetShaderResources(
+				slot, 1, &shaderResourceView);
+		}
+
+		if (flags & ConstantBufferFlags::COMPUTE_SHADER)
+		{
+			renderingAPI.m_deviceContext->CSSetShaderResources(
+				slot, 1, &shaderResourceView);
+		}
+
+		if (flags & ConstantBufferFlags::HULL_SHADER)
+		{
+			renderingAPI.m_deviceContext->HSSetShaderResources(
+				slot, 1, &shaderResourceView);
+		}
+	}
+}
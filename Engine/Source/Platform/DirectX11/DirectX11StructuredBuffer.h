@@ -0,0 +1,29 @@
+#pragma once
+
+#include "StructuredBuffer.h"
+
+struct ID3D11Buffer;
+struct ID3D11ShaderResourceView;
+
+namespace Engine
+{
+
+	class DirectX11StructuredBuffer : public StructuredBuffer
+	{
+	public:
+		explicit DirectX11StructuredBuffer(std::size_t stride, std::uint32_t capacity);
+		~DirectX11StructuredBuffer();
+
+	protected:
+		void Resize_Internal(std::uint32_t capacity) override;
+		void SetData_Internal(const void* elements, std::uint32_t numElements) override;
+		void Bind_Internal(std::uint32_t slot, int flags) const override;
+
+	private:
+		void Release();
+
+	private:
+		ID3D11Buffer* m_buffer;
+		ID3D11ShaderResourceView* m_shaderResourceView;
+	};
+}
@@ -131,7 +131,7 @@ namespace Engine
 			&& m_texture != nullptr;
 	}
 
-	void DirectX11Texture::Bind(std::uint32_t slot) const
+	void DirectX11Texture::Bind_Internal(std::uint32_t slot) const
 	{
 		if (!IsValid())
 		{
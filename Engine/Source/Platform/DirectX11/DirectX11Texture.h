@@ -16,7 +16,6 @@ namespace Engine
 		~DirectX11Texture();
 
 		bool IsValid() const override;
-		void Bind(const uint32_t slot) const override;
 
 		const void* GetTextureID() const override;
 
@@ -26,6 +25,7 @@ namespace Engine
 		void CopyPixels(BufferModifier& view) const override;
 	
 	protected:
+		void Bind_Internal(uint32_t slot) const override;
 		bool LoadFromFile_Internal(const wchar_t* texturePath) override;
 		void Free();
 		bool CopyTo(Texture& texture) override;
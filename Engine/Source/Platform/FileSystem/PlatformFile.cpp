@@ -33,7 +33,7 @@ bool FOpenFile(FILE** file, const wchar_t* filePath, const wchar_t* mode)
 bool FOpenFile(FILE** file, const char* filePath, const char* mode)
 {
     // TODO: Implement Windows
-#if defined(PLATFORM_MACOSX)
+#if defined(PLATFORM_MACOSX) || defined(PLATFORM_LINUX)
     *file = fopen(filePath, mode);
     // If its null that means that it failed.
     return *file != nullptr;
@@ -8,7 +8,7 @@ namespace Platform::File
 {
 
 #ifndef FPrintFile
-#if defined(PLATFORM_MACOS)
+#if defined(PLATFORM_MACOS) || defined(PLATFORM_LINUX)
 #define FPrintFile(...) fprintf(__VA_ARGS__)
 #elif defined(PLATFORM_WINDOWS)
 #define FPrintFile(...) fprintf_s(__VA_ARGS__)
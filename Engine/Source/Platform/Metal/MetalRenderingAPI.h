@@ -30,6 +30,8 @@ public:
     void Draw(VertexArray* vertexArray) override;
     void Draw(VertexBuffer* vertexBuffer,
         IndexBuffer* indexBuffer = nullptr) override;
+    void DrawInstanced(VertexArray* vertexArray,
+        VertexBuffer* instanceBuffer, uint32_t numInstances) override;
     
     void SetWireframe(bool wireframeMode) override;
     bool IsWireframe() const override;
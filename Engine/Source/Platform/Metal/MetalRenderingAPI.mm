@@ -169,6 +169,12 @@ void MetalRenderingAPI::Draw(VertexBuffer* vertexBuffer, IndexBuffer* indexBuffe
     }
 }
 
+void MetalRenderingAPI::DrawInstanced(VertexArray* vertexArray,
+    VertexBuffer* instanceBuffer, uint32_t numInstances)
+{
+    JKORN_ENGINE_ASSERT(false, "Not Implemented Yet.");
+}
+
 void MetalRenderingAPI::SetWireframe(bool wireframeMode)
 {
     // TODO: Implementation
@@ -13,6 +13,8 @@ namespace Engine
         ~MetalShader();
         
         bool IsValid() const override;
-        void Bind() const override;
+
+    protected:
+        void Bind_Internal() const override;
     };
 }
@@ -27,7 +27,7 @@ namespace Engine
         return false;
     }
 
-    void MetalShader::Bind() const
+    void MetalShader::Bind_Internal() const
     {
         
     }
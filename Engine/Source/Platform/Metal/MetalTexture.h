@@ -17,8 +17,6 @@ namespace Engine
         bool IsValid() const override;
         const void* GetTextureID() const override { return m_texture; }
         
-        void Bind(uint32_t textureSlot) const override;
-        
         bool GetPixel(uint32_t x, uint32_t y, MathLib::Vector4& pixel) const override;
         
         void SetPixel(uint32_t x, uint32_t y, const MathLib::Vector4& pixel) override;
@@ -26,6 +24,7 @@ namespace Engine
         void CopyPixels(BufferModifier& view) const override;
         
     protected:
+        void Bind_Internal(uint32_t textureSlot) const override;
         bool LoadFromFile_Internal(const wchar_t* texturePath) override;
         bool CopyTo(Texture& b) override;
 
@@ -159,7 +159,7 @@ namespace Engine
         return m_texture != nullptr;
     }
 
-    void MetalTexture::Bind(uint32_t textureSlot) const
+    void MetalTexture::Bind_Internal(uint32_t textureSlot) const
     {
         // Don't bind texture at slot if it isn't valid.
         if (!IsValid())
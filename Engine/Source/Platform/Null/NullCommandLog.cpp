@@ -0,0 +1,140 @@
+#include "EnginePCH.h"
+#include "NullCommandLog.h"
+
+namespace Engine
+{
+
+	NullCommandLog::NullCommandLog()
+		: m_commands(),
+		m_numCommands(),
+		m_numBytes(),
+		m_recordCommands(true),
+		m_mutex()
+	{
+	}
+
+	void NullCommandLog::Record(NullCommandType type, const void* resource,
+		uint64_t bytes, uint32_t slot, uint32_t count)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_numCommands[type]++;
+		m_numBytes[type] += bytes;
+
+		if (m_recordCommands)
+		{
+			NullCommand& command = m_commands.emplace_back();
+			command.type = type;
+			command.resource = resource;
+			command.bytes = bytes;
+			command.slot = slot;
+			command.count = count;
+		}
+	}
+
+	void NullCommandLog::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_commands.clear();
+		for (uint32_t i = 0; i < NullCommand_Count; i++)
+		{
+			m_numCommands[i] = 0;
+			m_numBytes[i] = 0;
+		}
+	}
+
+	void NullCommandLog::SetRecordCommands(bool recordCommands)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_recordCommands = recordCommands;
+	}
+
+	bool NullCommandLog::IsRecordingCommands() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_recordCommands;
+	}
+
+	uint64_t NullCommandLog::GetNumCommands(NullCommandType type) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_numCommands[type];
+	}
+
+	uint64_t NullCommandLog::GetNumBytes(NullCommandType type) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_numBytes[type];
+	}
+
+	uint64_t NullCommandLog::GetTotalCommands() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		uint64_t total = 0;
+		for (uint32_t i = 0; i < NullCommand_Count; i++)
+		{
+			total += m_numCommands[i];
+		}
+		return total;
+	}
+
+	uint64_t NullCommandLog::GetTotalBytes() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		uint64_t total = 0;
+		for (uint32_t i = 0; i < NullCommand_Count; i++)
+		{
+			total += m_numBytes[i];
+		}
+		return total;
+	}
+
+	uint64_t NullCommandLog::GetNumDrawCalls() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_numCommands[NullCommand_Draw]
+			+ m_numCommands[NullCommand_DrawIndexed]
+			+ m_numCommands[NullCommand_DrawIndexedInstanced];
+	}
+
+	const char* NullCommandLog::GetCommandName(NullCommandType type)
+	{
+		switch (type)
+		{
+		case NullCommand_SetViewport: return "SetViewport";
+		case NullCommand_SetResolution: return "SetResolution";
+		case NullCommand_SetClearColor: return "SetClearColor";
+		case NullCommand_SetWireframe: return "SetWireframe";
+		case NullCommand_Present: return "Present";
+		case NullCommand_ClearTexture: return "ClearTexture";
+		case NullCommand_Draw: return "Draw";
+		case NullCommand_DrawIndexed: return "DrawIndexed";
+		case NullCommand_DrawIndexedInstanced: return "DrawIndexedInstanced";
+		case NullCommand_CreateVertexBuffer: return "CreateVertexBuffer";
+		case NullCommand_SetVertexBufferData: return "SetVertexBufferData";
+		case NullCommand_BindVertexBuffer: return "BindVertexBuffer";
+		case NullCommand_CreateIndexBuffer: return "CreateIndexBuffer";
+		case NullCommand_SetIndexBufferData: return "SetIndexBufferData";
+		case NullCommand_BindIndexBuffer: return "BindIndexBuffer";
+		case NullCommand_CreateConstantBuffer: return "CreateConstantBuffer";
+		case NullCommand_SetConstantBufferData: return "SetConstantBufferData";
+		case NullCommand_BindConstantBuffer: return "BindConstantBuffer";
+		case NullCommand_CreateStructuredBuffer: return "CreateStructuredBuffer";
+		case NullCommand_SetStructuredBufferData: return "SetStructuredBufferData";
+		case NullCommand_BindStructuredBuffer: return "BindStructuredBuffer";
+		case NullCommand_BindVertexArray: return "BindVertexArray";
+		case NullCommand_CreateShader: return "CreateShader";
+		case NullCommand_LoadShader: return "LoadShader";
+		case NullCommand_BindShader: return "BindShader";
+		case NullCommand_CreateTexture: return "CreateTexture";
+		case NullCommand_LoadTexture: return "LoadTexture";
+		case NullCommand_BindTexture: return "BindTexture";
+		case NullCommand_ReadTexture: return "ReadTexture";
+		case NullCommand_WriteTexture: return "WriteTexture";
+		case NullCommand_CreateFrameBuffer: return "CreateFrameBuffer";
+		case NullCommand_BindFrameBuffer: return "BindFrameBuffer";
+		case NullCommand_UnBindFrameBuffer: return "UnBindFrameBuffer";
+		case NullCommand_ResizeFrameBuffer: return "ResizeFrameBuffer";
+		default: return "Unknown";
+		}
+	}
+}
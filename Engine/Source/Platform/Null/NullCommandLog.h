@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Engine
+{
+
+	enum NullCommandType
+	{
+		NullCommand_SetViewport,
+		NullCommand_SetResolution,
+		NullCommand_SetClearColor,
+		NullCommand_SetWireframe,
+		NullCommand_Present,
+		NullCommand_ClearTexture,
+
+		NullCommand_Draw,
+		NullCommand_DrawIndexed,
+		NullCommand_DrawIndexedInstanced,
+
+		NullCommand_CreateVertexBuffer,
+		NullCommand_SetVertexBufferData,
+		NullCommand_BindVertexBuffer,
+
+		NullCommand_CreateIndexBuffer,
+		NullCommand_SetIndexBufferData,
+		NullCommand_BindIndexBuffer,
+
+		NullCommand_CreateConstantBuffer,
+		NullCommand_SetConstantBufferData,
+		NullCommand_BindConstantBuffer,
+
+		NullCommand_CreateStructuredBuffer,
+		NullCommand_SetStructuredBufferData,
+		NullCommand_BindStructuredBuffer,
+
+		NullCommand_BindVertexArray,
+
+		NullCommand_CreateShader,
+		NullCommand_LoadShader,
+		NullCommand_BindShader,
+
+		NullCommand_CreateTexture,
+		NullCommand_LoadTexture,
+		NullCommand_BindTexture,
+		NullCommand_ReadTexture,
+		NullCommand_WriteTexture,
+
+		NullCommand_CreateFrameBuffer,
+		NullCommand_BindFrameBuffer,
+		NullCommand_UnBindFrameBuffer,
+		NullCommand_ResizeFrameBuffer,
+
+		NullCommand_Count
+	};
+
+	/**
+	 * A call that was made to the null rendering api.
+	 */
+	struct NullCommand
+	{
+		NullCommandType type;
+		// The resource that the command was called on.
+		const void* resource = nullptr;
+		// The number of bytes that would've been sent to the gpu.
+		uint64_t bytes = 0;
+		// The slot for binds, instance count for instanced draws, vertex/index count for draws.
+		uint32_t slot = 0;
+		uint32_t count = 0;
+	};
+
+	/**
+	 * Records all of the calls made to the null rendering api so that
+	 * they can be inspected by tests & benchmarks. The calls can be recorded
+	 * from any thread, e.g. the render thread & the job workers.
+	 */
+	class NullCommandLog
+	{
+	public:
+		explicit NullCommandLog();
+
+		void Record(NullCommandType type, const void* resource,
+			uint64_t bytes = 0, uint32_t slot = 0, uint32_t count = 0);
+
+		/**
+		 * Clears the recorded commands & counters.
+		 */
+		void Clear();
+
+		/**
+		 * When disabled only the counters are updated, which
+		 * keeps the memory usage flat for long benchmarks.
+		 */
+		void SetRecordCommands(bool recordCommands);
+		bool IsRecordingCommands() const;
+
+		/**
+		 * The recorded commands, in the order they were called. The reference
+		 * should only be read while no other thread is rendering.
+		 */
+		const std::vector<NullCommand>& GetCommands() const { return m_commands; }
+
+		uint64_t GetNumCommands(NullCommandType type) const;
+		uint64_t GetNumBytes(NullCommandType type) const;
+
+		uint64_t GetTotalCommands() const;
+		uint64_t GetTotalBytes() const;
+
+		// The number of draw calls, indexed or not.
+		uint64_t GetNumDrawCalls() const;
+
+		static const char* GetCommandName(NullCommandType type);
+
+	private:
+		std::vector<NullCommand> m_commands;
+		uint64_t m_numCommands[NullCommand_Count];
+		uint64_t m_numBytes[NullCommand_Count];
+		bool m_recordCommands;
+		mutable std::mutex m_mutex;
+	};
+}
@@ -0,0 +1,40 @@
+#include "EnginePCH.h"
+#include "NullConstantBuffer.h"
+
+#include "Memory.h"
+#include "NullRenderingAPI.h"
+
+namespace Engine
+{
+	NullConstantBuffer::NullConstantBuffer(const void* buffer, std::size_t stride)
+		: ConstantBuffer(buffer, stride),
+		m_data(stride)
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateConstantBuffer, this,
+			(uint64_t)stride);
+		SetData_Internal(buffer, stride);
+	}
+
+	NullConstantBuffer::~NullConstantBuffer()
+	{
+	}
+
+	void NullConstantBuffer::SetData_Internal(const void* buffer, std::size_t stride)
+	{
+		if (buffer == nullptr)
+		{
+			return;
+		}
+		// Matches the gpu buffer, which has a fixed size.
+		size_t size = stride < m_data.size() ? stride : m_data.size();
+		Memory::Memcpy(m_data.data(), buffer, size);
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_SetConstantBufferData, this,
+			(uint64_t)size);
+	}
+
+	void NullConstantBuffer::Bind_Internal(const std::uint32_t& slot, int flags) const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_BindConstantBuffer, this,
+			0, slot, (uint32_t)flags);
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ConstantBuffer.h"
+
+#include <vector>
+
+namespace Engine
+{
+
+	class NullConstantBuffer : public ConstantBuffer
+	{
+	public:
+		explicit NullConstantBuffer(const void* buffer, std::size_t stride);
+		~NullConstantBuffer();
+
+		// The cpu copy of the last uploaded data.
+		const std::vector<uint8_t>& GetData() const { return m_data; }
+
+	protected:
+		void SetData_Internal(const void* buffer, std::size_t stride) override;
+		void Bind_Internal(const std::uint32_t& slot, int flags) const override;
+
+	private:
+		std::vector<uint8_t> m_data;
+	};
+}
@@ -0,0 +1,92 @@
+#include "EnginePCH.h"
+#include "NullFrameBuffer.h"
+
+#include "NullTexture.h"
+#include "NullRenderingAPI.h"
+
+namespace Engine
+{
+	NullFrameBuffer::NullFrameBuffer(const FrameBufferSpecification& specification)
+		: FrameBuffer(specification),
+		m_renderTargetTextures(),
+		m_depthTexture(nullptr)
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateFrameBuffer, this,
+			0, 0, (uint32_t)GetNumRenderTargets());
+		ReGenerateTextures();
+	}
+
+	NullFrameBuffer::~NullFrameBuffer()
+	{
+		ReleaseTextures();
+	}
+
+	void NullFrameBuffer::Bind() const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_BindFrameBuffer, this);
+	}
+
+	void NullFrameBuffer::UnBind() const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_UnBindFrameBuffer, this);
+	}
+
+	void NullFrameBuffer::Resize(uint32_t width, uint32_t height)
+	{
+		FrameBuffer::Resize(width, height);
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_ResizeFrameBuffer, this);
+		ReGenerateTextures();
+	}
+
+	void NullFrameBuffer::ReGenerateTextures()
+	{
+		ReleaseTextures();
+
+		uint32_t width = m_frameBufferSpecification.width;
+		uint32_t height = m_frameBufferSpecification.height;
+
+		// The attachments are readable & writable so that tests can inspect them.
+		const uint32_t readWriteFlags = Flag_CPU_ReadTexture | Flag_CPU_WriteTexture
+			| Flag_GPU_ReadTexture | Flag_GPU_WriteTexture;
+		for (const auto& attachment : m_frameBufferSpecification.attachments)
+		{
+			TextureSpecifications specifications(readWriteFlags,
+				Graphics::ToGraphicsFormat(attachment.format));
+			m_renderTargetTextures.push_back(new NullTexture(width, height, specifications));
+		}
+
+		DepthFormat depthFormat = m_frameBufferSpecification.attachments.depthStencilAttachment.format.format;
+		if (depthFormat != DepthFormat_None)
+		{
+			TextureSpecifications specifications(readWriteFlags,
+				Graphics::ToGraphicsFormat(depthFormat));
+			m_depthTexture = new NullTexture(width, height, specifications);
+		}
+	}
+
+	void NullFrameBuffer::ReleaseTextures()
+	{
+		for (NullTexture* texture : m_renderTargetTextures)
+		{
+			delete texture;
+		}
+		m_renderTargetTextures.clear();
+
+		delete m_depthTexture;
+		m_depthTexture = nullptr;
+	}
+
+	Texture* NullFrameBuffer::GetDepthTexture() const
+	{
+		return m_depthTexture;
+	}
+
+	Texture* NullFrameBuffer::GetRenderTargetTexture(uint32_t index) const
+	{
+		if (index >= m_renderTargetTextures.size())
+		{
+			return nullptr;
+		}
+		return m_renderTargetTextures[index];
+	}
+}
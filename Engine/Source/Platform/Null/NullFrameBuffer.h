@@ -0,0 +1,33 @@
+#pragma once
+
+#include "FrameBuffer.h"
+
+#include <vector>
+
+namespace Engine
+{
+	class NullTexture;
+
+	class NullFrameBuffer : public FrameBuffer
+	{
+	public:
+		explicit NullFrameBuffer(const FrameBufferSpecification& specification);
+		~NullFrameBuffer();
+
+		void Bind() const override;
+		void UnBind() const override;
+
+		void Resize(uint32_t width, uint32_t height) override;
+		void ReGenerateTextures() override;
+
+		Texture* GetDepthTexture() const override;
+		Texture* GetRenderTargetTexture(uint32_t index) const override;
+
+	private:
+		void ReleaseTextures();
+
+	private:
+		std::vector<NullTexture*> m_renderTargetTextures;
+		NullTexture* m_depthTexture;
+	};
+}
@@ -0,0 +1,47 @@
+#include "EnginePCH.h"
+#include "NullIndexBuffer.h"
+
+#include "Memory.h"
+#include "NullRenderingAPI.h"
+
+namespace Engine
+{
+	NullIndexBuffer::NullIndexBuffer(const void* buffer,
+		uint32_t numIndices, uint32_t stride)
+		: IndexBuffer(buffer, numIndices, stride),
+		m_data()
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateIndexBuffer, this,
+			(uint64_t)numIndices * stride, 0, numIndices);
+		SetData(buffer, numIndices, stride);
+	}
+
+	NullIndexBuffer::~NullIndexBuffer()
+	{
+	}
+
+	bool NullIndexBuffer::IsValid() const
+	{
+		return true;
+	}
+
+	void NullIndexBuffer::SetData(const void* buffer, uint32_t numIndices, uint32_t stride)
+	{
+		m_numIndices = numIndices;
+		m_indexStride = stride;
+
+		size_t size = (size_t)numIndices * stride;
+		m_data.resize(size);
+		if (buffer != nullptr && size > 0)
+		{
+			Memory::Memcpy(m_data.data(), buffer, size);
+		}
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_SetIndexBufferData, this,
+			(uint64_t)size, 0, numIndices);
+	}
+
+	void NullIndexBuffer::Bind() const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_BindIndexBuffer, this);
+	}
+}
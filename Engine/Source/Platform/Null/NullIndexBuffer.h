@@ -0,0 +1,30 @@
+#pragma once
+
+#include "IndexBuffer.h"
+
+#include <vector>
+
+namespace Engine
+{
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		explicit NullIndexBuffer(const void* buffer,
+			std::uint32_t numIndices, std::uint32_t stride);
+		~NullIndexBuffer();
+
+		bool IsValid() const override;
+
+		void SetData(const void* buffer,
+			std::uint32_t numIndices, std::uint32_t stride) override;
+
+		void Bind() const;
+
+		// The cpu copy of the last uploaded data.
+		const std::vector<uint8_t>& GetData() const { return m_data; }
+
+	private:
+		std::vector<uint8_t> m_data;
+	};
+}
@@ -0,0 +1,131 @@
+#include "EnginePCH.h"
+#include "NullRenderingAPI.h"
+
+#include "GraphicsRenderer.h"
+#include "Window.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "NullIndexBuffer.h"
+
+namespace Engine
+{
+
+	NullRenderingAPI::NullRenderingAPI()
+		: m_commandLog(),
+		m_clearColor(),
+		m_width(0),
+		m_height(0),
+		m_wireframeMode(false)
+	{
+	}
+
+	NullRenderingAPI::~NullRenderingAPI()
+	{
+	}
+
+	NullCommandLog& NullRenderingAPI::GetActiveCommandLog()
+	{
+		NullRenderingAPI& renderingAPI = (NullRenderingAPI&)
+			GraphicsRenderer::GetRenderingAPI();
+		return renderingAPI.m_commandLog;
+	}
+
+	bool NullRenderingAPI::Initialize(Window* window)
+	{
+		// Headless runs don't have a window.
+		if (window != nullptr)
+		{
+			m_width = window->GetWidth();
+			m_height = window->GetHeight();
+		}
+		return true;
+	}
+
+	void NullRenderingAPI::SetViewport(float x, float y, float width, float height)
+	{
+		m_commandLog.Record(NullCommand_SetViewport, this);
+	}
+
+	void NullRenderingAPI::SetResolution(uint32_t width, uint32_t height)
+	{
+		m_width = width;
+		m_height = height;
+		m_commandLog.Record(NullCommand_SetResolution, this);
+	}
+
+	void NullRenderingAPI::SetClearColor(const MathLib::Vector4& clearColor)
+	{
+		m_clearColor = clearColor;
+		m_commandLog.Record(NullCommand_SetClearColor, this);
+	}
+
+	void NullRenderingAPI::Present()
+	{
+		m_commandLog.Record(NullCommand_Present, this);
+	}
+
+	void NullRenderingAPI::ClearTexture(uint32_t slot)
+	{
+		m_commandLog.Record(NullCommand_ClearTexture, this, 0, slot);
+	}
+
+	void NullRenderingAPI::Draw(VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer)
+	{
+		vertexBuffer->Bind();
+		if (indexBuffer != nullptr)
+		{
+			static_cast<NullIndexBuffer*>(indexBuffer)->Bind();
+			m_commandLog.Record(NullCommand_DrawIndexed, vertexBuffer,
+				0, 0, indexBuffer->GetNumIndices());
+		}
+		else
+		{
+			m_commandLog.Record(NullCommand_Draw, vertexBuffer,
+				0, 0, vertexBuffer->GetNumVerts());
+		}
+	}
+
+	void NullRenderingAPI::Draw(VertexArray* vertexArray)
+	{
+		if (!vertexArray->IsValid()) return;
+
+		vertexArray->Bind();
+		m_commandLog.Record(NullCommand_DrawIndexed, vertexArray,
+			0, 0, vertexArray->GetIndexBuffer()->GetNumIndices());
+	}
+
+	void NullRenderingAPI::DrawInstanced(VertexArray* vertexArray,
+		VertexBuffer* instanceBuffer, uint32_t numInstances)
+	{
+		if (!vertexArray->IsValid() || numInstances <= 0) return;
+
+		vertexArray->Bind();
+		instanceBuffer->Bind();
+		m_commandLog.Record(NullCommand_DrawIndexedInstanced, vertexArray,
+			0, numInstances, vertexArray->GetIndexBuffer()->GetNumIndices());
+	}
+
+	uint32_t NullRenderingAPI::GetWidth() const
+	{
+		return m_width;
+	}
+
+	uint32_t NullRenderingAPI::GetHeight() const
+	{
+		return m_height;
+	}
+
+	bool NullRenderingAPI::IsWireframe() const
+	{
+		return m_wireframeMode;
+	}
+
+	void NullRenderingAPI::SetWireframe(bool wireframeMode)
+	{
+		if (wireframeMode != m_wireframeMode)
+		{
+			m_wireframeMode = wireframeMode;
+			m_commandLog.Record(NullCommand_SetWireframe, this);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Vector.h"
+#include "RenderingAPI.h"
+#include "NullCommandLog.h"
+
+namespace Engine
+{
+	class VertexArray;
+	class VertexBuffer;
+	class IndexBuffer;
+
+	/**
+	 * Rendering api that doesn't talk to a gpu, every call gets
+	 * recorded into a command log. Used for headless runs.
+	 */
+	class NullRenderingAPI : public RenderingAPI
+	{
+	public:
+		explicit NullRenderingAPI();
+		~NullRenderingAPI();
+
+		bool Initialize(class Window* window) override;
+		void SetViewport(float x, float y, float width, float height) override;
+		void SetResolution(uint32_t width, uint32_t height) override;
+
+		void SetClearColor(const MathLib::Vector4& clearColor) override;
+
+		void Present() override;
+		void ClearTexture(uint32_t slot) override;
+
+		void Draw(VertexArray* vertexArray) override;
+		void Draw(VertexBuffer* buffer,
+			IndexBuffer* indexBuffer = nullptr) override;
+		void DrawInstanced(VertexArray* vertexArray,
+			VertexBuffer* instanceBuffer, uint32_t numInstances) override;
+
+		uint32_t GetWidth() const override;
+		uint32_t GetHeight() const override;
+
+		bool IsWireframe() const override;
+		void SetWireframe(bool wireframeMode) override;
+
+		const MathLib::Vector4& GetClearColor() const { return m_clearColor; }
+
+		NullCommandLog& GetCommandLog() { return m_commandLog; }
+		const NullCommandLog& GetCommandLog() const { return m_commandLog; }
+
+		/**
+		 * Gets the command log of the active null rendering api.
+		 */
+		static NullCommandLog& GetActiveCommandLog();
+
+	private:
+		NullCommandLog m_commandLog;
+		MathLib::Vector4 m_clearColor;
+		uint32_t m_width;
+		uint32_t m_height;
+		bool m_wireframeMode;
+	};
+}
@@ -0,0 +1,40 @@
+#include "EnginePCH.h"
+#include "NullShader.h"
+
+#include "NullRenderingAPI.h"
+
+namespace Engine
+{
+	NullShader::NullShader()
+		: Shader()
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateShader, this);
+	}
+
+	NullShader::NullShader(const BufferLayout& bufferLayout)
+		: Shader(bufferLayout)
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateShader, this);
+	}
+
+	NullShader::~NullShader()
+	{
+	}
+
+	bool NullShader::IsValid() const
+	{
+		return true;
+	}
+
+	void NullShader::Bind_Internal() const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_BindShader, this);
+	}
+
+	bool NullShader::LoadFromFile_Internal(const wchar_t* shaderPath)
+	{
+		// Shaders aren't compiled, so loading always succeeds.
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_LoadShader, this);
+		return true;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Shader.h"
+
+namespace Engine
+{
+
+	class NullShader : public Shader
+	{
+	public:
+		explicit NullShader();
+		explicit NullShader(const BufferLayout& bufferLayout);
+		~NullShader();
+
+		bool IsValid() const override;
+
+	protected:
+		void Bind_Internal() const override;
+		bool LoadFromFile_Internal(const wchar_t* shaderPath) override;
+	};
+}
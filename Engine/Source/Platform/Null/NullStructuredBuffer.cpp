@@ -0,0 +1,40 @@
+#include "EnginePCH.h"
+#include "NullStructuredBuffer.h"
+
+#include "Memory.h"
+#include "NullRenderingAPI.h"
+
+namespace Engine
+{
+	NullStructuredBuffer::NullStructuredBuffer(std::size_t stride, std::uint32_t capacity)
+		: StructuredBuffer(stride, capacity),
+		m_data()
+	{
+		Resize_Internal(GetCapacity());
+	}
+
+	NullStructuredBuffer::~NullStructuredBuffer()
+	{
+	}
+
+	void NullStructuredBuffer::Resize_Internal(std::uint32_t capacity)
+	{
+		m_data.resize(GetStride() * capacity);
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateStructuredBuffer, this,
+			(uint64_t)m_data.size(), 0, capacity);
+	}
+
+	void NullStructuredBuffer::SetData_Internal(const void* elements, std::uint32_t numElements)
+	{
+		size_t size = GetStride() * numElements;
+		Memory::Memcpy(m_data.data(), elements, size);
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_SetStructuredBufferData, this,
+			(uint64_t)size, 0, numElements);
+	}
+
+	void NullStructuredBuffer::Bind_Internal(std::uint32_t slot, int flags) const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_BindStructuredBuffer, this,
+			0, slot, (uint32_t)flags);
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "StructuredBuffer.h"
+
+#include <vector>
+
+namespace Engine
+{
+
+	class NullStructuredBuffer : public StructuredBuffer
+	{
+	public:
+		explicit NullStructuredBuffer(std::size_t stride, std::uint32_t capacity);
+		~NullStructuredBuffer();
+
+		// The cpu copy of the last uploaded elements.
+		const std::vector<uint8_t>& GetData() const { return m_data; }
+
+	protected:
+		void Resize_Internal(std::uint32_t capacity) override;
+		void SetData_Internal(const void* elements, std::uint32_t numElements) override;
+		void Bind_Internal(std::uint32_t slot, int flags) const override;
+
+	private:
+		std::vector<uint8_t> m_data;
+	};
+}
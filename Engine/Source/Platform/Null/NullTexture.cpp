@@ -0,0 +1,92 @@
+#include "EnginePCH.h"
+#include "NullTexture.h"
+
+#include "NullRenderingAPI.h"
+
+namespace Engine
+{
+	NullTexture::NullTexture()
+		: Texture(),
+		m_pixels()
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateTexture, this);
+	}
+
+	NullTexture::NullTexture(uint32_t width, uint32_t height, const TextureSpecifications& specifications)
+		: Texture(width, height, specifications),
+		m_pixels((size_t)width * height)
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateTexture, this,
+			(uint64_t)width * height * Graphics::SizeOfFormat(GetTextureFormat()));
+	}
+
+	NullTexture::~NullTexture()
+	{
+	}
+
+	bool NullTexture::IsValid() const
+	{
+		return true;
+	}
+
+	void NullTexture::Bind_Internal(uint32_t slot) const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_BindTexture, this, 0, slot);
+	}
+
+	bool NullTexture::GetPixel(uint32_t x, uint32_t y, MathLib::Vector4& pixel) const
+	{
+		if (!IsReadable()) return false;
+		if (x >= m_width || y >= m_height) return false;
+
+		pixel = m_pixels[(size_t)y * m_width + x];
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_ReadTexture, this,
+			Graphics::SizeOfFormat(GetTextureFormat()));
+		return true;
+	}
+
+	void NullTexture::SetPixel(uint32_t x, uint32_t y, const MathLib::Vector4& pixel)
+	{
+		if (!IsWritable()) return;
+		if (x >= m_width || y >= m_height) return;
+
+		m_pixels[(size_t)y * m_width + x] = pixel;
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_WriteTexture, this,
+			Graphics::SizeOfFormat(GetTextureFormat()));
+	}
+
+	void NullTexture::CopyPixels(BufferModifier& pixels) const
+	{
+		// The null texture has no gpu memory, so only the size gets recorded.
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_ReadTexture, this,
+			(uint64_t)m_width * m_height * Graphics::SizeOfFormat(GetTextureFormat()));
+	}
+
+	void NullTexture::Resize(uint32_t width, uint32_t height)
+	{
+		m_width = width;
+		m_height = height;
+		m_pixels.clear();
+		m_pixels.resize((size_t)width * height);
+	}
+
+	bool NullTexture::LoadFromFile_Internal(const wchar_t* texturePath)
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_LoadTexture, this);
+		return true;
+	}
+
+	bool NullTexture::CopyTo(Texture& texture)
+	{
+		NullTexture* nullTexture = dynamic_cast<NullTexture*>(&texture);
+		if (nullTexture == nullptr)
+		{
+			return false;
+		}
+		nullTexture->m_width = m_width;
+		nullTexture->m_height = m_height;
+		nullTexture->m_specifications = m_specifications;
+		nullTexture->m_pixels = m_pixels;
+		return true;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Texture.h"
+#include "Vector.h"
+
+#include <vector>
+
+namespace Engine
+{
+
+	class NullTexture : public Texture
+	{
+	public:
+		explicit NullTexture();
+		explicit NullTexture(uint32_t width, uint32_t height, const TextureSpecifications& specifications);
+		~NullTexture();
+
+		bool IsValid() const override;
+		const void* GetTextureID() const override { return this; }
+
+		bool GetPixel(uint32_t x, uint32_t y, MathLib::Vector4& pixel) const override;
+		void SetPixel(uint32_t x, uint32_t y, const MathLib::Vector4& pixel) override;
+
+		void CopyPixels(BufferModifier& pixels) const override;
+
+		void Resize(uint32_t width, uint32_t height);
+
+	protected:
+		void Bind_Internal(uint32_t slot) const override;
+		bool LoadFromFile_Internal(const wchar_t* texturePath) override;
+		bool CopyTo(Texture& texture) override;
+
+	private:
+		std::vector<MathLib::Vector4> m_pixels;
+	};
+}
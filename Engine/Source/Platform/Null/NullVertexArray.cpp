@@ -0,0 +1,61 @@
+#include "EnginePCH.h"
+#include "NullVertexArray.h"
+
+#include "VertexBuffer.h"
+#include "NullIndexBuffer.h"
+#include "NullRenderingAPI.h"
+
+namespace Engine
+{
+	NullVertexArray::NullVertexArray()
+		: VertexArray(),
+		m_vertexBuffers()
+	{
+	}
+
+	NullVertexArray::~NullVertexArray()
+	{
+		m_vertexBuffers.clear();
+	}
+
+	void NullVertexArray::SetVertexBuffers(const std::vector<std::shared_ptr<VertexBuffer>>& buffers)
+	{
+		m_vertexBuffers = buffers;
+	}
+
+	void NullVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer)
+	{
+		m_vertexBuffers.push_back(vertexBuffer);
+	}
+
+	bool NullVertexArray::GetVertexBuffer(std::shared_ptr<VertexBuffer>& buf, uint32_t index) const
+	{
+		if (index >= m_vertexBuffers.size())
+		{
+			return false;
+		}
+		buf = m_vertexBuffers[index];
+		return true;
+	}
+
+	void NullVertexArray::Bind() const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_BindVertexArray, this,
+			0, 0, (uint32_t)m_vertexBuffers.size());
+
+		for (const auto& vertexBuffer : m_vertexBuffers)
+		{
+			vertexBuffer->Bind();
+		}
+
+		if (m_indexBuffer != nullptr)
+		{
+			static_cast<NullIndexBuffer*>(m_indexBuffer.get())->Bind();
+		}
+	}
+
+	void NullVertexArray::ClearVertexBuffers()
+	{
+		m_vertexBuffers.clear();
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "VertexArray.h"
+#include <vector>
+
+namespace Engine
+{
+
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		explicit NullVertexArray();
+		~NullVertexArray();
+
+		void SetVertexBuffers(const std::vector<std::shared_ptr<VertexBuffer>>& buffers) override;
+		void AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer) override;
+		bool GetVertexBuffer(std::shared_ptr<VertexBuffer>& buf, uint32_t index) const override;
+
+		size_t GetNumVertexBuffers() const override { return m_vertexBuffers.size(); }
+		void Bind() const override;
+
+		void ClearVertexBuffers() override;
+
+	private:
+		std::vector<std::shared_ptr<VertexBuffer>> m_vertexBuffers;
+	};
+}
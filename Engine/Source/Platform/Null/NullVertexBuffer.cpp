@@ -0,0 +1,47 @@
+#include "EnginePCH.h"
+#include "NullVertexBuffer.h"
+
+#include "Memory.h"
+#include "NullRenderingAPI.h"
+
+namespace Engine
+{
+	NullVertexBuffer::NullVertexBuffer(const void* buffer,
+		uint32_t numVertices, uint32_t stride)
+		: VertexBuffer(buffer, numVertices, stride),
+		m_data()
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_CreateVertexBuffer, this,
+			(uint64_t)numVertices * stride, 0, numVertices);
+		SetData(buffer, numVertices, stride);
+	}
+
+	NullVertexBuffer::~NullVertexBuffer()
+	{
+	}
+
+	bool NullVertexBuffer::IsValid() const
+	{
+		return true;
+	}
+
+	void NullVertexBuffer::SetData(const void* buffer, uint32_t numVertices, uint32_t stride)
+	{
+		m_numVerts = numVertices;
+		m_stride = stride;
+
+		size_t size = (size_t)numVertices * stride;
+		m_data.resize(size);
+		if (buffer != nullptr && size > 0)
+		{
+			Memory::Memcpy(m_data.data(), buffer, size);
+		}
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_SetVertexBufferData, this,
+			(uint64_t)size, 0, numVertices);
+	}
+
+	void NullVertexBuffer::Bind() const
+	{
+		NullRenderingAPI::GetActiveCommandLog().Record(NullCommand_BindVertexBuffer, this);
+	}
+}
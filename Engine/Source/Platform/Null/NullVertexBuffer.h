@@ -0,0 +1,29 @@
+#pragma once
+
+#include "VertexBuffer.h"
+
+#include <vector>
+
+namespace Engine
+{
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		explicit NullVertexBuffer(const void* buffer,
+			std::uint32_t numVertices, std::uint32_t stride);
+		~NullVertexBuffer();
+
+		bool IsValid() const override;
+
+		void SetData(const void* buffer,
+			std::uint32_t numVertices, std::uint32_t stride) override;
+		void Bind() const override;
+
+		// The cpu copy of the last uploaded data.
+		const std::vector<uint8_t>& GetData() const { return m_data; }
+
+	private:
+		std::vector<uint8_t> m_data;
+	};
+}
@@ -20,6 +20,9 @@
 
 #ifdef PLATFORM_LINUX
 
-#error Platform is not supported.
+// Linux only has the null rendering api, so it can only run headless.
+#ifndef GRAPHICS_API_NULL
+#error Linux only supports the null graphics api (--graphicsapi=none).
+#endif
 
 #endif
\ No newline at end of file
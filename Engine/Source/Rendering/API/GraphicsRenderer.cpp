@@ -6,23 +6,53 @@
 #include "Shader.h"
 #include "FrameBuffer.h"
 #include "Texture.h"
+#include "ConstantBuffer.h"
 #include "RenderingAPI.h"
 #include "Profiler.h"
 #include "Application.h"
 #include "Window.h"
 
+#include <cstring>
+#include <vector>
+
 namespace Engine
 {
 	RenderingAPI* GraphicsRenderer::s_renderingAPI = nullptr;
+
+	// The number of texture & constant buffer slots tracked by the cache,
+	// binds to slots past these always go through.
+	static const uint32_t c_maxCachedTextureSlots = 16;
+	static const uint32_t c_maxCachedConstantBufferSlots = 16;
+
+	struct GraphicsCachedConstantBuffer
+	{
+		const ConstantBuffer* constantBuffer = nullptr;
+		int flags = 0;
+	};
+
+	struct GraphicsRenderState
+	{
+		const Shader* shader = nullptr;
+		const Texture* textures[c_maxCachedTextureSlots] = { };
+		GraphicsCachedConstantBuffer constantBuffers[c_maxCachedConstantBufferSlots];
+	};
+
+	static GraphicsRenderState s_renderState;
+	static GraphicsRenderStateStats s_renderStateStats;
 	
 	bool GraphicsRenderer::Init()
+	{
+		return Init(&Application::Get().GetWindow());
+	}
+
+	bool GraphicsRenderer::Init(Window* window)
 	{
 		PROFILE_SCOPE(Init, GraphicsRenderer);
 
         JKORN_ENGINE_ASSERT(s_renderingAPI == nullptr,
 			"Graphics Rendering API has already been initialized.");
 		s_renderingAPI = RenderingAPI::Create();
-		if (!s_renderingAPI->Initialize(&Application::Get().GetWindow()))
+		if (!s_renderingAPI->Initialize(window))
 		{
 			return false;
 		}
@@ -32,6 +62,8 @@ namespace Engine
 	void GraphicsRenderer::Release()
 	{
 		delete s_renderingAPI;
+		s_renderingAPI = nullptr;
+		InvalidateRenderState();
 	}
 
 	void GraphicsRenderer::Draw(VertexArray* vertexArray)
@@ -46,9 +78,17 @@ namespace Engine
 		GetRenderingAPI().Draw(vBuffer, iBuffer);
 	}
 
+	void GraphicsRenderer::DrawInstanced(VertexArray* vertexArray,
+		VertexBuffer* instanceBuffer, uint32_t numInstances)
+	{
+		GetRenderingAPI().DrawInstanced(vertexArray, instanceBuffer, numInstances);
+	}
+
 	void GraphicsRenderer::Present()
 	{
 		GetRenderingAPI().Present();
+		// The frame could've been modified outside of the renderer, such as by ImGui.
+		InvalidateRenderState();
 	}
 
 	RenderingAPI& GraphicsRenderer::GetRenderingAPI()
@@ -57,6 +97,124 @@ namespace Engine
 		return *s_renderingAPI;
 	}
 
+	void GraphicsRenderer::BindShader(const Shader& shader)
+	{
+		if (s_renderState.shader == &shader)
+		{
+			s_renderStateStats.numShaderBindsSkipped++;
+			return;
+		}
+		shader.Bind_Internal();
+		s_renderState.shader = &shader;
+		s_renderStateStats.numShaderBinds++;
+	}
+
+	void GraphicsRenderer::BindTexture(const Texture& texture, uint32_t slot)
+	{
+		if (slot < c_maxCachedTextureSlots)
+		{
+			if (s_renderState.textures[slot] == &texture)
+			{
+				s_renderStateStats.numTextureBindsSkipped++;
+				return;
+			}
+			s_renderState.textures[slot] = &texture;
+		}
+		texture.Bind_Internal(slot);
+		s_renderStateStats.numTextureBinds++;
+	}
+
+	void GraphicsRenderer::ClearTexture(uint32_t slot)
+	{
+		if (slot < c_maxCachedTextureSlots)
+		{
+			s_renderState.textures[slot] = nullptr;
+		}
+		GetRenderingAPI().ClearTexture(slot);
+	}
+
+	void GraphicsRenderer::BindConstantBuffer(const ConstantBuffer& constantBuffer,
+		uint32_t slot, int flags)
+	{
+		// Compute shaders unbind their constant buffers after dispatching, so those aren't cached.
+		if (slot < c_maxCachedConstantBufferSlots
+			&& !(flags & ConstantBufferFlags::COMPUTE_SHADER))
+		{
+			GraphicsCachedConstantBuffer& cached = s_renderState.constantBuffers[slot];
+			if (cached.constantBuffer == &constantBuffer
+				&& cached.flags == flags)
+			{
+				s_renderStateStats.numConstantBufferBindsSkipped++;
+				return;
+			}
+			cached.constantBuffer = &constantBuffer;
+			cached.flags = flags;
+		}
+		constantBuffer.Bind_Internal(slot, flags);
+		s_renderStateStats.numConstantBufferBinds++;
+	}
+
+	void GraphicsRenderer::SetConstantBufferData(ConstantBuffer& constantBuffer,
+		const void* data, size_t size)
+	{
+		if (data == nullptr)
+		{
+			return;
+		}
+
+		// Compares against the last uploaded data, the buffer
+		// stays bound after an upload so only the contents matter.
+		std::vector<uint8_t>& cachedData = constantBuffer.m_cachedData;
+		if (cachedData.size() == size
+			&& std::memcmp(cachedData.data(), data, size) == 0)
+		{
+			s_renderStateStats.numConstantBufferUploadsSkipped++;
+			return;
+		}
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		cachedData.assign(bytes, bytes + size);
+		constantBuffer.SetData_Internal(data, size);
+		s_renderStateStats.numConstantBufferUploads++;
+	}
+
+	void GraphicsRenderer::InvalidateRenderState()
+	{
+		s_renderState = GraphicsRenderState();
+	}
+
+	const GraphicsRenderStateStats& GraphicsRenderer::GetRenderStateStats()
+	{
+		return s_renderStateStats;
+	}
+
+	void GraphicsRenderer::ResetRenderStateStats()
+	{
+		s_renderStateStats = GraphicsRenderStateStats();
+	}
+
+	void GraphicsRenderer::OnResourceReleased(const void* resource)
+	{
+		// A new resource could be allocated at the same address, so the released one can't stay cached.
+		if (s_renderState.shader == resource)
+		{
+			s_renderState.shader = nullptr;
+		}
+		for (const Texture*& texture : s_renderState.textures)
+		{
+			if (texture == resource)
+			{
+				texture = nullptr;
+			}
+		}
+		for (GraphicsCachedConstantBuffer& cached : s_renderState.constantBuffers)
+		{
+			if (cached.constantBuffer == resource)
+			{
+				cached = GraphicsCachedConstantBuffer();
+			}
+		}
+	}
+
 	void GraphicsRenderer::OnWindowResized(uint32_t x, uint32_t y)
 	{
 		GetRenderingAPI().SetViewport(
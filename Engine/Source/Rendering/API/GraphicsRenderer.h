@@ -6,12 +6,29 @@
 namespace Engine
 {
 	class RenderingAPI;
+	class Shader;
+	class Texture;
+	class ConstantBuffer;
+
+	struct GraphicsRenderStateStats
+	{
+		uint32_t numShaderBinds = 0;
+		uint32_t numShaderBindsSkipped = 0;
+		uint32_t numTextureBinds = 0;
+		uint32_t numTextureBindsSkipped = 0;
+		uint32_t numConstantBufferBinds = 0;
+		uint32_t numConstantBufferBindsSkipped = 0;
+		uint32_t numConstantBufferUploads = 0;
+		uint32_t numConstantBufferUploadsSkipped = 0;
+	};
 
 	class GraphicsRenderer
 	{
 
 	public:
 		static bool Init();
+		// Initializes the renderer against the given window, headless runs pass nullptr.
+		static bool Init(class Window* window);
 		static void Release();
 
 		static void Present();
@@ -19,15 +36,40 @@ namespace Engine
 		static void Draw(class VertexArray* vertexArray);
 		static void Draw(class VertexBuffer* vertexBuffer,
 			class IndexBuffer* indexBuffer);
+		static void DrawInstanced(class VertexArray* vertexArray,
+			class VertexBuffer* instanceBuffer, uint32_t numInstances);
 
 		static RenderingAPI& GetRenderingAPI();
 
+		/**
+		 * The render state cache, the shaders, textures & constant buffers
+		 * bind through these so that redundant binds & uploads are skipped.
+		 */
+		static void BindShader(const Shader& shader);
+		static void BindTexture(const Texture& texture, uint32_t slot);
+		static void ClearTexture(uint32_t slot);
+		static void BindConstantBuffer(const ConstantBuffer& constantBuffer,
+			uint32_t slot, int flags);
+		static void SetConstantBufferData(ConstantBuffer& constantBuffer,
+			const void* data, size_t size);
+
+		// Forgets the bound state, needed when the state was changed outside of the renderer.
+		static void InvalidateRenderState();
+
+		static const GraphicsRenderStateStats& GetRenderStateStats();
+		static void ResetRenderStateStats();
+
 	private:
 		static void OnWindowResized(uint32_t x, uint32_t y);
+		// Removes the released resource from the render state cache.
+		static void OnResourceReleased(const void* resource);
 
 	private:
 		static RenderingAPI* s_renderingAPI;
 
 		friend class Application;
+		friend class Shader;
+		friend class Texture;
+		friend class ConstantBuffer;
 	};
 }
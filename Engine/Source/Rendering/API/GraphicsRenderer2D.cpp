@@ -2,9 +2,9 @@
 #include "GraphicsRenderer2D.h"
 
 #include "RenderingAPI.h"
+#include "GraphicsRenderer.h"
 #include "VertexBuffer.h"
-#include "IndexBuffer.h"
-#include "Material.h"
+#include "Shader.h"
 #include "BufferLayout.h"
 
 #include "Profiler.h"
@@ -12,6 +12,8 @@
 #include "Texture.h"
 #include "SubTexture.h"
 
+#include <vector>
+
 namespace Engine
 {
 	using Mat4x4 = MathLib::Matrix4x4;
@@ -19,41 +21,51 @@ namespace Engine
 	using Vec4 = MathLib::Vector4;
 	using Vec2 = MathLib::Vector2;
 
-	struct GraphicsObjectConstants
-	{
-		MathLib::Matrix4x4 c_objectToWorld;
-		int32_t c_entityID = -1;
-
-	private:
-		float pad1, pad2, pad3;
-	};
-
-	struct GraphicsSpriteVertex
+	struct GraphicsBatchSpriteVertex
 	{
 		Vec3 position;
 		Vec2 uv;
+		Vec4 color;
+		// The texture slot in the batch, -1 if the sprite isn't textured.
+		int32_t textureIndex;
+		int32_t entityID;
 	};
 
-	static VertexBuffer* s_spriteVertexBuffer = nullptr;
-	bool s_spriteVertexBufferDefault = true;
+	static const BufferLayoutParam c_textureIndexParam =
+		{ "TEXINDEX", BufferLayoutSemanticType::Type_Custom, BufferLayoutType::Int32, 1 };
+	static const BufferLayoutParam c_entityIDParam =
+		{ "ENTITYID", BufferLayoutSemanticType::Type_Custom, BufferLayoutType::Int32, 1 };
+
+	// The sprites are drawn as two triangles, so no index buffer is needed.
+	static const uint32_t c_verticesPerSprite = 6;
+	static const uint32_t c_maxBatchVertices = GraphicsRenderer2D::c_maxBatchSprites * c_verticesPerSprite;
 
-	static IndexBuffer* s_spriteIndexBuffer = nullptr;
+	static VertexBuffer* s_batchVertexBuffer = nullptr;
+	static std::vector<GraphicsBatchSpriteVertex> s_batchVertices;
 
-	static ConstantBuffer* s_spriteObjectConstantBuffer = nullptr;
-	static GraphicsObjectConstants s_spriteObjectConstants;
+	static Texture* s_batchTextures[GraphicsRenderer2D::c_maxBatchTextures];
+	static uint32_t s_numBatchTextures = 0;
 
-	static Material* s_spriteMaterial;
-	static Shader* s_spriteShader;
+	static Shader* s_spriteShader = nullptr;
+	static GraphicsRenderer2DStats s_stats;
 
-	static GraphicsSpriteVertex vertices[4] =
+	static const Vec3 c_spriteCorners[4] =
 	{
-		{ MathLib::Vector3(-0.5f, -0.5f, 0.0f), MathLib::Vector2(0.0f, 1.0f) },
-		{ MathLib::Vector3(0.5f, -0.5f, 0.0f), MathLib::Vector2(1.0f, 1.0f) },
-		{ MathLib::Vector3(0.5f, 0.5f, 0.0f), MathLib::Vector2(1.0f, 0.0f) },
-		{ MathLib::Vector3(-0.5f, 0.5f, 0.0f), MathLib::Vector2(0.0f, 0.0f) }
+		MathLib::Vector3(-0.5f, -0.5f, 0.0f),
+		MathLib::Vector3(0.5f, -0.5f, 0.0f),
+		MathLib::Vector3(0.5f, 0.5f, 0.0f),
+		MathLib::Vector3(-0.5f, 0.5f, 0.0f)
 	};
 
-	static const std::uint32_t indices[6] =
+	static const Vec2 c_spriteUVs[4] =
+	{
+		MathLib::Vector2(0.0f, 1.0f),
+		MathLib::Vector2(1.0f, 1.0f),
+		MathLib::Vector2(1.0f, 0.0f),
+		MathLib::Vector2(0.0f, 0.0f)
+	};
+
+	static const std::uint32_t c_spriteIndices[c_verticesPerSprite] =
 	{
 		0, 1, 2,
 		2, 3, 0
@@ -71,31 +83,62 @@ namespace Engine
 #endif
 		}
 
+		/**
+		 * Gets the slot of the texture in the current batch, flushes the
+		 * batch when the texture isn't in it & all of the slots are used.
+		 */
+		int32_t GetBatchTextureIndex(Texture* texture)
+		{
+			if (texture == nullptr)
+			{
+				return -1;
+			}
+
+			for (uint32_t i = 0; i < s_numBatchTextures; i++)
+			{
+				if (s_batchTextures[i] == texture)
+				{
+					return (int32_t)i;
+				}
+			}
+
+			if (s_numBatchTextures >= GraphicsRenderer2D::c_maxBatchTextures)
+			{
+				GraphicsRenderer2D::Flush();
+			}
+			s_batchTextures[s_numBatchTextures] = texture;
+			return (int32_t)s_numBatchTextures++;
+		}
+
 		void DrawRectInternal(const MathLib::Matrix4x4& transform, const MathLib::Vector4& color,
-			Texture* texture, uint32_t entityID)
+			Texture* texture, const Vec2* uvs, int32_t entityID)
 		{
 			PROFILE_SCOPE(DrawRectInternal, Rendering);
 
-			// Clears the texture at the initial texture slot.
-			GraphicsRenderer::GetRenderingAPI().ClearTexture(0);
-
-			// Bind Material.
-			s_spriteMaterial->SetConstantValue("c_spriteColor", color);
-			s_spriteMaterial->SetTexture(0, texture);
-			s_spriteMaterial->Bind();
-
-			s_spriteObjectConstants.c_objectToWorld = transform;
-			s_spriteObjectConstants.c_entityID = entityID;
-
-			// Bind Per Object Constants.
-			s_spriteObjectConstantBuffer->SetData(&s_spriteObjectConstants,
-				sizeof(GraphicsObjectConstants));
-
-			s_spriteObjectConstantBuffer->Bind(1, ConstantBufferFlags::PIXEL_SHADER
-				| ConstantBufferFlags::VERTEX_SHADER);
-
-			GraphicsRenderer::Draw(s_spriteVertexBuffer,
-				s_spriteIndexBuffer);
+			if (s_batchVertices.size() + c_verticesPerSprite > c_maxBatchVertices)
+			{
+				GraphicsRenderer2D::Flush();
+			}
+			int32_t textureIndex = GetBatchTextureIndex(texture);
+
+			// Transforms the corners on the cpu, the same as mul(float4(pos, 1.0), c_objectToWorld).
+			Vec3 corners[4];
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				const Vec3& corner = c_spriteCorners[i];
+				corners[i] = Vec3(
+					corner.x * transform.matrix[0][0] + corner.y * transform.matrix[1][0] + transform.matrix[3][0],
+					corner.x * transform.matrix[0][1] + corner.y * transform.matrix[1][1] + transform.matrix[3][1],
+					corner.x * transform.matrix[0][2] + corner.y * transform.matrix[1][2] + transform.matrix[3][2]);
+			}
+
+			for (uint32_t i = 0; i < c_verticesPerSprite; i++)
+			{
+				uint32_t corner = c_spriteIndices[i];
+				s_batchVertices.push_back({ corners[corner], uvs[corner],
+					color, textureIndex, entityID });
+			}
+			s_stats.numSprites++;
 		}
 	}
 
@@ -104,68 +147,102 @@ namespace Engine
 	{
 		PROFILE_SCOPE(Init, GraphicsRenderer2D);
 
-		if (s_spriteVertexBuffer == nullptr)
+		s_batchVertices.reserve(c_maxBatchVertices);
+		if (s_batchVertexBuffer == nullptr)
 		{
-			VertexBuffer::Create(&s_spriteVertexBuffer,
-				&vertices, sizeof(vertices) / sizeof(vertices[0]), sizeof(GraphicsSpriteVertex));
-			s_spriteVertexBuffer->SetBufferLayoutParameters({
+			// Allocates the vertex buffer to fit the largest batch.
+			std::vector<GraphicsBatchSpriteVertex> vertices(c_maxBatchVertices);
+			VertexBuffer::Create(&s_batchVertexBuffer,
+				vertices.data(), c_maxBatchVertices, sizeof(GraphicsBatchSpriteVertex));
+			s_batchVertexBuffer->SetBufferLayoutParameters({
 				BufferLayoutParam::Position0,
-				BufferLayoutParam::Uv0
+				BufferLayoutParam::Uv0,
+				BufferLayoutParam::Color4_0,
+				c_textureIndexParam,
+				c_entityIDParam
 			});
 		}
-		if (s_spriteIndexBuffer == nullptr)
-		{
-			IndexBuffer::Create(&s_spriteIndexBuffer,
-				&indices, sizeof(indices) / sizeof(indices[0]), sizeof(int32_t));
-		}
 
 		// Loads the Sprite Shader.
 		{
 			// TODO: Replace with Asset Caching, but for now this will due.
 			s_spriteShader = Engine::Shader::LoadFromFile(
 				L"Shaders/SpriteShader.hlsl",
-				{ s_spriteVertexBuffer->GetBufferLayoutParameters() });
-			s_spriteMaterial = new Material({ { "c_spriteColor", LayoutType_Vector4 } });
-			s_spriteMaterial->SetShader(s_spriteShader);
+				{ s_batchVertexBuffer->GetBufferLayoutParameters() });
 		}
-		ConstantBuffer::Create(&s_spriteObjectConstantBuffer,
-			&s_spriteObjectConstants, sizeof(GraphicsObjectConstants));
 	}
 
 	void GraphicsRenderer2D::Release()
 	{
-		delete s_spriteVertexBuffer;
-		delete s_spriteIndexBuffer;
+		delete s_batchVertexBuffer;
 		delete s_spriteShader;
-		delete s_spriteMaterial;
-		delete s_spriteObjectConstantBuffer;
+		s_batchVertexBuffer = nullptr;
+		s_spriteShader = nullptr;
+
+		s_batchVertices.clear();
+		s_numBatchTextures = 0;
+	}
+
+	void GraphicsRenderer2D::Flush()
+	{
+		if (s_batchVertices.empty())
+		{
+			return;
+		}
+
+		PROFILE_SCOPE(FlushSpriteBatch, Rendering);
+
+		if (s_spriteShader != nullptr)
+		{
+			s_spriteShader->Bind();
+		}
+
+		// Clears the texture at the initial texture slot if the batch has no textures.
+		if (s_numBatchTextures <= 0)
+		{
+			GraphicsRenderer::ClearTexture(0);
+		}
+		for (uint32_t i = 0; i < s_numBatchTextures; i++)
+		{
+			s_batchTextures[i]->Bind(i);
+		}
+
+		s_batchVertexBuffer->SetData(s_batchVertices.data(),
+			(uint32_t)s_batchVertices.size(), sizeof(GraphicsBatchSpriteVertex));
+		GraphicsRenderer::Draw(s_batchVertexBuffer, nullptr);
+		s_stats.numDrawCalls++;
+
+		s_batchVertices.clear();
+		s_numBatchTextures = 0;
+	}
+
+	const GraphicsRenderer2DStats& GraphicsRenderer2D::GetStats()
+	{
+		return s_stats;
+	}
+
+	void GraphicsRenderer2D::ResetStats()
+	{
+		s_stats = GraphicsRenderer2DStats();
 	}
 
-	void GraphicsRenderer2D::DrawRect(const MathLib::Vector2& pos, const MathLib::Vector2& scale, 
+	void GraphicsRenderer2D::DrawRect(const MathLib::Vector2& pos, const MathLib::Vector2& scale,
 		Texture* texture, int32_t entityID)
 	{
 		Mat4x4 mat = Mat4x4::CreateScale(scale.x, scale.y, 1.0f)
 			* Mat4x4::CreateTranslation(pos.x, pos.y, 0.0f);
 		DrawRect(mat, Vec4::One, texture, entityID);
 	}
-	
-	void GraphicsRenderer2D::DrawRect(const MathLib::Matrix4x4& transformMat, const MathLib::Vector4& color, 
+
+	void GraphicsRenderer2D::DrawRect(const MathLib::Matrix4x4& transformMat, const MathLib::Vector4& color,
 		Texture* texture, int32_t entityID)
 	{
-		// Used so that the vertex buffers are always set to a default rect.
-		if (!s_spriteVertexBufferDefault)
-		{
-			s_spriteVertexBuffer->SetData(&vertices,
-				sizeof(vertices) / sizeof(vertices[0]), sizeof(vertices[0]));
-			s_spriteVertexBufferDefault = true;
-		}
-		
 		Mat4x4 mat = transformMat;
 		if (texture)
 		{
 			ApplySizeToMatrix(mat, { (float)texture->GetWidth(), (float)texture->GetHeight() });
 		}
-		DrawRectInternal(mat, color, texture, entityID);
+		DrawRectInternal(mat, color, texture, c_spriteUVs, entityID);
 	}
 
 	void GraphicsRenderer2D::DrawRect(const MathLib::Vector2& pos, const MathLib::Vector2& scale,
@@ -174,15 +251,15 @@ namespace Engine
 		DrawRect(pos, scale, subTexture.texture, subTexture.subTextureContext, entityID);
 	}
 
-	void GraphicsRenderer2D::DrawRect(const MathLib::Vector2& pos, const MathLib::Vector2 &scale, 
+	void GraphicsRenderer2D::DrawRect(const MathLib::Vector2& pos, const MathLib::Vector2 &scale,
 		Texture* texture, const SubTextureContext& context, int32_t entityID)
 	{
 		Mat4x4 mat = Mat4x4::CreateScale(scale.x, scale.y, 1.0f)
 			* Mat4x4::CreateTranslation(pos.x, pos.y, 0.0f);
 		DrawRect(mat, Vec4::One, texture, context, entityID);
 	}
-	
-	void GraphicsRenderer2D::DrawRect(const MathLib::Matrix4x4& transformMat, const MathLib::Vector4& color, 
+
+	void GraphicsRenderer2D::DrawRect(const MathLib::Matrix4x4& transformMat, const MathLib::Vector4& color,
 		Texture* texture, const SubTextureContext& context, int32_t entityID)
 	{
 		// Only changes UVs if it doesn't have defaults.
@@ -192,21 +269,10 @@ namespace Engine
 			return;
 		}
 		// TODO: Create Bounds so that it can be rendered in its specific aspect ratio
-		// 
-		// Changes the UVs so that is based on the sub texture.
-		GraphicsSpriteVertex verts[4];
-		Memory::Memcpy(&verts[0], &vertices[0], sizeof(vertices));
-		verts[0].uv = context.GetUVS()[0];
-		verts[1].uv = context.GetUVS()[1];
-		verts[2].uv = context.GetUVS()[2];
-		verts[3].uv = context.GetUVS()[3];
-
-		s_spriteVertexBuffer->SetData(&verts, 4, sizeof(GraphicsSpriteVertex));
-		s_spriteVertexBufferDefault = false;
 
 		Mat4x4 cpy = transformMat;
 		ApplySizeToMatrix(cpy, context.GetSize());
-		DrawRectInternal(cpy, color, texture, entityID);
+		DrawRectInternal(cpy, color, texture, context.GetUVS(), entityID);
 	}
 
-}
\ No newline at end of file
+}
@@ -10,12 +10,35 @@ namespace Engine
 	class SubTextureContext;
 	struct SubTexture;
 
+	/**
+	 * The statistics of the sprite batches since the last reset.
+	 */
+	struct GraphicsRenderer2DStats
+	{
+		uint32_t numSprites = 0;
+		uint32_t numDrawCalls = 0;
+	};
+
+	/**
+	 * Batches the sprites into a dynamic vertex buffer, the batch gets drawn
+	 * when it runs out of vertices or texture slots or when it gets flushed.
+	 */
 	class GraphicsRenderer2D
 	{
+	public:
+		static const uint32_t c_maxBatchSprites = 4096;
+		static const uint32_t c_maxBatchTextures = 8;
+
 	public:
 		static void Init();
 		static void Release();
 
+		// Draws all of the sprites that are in the current batch.
+		static void Flush();
+
+		static const GraphicsRenderer2DStats& GetStats();
+		static void ResetStats();
+
 		static void DrawRect(const MathLib::Vector2& pos,
 			const MathLib::Vector2& scale, Texture* texture,
 			int32_t entityID = -1);
@@ -4,13 +4,18 @@
 #include "Profiler.h"
 #include "Material.h"
 #include "ConstantBuffer.h"
+#include "StructuredBuffer.h"
 #include "BufferLayout.h"
 
 #include "Mesh.h"
+#include "Shader.h"
+#include "VertexBuffer.h"
 #include "GraphicsRenderer.h"
 #include "RenderingAPI.h"
 
 #include "LightingComponents.h"
+#include "ClusteredLighting.h"
+#include "FramePacket.h"
 
 namespace Engine
 {
@@ -33,27 +38,20 @@ namespace Engine
 
 #pragma region lighting_structs
 
+	// An element of the point lights structured buffer, only the enabled lights are uploaded.
 	struct GraphicsPointLightData
 	{
 	public:
 		MathLib::Vector3 position;
-	private:
-		float fpad1;
-
-	public:
-		MathLib::Vector3 lightColor;
 		float innerRadius = 1.0f;
 
+		MathLib::Vector3 lightColor;
 		float outerRadius = 1.0f;
-		float intensity = 1.0f;
-		bool isEnabled = false;
 
-		GraphicsPointLightData()
-			: intensity(1.0f) { }
+		float intensity = 1.0f;
 
 	private:
-		bool bpad1, bpad2, bpad3;
-		float fpad2;
+		float pad1, pad2, pad3;
 	};
 
 	struct GraphicsDirectionalLightData
@@ -85,14 +83,19 @@ namespace Engine
 
 	public:
 		GraphicsDirectionalLightData c_directionalLight;
-		GraphicsPointLightData c_pointLightData[MAX_POINT_LIGHTS];
+
+		// The slice of a pixel is log(depth) * c_clusterDepthScale + c_clusterDepthBias.
+		float c_clusterDepthScale = 0.0f;
+		float c_clusterDepthBias = 0.0f;
+		uint32_t c_numPointLights = 0;
+	private:
+		float clusterPad;
 	};
 
 	struct LightingData
 	{
-		uint32_t numPointLights = 0;
-		bool lightsBound = false;
 		LightingConstantBufferData constantBufferData;
+		std::vector<GraphicsPointLightData> pointLights;
 	};
 
 #pragma endregion
@@ -104,9 +107,28 @@ namespace Engine
 
 	static Mesh* s_cubeMesh;
 	static Material* s_defaultMaterial;
+	static Material* s_defaultInstancedMaterial;
+
+	static VertexBuffer* s_instanceBuffer = nullptr;
+
+	// The object to world rows followed by the entity id, matches GraphicsInstanceData.
+	static const BufferLayoutParameterSet c_instanceLayoutParameters =
+	{
+		{
+			{ "WORLD", BufferLayoutSemanticType::Type_Custom, BufferLayoutType::Float32, 4, 0 },
+			{ "WORLD", BufferLayoutSemanticType::Type_Custom, BufferLayoutType::Float32, 4, 1 },
+			{ "WORLD", BufferLayoutSemanticType::Type_Custom, BufferLayoutType::Float32, 4, 2 },
+			{ "WORLD", BufferLayoutSemanticType::Type_Custom, BufferLayoutType::Float32, 4, 3 },
+			{ "ENTITYID", BufferLayoutSemanticType::Type_Custom, BufferLayoutType::Int32, 1, 0 }
+		},
+		true
+	};
 
 	static LightingData s_lightingData;
 	static ConstantBuffer* s_lightingConstantBuffer = nullptr;
+	static StructuredBuffer* s_pointLightBuffer = nullptr;
+	static StructuredBuffer* s_lightClusterBuffer = nullptr;
+	static StructuredBuffer* s_lightIndexBuffer = nullptr;
 
 
 	static MathLib::Vector3 s_cubeMeshNormals[] =
@@ -243,6 +265,18 @@ namespace Engine
 		{
 			ConstantBuffer::Create(&s_lightingConstantBuffer, &s_lightingData.constantBufferData, 
 				sizeof(s_lightingData.constantBufferData));
+
+			// Without structured buffers the point lights are left out, the buffers stay null.
+			if (StructuredBuffer::IsSupported())
+			{
+				// The clusters start out without any lights.
+				std::vector<LightCluster> clusters(LightClusterList::c_numClusters);
+				StructuredBuffer::Create(&s_lightClusterBuffer, sizeof(LightCluster),
+					LightClusterList::c_numClusters);
+				s_lightClusterBuffer->SetData(clusters.data(), (uint32_t)clusters.size());
+				StructuredBuffer::Create(&s_pointLightBuffer, sizeof(GraphicsPointLightData), 64);
+				StructuredBuffer::Create(&s_lightIndexBuffer, sizeof(uint32_t), 1024);
+			}
 		}
 
 		// Initializes the default material.
@@ -256,6 +290,23 @@ namespace Engine
 			s_defaultMaterial->SetShader(shader.get());
 		}
 
+		// Initializes the default instanced material & the instance buffer.
+		{
+			BufferLayout instancedLayout = Mesh::c_defaultLayout;
+			instancedLayout.parameters.push_back(c_instanceLayoutParameters);
+
+			static std::shared_ptr<Shader> instancedShader;
+			instancedShader.reset(Shader::LoadFromFile(
+				L"Shaders/Unlit-VertUvPosShader-Instanced.hlsl", instancedLayout));
+			s_defaultInstancedMaterial = new Material(*s_defaultMaterial);
+			s_defaultInstancedMaterial->SetShader(instancedShader.get());
+
+			std::vector<GraphicsInstanceData> instances(c_maxInstancesPerDraw);
+			VertexBuffer::Create(&s_instanceBuffer, instances.data(),
+				c_maxInstancesPerDraw, sizeof(GraphicsInstanceData));
+			s_instanceBuffer->SetBufferLayoutParameters(c_instanceLayoutParameters);
+		}
+
 		// Initialize the constant buffer and buffer layout.
 		{
 			ConstantBuffer::Create(
@@ -281,9 +332,31 @@ namespace Engine
 	void GraphicsRenderer3D::Release()
 	{
 		delete s_lightingConstantBuffer;
+		delete s_pointLightBuffer;
+		delete s_lightClusterBuffer;
+		delete s_lightIndexBuffer;
 		delete s_objectConstantBuffer;
 		delete s_defaultMaterial;
+		delete s_defaultInstancedMaterial;
+		delete s_instanceBuffer;
 		delete s_cubeMesh;
+
+		// Lets the renderer get initialized again, e.g. by each of the unit tests.
+		s_lightingConstantBuffer = nullptr;
+		s_pointLightBuffer = nullptr;
+		s_lightClusterBuffer = nullptr;
+		s_lightIndexBuffer = nullptr;
+		s_objectConstantBuffer = nullptr;
+		s_defaultMaterial = nullptr;
+		s_defaultInstancedMaterial = nullptr;
+		s_instanceBuffer = nullptr;
+		s_cubeMesh = nullptr;
+		s_initialized = false;
+	}
+
+	const BufferLayoutParameterSet& GraphicsRenderer3D::GetInstanceLayoutParameters()
+	{
+		return c_instanceLayoutParameters;
 	}
 
 	Mesh& GraphicsRenderer3D::GetCubeMesh()
@@ -321,6 +394,40 @@ namespace Engine
 			mesh.GetVertexArray().get());
 	}
 
+	void GraphicsRenderer3D::DrawMeshInstanced(Mesh& mesh, const GraphicsInstanceData* instances,
+		uint32_t numInstances)
+	{
+		DrawMeshInstanced(mesh, *s_defaultInstancedMaterial, instances, numInstances);
+	}
+
+	void GraphicsRenderer3D::DrawMeshInstanced(Mesh& mesh, const Material& material,
+		const GraphicsInstanceData* instances, uint32_t numInstances)
+	{
+		PROFILE_SCOPE(DrawMeshInstanced, Rendering);
+
+		// Falls back to a draw per instance if the shader can't read the instances.
+		if (!material.HasShader()
+			|| !material.GetShader()->GetBufferLayout().HasPerInstanceParameters())
+		{
+			for (uint32_t i = 0; i < numInstances; i++)
+			{
+				DrawMesh(instances[i].objectToWorld, mesh, material, instances[i].entityID);
+			}
+			return;
+		}
+
+		material.Bind();
+
+		// Draws the instances in chunks that fit into the instance buffer.
+		for (uint32_t offset = 0; offset < numInstances; offset += c_maxInstancesPerDraw)
+		{
+			uint32_t count = std::min(numInstances - offset, c_maxInstancesPerDraw);
+			s_instanceBuffer->SetData(instances + offset, count, sizeof(GraphicsInstanceData));
+			GraphicsRenderer::DrawInstanced(mesh.GetVertexArray().get(),
+				s_instanceBuffer, count);
+		}
+	}
+
 	void GraphicsRenderer3D::DrawCube(const MathLib::Matrix4x4& transformMatrix, int32_t entityID)
 	{
 		DrawCube(transformMatrix, *s_defaultMaterial, entityID);
@@ -336,34 +443,44 @@ namespace Engine
 		s_lightingData.constantBufferData.c_ambientLight = lightColor;
 	}
 
-	bool GraphicsRenderer3D::AddPointLight(const MathLib::Vector3& position, const PointLightComponent& pointLight)
+	void GraphicsRenderer3D::SetPointLights(const std::vector<FramePacketPointLight>& pointLights,
+		const LightClusterList& lightClusters)
 	{
-		if (s_lightingData.lightsBound)
+		PROFILE_SCOPE(SetPointLights, Rendering);
+
+		std::vector<GraphicsPointLightData>& pointLightData = s_lightingData.pointLights;
+		pointLightData.resize(pointLights.size());
+		for (uint32_t i = 0; i < (uint32_t)pointLights.size(); i++)
 		{
-			s_lightingData.lightsBound = false;
-			s_lightingData.numPointLights = 0;
+			const PointLightComponent& pointLight = pointLights[i].pointLight;
+			GraphicsPointLightData& data = pointLightData[i];
+			data.position = pointLights[i].position;
+			data.innerRadius = pointLight.innerRadius;
+			data.lightColor = pointLight.lightColor;
+			data.outerRadius = pointLight.outerRadius;
+			data.intensity = pointLight.lightIntensity;
 		}
 
-		if (s_lightingData.numPointLights >= MAX_POINT_LIGHTS)
+		LightingConstantBufferData& constants = s_lightingData.constantBufferData;
+		constants.c_clusterDepthScale = lightClusters.depthScale;
+		constants.c_clusterDepthBias = lightClusters.depthBias;
+
+		if (s_pointLightBuffer == nullptr)
 		{
-			return false;
+			constants.c_numPointLights = 0;
+			return;
 		}
-		
-		if (!pointLight.enabled)
+		s_pointLightBuffer->SetData(pointLightData.data(), (uint32_t)pointLightData.size());
+		constants.c_numPointLights = (uint32_t)pointLightData.size();
+
+		// The lists are left empty when the lights weren't assigned to the clusters.
+		if (lightClusters.clusters.size() == LightClusterList::c_numClusters)
 		{
-			return true;
+			s_lightClusterBuffer->SetData(lightClusters.clusters.data(),
+				(uint32_t)lightClusters.clusters.size());
+			s_lightIndexBuffer->SetData(lightClusters.lightIndices.data(),
+				(uint32_t)lightClusters.lightIndices.size());
 		}
-
-		GraphicsPointLightData* pointLightData 
-			= &s_lightingData.constantBufferData.c_pointLightData[s_lightingData.numPointLights];
-		pointLightData->innerRadius = pointLight.innerRadius;
-		pointLightData->outerRadius = pointLight.outerRadius;
-		pointLightData->intensity = pointLight.lightIntensity;
-		pointLightData->lightColor = pointLight.lightColor;
-		pointLightData->position = position;
-		pointLightData->isEnabled = pointLight.enabled;
-		s_lightingData.numPointLights++;
-		return true;
 	}
 	
 	void GraphicsRenderer3D::SetDirectionalLight(const MathLib::Vector3& direction, 
@@ -379,11 +496,16 @@ namespace Engine
 	
 	void GraphicsRenderer3D::BindLights()
 	{
-		s_lightingData.lightsBound = true;
-
 		s_lightingConstantBuffer->SetData(&s_lightingData.constantBufferData,
 			sizeof(s_lightingData.constantBufferData));
 		s_lightingConstantBuffer->Bind(4,
 			ConstantBufferFlags::VERTEX_SHADER | ConstantBufferFlags::PIXEL_SHADER);
+
+		if (s_pointLightBuffer != nullptr)
+		{
+			s_pointLightBuffer->Bind(c_pointLightsSlot, ConstantBufferFlags::PIXEL_SHADER);
+			s_lightClusterBuffer->Bind(c_lightClustersSlot, ConstantBufferFlags::PIXEL_SHADER);
+			s_lightIndexBuffer->Bind(c_lightIndicesSlot, ConstantBufferFlags::PIXEL_SHADER);
+		}
 	}
 }
@@ -2,16 +2,38 @@
 
 #include "Matrix.h"
 
+#include <vector>
+
 namespace Engine
 {
 
 	struct PointLightComponent;
 	struct DirectionalLightComponent;
 
-	static const uint32_t MAX_POINT_LIGHTS = 32;
+	struct BufferLayoutParameterSet;
+	struct FramePacketPointLight;
+	struct LightClusterList;
+
+	/**
+	 * The per instance data of an instanced mesh.
+	 */
+	struct GraphicsInstanceData
+	{
+		MathLib::Matrix4x4 objectToWorld;
+		int32_t entityID = -1;
+	};
 
 	class GraphicsRenderer3D
 	{
+	public:
+		// The maximum number of instances that are drawn in one draw call.
+		static const uint32_t c_maxInstancesPerDraw = 1024;
+
+		// The shader resource slots of the clustered lights, matches LightingConstants.hlsl.
+		static const uint32_t c_pointLightsSlot = 8;
+		static const uint32_t c_lightClustersSlot = 9;
+		static const uint32_t c_lightIndicesSlot = 10;
+
 	public:
 		static void Init();
 		static void Release();
@@ -21,18 +43,36 @@ namespace Engine
 		static void DrawMesh(const MathLib::Matrix4x4& transformMatrix, class Mesh& mesh,
 			const class Material& material, int32_t entityID = -1);
 
+		/**
+		 * Draws the mesh once per instance. The material's shader needs the instance
+		 * parameters in its layout, otherwise each instance is drawn separately.
+		 */
+		static void DrawMeshInstanced(class Mesh& mesh, const GraphicsInstanceData* instances,
+			uint32_t numInstances);
+		static void DrawMeshInstanced(class Mesh& mesh, const class Material& material,
+			const GraphicsInstanceData* instances, uint32_t numInstances);
+
 		static void DrawCube(const MathLib::Matrix4x4& transformMatrix,
 			const class Material& material, int32_t entityID = -1);
 		static void DrawCube(const MathLib::Matrix4x4& transformMatrix, int32_t entityID = -1);
 
 		static void SetAmbientLight(const MathLib::Vector3& color);
-		static bool AddPointLight(const MathLib::Vector3& position,
-			const PointLightComponent& pointLight);
+		/**
+		 * Uploads the point lights & the lights of each cluster, the lit
+		 * shader only shades the lights of the pixel's cluster.
+		 */
+		static void SetPointLights(const std::vector<FramePacketPointLight>& pointLights,
+			const LightClusterList& lightClusters);
 		static void SetDirectionalLight(const MathLib::Vector3& direction,
 			const DirectionalLightComponent& directionalLight);
 
 		static Mesh& GetCubeMesh();
 
+		/**
+		 * Gets the per instance parameters that instanced shaders append to their layout.
+		 */
+		static const BufferLayoutParameterSet& GetInstanceLayoutParameters();
+
 		static void BindLights();
 	};
 }
@@ -9,6 +9,10 @@
 #include "MetalRenderingAPI.h"
 #endif
 
+#ifdef GRAPHICS_API_NULL
+#include "NullRenderingAPI.h"
+#endif
+
 namespace Engine
 {
 	RenderingAPI* RenderingAPI::Create()
@@ -17,6 +21,8 @@ namespace Engine
         return new DirectX11RenderingAPI();
 #elif defined(GRAPHICS_API_METAL)
         return new MetalRenderingAPI();
+#elif defined(GRAPHICS_API_NULL)
+        return new NullRenderingAPI();
 #else
         JKORN_ENGINE_ASSERT(false, "Unsupported rendering api.");
         return nullptr;
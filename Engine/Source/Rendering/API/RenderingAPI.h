@@ -38,6 +38,13 @@ namespace Engine
 		virtual void Draw(VertexBuffer* vertexBuffer,
             IndexBuffer* indexBuffer = nullptr)=0;
 
+        /**
+         * Draws the vertex array once per instance, the instance buffer
+         * gets bound to the slot after the vertex array's buffers.
+         */
+		virtual void DrawInstanced(VertexArray* vertexArray,
+			VertexBuffer* instanceBuffer, uint32_t numInstances) =0;
+
 		virtual void SetWireframe(bool wireframeMode)=0;
 		virtual bool IsWireframe() const=0;
 
@@ -8,6 +8,7 @@ namespace Engine
      */
 	enum class RenderingAPIType
 	{
+        // No graphics api, uses the null rendering api when GRAPHICS_API_NULL is defined.
 		NONE,
         // The directx graphics rendering api.
 		DIRECTX11,
@@ -36,4 +36,35 @@ namespace Engine
 		camSpace.y *= (float)api.GetHeight();
 		return camSpace;
 	}
-}
\ No newline at end of file
+
+	MathLib::Ray3D Camera::ViewportToRay(const MathLib::Vector2& viewportPosition) const
+	{
+		MathLib::Vector2 ndc(viewportPosition.x * 2.0f - 1.0f,
+			1.0f - viewportPosition.y * 2.0f);
+
+		// Inverts the projection in view space, the camera looks down +z.
+		const auto& projection = m_projectionMatrix.matrix;
+		MathLib::Vector3 viewOrigin, viewDirection;
+		if (projection[2][3] != 0.0f)
+		{
+			// Perspective, the rays start at the camera.
+			viewOrigin = MathLib::Vector3(0.0f, 0.0f, 0.0f);
+			viewDirection = MathLib::Vector3(ndc.x / projection[0][0],
+				ndc.y / projection[1][1], 1.0f);
+		}
+		else
+		{
+			// Orthographic, the rays are parallel.
+			viewOrigin = MathLib::Vector3((ndc.x - projection[3][0]) / projection[0][0],
+				(ndc.y - projection[3][1]) / projection[1][1], 0.0f);
+			viewDirection = MathLib::Vector3(0.0f, 0.0f, 1.0f);
+		}
+
+		// The view matrix is from world to camera, so the inverse is from camera to world.
+		MathLib::Matrix4x4 cameraToWorld = MathLib::Matrix4x4::InvertAffine(m_viewMatrix);
+		MathLib::Vector4 origin = MathLib::Vector4(viewOrigin, 1.0f) * cameraToWorld;
+		MathLib::Vector4 direction = MathLib::Vector4(viewDirection, 0.0f) * cameraToWorld;
+		return MathLib::Ray3D(MathLib::Vector3(origin.x, origin.y, origin.z),
+			Normalize(MathLib::Vector3(direction.x, direction.y, direction.z)));
+	}
+}
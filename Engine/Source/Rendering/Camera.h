@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Matrix.h"
+#include "Geometry3D.h"
 
 namespace Engine
 {
@@ -22,6 +23,12 @@ namespace Engine
 		MathLib::Vector3 ScreenToWorld(const MathLib::Vector2& screenPos);
 		MathLib::Vector2 WorldToScreen(const MathLib::Vector3& worldPos);
 
+		/**
+		 * Gets the world space ray through the viewport position, where (0, 0) is the top left
+		 * & (1, 1) is the bottom right of the viewport. Used for picking on the CPU.
+		 */
+		MathLib::Ray3D ViewportToRay(const MathLib::Vector2& viewportPosition) const;
+
 	protected:
 		// The world to camera matrix.
 		MathLib::Matrix4x4 m_viewMatrix;
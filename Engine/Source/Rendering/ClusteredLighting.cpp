@@ -0,0 +1,303 @@
+#include "EnginePCH.h"
+#include "ClusteredLighting.h"
+
+#include "FramePacket.h"
+#include "JobManager.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine
+{
+	// The minimum number of lights a job bins, fewer lights are binned on the calling thread.
+	static const uint32_t c_minLightsPerAssignChunk = 256;
+	// Matches the lit shader, keeps the log of the depth finite.
+	static const float c_minClusterDepth = 0.0001f;
+	// The depth range used when the near & far planes can't be read from the projection.
+	static const float c_defaultNearPlane = 0.01f;
+	static const float c_defaultDepthRange = 10000.0f;
+
+	namespace
+	{
+		// The range of clusters that a light's sphere touches.
+		struct LightClusterRange
+		{
+			uint32_t minX = 0, maxX = 0;
+			uint32_t minY = 0, maxY = 0;
+			uint32_t minSlice = 0, maxSlice = 0;
+			bool visible = false;
+		};
+
+		struct ClusterPlane
+		{
+			MathLib::Vector3 normal;
+			float distance = 0.0f;
+
+			float GetDistance(const MathLib::Vector3& point) const
+			{
+				return MathLib::Vector3::Dot(normal, point) + distance;
+			}
+		};
+
+		void GetColumn(const MathLib::Matrix4x4& matrix, uint32_t j, float (&out)[4])
+		{
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				out[i] = matrix.matrix[i][j];
+			}
+		}
+
+		/**
+		 * Gets the normalized plane column - ndc * depthColumn, a point is on the
+		 * positive side when its ndc coordinate is greater than the boundary.
+		 */
+		ClusterPlane CreateBoundaryPlane(const float (&column)[4], const float (&depthColumn)[4], float ndc)
+		{
+			ClusterPlane plane;
+			plane.normal = MathLib::Vector3(column[0] - ndc * depthColumn[0],
+				column[1] - ndc * depthColumn[1], column[2] - ndc * depthColumn[2]);
+			plane.distance = column[3] - ndc * depthColumn[3];
+			float length = plane.normal.Length();
+			if (length > 0.0f)
+			{
+				plane.normal = plane.normal / length;
+				plane.distance /= length;
+			}
+			return plane;
+		}
+
+		/**
+		 * Finds the first & last tile between the boundary planes that the sphere touches.
+		 * A tile is touched when the sphere isn't fully outside either of its boundaries.
+		 */
+		template<uint32_t NumTiles>
+		bool GetTileRange(const ClusterPlane (&boundaries)[NumTiles + 1], const MathLib::Vector3& center,
+			float radius, uint32_t& outMin, uint32_t& outMax)
+		{
+			float distances[NumTiles + 1];
+			for (uint32_t i = 0; i <= NumTiles; i++)
+			{
+				distances[i] = boundaries[i].GetDistance(center);
+			}
+
+			bool found = false;
+			for (uint32_t tile = 0; tile < NumTiles; tile++)
+			{
+				if (distances[tile] >= -radius && distances[tile + 1] <= radius)
+				{
+					outMin = found ? outMin : tile;
+					outMax = tile;
+					found = true;
+				}
+			}
+			return found;
+		}
+
+		uint32_t GetSlice(const LightClusterList& clusters, float depth)
+		{
+			float slice = std::floor(std::log(std::max(depth, c_minClusterDepth))
+				* clusters.depthScale + clusters.depthBias);
+			slice = std::min(std::max(slice, 0.0f), (float)(LightClusterList::c_numSlices - 1));
+			return (uint32_t)slice;
+		}
+	}
+
+	uint32_t LightClusterList::FindCluster(const MathLib::Matrix4x4& viewProjection,
+		const MathLib::Vector3& worldPosition) const
+	{
+		MathLib::Vector4 clip = MathLib::Vector4(worldPosition, 1.0f) * viewProjection;
+		if (clip.w <= 0.0f)
+		{
+			return c_numClusters;
+		}
+
+		float tileX = std::floor((clip.x / clip.w * 0.5f + 0.5f) * (float)c_numTilesX);
+		float tileY = std::floor((clip.y / clip.w * 0.5f + 0.5f) * (float)c_numTilesY);
+		tileX = std::min(std::max(tileX, 0.0f), (float)(c_numTilesX - 1));
+		tileY = std::min(std::max(tileY, 0.0f), (float)(c_numTilesY - 1));
+		return GetClusterIndex((uint32_t)tileX, (uint32_t)tileY, GetSlice(*this, clip.w));
+	}
+
+	void LightClusterList::Clear()
+	{
+		clusters.clear();
+		lightIndices.clear();
+		depthScale = 0.0f;
+		depthBias = 0.0f;
+	}
+
+	namespace Graphics::Lighting
+	{
+
+		void AssignLightsToClusters(const MathLib::Matrix4x4& viewProjection,
+			const std::vector<FramePacketPointLight>& pointLights, LightClusterList& outClusters)
+		{
+			PROFILE_SCOPE(AssignLightsToClusters, Rendering);
+
+			const uint32_t c_numTilesX = LightClusterList::c_numTilesX;
+			const uint32_t c_numTilesY = LightClusterList::c_numTilesY;
+			const uint32_t c_numSlices = LightClusterList::c_numSlices;
+
+			// Row vectors get transformed by pos * viewProjection, so clip.x = dot((pos, 1), column 0).
+			float columnX[4], columnY[4], columnZ[4], columnW[4];
+			GetColumn(viewProjection, 0, columnX);
+			GetColumn(viewProjection, 1, columnY);
+			GetColumn(viewProjection, 2, columnZ);
+			GetColumn(viewProjection, 3, columnW);
+
+			// The clip w of a perspective projection is the view depth,
+			// an orthographic projection has a constant w of 1.
+			MathLib::Vector3 depthAxis(columnW[0], columnW[1], columnW[2]);
+			float depthAxisLength = depthAxis.Length();
+			bool isPerspective = depthAxisLength > 1e-6f;
+
+			float nearPlane = 0.0f, farPlane = 0.0f;
+			outClusters.depthScale = 0.0f;
+			outClusters.depthBias = 0.0f;
+			if (isPerspective)
+			{
+				// The clip z is a * w + b, which is 0 on the near plane & w on the far plane.
+				float a = MathLib::Vector3::Dot(MathLib::Vector3(columnZ[0], columnZ[1], columnZ[2]), depthAxis)
+					/ (depthAxisLength * depthAxisLength);
+				float b = columnZ[3] - a * columnW[3];
+				nearPlane = a != 0.0f ? -b / a : 0.0f;
+				farPlane = a != 1.0f ? b / (1.0f - a) : 0.0f;
+				if (!(nearPlane > 0.0f) || !std::isfinite(nearPlane))
+				{
+					nearPlane = c_defaultNearPlane;
+				}
+				if (!(farPlane > nearPlane) || !std::isfinite(farPlane))
+				{
+					farPlane = nearPlane * c_defaultDepthRange;
+				}
+				outClusters.depthScale = (float)c_numSlices / std::log(farPlane / nearPlane);
+				outClusters.depthBias = -std::log(nearPlane) * outClusters.depthScale;
+			}
+
+			ClusterPlane tilePlanesX[c_numTilesX + 1];
+			for (uint32_t i = 0; i <= c_numTilesX; i++)
+			{
+				tilePlanesX[i] = CreateBoundaryPlane(columnX, columnW,
+					-1.0f + 2.0f * (float)i / (float)c_numTilesX);
+			}
+			ClusterPlane tilePlanesY[c_numTilesY + 1];
+			for (uint32_t i = 0; i <= c_numTilesY; i++)
+			{
+				tilePlanesY[i] = CreateBoundaryPlane(columnY, columnW,
+					-1.0f + 2.0f * (float)i / (float)c_numTilesY);
+			}
+
+			uint32_t numLights = (uint32_t)pointLights.size();
+			std::vector<LightClusterRange> ranges(numLights);
+			auto computeRange = [&](uint32_t lightIndex)
+			{
+				const FramePacketPointLight& light = pointLights[lightIndex];
+				float radius = std::max(light.pointLight.outerRadius, light.pointLight.innerRadius);
+				LightClusterRange& range = ranges[lightIndex];
+
+				range.visible = GetTileRange<c_numTilesX>(tilePlanesX, light.position, radius, range.minX, range.maxX)
+					&& GetTileRange<c_numTilesY>(tilePlanesY, light.position, radius, range.minY, range.maxY);
+				if (!range.visible || !isPerspective)
+				{
+					return;
+				}
+
+				float depth = MathLib::Vector3::Dot(depthAxis, light.position) + columnW[3];
+				float minDepth = depth - radius * depthAxisLength;
+				float maxDepth = depth + radius * depthAxisLength;
+				if (maxDepth < nearPlane || minDepth > farPlane)
+				{
+					range.visible = false;
+					return;
+				}
+				range.minSlice = GetSlice(outClusters, std::max(minDepth, nearPlane));
+				range.maxSlice = GetSlice(outClusters, std::min(maxDepth, farPlane));
+			};
+
+			uint32_t numChunks = (numLights + c_minLightsPerAssignChunk - 1) / c_minLightsPerAssignChunk;
+			numChunks = std::min(numChunks, JobManager::GetNumWorkers() + 1);
+			if (numChunks > 1)
+			{
+				uint32_t lightsPerChunk = (numLights + numChunks - 1) / numChunks;
+				JobManager::ParallelFor(numChunks, [&](uint32_t chunk)
+					{
+						uint32_t chunkEnd = std::min(numLights, (chunk + 1) * lightsPerChunk);
+						for (uint32_t i = chunk * lightsPerChunk; i < chunkEnd; i++)
+						{
+							computeRange(i);
+						}
+					});
+			}
+			else
+			{
+				for (uint32_t i = 0; i < numLights; i++)
+				{
+					computeRange(i);
+				}
+			}
+
+			// Counts the lights of each cluster, each job owns the clusters of a slice.
+			std::vector<LightCluster>& clusters = outClusters.clusters;
+			clusters.assign(LightClusterList::c_numClusters, LightCluster());
+			auto forEachLightInSlice = [&](uint32_t slice, const auto& func)
+			{
+				for (uint32_t lightIndex = 0; lightIndex < numLights; lightIndex++)
+				{
+					const LightClusterRange& range = ranges[lightIndex];
+					if (!range.visible || slice < range.minSlice || slice > range.maxSlice)
+					{
+						continue;
+					}
+					for (uint32_t y = range.minY; y <= range.maxY; y++)
+					{
+						for (uint32_t x = range.minX; x <= range.maxX; x++)
+						{
+							func(LightClusterList::GetClusterIndex(x, y, slice), lightIndex);
+						}
+					}
+				}
+			};
+
+			if (numLights > 0)
+			{
+				JobManager::ParallelFor(c_numSlices, [&](uint32_t slice)
+					{
+						forEachLightInSlice(slice, [&clusters](uint32_t cluster, uint32_t)
+							{
+								clusters[cluster].count++;
+							});
+					});
+			}
+
+			uint32_t numIndices = 0;
+			for (LightCluster& cluster : clusters)
+			{
+				cluster.offset = numIndices;
+				numIndices += cluster.count;
+			}
+
+			// Fills the light lists, the lights of a cluster stay in the frame packet's order.
+			std::vector<uint32_t>& lightIndices = outClusters.lightIndices;
+			lightIndices.resize(numIndices);
+			if (numIndices > 0)
+			{
+				JobManager::ParallelFor(c_numSlices, [&](uint32_t slice)
+					{
+						PROFILE_SCOPE(AssignLightsToSlice, Rendering);
+
+						uint32_t sliceBegin = LightClusterList::GetClusterIndex(0, 0, slice);
+						uint32_t cursors[c_numTilesX * c_numTilesY];
+						for (uint32_t i = 0; i < c_numTilesX * c_numTilesY; i++)
+						{
+							cursors[i] = clusters[sliceBegin + i].offset;
+						}
+						forEachLightInSlice(slice, [&](uint32_t cluster, uint32_t lightIndex)
+							{
+								lightIndices[cursors[cluster - sliceBegin]++] = lightIndex;
+							});
+					});
+			}
+		}
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+	struct FramePacketPointLight;
+
+	// The range of a cluster's lights in the light index list.
+	struct LightCluster
+	{
+		uint32_t offset = 0;
+		uint32_t count = 0;
+	};
+
+	/**
+	 * The point lights that affect each cluster of the camera's view. The clusters split
+	 * the screen into tiles & the view depth into slices that grow logarithmically, so the
+	 * lit shader only shades the lights of the pixel's cluster instead of every light.
+	 * The grid dimensions must match the ones in LightingConstants.hlsl.
+	 */
+	struct LightClusterList
+	{
+		static const uint32_t c_numTilesX = 16;
+		static const uint32_t c_numTilesY = 8;
+		static const uint32_t c_numSlices = 24;
+		static const uint32_t c_numClusters = c_numTilesX * c_numTilesY * c_numSlices;
+
+		std::vector<LightCluster> clusters;
+		// The indices of the lights in the frame packet, listed per cluster.
+		std::vector<uint32_t> lightIndices;
+		// The slice of a view depth is log(depth) * depthScale + depthBias,
+		// orthographic cameras only use the first slice.
+		float depthScale = 0.0f;
+		float depthBias = 0.0f;
+
+		static uint32_t GetClusterIndex(uint32_t tileX, uint32_t tileY, uint32_t slice)
+		{
+			return (slice * c_numTilesY + tileY) * c_numTilesX + tileX;
+		}
+
+		// Gets the cluster of the world position, the same lookup as the lit shader.
+		uint32_t FindCluster(const MathLib::Matrix4x4& viewProjection,
+			const MathLib::Vector3& worldPosition) const;
+
+		void Clear();
+	};
+
+	namespace Graphics::Lighting
+	{
+
+		/**
+		 * Bins the point lights into the clusters of the view projection. Each light's
+		 * sphere is tested against the tile & slice planes to find the clusters it
+		 * touches, then the clusters' light lists are built in parallel per slice.
+		 */
+		void AssignLightsToClusters(const MathLib::Matrix4x4& viewProjection,
+			const std::vector<FramePacketPointLight>& pointLights, LightClusterList& outClusters);
+	}
+}
@@ -0,0 +1,116 @@
+#include "EnginePCH.h"
+#include "CommandList.h"
+
+#include "GraphicsRenderer2D.h"
+#include "Material.h"
+#include "Profiler.h"
+
+namespace Engine
+{
+
+	CommandList::CommandList()
+		: m_commands(),
+		m_instances(),
+		m_sprites()
+	{
+	}
+
+	void CommandList::Clear()
+	{
+		m_commands.clear();
+		m_instances.clear();
+		m_sprites.clear();
+	}
+
+	void CommandList::DrawMeshInstanced(Mesh& mesh, const Material* material,
+		const GraphicsInstanceData* instances, uint32_t numInstances)
+	{
+		if (numInstances <= 0)
+		{
+			return;
+		}
+
+		CommandListCommand command;
+		command.type = CommandListCommand_DrawMeshInstanced;
+		command.mesh = &mesh;
+		command.material = material;
+		command.dataOffset = (uint32_t)m_instances.size();
+		command.dataCount = numInstances;
+		m_commands.push_back(command);
+
+		m_instances.insert(m_instances.end(), instances, instances + numInstances);
+	}
+
+	void CommandList::DrawMesh(Mesh& mesh, const Material* material,
+		const MathLib::Matrix4x4& objectToWorld, int32_t entityID)
+	{
+		// Extends the previous draw if it uses the same mesh & material.
+		if (!m_commands.empty())
+		{
+			CommandListCommand& previous = m_commands.back();
+			if (previous.type == CommandListCommand_DrawMeshInstanced
+				&& previous.mesh == &mesh
+				&& previous.material == material)
+			{
+				m_instances.push_back({ objectToWorld, entityID });
+				previous.dataCount++;
+				return;
+			}
+		}
+		GraphicsInstanceData instance = { objectToWorld, entityID };
+		DrawMeshInstanced(mesh, material, &instance, 1);
+	}
+
+	void CommandList::DrawSprite(const MathLib::Matrix4x4& objectToWorld, const MathLib::Vector4& color,
+		Texture* texture, int32_t entityID)
+	{
+		// The 2d renderer batches the sprites, so neighbouring sprites share a command.
+		if (m_commands.empty()
+			|| m_commands.back().type != CommandListCommand_DrawSprite)
+		{
+			CommandListCommand command;
+			command.type = CommandListCommand_DrawSprite;
+			command.dataOffset = (uint32_t)m_sprites.size();
+			m_commands.push_back(command);
+		}
+		m_sprites.push_back({ objectToWorld, color, texture, entityID });
+		m_commands.back().dataCount++;
+	}
+
+	void CommandList::Submit() const
+	{
+		PROFILE_SCOPE(SubmitCommandList, Rendering);
+
+		for (const CommandListCommand& command : m_commands)
+		{
+			switch (command.type)
+			{
+			case CommandListCommand_DrawMeshInstanced:
+			{
+				const GraphicsInstanceData* instances = m_instances.data() + command.dataOffset;
+				if (command.material != nullptr)
+				{
+					GraphicsRenderer3D::DrawMeshInstanced(*command.mesh, *command.material,
+						instances, command.dataCount);
+				}
+				else
+				{
+					GraphicsRenderer3D::DrawMeshInstanced(*command.mesh,
+						instances, command.dataCount);
+				}
+				break;
+			}
+			case CommandListCommand_DrawSprite:
+			{
+				for (uint32_t i = 0; i < command.dataCount; i++)
+				{
+					const CommandListSprite& sprite = m_sprites[command.dataOffset + i];
+					GraphicsRenderer2D::DrawRect(sprite.objectToWorld, sprite.color,
+						sprite.texture, sprite.entityID);
+				}
+				break;
+			}
+			}
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "GraphicsRenderer3D.h"
+#include "Vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+	class Mesh;
+	class Material;
+	class Texture;
+
+	enum CommandListCommandType
+	{
+		CommandListCommand_DrawMeshInstanced,
+		CommandListCommand_DrawSprite
+	};
+
+	struct CommandListCommand
+	{
+		CommandListCommandType type;
+		Mesh* mesh = nullptr;
+		const Material* material = nullptr;
+		// The offset & count into the command list's instances or sprites.
+		uint32_t dataOffset = 0;
+		uint32_t dataCount = 0;
+	};
+
+	struct CommandListSprite
+	{
+		MathLib::Matrix4x4 objectToWorld;
+		MathLib::Vector4 color;
+		Texture* texture = nullptr;
+		int32_t entityID = -1;
+	};
+
+	/**
+	 * Records draws without touching the graphics api, so that multiple jobs
+	 * can each record into their own list in parallel. The recorded draws are
+	 * executed on the render thread when the list is submitted.
+	 */
+	class CommandList
+	{
+	public:
+		explicit CommandList();
+
+		/**
+		 * Clears the recorded commands, keeps the capacity.
+		 */
+		void Clear();
+
+		/**
+		 * Records an instanced draw, the instances are copied into the list.
+		 * A null material draws with the default instanced material.
+		 */
+		void DrawMeshInstanced(Mesh& mesh, const Material* material,
+			const GraphicsInstanceData* instances, uint32_t numInstances);
+		void DrawMesh(Mesh& mesh, const Material* material,
+			const MathLib::Matrix4x4& objectToWorld, int32_t entityID = -1);
+		void DrawSprite(const MathLib::Matrix4x4& objectToWorld, const MathLib::Vector4& color,
+			Texture* texture, int32_t entityID = -1);
+
+		/**
+		 * Executes the commands in the order they were recorded,
+		 * must be called from the thread that owns the graphics api.
+		 */
+		void Submit() const;
+
+		const std::vector<CommandListCommand>& GetCommands() const { return m_commands; }
+		size_t GetNumCommands() const { return m_commands.size(); }
+
+	private:
+		std::vector<CommandListCommand> m_commands;
+		std::vector<GraphicsInstanceData> m_instances;
+		std::vector<CommandListSprite> m_sprites;
+	};
+}
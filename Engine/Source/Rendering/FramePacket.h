@@ -0,0 +1,74 @@
+#pragma once
+
+#include "GraphicsUtility.h"
+#include "SceneRenderList.h"
+#include "LightingComponents.h"
+#include "ClusteredLighting.h"
+#include "RenderQueue.h"
+#include "CommandList.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+
+	struct FramePacketPointLight
+	{
+		MathLib::Vector3 position;
+		PointLightComponent pointLight;
+	};
+
+	// The LOD that was selected for an entity's mesh, stored back in the scene after gathering.
+	struct FramePacketMeshLOD
+	{
+		int32_t entityID = -1;
+		uint32_t lodIndex = 0;
+	};
+
+	/**
+	 * Everything needed to render a scene for a frame, produced on the game thread
+	 * & consumed on the render thread. The meshes, materials & textures are referenced
+	 * rather than copied, so they need to outlive the frames that are in flight.
+	 */
+	struct FramePacket
+	{
+		uint64_t frameIndex = 0;
+		CameraConstants cameraConstants;
+		SceneRenderList renderList;
+		// The number of gathered items that were outside of the camera.
+		uint32_t numCulledItems = 0;
+		// The selected LOD of every mesh with a LOD group, including the ones that aren't drawn.
+		std::vector<FramePacketMeshLOD> meshLODs;
+
+		bool hasDirectionalLight = false;
+		MathLib::Vector3 directionalLightDirection;
+		DirectionalLightComponent directionalLight;
+		std::vector<FramePacketPointLight> pointLights;
+		// The point lights of each cluster of the camera's view.
+		LightClusterList lightClusters;
+
+		// Clears the packet but keeps the capacity.
+		void Clear()
+		{
+			renderList.Clear();
+			numCulledItems = 0;
+			meshLODs.clear();
+			hasDirectionalLight = false;
+			pointLights.clear();
+			lightClusters.Clear();
+		}
+	};
+
+	/**
+	 * The scratch memory used while a frame packet is rendered, owned by whoever renders
+	 * the packets rather than the scene, so the game thread never touches it while the
+	 * render thread is recording.
+	 */
+	struct FrameRenderContext
+	{
+		RenderQueue renderQueue;
+		// The meshes are recorded in parallel, one command list per chunk of the render queue.
+		std::vector<CommandList> commandLists;
+	};
+}
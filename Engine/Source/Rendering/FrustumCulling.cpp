@@ -0,0 +1,228 @@
+#include "EnginePCH.h"
+#include "FrustumCulling.h"
+
+#include "SceneRenderList.h"
+#include "Mesh.h"
+#include "JobManager.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define CULLING_USE_SSE 1
+#include <xmmintrin.h>
+#else
+#define CULLING_USE_SSE 0
+#endif
+
+namespace Engine
+{
+	// The minimum number of items a job culls, smaller lists are culled on the calling thread.
+	static const uint32_t c_minItemsPerCullChunk = 4096;
+
+	// The sprites are unit quads centered on the origin.
+	static const MathLib::Vector3 c_spriteLocalCenter = MathLib::Vector3(0.0f, 0.0f, 0.0f);
+	static const MathLib::Vector3 c_spriteLocalExtents = MathLib::Vector3(0.5f, 0.5f, 0.0f);
+
+	namespace
+	{
+		void SetPlane(CullingFrustum& frustum, uint32_t index,
+			float x, float y, float z, float distance)
+		{
+			frustum.normalX[index] = x;
+			frustum.normalY[index] = y;
+			frustum.normalZ[index] = z;
+			frustum.absNormalX[index] = std::abs(x);
+			frustum.absNormalY[index] = std::abs(y);
+			frustum.absNormalZ[index] = std::abs(z);
+			frustum.distance[index] = distance;
+		}
+
+		/**
+		 * Compacts the visible items to the front of the list, keeping their order.
+		 * Each chunk is compacted in place by a job, then the chunks are moved together.
+		 */
+		template<typename TItem, typename TIsVisibleFunc>
+		uint32_t CullItems(std::vector<TItem>& items, const TIsVisibleFunc& isVisible)
+		{
+			uint32_t numItems = (uint32_t)items.size();
+			if (numItems <= 0)
+			{
+				return 0;
+			}
+
+			uint32_t numChunks = (numItems + c_minItemsPerCullChunk - 1) / c_minItemsPerCullChunk;
+			numChunks = std::min(numChunks, JobManager::GetNumWorkers() + 1);
+			numChunks = std::max(numChunks, 1u);
+			uint32_t itemsPerChunk = (numItems + numChunks - 1) / numChunks;
+
+			std::vector<uint32_t> numVisiblePerChunk(numChunks, 0);
+			JobManager::ParallelFor(numChunks, [&](uint32_t chunk)
+				{
+					PROFILE_SCOPE(CullChunk, Rendering);
+
+					uint32_t chunkBegin = chunk * itemsPerChunk;
+					uint32_t chunkEnd = std::min(numItems, chunkBegin + itemsPerChunk);
+					uint32_t numVisible = 0;
+					for (uint32_t i = chunkBegin; i < chunkEnd; i++)
+					{
+						if (isVisible(items[i]))
+						{
+							if (chunkBegin + numVisible != i)
+							{
+								items[chunkBegin + numVisible] = std::move(items[i]);
+							}
+							numVisible++;
+						}
+					}
+					numVisiblePerChunk[chunk] = numVisible;
+				});
+
+			// The first chunk is already at the front.
+			uint32_t numVisible = numVisiblePerChunk[0];
+			for (uint32_t chunk = 1; chunk < numChunks; chunk++)
+			{
+				auto chunkBegin = items.begin() + chunk * itemsPerChunk;
+				std::move(chunkBegin, chunkBegin + numVisiblePerChunk[chunk],
+					items.begin() + numVisible);
+				numVisible += numVisiblePerChunk[chunk];
+			}
+			items.resize(numVisible);
+			return numItems - numVisible;
+		}
+	}
+
+	namespace
+	{
+		// MathLib::Frustum3D stores the left, right, bottom, top, near & far planes.
+		const uint32_t c_frustumNearPlane = 4;
+
+		CullingFrustum CreateFrustum(const MathLib::Frustum3D& frustum, bool includeNearPlane)
+		{
+			CullingFrustum cullingFrustum;
+			for (uint32_t i = 0; i < CullingFrustum::c_maxPlanes; i++)
+			{
+				SetPlane(cullingFrustum, i, 0.0f, 0.0f, 0.0f, 1.0f);
+			}
+
+			uint32_t numPlanes = 0;
+			for (uint32_t i = 0; i < (uint32_t)MathLib::Frustum3D::c_numPlanes; i++)
+			{
+				if (i == c_frustumNearPlane && !includeNearPlane)
+				{
+					continue;
+				}
+				const MathLib::Plane3D& plane = frustum.planes[i];
+				SetPlane(cullingFrustum, numPlanes++, plane.normal.x,
+					plane.normal.y, plane.normal.z, plane.distanceFromZero);
+			}
+			return cullingFrustum;
+		}
+	}
+
+	CullingFrustum CullingFrustum::FromViewProjection(const MathLib::Matrix4x4& viewProjection)
+	{
+		return CreateFrustum(MathLib::Frustum3D::FromViewProjection(viewProjection), false);
+	}
+
+	CullingFrustum CullingFrustum::FromFrustum(const MathLib::Frustum3D& frustum)
+	{
+		return CreateFrustum(frustum, true);
+	}
+
+	bool CullingFrustum::IsVisible(const MathLib::Vector3& center, const MathLib::Vector3& extents) const
+	{
+		// The box is outside when the point that's furthest along the
+		// plane normal, center + |normal| * extents, is behind the plane.
+#if CULLING_USE_SSE
+		const __m128 centerX = _mm_set1_ps(center.x);
+		const __m128 centerY = _mm_set1_ps(center.y);
+		const __m128 centerZ = _mm_set1_ps(center.z);
+		const __m128 extentsX = _mm_set1_ps(extents.x);
+		const __m128 extentsY = _mm_set1_ps(extents.y);
+		const __m128 extentsZ = _mm_set1_ps(extents.z);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (uint32_t i = 0; i < c_maxPlanes; i += 4)
+		{
+			__m128 d = _mm_load_ps(distance + i);
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_load_ps(normalX + i), centerX));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_load_ps(normalY + i), centerY));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_load_ps(normalZ + i), centerZ));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_load_ps(absNormalX + i), extentsX));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_load_ps(absNormalY + i), extentsY));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_load_ps(absNormalZ + i), extentsZ));
+			if (_mm_movemask_ps(_mm_cmplt_ps(d, zero)) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+#else
+		for (uint32_t i = 0; i < c_maxPlanes; i++)
+		{
+			float d = distance[i]
+				+ normalX[i] * center.x + normalY[i] * center.y + normalZ[i] * center.z
+				+ absNormalX[i] * extents.x + absNormalY[i] * extents.y + absNormalZ[i] * extents.z;
+			if (d < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+#endif
+	}
+
+	namespace Graphics::Culling
+	{
+
+		void TransformBounds(const MathLib::Matrix4x4& objectToWorld,
+			const MathLib::Vector3& localCenter, const MathLib::Vector3& localExtents,
+			MathLib::Vector3& outCenter, MathLib::Vector3& outExtents)
+		{
+			const auto& m = objectToWorld.matrix;
+			float center[3];
+			float extents[3];
+			for (uint32_t j = 0; j < 3; j++)
+			{
+				center[j] = localCenter.x * m[0][j] + localCenter.y * m[1][j]
+					+ localCenter.z * m[2][j] + m[3][j];
+				extents[j] = localExtents.x * std::abs(m[0][j]) + localExtents.y * std::abs(m[1][j])
+					+ localExtents.z * std::abs(m[2][j]);
+			}
+			outCenter = MathLib::Vector3(center[0], center[1], center[2]);
+			outExtents = MathLib::Vector3(extents[0], extents[1], extents[2]);
+		}
+
+		uint32_t CullRenderList(SceneRenderList& renderList, const CullingFrustum& frustum)
+		{
+			PROFILE_SCOPE(CullRenderList, Rendering);
+
+			uint32_t numCulled = CullItems(renderList.meshes,
+				[&frustum](const MeshRenderItem& item) -> bool
+				{
+					if (item.mesh == nullptr || !item.mesh->HasLocalBounds())
+					{
+						return true;
+					}
+					const MathLib::Rect3D& localBounds = item.mesh->GetLocalBounds();
+					MathLib::Vector3 center, extents;
+					TransformBounds(item.objectToWorld, localBounds.center,
+						localBounds.size * 0.5f, center, extents);
+					return frustum.IsVisible(center, extents);
+				});
+
+			numCulled += CullItems(renderList.sprites,
+				[&frustum](const SpriteRenderItem& item) -> bool
+				{
+					MathLib::Vector3 center, extents;
+					TransformBounds(item.objectToWorld, c_spriteLocalCenter,
+						c_spriteLocalExtents, center, extents);
+					return frustum.IsVisible(center, extents);
+				});
+			return numCulled;
+		}
+	}
+}
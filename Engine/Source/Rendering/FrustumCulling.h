@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Shape3D.h"
+#include "Vector.h"
+
+#include <cstdint>
+
+namespace Engine
+{
+	struct SceneRenderList;
+
+	/**
+	 * The clip planes of a view projection matrix, stored as structure of arrays
+	 * so that a box can be tested against four planes at a time. The plane normals
+	 * point inwards, a point is inside a plane when dot(normal, point) + distance >= 0.
+	 */
+	struct CullingFrustum
+	{
+		// The planes are padded to a multiple of four, the padding planes never cull.
+		static const uint32_t c_maxPlanes = 8;
+
+		alignas(16) float normalX[c_maxPlanes];
+		alignas(16) float normalY[c_maxPlanes];
+		alignas(16) float normalZ[c_maxPlanes];
+		alignas(16) float absNormalX[c_maxPlanes];
+		alignas(16) float absNormalY[c_maxPlanes];
+		alignas(16) float absNormalZ[c_maxPlanes];
+		alignas(16) float distance[c_maxPlanes];
+
+		/**
+		 * Extracts the left, right, bottom, top & far planes through MathLib::Frustum3D.
+		 * The near plane is left out as the orthographic & perspective matrices map the
+		 * depth differently, the side planes of a perspective frustum already cull
+		 * what's behind the camera.
+		 */
+		static CullingFrustum FromViewProjection(const MathLib::Matrix4x4& viewProjection);
+
+		// Copies all of the planes of the frustum, including the near plane.
+		static CullingFrustum FromFrustum(const MathLib::Frustum3D& frustum);
+
+		// Whether the axis aligned box is inside or intersects the frustum.
+		bool IsVisible(const MathLib::Vector3& center, const MathLib::Vector3& extents) const;
+	};
+
+	namespace Graphics::Culling
+	{
+
+		/**
+		 * Transforms the local bounds by the object to world matrix,
+		 * the result is the world space box that encloses the transformed box.
+		 */
+		void TransformBounds(const MathLib::Matrix4x4& objectToWorld,
+			const MathLib::Vector3& localCenter, const MathLib::Vector3& localExtents,
+			MathLib::Vector3& outCenter, MathLib::Vector3& outExtents);
+
+		/**
+		 * Removes the meshes & sprites that are outside of the frustum, keeping the order
+		 * of the visible items. The meshes are culled in parallel with the job manager,
+		 * meshes without bounds are always kept. Returns the number of culled items.
+		 */
+		uint32_t CullRenderList(SceneRenderList& renderList, const CullingFrustum& frustum);
+	}
+}
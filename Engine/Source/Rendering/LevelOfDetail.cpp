@@ -0,0 +1,90 @@
+#include "EnginePCH.h"
+#include "LevelOfDetail.h"
+
+#include "SceneRenderList.h"
+#include "MeshLODGroup.h"
+#include "JobManager.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Engine
+{
+	// The minimum number of items a job selects the LODs of.
+	static const uint32_t c_minItemsPerLODChunk = 4096;
+
+	namespace Graphics::LevelOfDetail
+	{
+
+		float GetScreenSize(const MathLib::Matrix4x4& viewProjection,
+			const MathLib::Vector3& center, float radius)
+		{
+			// Row vectors get transformed by pos * viewProjection, so clip.y = dot((pos, 1), column 1).
+			const auto& m = viewProjection.matrix;
+			float scaleY = std::sqrt(m[0][1] * m[0][1] + m[1][1] * m[1][1] + m[2][1] * m[2][1]);
+			float depthAxisLength = std::sqrt(m[0][3] * m[0][3] + m[1][3] * m[1][3] + m[2][3] * m[2][3]);
+
+			// The projected diameter over the screen's 2 units of height is the projected radius.
+			if (depthAxisLength <= 1e-6f)
+			{
+				return radius * scaleY;
+			}
+			float depth = center.x * m[0][3] + center.y * m[1][3] + center.z * m[2][3] + m[3][3];
+			if (depth <= radius * depthAxisLength)
+			{
+				return FLT_MAX;
+			}
+			return radius * scaleY / depth;
+		}
+
+		void SelectMeshLODs(std::vector<MeshRenderItem>& meshes, const MathLib::Matrix4x4& viewProjection)
+		{
+			PROFILE_SCOPE(SelectMeshLODs, Rendering);
+
+			uint32_t numItems = (uint32_t)meshes.size();
+			if (numItems <= 0)
+			{
+				return;
+			}
+
+			uint32_t numChunks = (numItems + c_minItemsPerLODChunk - 1) / c_minItemsPerLODChunk;
+			numChunks = std::min(numChunks, JobManager::GetNumWorkers() + 1);
+			numChunks = std::max(numChunks, 1u);
+			uint32_t itemsPerChunk = (numItems + numChunks - 1) / numChunks;
+
+			JobManager::ParallelFor(numChunks, [&](uint32_t chunk)
+				{
+					uint32_t chunkEnd = std::min(numItems, (chunk + 1) * itemsPerChunk);
+					for (uint32_t i = chunk * itemsPerChunk; i < chunkEnd; i++)
+					{
+						MeshRenderItem& item = meshes[i];
+						if (item.lodGroup == nullptr)
+						{
+							continue;
+						}
+
+						// The world radius is scaled by the largest axis scale of the transform.
+						const auto& m = item.objectToWorld.matrix;
+						float maxScaleSquared = 0.0f;
+						for (uint32_t row = 0; row < 3; row++)
+						{
+							maxScaleSquared = std::max(maxScaleSquared,
+								m[row][0] * m[row][0] + m[row][1] * m[row][1] + m[row][2] * m[row][2]);
+						}
+						const MathLib::Vector3& localCenter = item.lodGroup->GetBoundsCenter();
+						MathLib::Vector3 center(
+							localCenter.x * m[0][0] + localCenter.y * m[1][0] + localCenter.z * m[2][0] + m[3][0],
+							localCenter.x * m[0][1] + localCenter.y * m[1][1] + localCenter.z * m[2][1] + m[3][1],
+							localCenter.x * m[0][2] + localCenter.y * m[1][2] + localCenter.z * m[2][2] + m[3][2]);
+						float radius = item.lodGroup->GetBoundsRadius() * std::sqrt(maxScaleSquared);
+
+						float screenSize = GetScreenSize(viewProjection, center, radius);
+						item.lodIndex = item.lodGroup->SelectLOD(screenSize, item.lodIndex);
+						item.mesh = item.lodGroup->GetMesh(item.lodIndex);
+					}
+				});
+		}
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+	struct MeshRenderItem;
+
+	namespace Graphics::LevelOfDetail
+	{
+
+		/**
+		 * Gets the diameter of the sphere on screen relative to the screen height, so a
+		 * sphere that fills the height of the screen has a size of 1. Spheres that contain
+		 * the camera of a perspective projection have the largest size.
+		 */
+		float GetScreenSize(const MathLib::Matrix4x4& viewProjection,
+			const MathLib::Vector3& center, float radius);
+
+		/**
+		 * Selects the meshes of the items with LOD groups in parallel with the job manager.
+		 * Each item starts from the LOD it had last frame, the selected LOD is written back
+		 * to the item & the mesh is null when the group is too small to be drawn.
+		 */
+		void SelectMeshLODs(std::vector<MeshRenderItem>& meshes, const MathLib::Matrix4x4& viewProjection);
+	}
+}
@@ -106,22 +106,31 @@ namespace Engine
 	struct BufferLayoutParameterSet
 	{
 		std::vector<BufferLayoutParam> parameters;
+		// Determines whether the parameters advance per instance instead of per vertex.
+		bool perInstance = false;
 
-		BufferLayoutParameterSet() : parameters() { }
+		BufferLayoutParameterSet() : parameters(), perInstance(false) { }
 
 		BufferLayoutParameterSet(const BufferLayoutParam& param)
-			: parameters({ param })
+			: parameters({ param }), perInstance(false)
 		{
 		}
 
 		BufferLayoutParameterSet(const std::initializer_list<BufferLayoutParam>& params)
-			: parameters(params)
+			: parameters(params), perInstance(false)
+		{
+
+		}
+
+		BufferLayoutParameterSet(const std::initializer_list<BufferLayoutParam>& params, bool perInstance)
+			: parameters(params), perInstance(perInstance)
 		{
 
 		}
 
 		friend bool operator==(const BufferLayoutParameterSet& a, const BufferLayoutParameterSet& b)
 		{
+			if (a.perInstance != b.perInstance) return false;
 			if (a.parameters.size() != b.parameters.size()) return false;
 
 			for (size_t i = 0; i < a.parameters.size(); ++i)
@@ -133,6 +142,7 @@ namespace Engine
 
 		friend bool operator!=(const BufferLayoutParameterSet& a, const BufferLayoutParameterSet& b)
 		{
+			if (a.perInstance != b.perInstance) return true;
 			if (a.parameters.size() != b.parameters.size()) return true;
 
 			for (size_t i = 0; i < a.parameters.size(); ++i)
@@ -182,6 +192,18 @@ namespace Engine
 
 		uint32_t GetNumElements() const { return (uint32_t)parameters.size(); }
 
+		bool HasPerInstanceParameters() const
+		{
+			for (const BufferLayoutParameterSet& set : parameters)
+			{
+				if (set.perInstance)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
 		friend bool operator==(const BufferLayout& a, const BufferLayout& b)
 		{
 			if (a.parameters.size() != b.parameters.size())
@@ -8,13 +8,36 @@
 #include "DirectX11ConstantBuffer.h"
 #endif
 
+#if defined(GRAPHICS_API_NULL)
+#include "NullConstantBuffer.h"
+#endif
+
 namespace Engine
 {
-	ConstantBuffer::ConstantBuffer(const void* buffer, size_t stride) { }
+	ConstantBuffer::ConstantBuffer(const void* buffer, size_t stride)
+		: m_cachedData()
+	{
+		// The initial data gets uploaded when the buffer is created.
+		if (buffer != nullptr)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(buffer);
+			m_cachedData.assign(bytes, bytes + stride);
+		}
+	}
+
+	ConstantBuffer::~ConstantBuffer()
+	{
+		GraphicsRenderer::OnResourceReleased(this);
+	}
 
 	void ConstantBuffer::SetData(const void* bufferData, size_t stride)
 	{
-		SetData((void*)bufferData, stride);
+		GraphicsRenderer::SetConstantBufferData(*this, bufferData, stride);
+	}
+
+	void ConstantBuffer::Bind(const uint32_t& slot, int flags) const
+	{
+		GraphicsRenderer::BindConstantBuffer(*this, slot, flags);
 	}
 
 	bool ConstantBuffer::Create(ConstantBuffer** outConstantBuffer, const void* buffer, std::size_t stride)
@@ -24,6 +47,9 @@ namespace Engine
 #if defined(GRAPHICS_API_DIRECTX11)
 		*outConstantBuffer = new DirectX11ConstantBuffer(buffer, stride);
 		return true;			
+#elif defined(GRAPHICS_API_NULL)
+		*outConstantBuffer = new NullConstantBuffer(buffer, stride);
+		return true;			
 #else
 		JKORN_ENGINE_ASSERT(false, "Invalid Rendering API for Constant buffer.");
 		return false;
@@ -37,6 +63,9 @@ namespace Engine
 #if defined(GRAPHICS_API_DIRECTX11)
 		outConstantBuffer = std::make_shared<DirectX11ConstantBuffer>(buffer, stride);
 		return true;			
+#elif defined(GRAPHICS_API_NULL)
+		outConstantBuffer = std::make_shared<NullConstantBuffer>(buffer, stride);
+		return true;			
 #else
 		JKORN_ENGINE_ASSERT(false, "Invalid Rendering API for Constant buffer.");
 		return false;
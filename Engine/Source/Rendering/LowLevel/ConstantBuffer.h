@@ -2,6 +2,8 @@
 
 #include "Memory.h"
 
+#include <vector>
+
 namespace Engine
 {
 
@@ -19,12 +21,20 @@ namespace Engine
 	public:
 		ConstantBuffer(const ConstantBuffer& buf) = delete;
 		explicit ConstantBuffer(const void* buffer, size_t stride);
-		virtual ~ConstantBuffer() { }
+		virtual ~ConstantBuffer();
 
-		virtual void SetData(void* buffer, size_t stride)=0;
+		// Skips the upload if the data matches the last uploaded data.
 		void SetData(const void* buffer, size_t stride);
+		// Skips the bind if the buffer is already bound to the slot.
+		void Bind(const uint32_t& slot, int flags) const;
+
+	protected:
+		virtual void SetData_Internal(const void* buffer, size_t stride)=0;
+		virtual void Bind_Internal(const uint32_t& slot, int flags) const=0;
 
-		virtual void Bind(const uint32_t& slot, int flags) const=0;
+	private:
+		// The last uploaded data, used by the graphics renderer's render state cache.
+		std::vector<uint8_t> m_cachedData;
 		
 	public:
 		static bool Create(ConstantBuffer** outConstantBuffer,
@@ -13,6 +13,10 @@
 #include "MetalFrameBuffer.h"
 #endif
 
+#if defined(GRAPHICS_API_NULL)
+#include "NullFrameBuffer.h"
+#endif
+
 namespace Engine
 {
 
@@ -36,6 +40,8 @@ namespace Engine
         return new DirectX11FrameBuffer(specification);
 #elif defined(GRAPHICS_API_METAL)
         return new MetalFrameBuffer(specification);
+#elif defined(GRAPHICS_API_NULL)
+        return new NullFrameBuffer(specification);
 #else
         JKORN_ENGINE_ASSERT(false, "Unsupported Frame Buffer Type.");
         return nullptr;
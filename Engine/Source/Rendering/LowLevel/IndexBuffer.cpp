@@ -11,6 +11,10 @@
 #include "MetalIndexBuffer.h"
 #endif
 
+#if defined(GRAPHICS_API_NULL)
+#include "NullIndexBuffer.h"
+#endif
+
 namespace Engine
 {
 
@@ -38,6 +42,9 @@ namespace Engine
 #elif defined(GRAPHICS_API_METAL)
         buf = std::make_shared<MetalIndexBuffer>(buffer, indices, stride);
         return true;
+#elif defined(GRAPHICS_API_NULL)
+        buf = std::make_shared<NullIndexBuffer>(buffer, indices, stride);
+        return true;
 #else
         JKORN_ENGINE_ASSERT(false, "Unsupported Index buffer type.");
         return false;
@@ -52,6 +59,9 @@ namespace Engine
 #elif defined(GRAPHICS_API_METAL)
         buf = std::make_unique<MetalIndexBuffer>(buffer, indices, stride);
         return true;
+#elif defined(GRAPHICS_API_NULL)
+        buf = std::make_unique<NullIndexBuffer>(buffer, indices, stride);
+        return true;
 #else
         JKORN_ENGINE_ASSERT(false, "Unsupported Index buffer type.");
         return false;
@@ -66,6 +76,9 @@ namespace Engine
 #elif defined(GRAPHICS_API_METAL)
         *buf = new MetalIndexBuffer(buffer, indices, stride);
         return true;
+#elif defined(GRAPHICS_API_NULL)
+        *buf = new NullIndexBuffer(buffer, indices, stride);
+        return true;
 #else
         JKORN_ENGINE_ASSERT(false, "Unsupported Index buffer type.");
         return false;
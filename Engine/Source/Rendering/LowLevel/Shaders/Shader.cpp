@@ -2,12 +2,17 @@
 #include "Shader.h"
 
 #include "RenderingAPI.h"
+#include "GraphicsRenderer.h"
 #include "BufferLayout.h"
 
 #if defined(GRAPHICS_API_DIRECTX11)
 #include "DirectX11Shader.h"
 #endif
 
+#if defined(GRAPHICS_API_NULL)
+#include "NullShader.h"
+#endif
+
 namespace Engine
 {
 	Shader::Shader(const BufferLayout& bufferLayout)
@@ -15,6 +20,16 @@ namespace Engine
 	{
 	}
 
+	Shader::~Shader()
+	{
+		GraphicsRenderer::OnResourceReleased(this);
+	}
+
+	void Shader::Bind() const
+	{
+		GraphicsRenderer::BindShader(*this);
+	}
+
 	bool Shader::LoadFromFile_Internal(const wchar_t* filePath, const BufferLayout& bufferLayout)
 	{
 		m_bufferLayout = bufferLayout;
@@ -26,6 +41,9 @@ namespace Engine
 #if defined(GRAPHICS_API_DIRECTX11)
 		return empty ? new DirectX11Shader()
 			: new DirectX11Shader(bufferLayout);
+#elif defined(GRAPHICS_API_NULL)
+		return empty ? new NullShader()
+			: new NullShader(bufferLayout);
 #else
 		JKORN_ENGINE_ASSERT(false, "Unsupported shader type.");
 		return nullptr;
@@ -11,14 +11,16 @@ namespace Engine
 	public:
 		explicit Shader() = default;
 		explicit Shader(const BufferLayout& bufferLayout);
-		virtual ~Shader() { }
+		virtual ~Shader();
 
 		virtual bool IsValid() const = 0;
-		virtual void Bind() const = 0;
+		// Skips the bind if the shader is already bound.
+		void Bind() const;
 
 		const BufferLayout& GetBufferLayout() const { return m_bufferLayout; }
 
 	protected:
+		virtual void Bind_Internal() const = 0;
 		virtual bool LoadFromFile_Internal(const wchar_t* fileName) =0;
 		bool LoadFromFile_Internal(const wchar_t* fileName, const BufferLayout& bufferLayout);
 
@@ -48,5 +50,7 @@ namespace Engine
 
 	private:
 		static Shader* Create(const BufferLayout& bufferLayout, bool empty);
+
+		friend class GraphicsRenderer;
 	};
 }
@@ -0,0 +1,96 @@
+#include "EnginePCH.h"
+#include "StructuredBuffer.h"
+#include "Profiler.h"
+
+#if defined(GRAPHICS_API_DIRECTX11)
+#include "DirectX11StructuredBuffer.h"
+#endif
+
+#if defined(GRAPHICS_API_NULL)
+#include "NullStructuredBuffer.h"
+#endif
+
+namespace Engine
+{
+	StructuredBuffer::StructuredBuffer(size_t stride, uint32_t capacity)
+		: m_stride(stride),
+		// Empty buffers can't be created on the gpu.
+		m_capacity(capacity > 0 ? capacity : 1),
+		m_numElements(0)
+	{
+	}
+
+	void StructuredBuffer::SetData(const void* elements, uint32_t numElements)
+	{
+		if (elements == nullptr)
+		{
+			return;
+		}
+
+		if (numElements > m_capacity)
+		{
+			PROFILE_SCOPE(ResizeStructuredBuffer, Rendering);
+
+			// Grows geometrically so that slowly increasing counts don't resize every frame.
+			uint32_t capacity = m_capacity;
+			while (capacity < numElements)
+			{
+				capacity *= 2;
+			}
+			m_capacity = capacity;
+			Resize_Internal(capacity);
+		}
+		m_numElements = numElements;
+		if (numElements > 0)
+		{
+			SetData_Internal(elements, numElements);
+		}
+	}
+
+	void StructuredBuffer::Bind(uint32_t slot, int flags) const
+	{
+		Bind_Internal(slot, flags);
+	}
+
+	bool StructuredBuffer::IsSupported()
+	{
+#if defined(GRAPHICS_API_DIRECTX11) || defined(GRAPHICS_API_NULL)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool StructuredBuffer::Create(StructuredBuffer** outStructuredBuffer, size_t stride, uint32_t capacity)
+	{
+		PROFILE_SCOPE(CreateStructuredBuffer, Rendering);
+
+#if defined(GRAPHICS_API_DIRECTX11)
+		*outStructuredBuffer = new DirectX11StructuredBuffer(stride, capacity);
+		return true;
+#elif defined(GRAPHICS_API_NULL)
+		*outStructuredBuffer = new NullStructuredBuffer(stride, capacity);
+		return true;
+#else
+		JKORN_ENGINE_ASSERT(false, "Invalid Rendering API for Structured buffer.");
+		return false;
+#endif
+	}
+
+	bool StructuredBuffer::Create(std::shared_ptr<StructuredBuffer>& outStructuredBuffer,
+		size_t stride, uint32_t capacity)
+	{
+		PROFILE_SCOPE(CreateStructuredBuffer, Rendering);
+
+#if defined(GRAPHICS_API_DIRECTX11)
+		outStructuredBuffer = std::make_shared<DirectX11StructuredBuffer>(stride, capacity);
+		return true;
+#elif defined(GRAPHICS_API_NULL)
+		outStructuredBuffer = std::make_shared<NullStructuredBuffer>(stride, capacity);
+		return true;
+#else
+		JKORN_ENGINE_ASSERT(false, "Invalid Rendering API for Structured buffer.");
+		return false;
+#endif
+	}
+}
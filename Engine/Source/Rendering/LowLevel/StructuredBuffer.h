@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ConstantBuffer.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace Engine
+{
+
+	/**
+	 * A read only array of structures that shaders read through a shader resource slot.
+	 * Unlike a constant buffer the number of elements isn't fixed, the buffer grows
+	 * when the uploaded elements don't fit.
+	 */
+	class StructuredBuffer
+	{
+	public:
+		StructuredBuffer(const StructuredBuffer& buf) = delete;
+		explicit StructuredBuffer(size_t stride, uint32_t capacity);
+		virtual ~StructuredBuffer() = default;
+
+		// Uploads the elements, the buffer is resized if they don't fit.
+		void SetData(const void* elements, uint32_t numElements);
+		// Binds the buffer to the shader resource slot, the flags are the constant buffer flags.
+		void Bind(uint32_t slot, int flags) const;
+
+		size_t GetStride() const { return m_stride; }
+		uint32_t GetCapacity() const { return m_capacity; }
+		uint32_t GetNumElements() const { return m_numElements; }
+
+	protected:
+		virtual void Resize_Internal(uint32_t capacity)=0;
+		virtual void SetData_Internal(const void* elements, uint32_t numElements)=0;
+		virtual void Bind_Internal(uint32_t slot, int flags) const=0;
+
+	private:
+		size_t m_stride;
+		uint32_t m_capacity;
+		uint32_t m_numElements;
+
+	public:
+		// Whether the rendering api has structured buffers, Metal doesn't implement them yet.
+		static bool IsSupported();
+
+		static bool Create(StructuredBuffer** outStructuredBuffer, size_t stride, uint32_t capacity);
+		static bool Create(std::shared_ptr<StructuredBuffer>& outStructuredBuffer,
+			size_t stride, uint32_t capacity);
+	};
+}
@@ -8,6 +8,10 @@
 #include "DirectX11VertexArray.h"
 #endif
 
+#if defined(GRAPHICS_API_NULL)
+#include "NullVertexArray.h"
+#endif
+
 namespace Engine
 {
 	bool VertexArray::Create(VertexArray** outVertexArray)
@@ -15,6 +19,9 @@ namespace Engine
 #if defined(GRAPHICS_API_DIRECTX11)
         *outVertexArray = new DirectX11VertexArray();
         return true;
+#elif defined(GRAPHICS_API_NULL)
+        *outVertexArray = new NullVertexArray();
+        return true;
 #else
         JKORN_ENGINE_ASSERT(false, "Failed to create Vertex Array.");
         return false;
@@ -26,6 +33,9 @@ namespace Engine
 #if defined(GRAPHICS_API_DIRECTX11)
         outVertexArray = std::make_shared<DirectX11VertexArray>();
         return true;
+#elif defined(GRAPHICS_API_NULL)
+        outVertexArray = std::make_shared<NullVertexArray>();
+        return true;
 #else
         JKORN_ENGINE_ASSERT(false, "Failed to Create Vertex Array.");
         return false;
@@ -37,6 +47,9 @@ namespace Engine
 #if defined(GRAPHICS_API_DIRECTX11)
         outVertexArray = std::make_unique<DirectX11VertexArray>();
         return true;
+#elif defined(GRAPHICS_API_NULL)
+        outVertexArray = std::make_unique<NullVertexArray>();
+        return true;
 #else
         JKORN_ENGINE_ASSERT(false, "Failed to Create Vertex Array.");
         return false;
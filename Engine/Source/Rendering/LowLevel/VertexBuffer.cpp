@@ -11,6 +11,10 @@
 #include "MetalVertexBuffer.h"
 #endif
 
+#if defined(GRAPHICS_API_NULL)
+#include "NullVertexBuffer.h"
+#endif
+
 namespace Engine
 {
 
@@ -23,6 +27,9 @@ namespace Engine
 #elif defined(GRAPHICS_API_METAL)
         *ptr = new MetalVertexBuffer(bufferData, numVertices, stride);
         return true;
+#elif defined(GRAPHICS_API_NULL)
+        *ptr = new NullVertexBuffer(bufferData, numVertices, stride);
+        return true;
 #else
         JKORN_ENGINE_ASSERT(false, "Unsupported Vertex Buffer type.");
         return false;
@@ -38,6 +45,9 @@ namespace Engine
 #elif defined(GRAPHICS_API_METAL)
         ptr = std::make_shared<MetalVertexBuffer>(bufferData, numVertices, stride);
         return true;
+#elif defined(GRAPHICS_API_NULL)
+        ptr = std::make_shared<NullVertexBuffer>(bufferData, numVertices, stride);
+        return true;
 #else
         JKORN_ENGINE_ASSERT(false, "Unsupported Vertex Buffer type.");
         return false;
@@ -0,0 +1,159 @@
+#include "EnginePCH.h"
+#include "RenderQueue.h"
+
+#include "Profiler.h"
+
+#include <cstring>
+
+namespace Engine
+{
+	namespace
+	{
+		constexpr uint64_t CreateMask(uint32_t numBits)
+		{
+			return (1ull << numBits) - 1ull;
+		}
+
+		/**
+		 * Converts the depth to an integer that keeps the order of positive floats,
+		 * negative depths are behind the camera so they get clamped to zero.
+		 */
+		uint32_t QuantizeDepth(float depth)
+		{
+			if (!(depth > 0.0f))
+			{
+				return 0;
+			}
+			uint32_t bits;
+			std::memcpy(&bits, &depth, sizeof(bits));
+			return bits >> (31 - RenderQueue::c_depthBits);
+		}
+	}
+
+	RenderQueue::RenderQueue()
+		: m_entries(),
+		m_sortBuffer(),
+		m_histograms(),
+		m_ids()
+	{
+	}
+
+	void RenderQueue::Clear()
+	{
+		m_entries.clear();
+		m_ids.clear();
+	}
+
+	uint32_t RenderQueue::GetID(const void* resource)
+	{
+		if (resource == nullptr)
+		{
+			return 0;
+		}
+		auto found = m_ids.find(resource);
+		if (found != m_ids.end())
+		{
+			return found->second;
+		}
+		uint32_t id = (uint32_t)m_ids.size() + 1;
+		m_ids.emplace(resource, id);
+		return id;
+	}
+
+	void RenderQueue::Submit(uint64_t sortKey, uint32_t itemIndex)
+	{
+		m_entries.push_back({ sortKey, itemIndex });
+	}
+
+	void RenderQueue::Submit(RenderQueueLayer layer, const void* shader, const void* material,
+		const void* mesh, float depth, uint32_t itemIndex)
+	{
+		Submit(CreateSortKey(layer, GetID(shader), GetID(material), GetID(mesh), depth), itemIndex);
+	}
+
+	uint64_t RenderQueue::CreateSortKey(RenderQueueLayer layer, uint32_t shaderID,
+		uint32_t materialID, uint32_t meshID, float depth)
+	{
+		// The ids wrap around if there are more than the bits can hold, this only affects the batching.
+		uint64_t shader = shaderID & CreateMask(c_shaderBits);
+		uint64_t material = materialID & CreateMask(c_materialBits);
+		uint64_t mesh = meshID & CreateMask(c_meshBits);
+		uint64_t quantizedDepth = QuantizeDepth(depth);
+
+		uint64_t key = (uint64_t)layer << 62;
+		if (layer == RenderQueueLayer_Transparent)
+		{
+			// Transparent objects must be drawn back to front, so depth has the highest priority.
+			uint64_t invertedDepth = CreateMask(c_depthBits) - quantizedDepth;
+			key |= invertedDepth << (c_shaderBits + c_materialBits + c_meshBits);
+			key |= shader << (c_materialBits + c_meshBits);
+			key |= material << c_meshBits;
+			key |= mesh;
+			return key;
+		}
+		key |= shader << (c_materialBits + c_meshBits + c_depthBits);
+		key |= material << (c_meshBits + c_depthBits);
+		key |= mesh << c_depthBits;
+		key |= quantizedDepth;
+		return key;
+	}
+
+	void RenderQueue::Sort()
+	{
+		PROFILE_SCOPE(SortRenderQueue, Rendering);
+
+		size_t numEntries = m_entries.size();
+		if (numEntries <= 1)
+		{
+			return;
+		}
+		m_sortBuffer.resize(numEntries);
+
+		// Counts the bytes of every pass in one read of the keys.
+		std::vector<size_t>& histograms = m_histograms;
+		histograms.assign(8 * 256, 0);
+		for (size_t i = 0; i < numEntries; i++)
+		{
+			uint64_t key = m_entries[i].sortKey;
+			for (uint32_t pass = 0; pass < 8; pass++)
+			{
+				histograms[pass * 256 + ((key >> (pass * 8)) & 0xFF)]++;
+			}
+		}
+
+		// Least significant digit radix sort, a byte per pass.
+		RenderQueueEntry* source = m_entries.data();
+		RenderQueueEntry* destination = m_sortBuffer.data();
+		for (uint32_t pass = 0; pass < 8; pass++)
+		{
+			uint32_t shift = pass * 8;
+			size_t* offsets = &histograms[pass * 256];
+
+			// Skips the pass when every key has the same byte.
+			if (offsets[(source[0].sortKey >> shift) & 0xFF] == numEntries)
+			{
+				continue;
+			}
+
+			size_t total = 0;
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				size_t count = offsets[i];
+				offsets[i] = total;
+				total += count;
+			}
+
+			for (size_t i = 0; i < numEntries; i++)
+			{
+				destination[offsets[(source[i].sortKey >> shift) & 0xFF]++] = source[i];
+			}
+			std::swap(source, destination);
+		}
+
+		// The sorted entries ended up in the sort buffer.
+		if (source != m_entries.data())
+		{
+			m_entries.swap(m_sortBuffer);
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+namespace Engine
+{
+
+	enum RenderQueueLayer
+	{
+		// Drawn first, sorted by state & then front to back.
+		RenderQueueLayer_Opaque = 0,
+		// Drawn after the opaque layer, sorted back to front.
+		RenderQueueLayer_Transparent = 1
+	};
+
+	struct RenderQueueEntry
+	{
+		uint64_t sortKey;
+		// The index of the submitted item, such as the index in the scene render list.
+		uint32_t itemIndex;
+	};
+
+	/**
+	 * Sorts draw submissions with a 64 bit key so that the draws sharing a
+	 * shader, material & mesh are next to each other.
+	 *
+	 * Opaque Key:      | Layer 2 | Shader 12 | Material 12 | Mesh 14 | Depth 24 |
+	 * Transparent Key: | Layer 2 | Inverted Depth 24 | Shader 12 | Material 12 | Mesh 14 |
+	 */
+	class RenderQueue
+	{
+	public:
+		static const uint32_t c_shaderBits = 12;
+		static const uint32_t c_materialBits = 12;
+		static const uint32_t c_meshBits = 14;
+		static const uint32_t c_depthBits = 24;
+
+	public:
+		explicit RenderQueue();
+
+		/**
+		 * Clears the entries & the ids, keeps the capacity.
+		 */
+		void Clear();
+
+		/**
+		 * Gets the id of a shader, material or mesh for this frame. The ids are
+		 * handed out in the order they're first seen, nullptr is always 0.
+		 */
+		uint32_t GetID(const void* resource);
+
+		void Submit(uint64_t sortKey, uint32_t itemIndex);
+		void Submit(RenderQueueLayer layer, const void* shader, const void* material,
+			const void* mesh, float depth, uint32_t itemIndex);
+
+		/**
+		 * Radix sorts the entries by their keys, the sort is stable.
+		 */
+		void Sort();
+
+		const std::vector<RenderQueueEntry>& GetEntries() const { return m_entries; }
+		size_t GetNumEntries() const { return m_entries.size(); }
+
+	public:
+		static uint64_t CreateSortKey(RenderQueueLayer layer, uint32_t shaderID,
+			uint32_t materialID, uint32_t meshID, float depth);
+
+	private:
+		std::vector<RenderQueueEntry> m_entries;
+		std::vector<RenderQueueEntry> m_sortBuffer;
+		std::vector<size_t> m_histograms;
+		std::unordered_map<const void*, uint32_t> m_ids;
+	};
+}
@@ -0,0 +1,184 @@
+#include "EnginePCH.h"
+#include "RenderThread.h"
+
+#include "Profiler.h"
+
+namespace Engine
+{
+	std::atomic<RenderThread*> RenderThread::s_activeRenderThread(nullptr);
+
+	// Set on the render thread, so that it never waits on itself.
+	static thread_local bool s_isRenderThread = false;
+
+	RenderThread::RenderThread(uint32_t frameLatency)
+		: m_packets(),
+		m_packetStates(),
+		m_writeIndex(0),
+		m_readIndex(0),
+		m_nextFrameIndex(0),
+		m_numFramesRendered(0),
+		m_renderFunc(),
+		m_frameLatency(frameLatency < c_maxFrameLatency ? frameLatency : c_maxFrameLatency),
+		m_running(false),
+		m_stopping(false),
+		m_thread(),
+		m_mutex(),
+		m_packetSubmitted(),
+		m_packetRendered()
+	{
+		for (uint32_t i = 0; i < c_numPackets; i++)
+		{
+			m_packetStates[i] = PacketState_Free;
+		}
+	}
+
+	RenderThread::~RenderThread()
+	{
+		Stop();
+	}
+
+	void RenderThread::Start(const RenderFunc& renderFunc)
+	{
+		JKORN_ENGINE_ASSERT(!m_running, "The render thread has already been started.");
+		JKORN_ENGINE_ASSERT(s_activeRenderThread == nullptr, "Another render thread has already been started.");
+		m_renderFunc = renderFunc;
+		m_running = true;
+		m_stopping = false;
+		s_activeRenderThread = this;
+
+		if (m_frameLatency > 0)
+		{
+			m_thread = std::thread(&RenderThread::Run, this);
+		}
+	}
+
+	void RenderThread::Stop()
+	{
+		if (!m_running)
+		{
+			return;
+		}
+
+		if (m_thread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stopping = true;
+			}
+			m_packetSubmitted.notify_one();
+			m_thread.join();
+		}
+		m_running = false;
+		s_activeRenderThread = nullptr;
+	}
+
+	FramePacket& RenderThread::BeginFrame()
+	{
+		PROFILE_SCOPE(WaitForFramePacket, Rendering);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_packetRendered.wait(lock, [this]()
+			{
+				return m_packetStates[m_writeIndex] == PacketState_Free;
+			});
+
+		FramePacket& packet = m_packets[m_writeIndex];
+		packet.Clear();
+		packet.frameIndex = m_nextFrameIndex;
+		return packet;
+	}
+
+	void RenderThread::EndFrame()
+	{
+		// Without the thread the frame gets rendered straight away.
+		if (!m_thread.joinable())
+		{
+			if (m_renderFunc)
+			{
+				m_renderFunc(m_packets[m_writeIndex]);
+			}
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_nextFrameIndex++;
+			m_numFramesRendered++;
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_packetStates[m_writeIndex] = PacketState_Pending;
+			m_writeIndex = (m_writeIndex + 1) % c_numPackets;
+			m_nextFrameIndex++;
+		}
+		m_packetSubmitted.notify_one();
+	}
+
+	void RenderThread::Flush()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_packetRendered.wait(lock, [this]()
+			{
+				for (uint32_t i = 0; i < c_numPackets; i++)
+				{
+					if (m_packetStates[i] != PacketState_Free)
+					{
+						return false;
+					}
+				}
+				return true;
+			});
+	}
+
+	void RenderThread::FlushActive()
+	{
+		RenderThread* renderThread = s_activeRenderThread;
+		if (renderThread != nullptr && !s_isRenderThread)
+		{
+			renderThread->Flush();
+		}
+	}
+
+	uint64_t RenderThread::GetNumFramesRendered() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_numFramesRendered;
+	}
+
+	void RenderThread::Run()
+	{
+		s_isRenderThread = true;
+		while (true)
+		{
+			uint32_t readIndex;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				// The pending frames are still rendered when stopping.
+				m_packetSubmitted.wait(lock, [this]()
+					{
+						return m_packetStates[m_readIndex] == PacketState_Pending || m_stopping;
+					});
+				if (m_packetStates[m_readIndex] != PacketState_Pending)
+				{
+					break;
+				}
+				readIndex = m_readIndex;
+				m_packetStates[readIndex] = PacketState_Rendering;
+			}
+
+			{
+				PROFILE_SCOPE(RenderFramePacket, Rendering);
+				if (m_renderFunc)
+				{
+					m_renderFunc(m_packets[readIndex]);
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_packetStates[readIndex] = PacketState_Free;
+				m_readIndex = (m_readIndex + 1) % c_numPackets;
+				m_numFramesRendered++;
+			}
+			m_packetRendered.notify_all();
+		}
+	}
+}
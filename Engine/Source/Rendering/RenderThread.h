@@ -0,0 +1,99 @@
+#pragma once
+
+#include "FramePacket.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Engine
+{
+
+	/**
+	 * Renders frame packets on a dedicated thread. The game thread fills one of
+	 * two packets while the render thread consumes the other, so the frames overlap
+	 * at the cost of a frame of latency. With a latency of 0 the packets are rendered
+	 * on the game thread when they're submitted.
+	 *
+	 * Once started, the render function should be the only thing using the graphics api.
+	 * The packets reference the meshes, materials & textures, so anything that destroys
+	 * them flushes the started render thread first.
+	 */
+	class RenderThread
+	{
+	public:
+		using RenderFunc = std::function<void(const FramePacket&)>;
+
+		static const uint32_t c_maxFrameLatency = 1;
+
+	public:
+		explicit RenderThread(uint32_t frameLatency = c_maxFrameLatency);
+		~RenderThread();
+
+		void Start(const RenderFunc& renderFunc);
+		// Renders the frames that were submitted & stops the thread.
+		void Stop();
+
+		/**
+		 * Gets the packet for the next frame, blocks until the
+		 * render thread has finished with it.
+		 */
+		FramePacket& BeginFrame();
+		/**
+		 * Submits the packet from BeginFrame to the render thread.
+		 */
+		void EndFrame();
+
+		// Blocks until all of the submitted frames have been rendered.
+		void Flush();
+
+		uint32_t GetFrameLatency() const { return m_frameLatency; }
+		uint64_t GetNumFramesRendered() const;
+
+		bool IsRunning() const { return m_running; }
+
+	public:
+		/**
+		 * Blocks until the started render thread has rendered the submitted frames, called
+		 * before destroying anything that the frames in flight could reference. Does nothing
+		 * without a started render thread or when called from the render thread itself.
+		 */
+		static void FlushActive();
+
+	private:
+		void Run();
+
+	private:
+		// The started render thread, only one can be started at a time.
+		static std::atomic<RenderThread*> s_activeRenderThread;
+
+	private:
+		enum PacketState
+		{
+			PacketState_Free,
+			PacketState_Pending,
+			PacketState_Rendering
+		};
+
+		static const uint32_t c_numPackets = 2;
+
+		FramePacket m_packets[c_numPackets];
+		PacketState m_packetStates[c_numPackets];
+		uint32_t m_writeIndex;
+		uint32_t m_readIndex;
+		uint64_t m_nextFrameIndex;
+		uint64_t m_numFramesRendered;
+
+		RenderFunc m_renderFunc;
+		uint32_t m_frameLatency;
+		bool m_running;
+		bool m_stopping;
+
+		std::thread m_thread;
+		mutable std::mutex m_mutex;
+		std::condition_variable m_packetSubmitted;
+		std::condition_variable m_packetRendered;
+	};
+}
@@ -4,6 +4,8 @@
 #include <filesystem>
 
 #include "RenderingAPI.h"
+#include "GraphicsRenderer.h"
+#include "RenderThread.h"
 
 #if defined(GRAPHICS_API_DIRECTX11)
 #include "DirectX11Texture.h"
@@ -13,6 +15,10 @@
 #include "MetalTexture.h"
 #endif
 
+#if defined(GRAPHICS_API_NULL)
+#include "NullTexture.h"
+#endif
+
 namespace Engine
 {
 
@@ -26,6 +32,18 @@ namespace Engine
 	{
 	}
 
+	Texture::~Texture()
+	{
+		// The frames in flight could still bind the texture.
+		RenderThread::FlushActive();
+		GraphicsRenderer::OnResourceReleased(this);
+	}
+
+	void Texture::Bind(uint32_t textureSlot) const
+	{
+		GraphicsRenderer::BindTexture(*this, textureSlot);
+	}
+
 	uint32_t Texture::GetWidth() const
 	{
 		return m_width;
@@ -60,6 +78,9 @@ namespace Engine
 #elif defined(GRAPHICS_API_METAL)
 		return empty ? new MetalTexture()
 				: new MetalTexture(width, height, specifications);
+#elif defined(GRAPHICS_API_NULL)
+		return empty ? new NullTexture()
+				: new NullTexture(width, height, specifications);
 #else
 		JKORN_ENGINE_ASSERT(false, "Unsupported rendering API type.");
 		return nullptr;
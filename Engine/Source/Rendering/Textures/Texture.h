@@ -50,13 +50,14 @@ namespace Engine
 	public:
 		explicit Texture();
 		explicit Texture(uint32_t width, uint32_t height, const TextureSpecifications& specifications);
-		virtual ~Texture() { }
+		virtual ~Texture();
 
 		uint32_t GetWidth() const;
 		uint32_t GetHeight() const;
 
 		virtual bool IsValid() const =0;
-		virtual void Bind(uint32_t textureSlot) const =0;
+		// Skips the bind if the texture is already bound to the slot.
+		void Bind(uint32_t textureSlot) const;
 		virtual const void* GetTextureID() const =0;
 
 		GraphicsFormat GetTextureFormat() const { return m_specifications.textureFormat; }
@@ -85,6 +86,7 @@ namespace Engine
 		static bool CopyTexture(Texture& a, Texture& b);
 
 	protected:
+		virtual void Bind_Internal(uint32_t textureSlot) const =0;
 		bool LoadFromFile_Internal(const wchar_t* texturePath, const TextureSpecifications& specifications);
 		virtual bool LoadFromFile_Internal(const wchar_t* texturePath) =0;
 		virtual bool CopyTo(Texture& b) = 0;
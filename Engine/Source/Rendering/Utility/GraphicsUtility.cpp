@@ -2,6 +2,7 @@
 #include "GraphicsUtility.h"
 
 #include "ConstantBuffer.h"
+#include "GraphicsRenderer2D.h"
 #include "GraphicsRenderer3D.h"
 
 namespace Engine
@@ -27,4 +28,9 @@ namespace Engine
         Graphics::Utility::SetCameraConstants(cameraConstants, cBuffer);
         GraphicsRenderer3D::BindLights();
     }
-}
+
+    void Graphics::Utility::EndRenderScene()
+    {
+        GraphicsRenderer2D::Flush();
+    }
+}
\ No newline at end of file
@@ -36,8 +36,8 @@ namespace Engine
         void BeginRenderScene(const CameraConstants& cameraConstants, ConstantBuffer** cBuffer);
 
         /**
-         * @brief Ends rendering the scene.
+         * @brief Ends rendering the scene, draws the remaining sprite batch.
          */
-        static void EndRenderScene() { }
+        void EndRenderScene();
     }
 }
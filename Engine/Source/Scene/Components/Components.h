@@ -7,6 +7,7 @@
 #include "SceneCamera.h"
 #include "EntityHierarchyComponent.h"
 #include "LightingComponents.h"
+#include "MeshLODGroup.h"
 
 namespace Engine
 {
@@ -129,21 +130,34 @@ namespace Engine
 		bool enabled = true;
 		Mesh* mesh;
 		Material* material;
+		// When set, the mesh is selected from the LOD group each frame.
+		MeshLODGroup* lodGroup;
+		// The LOD that was selected last frame, keeps the selection stable near the thresholds.
+		uint32_t lodIndex;
 
 		explicit MeshComponent()
-			: mesh(), material() { }
+			: mesh(), material(), lodGroup(), lodIndex(0) { }
 		explicit MeshComponent(Mesh* mesh, Material* material)
-			: mesh(mesh), material(material) { }
+			: mesh(mesh), material(material), lodGroup(), lodIndex(0) { }
+		explicit MeshComponent(MeshLODGroup* lodGroup, Material* material)
+			: mesh(), material(material), lodGroup(lodGroup), lodIndex(0) { }
 
 		MeshComponent(const MeshComponent& mesh)
-			: mesh(mesh.mesh), material(mesh.material), enabled(mesh.enabled) { }
+			: mesh(mesh.mesh), material(mesh.material), lodGroup(mesh.lodGroup),
+			lodIndex(mesh.lodIndex), enabled(mesh.enabled) { }
 
 		MeshComponent& operator=(const MeshComponent& cpy)
 		{
 			mesh = cpy.mesh;
 			material = cpy.material;
+			lodGroup = cpy.lodGroup;
+			lodIndex = cpy.lodIndex;
 			enabled = cpy.enabled;
 			return *this;
 		}
+
+		bool HasLODs() const { return lodGroup != nullptr && lodGroup->GetNumLODs() > 0; }
+		// The most detailed mesh, used for the bounds & picking.
+		Mesh* GetBaseMesh() const { return HasLODs() ? lodGroup->GetMesh(0) : mesh; }
 	};
 }
@@ -14,11 +14,100 @@
 #include "GraphicsRenderer.h"
 #include "GraphicsRenderer2D.h"
 #include "GraphicsRenderer3D.h"
+#include "FrustumCulling.h"
+#include "ClusteredLighting.h"
+#include "LevelOfDetail.h"
+
+#include "Material.h"
+#include "Mesh.h"
+#include "JobManager.h"
+#include "RenderThread.h"
 
 #include <sstream>
 
 namespace Engine
 {
+	// The fewest meshes that are worth recording in a separate job.
+	static const uint32_t c_minEntriesPerCommandList = 1024;
+
+	// The sprites are unit quads centered on the origin.
+	static const MathLib::Vector3 c_spriteCorners[4] =
+	{
+		MathLib::Vector3(-0.5f, -0.5f, 0.0f),
+		MathLib::Vector3(0.5f, -0.5f, 0.0f),
+		MathLib::Vector3(0.5f, 0.5f, 0.0f),
+		MathLib::Vector3(-0.5f, 0.5f, 0.0f)
+	};
+	static const uint32_t c_spriteIndices[6] = { 0, 1, 2, 2, 3, 0 };
+
+	namespace
+	{
+		MathLib::Vector3 TransformPoint(const MathLib::Vector3& point, const MathLib::Matrix4x4& matrix)
+		{
+			MathLib::Vector4 transformed = MathLib::Vector4(point, 1.0f) * matrix;
+			return MathLib::Vector3(transformed.x, transformed.y, transformed.z);
+		}
+
+		/**
+		 * Casts the ray against the triangles, the ray is moved into object space rather
+		 * than moving each of the triangles into world space. Gets the world space distance
+		 * & point of the closest hit that's nearer than the max distance.
+		 */
+		bool RayCastTriangles(const MathLib::Vector3* positions, uint32_t numPositions,
+			const uint32_t* indices, uint32_t numIndices, const MathLib::Matrix4x4& objectToWorld,
+			const MathLib::Ray3D& ray, float maxDistance, float& outDistance, MathLib::Vector3& outPoint)
+		{
+			if (positions == nullptr)
+			{
+				return false;
+			}
+
+			MathLib::Matrix4x4 worldToObject = MathLib::Matrix4x4::InvertAffine(objectToWorld);
+			MathLib::Vector4 localDirection = MathLib::Vector4(ray.direction, 0.0f) * worldToObject;
+			MathLib::Ray3D localRay(TransformPoint(ray.startPoint, worldToObject),
+				MathLib::Vector3(localDirection.x, localDirection.y, localDirection.z));
+
+			bool hasHit = false;
+			// Meshes without indices are a list of triangles.
+			uint32_t numVertices = indices != nullptr ? numIndices : numPositions;
+			for (uint32_t i = 0; i + 2 < numVertices; i += 3)
+			{
+				uint32_t triangleIndices[3] = { i, i + 1, i + 2 };
+				if (indices != nullptr)
+				{
+					triangleIndices[0] = indices[i];
+					triangleIndices[1] = indices[i + 1];
+					triangleIndices[2] = indices[i + 2];
+					if (triangleIndices[0] >= numPositions
+						|| triangleIndices[1] >= numPositions
+						|| triangleIndices[2] >= numPositions)
+					{
+						continue;
+					}
+				}
+
+				MathLib::Triangle3D triangle(positions[triangleIndices[0]],
+					positions[triangleIndices[1]], positions[triangleIndices[2]]);
+				MathLib::Vector3 localPoint;
+				if (!triangle.Intersects(localRay, localPoint))
+				{
+					continue;
+				}
+
+				MathLib::Vector3 point = TransformPoint(localPoint, objectToWorld);
+				float distance = MathLib::Vector3::Dot(point - ray.startPoint, ray.direction);
+				if (distance < maxDistance)
+				{
+					maxDistance = distance;
+					outDistance = distance;
+					outPoint = point;
+					hasHit = true;
+				}
+			}
+			return hasHit;
+		}
+	}
+
     namespace SceneUtility::Internals
     {
         entt::registry& GetEntityRegistry(Scene& scene)
@@ -107,6 +196,8 @@ namespace Engine
 
 	Scene::~Scene()
 	{
+		// The render thread could still be rendering a frame of the scene.
+		RenderThread::FlushActive();
 	}
 
 	void Scene::OnEvent(IEvent& event)
@@ -145,10 +236,15 @@ namespace Engine
 
 		// Destroys the entities if they are marked for destroy.
 		{
+			if (!m_markedForDestroyEntities.empty())
+			{
+				RenderThread::FlushActive();
+			}
 			int32_t sizeOfVec = (int32_t)m_markedForDestroyEntities.size() - 1;
 			while (sizeOfVec >= 0)
 			{
 				m_entityRegistry.destroy(m_markedForDestroyEntities[sizeOfVec]);
+				m_transforms.SetHierarchyDirty();
 				m_markedForDestroyEntities.pop_back();
 				sizeOfVec--;
 			}
@@ -159,14 +255,14 @@ namespace Engine
 			auto entityView = m_entityRegistry.view<SceneCameraComponent, Transform3DComponent>();
 			for (auto entity : entityView)
 			{
-				auto [cameraComponent, transformComponent]
-					= entityView.get<SceneCameraComponent, Transform3DComponent>(entity);
+				SceneCameraComponent& cameraComponent
+					= entityView.get<SceneCameraComponent>(entity);
 				SceneCamera& sceneCam = cameraComponent.camera;
 
 				// The camera's view matrix is from world to camera,
 				// but the transform matrix is from object to world.
-				auto matrix = transformComponent.GetTransformMatrix();
-				matrix.Invert();
+				auto matrix = m_transforms.GetWorldMatrix(entity, SceneTransforms::TransformType::Transform3D);
+				matrix.InvertAffine();
 				sceneCam.SetViewMatrix(matrix);
 				sceneCam.UpdateProjectionMatrix();
 
@@ -178,24 +274,79 @@ namespace Engine
 				}
 			}
 		}
+	}
+
+	void Scene::OnRuntimeUpdate(const Timestep& ts)
+	{
+		PROFILE_SCOPE(RuntimeUpdate, Scene);
+	}
+
+	void Scene::OnEditorUpdate(const Timestep& ts)
+	{
+		PROFILE_SCOPE(EditorUpdate, Scene);
+	}
+
+	void Scene::Render(const CameraConstants& cameraConstants, ConstantBuffer** cameraBuffer)
+	{
+		PROFILE_SCOPE(SceneRender, Rendering);
+
+		GatherFramePacket(cameraConstants, m_framePacket);
+		StoreMeshLODs(m_framePacket);
+		RenderFramePacket(m_framePacket, cameraBuffer);
+	}
+
+	void Scene::Render(ConstantBuffer** cameraBuffer)
+	{
+		Render(GetCameraConstants(), cameraBuffer);
+	}
+
+	CameraConstants Scene::GetCameraConstants() const
+	{
+		CameraConstants constants;
+		{
+			if (m_camera != nullptr)
+			{
+				MathLib::Matrix4x4 mat = m_camera->GetViewMatrix();
+				mat.InvertAffine();
+
+				constants.c_cameraPosition = mat.GetTranslation();
+				constants.c_viewProjection =
+					m_camera->GetViewProjectionMatrix();
+			}
+		}
+		return constants;
+	}
 
-		// Applies the scene lights.
+	void Scene::GatherFramePacket(const CameraConstants& cameraConstants, FramePacket& framePacket) const
+	{
+		PROFILE_SCOPE(GatherFramePacket, Rendering);
+
+		framePacket.Clear();
+		framePacket.cameraConstants = cameraConstants;
+		GatherRenderList(framePacket.renderList);
+		SelectMeshLODs(cameraConstants, framePacket);
+
+		// Culls the items outside of the camera before they get sorted & recorded.
+		framePacket.numCulledItems += Graphics::Culling::CullRenderList(framePacket.renderList,
+			CullingFrustum::FromViewProjection(cameraConstants.c_viewProjection));
+
+		// Gathers the scene lights.
 		{
-			// Directional Light.
+			// Directional Light, the last one with a transform is used.
 			{
-				auto entityView = m_entityRegistry.view<DirectionalLightComponent>();
+				auto entityView = m_entityRegistry.view<const DirectionalLightComponent>();
 				int32_t size = (int32_t)entityView.size() - 1;
 				for (int32_t back = size; back >= 0; back--)
 				{
-					auto eid = entityView[back];
-					EntityRef e(entityView[back], m_entityRegistry);
-					DirectionalLightComponent& directionalLight = entityView.get<0>(
-						(entt::entity)e.GetEntity());
+					auto entity = entityView[back];
+					TEntityRef e(entity, m_entityRegistry);
 					if (e.HasComponent<Engine::Transform3DComponent>())
 					{
-						GraphicsRenderer3D::SetDirectionalLight(
-							e.GetComponent<Engine::Transform3DComponent>().GetWorldForward(),
-							directionalLight);
+						framePacket.hasDirectionalLight = true;
+						framePacket.directionalLightDirection
+							= Normalize(m_transforms.GetWorldMatrix(entity,
+								SceneTransforms::TransformType::Transform3D).GetZAxis());
+						framePacket.directionalLight = entityView.get<const DirectionalLightComponent>(entity);
 						break;
 					}
 				}
@@ -203,102 +354,271 @@ namespace Engine
 
 			// Point Lights.
 			{
-				auto entityView = m_entityRegistry.view<PointLightComponent, Transform3DComponent>();
+				auto entityView = m_entityRegistry.view<const PointLightComponent, const Transform3DComponent>();
 				for (auto e : entityView)
 				{
-					auto [pointLight, transform3D] = entityView.get<PointLightComponent, Transform3DComponent>(e);
-					if (!GraphicsRenderer3D::AddPointLight(transform3D.GetWorldPosition(), pointLight))
+					const PointLightComponent& pointLight = entityView.get<const PointLightComponent>(e);
+					if (pointLight.enabled)
 					{
-						break;
+						framePacket.pointLights.push_back({ m_transforms.GetWorldMatrix(e,
+							SceneTransforms::TransformType::Transform3D).GetTranslation(), pointLight });
 					}
 				}
 			}
 		}
+
+		// Bins the point lights into the clusters of the camera's view.
+		Graphics::Lighting::AssignLightsToClusters(cameraConstants.c_viewProjection,
+			framePacket.pointLights, framePacket.lightClusters);
 	}
 
-	void Scene::OnRuntimeUpdate(const Timestep& ts)
+	void Scene::SelectMeshLODs(const CameraConstants& cameraConstants, FramePacket& framePacket) const
 	{
-		PROFILE_SCOPE(RuntimeUpdate, Scene);
+		PROFILE_SCOPE(SelectMeshLODs, Rendering);
+
+		std::vector<MeshRenderItem>& meshes = framePacket.renderList.meshes;
+		Graphics::LevelOfDetail::SelectMeshLODs(meshes, cameraConstants.c_viewProjection);
+
+		// Records the selected LODs for the next frame & removes the groups that are too small to draw.
+		uint32_t numMeshes = 0;
+		for (uint32_t i = 0; i < (uint32_t)meshes.size(); i++)
+		{
+			MeshRenderItem& item = meshes[i];
+			if (item.lodGroup != nullptr)
+			{
+				framePacket.meshLODs.push_back({ item.entityID, item.lodIndex });
+				if (item.mesh == nullptr)
+				{
+					continue;
+				}
+			}
+			if (numMeshes != i)
+			{
+				meshes[numMeshes] = std::move(item);
+			}
+			numMeshes++;
+		}
+		framePacket.numCulledItems += (uint32_t)meshes.size() - numMeshes;
+		meshes.resize(numMeshes);
 	}
 
-	void Scene::OnEditorUpdate(const Timestep& ts)
+	void Scene::StoreMeshLODs(const FramePacket& framePacket)
 	{
-		PROFILE_SCOPE(EditorUpdate, Scene);
+		for (const FramePacketMeshLOD& meshLOD : framePacket.meshLODs)
+		{
+			MeshComponent* meshComponent = m_entityRegistry.try_get<MeshComponent>((entt::entity)meshLOD.entityID);
+			if (meshComponent != nullptr)
+			{
+				meshComponent->lodIndex = meshLOD.lodIndex;
+			}
+		}
 	}
 
-	void Scene::Render(const CameraConstants& cameraConstants, ConstantBuffer** cameraBuffer)
+	void Scene::RenderFramePacket(const FramePacket& framePacket, ConstantBuffer** cameraBuffer)
 	{
-		PROFILE_SCOPE(SceneRender, Rendering);
+		RenderFramePacket(framePacket, m_renderContext, cameraBuffer);
+	}
+
+	void Scene::RenderFramePacket(const FramePacket& framePacket,
+		FrameRenderContext& renderContext, ConstantBuffer** cameraBuffer)
+	{
+		PROFILE_SCOPE(RenderFramePacket, Rendering);
 
+		// Applies the scene lights, these get bound when the scene begins.
+		if (framePacket.hasDirectionalLight)
+		{
+			GraphicsRenderer3D::SetDirectionalLight(
+				framePacket.directionalLightDirection, framePacket.directionalLight);
+		}
+		GraphicsRenderer3D::SetPointLights(framePacket.pointLights, framePacket.lightClusters);
+
+		const CameraConstants& cameraConstants = framePacket.cameraConstants;
+		const SceneRenderList& renderList = framePacket.renderList;
 		Graphics::Utility::BeginRenderScene(cameraConstants, cameraBuffer);
 
-		// Render the meshes.
+		// Sorts the meshes by layer, shader, material, mesh & depth.
+		RenderQueue& renderQueue = renderContext.renderQueue;
+		std::vector<CommandList>& commandLists = renderContext.commandLists;
+		renderQueue.Clear();
+		for (uint32_t i = 0; i < (uint32_t)renderList.meshes.size(); i++)
 		{
-			m_entityRegistry.view<MeshComponent, Transform3DComponent>().each(
-				[](auto entity, MeshComponent& mesh, Transform3DComponent& transform)
+			const MeshRenderItem& item = renderList.meshes[i];
+			RenderQueueLayer layer = RenderQueueLayer_Opaque;
+			const Shader* shader = nullptr;
+			if (item.material)
+			{
+				layer = item.material->GetRenderQueueLayer();
+				shader = item.material->GetShader();
+			}
+			MathLib::Vector3 offset = item.objectToWorld.GetTranslation() - cameraConstants.c_cameraPosition;
+			renderQueue.Submit(layer, shader, item.material, item.mesh,
+				MathLib::Vector3::Dot(offset, offset), i);
+		}
+		renderQueue.Sort();
+
+		// Splits the sorted meshes into chunks that get recorded in parallel.
+		const std::vector<RenderQueueEntry>& entries = renderQueue.GetEntries();
+		uint32_t numEntries = (uint32_t)entries.size();
+		uint32_t numChunks = (numEntries + c_minEntriesPerCommandList - 1) / c_minEntriesPerCommandList;
+		numChunks = std::min(numChunks, JobManager::GetNumWorkers() + 1);
+		numChunks = std::max(numChunks, 1u);
+		if (commandLists.size() < numChunks)
+		{
+			commandLists.resize(numChunks);
+		}
+		uint32_t entriesPerChunk = (numEntries + numChunks - 1) / numChunks;
+
+		JobManager::ParallelFor(numChunks, [&](uint32_t chunk)
+			{
+				PROFILE_SCOPE(RecordCommandList, Rendering);
+
+				// The neighbouring meshes that share a mesh & material get merged into an instanced draw.
+				CommandList& commandList = commandLists[chunk];
+				commandList.Clear();
+				uint32_t chunkEnd = std::min(numEntries, (chunk + 1) * entriesPerChunk);
+				for (uint32_t i = chunk * entriesPerChunk; i < chunkEnd; i++)
 				{
-					if (!mesh.enabled) return;
+					const MeshRenderItem& item = renderList.meshes[entries[i].itemIndex];
+					commandList.DrawMesh(*item.mesh, item.material,
+						item.objectToWorld, item.entityID);
+				}
+			});
 
-					if (mesh.mesh)
-					{
-						// Draws the mesh with a material.
-						if (mesh.material)
-						{
-							GraphicsRenderer3D::DrawMesh(transform.GetTransformMatrix(),
-								*mesh.mesh, *mesh.material, (int32_t)entity);
-							return;
-						}
-						// Draws the mesh without a material.
-						GraphicsRenderer3D::DrawMesh(transform.GetTransformMatrix(),
-							*mesh.mesh, (int32_t)entity);
-					}
-				});
+		// The sprites are drawn after the meshes.
+		CommandList& lastCommandList = commandLists[numChunks - 1];
+		for (const SpriteRenderItem& item : renderList.sprites)
+		{
+			lastCommandList.DrawSprite(item.objectToWorld,
+				item.color, item.texture, item.entityID);
 		}
 
-		// Render the sprites.
+		// Submits in chunk order, so the draws don't depend on which job finished first.
+		for (uint32_t i = 0; i < numChunks; i++)
 		{
-			auto entityView = m_entityRegistry.view<SpriteComponent>();
+			commandLists[i].Submit();
+		}
+
+		Graphics::Utility::EndRenderScene();
+	}
+
+	void Scene::GatherRenderList(SceneRenderList& renderList) const
+	{
+		PROFILE_SCOPE(GatherRenderList, Rendering);
+
+		// Gathers the meshes.
+		{
+			auto entityView = m_entityRegistry.view<const MeshComponent, const Transform3DComponent>();
 			for (auto entity : entityView)
 			{
-				auto sprite = entityView.get<SpriteComponent>(entity);
-				if (!sprite.enabled) return;
+				const MeshComponent& mesh = entityView.get<const MeshComponent>(entity);
+				if (!mesh.enabled
+					|| (!mesh.mesh && !mesh.HasLODs()))
+				{
+					continue;
+				}
+
+				MeshRenderItem& item = renderList.meshes.emplace_back();
+				item.objectToWorld = m_transforms.GetWorldMatrix(entity, SceneTransforms::TransformType::Transform3D);
+				item.mesh = mesh.mesh;
+				item.material = mesh.material;
+				item.entityID = (int32_t)entity;
+				if (mesh.HasLODs())
+				{
+					item.lodGroup = mesh.lodGroup;
+					item.lodIndex = mesh.lodIndex;
+				}
+			}
+		}
+
+		// Gathers the sprites.
+		{
+			auto entityView = m_entityRegistry.view<const SpriteComponent>();
+			for (auto entity : entityView)
+			{
+				const SpriteComponent& sprite = entityView.get<const SpriteComponent>(entity);
+				if (!sprite.enabled) continue;
 
-				EntityRef e(entity, m_entityRegistry);
+				TEntityRef e(entity, m_entityRegistry);
+				// A sprite with both transforms is drawn with each of them.
 				if (e.HasComponent<Transform2DComponent>())
 				{
-					MathLib::Matrix4x4 transformMat =
-						e.GetComponent<Transform2DComponent>().GetTransformMatrix();
-					GraphicsRenderer2D::DrawRect(
-						transformMat, sprite.color, sprite.texture, (int32_t)entity);
+					SpriteRenderItem& item = renderList.sprites.emplace_back();
+					item.objectToWorld = m_transforms.GetWorldMatrix(entity, SceneTransforms::TransformType::Transform2D);
+					item.color = sprite.color;
+					item.texture = sprite.texture;
+					item.entityID = (int32_t)entity;
 				}
 				if (e.HasComponent<Transform3DComponent>())
 				{
-					MathLib::Matrix4x4 transformMat
-						= e.GetComponent<Transform3DComponent>().GetTransformMatrix();
-					GraphicsRenderer2D::DrawRect(
-						transformMat, sprite.color, sprite.texture, (int32_t)entity);
+					SpriteRenderItem& item = renderList.sprites.emplace_back();
+					item.objectToWorld = m_transforms.GetWorldMatrix(entity, SceneTransforms::TransformType::Transform3D);
+					item.color = sprite.color;
+					item.texture = sprite.texture;
+					item.entityID = (int32_t)entity;
 				}
 			}
 		}
-
-		Graphics::Utility::EndRenderScene();
 	}
 
-	void Scene::Render(ConstantBuffer** cameraBuffer)
+	bool Scene::RayCast(const MathLib::Ray3D& ray, SceneRayCastHit& outHit) const
 	{
-		CameraConstants constants;
-		{
-			if (m_camera != nullptr)
+		PROFILE_SCOPE(RayCast, Scene);
+
+		bool hasHit = false;
+		m_spatialIndex.RayCast(ray, [&](Entity entity, float maxDistance) -> float
 			{
-				MathLib::Matrix4x4 mat = m_camera->GetViewMatrix();
-				mat.Invert();
+				TEntityRef e((entt::entity)entity, m_entityRegistry);
+				if (!e.IsValid())
+				{
+					return maxDistance;
+				}
+				const bool hasTransform2D = e.HasComponent<Transform2DComponent>();
+				const bool hasTransform3D = e.HasComponent<Transform3DComponent>();
+				const MathLib::Matrix4x4& objectToWorld = m_transforms.GetWorldMatrix(
+					entity, SceneTransforms::TransformType::Transform3D);
+
+				float distance = maxDistance;
+				MathLib::Vector3 point;
+				bool hitEntity = false;
+				if (hasTransform3D && e.HasComponent<MeshComponent>())
+				{
+					const MeshComponent& mesh = e.GetComponent<MeshComponent>();
+					const Mesh* baseMesh = mesh.GetBaseMesh();
+					if (mesh.enabled && baseMesh != nullptr)
+					{
+						hitEntity |= RayCastTriangles(baseMesh->GetPositions(), baseMesh->GetVertexCount(),
+							baseMesh->GetIndices(), baseMesh->GetIndexCount(), objectToWorld,
+							ray, distance, distance, point);
+					}
+				}
+				// A sprite with both transforms is drawn with each of them.
+				if (e.HasComponent<SpriteComponent>()
+					&& e.GetComponent<SpriteComponent>().enabled)
+				{
+					if (hasTransform2D)
+					{
+						hitEntity |= RayCastTriangles(c_spriteCorners, 4, c_spriteIndices, 6,
+							m_transforms.GetWorldMatrix(entity, SceneTransforms::TransformType::Transform2D),
+							ray, distance, distance, point);
+					}
+					if (hasTransform3D)
+					{
+						hitEntity |= RayCastTriangles(c_spriteCorners, 4, c_spriteIndices, 6,
+							objectToWorld, ray, distance, distance, point);
+					}
+				}
 
-				constants.c_cameraPosition = mat.GetTranslation();
-				constants.c_viewProjection =
-					m_camera->GetViewProjectionMatrix();
-			}
-		}
-		Render(constants, cameraBuffer);
+				if (!hitEntity)
+				{
+					return maxDistance;
+				}
+				outHit.entity = entity;
+				outHit.point = point;
+				outHit.distance = distance;
+				hasHit = true;
+				return distance;
+			});
+		return hasHit;
 	}
 
 	Camera* Scene::GetCamera() const
@@ -334,6 +654,7 @@ namespace Engine
 		{
 			m_rootEntities.push_back(createdEntity);
 		}
+		m_transforms.SetHierarchyDirty();
 		EntityCreatedEvent createdEvent(createdEntity);
 		EventInvoker::Global().Invoke(createdEvent);
 		return createdEntityRef;
@@ -363,6 +684,7 @@ namespace Engine
 			m_rootEntities.push_back(createdEntity);
 		}
 
+		m_transforms.SetHierarchyDirty();
 		EntityCreatedEvent createdEvent(createdEntity);
 		EventInvoker::Global().Invoke(createdEvent);
 		return createdEntityRef;
@@ -443,6 +765,8 @@ namespace Engine
 
 	bool Scene::OnEntityHierarchyChanged(EntityHierarchyChangedEvent& event)
 	{
+		m_transforms.SetHierarchyDirty();
+
 		const auto& found = std::find(m_rootEntities.begin(),
 			m_rootEntities.end(), event.entityHierarchy.GetOwner());
 		if (found != m_rootEntities.end())
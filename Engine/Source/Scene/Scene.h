@@ -8,6 +8,10 @@
 #include "Transform.h"
 
 #include "EntityRef.h"
+#include "SceneRenderList.h"
+#include "FramePacket.h"
+#include "SceneSpatialIndex.h"
+#include "SceneTransforms.h"
 
 #include <vector>
 #include <string>
@@ -105,6 +109,56 @@ namespace Engine
 		}
 
         Scene* CopyScene();
+
+		/**
+		 * Gathers the meshes & sprites that should be rendered.
+		 */
+		void GatherRenderList(SceneRenderList& renderList) const;
+
+		CameraConstants GetCameraConstants() const;
+
+		/**
+		 * Gathers everything needed to render the scene, doesn't touch the graphics api
+		 * so it can run on the game thread while the previous frame is rendered.
+		 */
+		void GatherFramePacket(const CameraConstants& cameraConstants, FramePacket& framePacket) const;
+		/**
+		 * Stores the LODs selected in a gathered frame packet in the mesh components,
+		 * so the next frame starts from them. Must be called before the entities change.
+		 */
+		void StoreMeshLODs(const FramePacket& framePacket);
+		/**
+		 * Renders a gathered frame packet with the scene's own render context,
+		 * must be called from the thread that owns the graphics api.
+		 */
+		void RenderFramePacket(const FramePacket& framePacket, ConstantBuffer** cBuffer);
+		/**
+		 * Renders a gathered frame packet without touching any scene, so the render thread
+		 * can render it while the game thread updates. Only one packet can be rendered
+		 * with a render context at a time.
+		 */
+		static void RenderFramePacket(const FramePacket& framePacket,
+			FrameRenderContext& renderContext, ConstantBuffer** cBuffer);
+
+		/**
+		 * The world matrices of the entities, updated by the entity hierarchy system.
+		 */
+		SceneTransforms& GetTransforms() { return m_transforms; }
+		const SceneTransforms& GetTransforms() const { return m_transforms; }
+
+		/**
+		 * The bounding volume hierarchy of the entities, for ray casts & overlap queries.
+		 * Only kept up to date while the spatial index system is added.
+		 */
+		SceneSpatialIndex& GetSpatialIndex() { return m_spatialIndex; }
+		const SceneSpatialIndex& GetSpatialIndex() const { return m_spatialIndex; }
+
+		/**
+		 * Casts the ray against the triangles of the meshes & sprites in the spatial index,
+		 * returns true if an entity was hit & gets the closest hit. Runs on the CPU, so
+		 * it doesn't need the graphics api. The ray's direction should be normalized.
+		 */
+		bool RayCast(const MathLib::Ray3D& ray, SceneRayCastHit& outHit) const;
         
 	private:
 		void OnUpdate(const Timestep& ts);
@@ -114,6 +168,9 @@ namespace Engine
 		void Render(const CameraConstants& cameraConstants, ConstantBuffer** cBuffer);
 		void Render(ConstantBuffer** cBuffer);
 
+		// Selects the meshes of the LOD groups in the frame packet for the camera.
+		void SelectMeshLODs(const CameraConstants& cameraConstants, FramePacket& framePacket) const;
+
 		bool OnEntityHierarchyChanged(EntityHierarchyChangedEvent& event);
 
 	private:
@@ -122,6 +179,11 @@ namespace Engine
 		std::vector<entt::entity> m_markedForDestroyEntities;
 		entt::registry m_entityRegistry;
 		std::wstring m_sceneName;
+		// Only used when the scene gets rendered on the calling thread.
+		FramePacket m_framePacket;
+		FrameRenderContext m_renderContext;
+		SceneSpatialIndex m_spatialIndex;
+		SceneTransforms m_transforms;
 
 	public:
 		static void CreateDefaultScene(Scene*& scene);
@@ -10,11 +10,15 @@
 #include "Profiler.h"
 
 #include "ConstantBuffer.h"
+#include "FramePacket.h"
+#include "RenderThread.h"
 
 namespace Engine
 {
 	static Scene* s_activeScene = nullptr;
 	static ConstantBuffer* c_cameraBuffer = nullptr;
+	// Used by whichever thread renders the frame packets.
+	static FrameRenderContext s_renderContext;
 
 	void SceneManager::Init()
 	{
@@ -121,4 +125,24 @@ namespace Engine
 			c_cameraBuffer = *refCpy;
 		}
 	}
+
+	void SceneManager::GatherFramePacket(FramePacket& framePacket)
+	{
+		if (s_activeScene != nullptr)
+		{
+			s_activeScene->GatherFramePacket(s_activeScene->GetCameraConstants(), framePacket);
+			s_activeScene->StoreMeshLODs(framePacket);
+		}
+		else
+		{
+			framePacket.Clear();
+		}
+	}
+
+	void SceneManager::RenderFramePacket(const FramePacket& framePacket)
+	{
+		ConstantBuffer** refCpy = &c_cameraBuffer;
+		Scene::RenderFramePacket(framePacket, s_renderContext, refCpy);
+		c_cameraBuffer = *refCpy;
+	}
 }
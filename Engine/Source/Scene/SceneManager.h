@@ -9,6 +9,7 @@ namespace Engine
 	class Timestep;
 	class Entity;
 	class IEvent;
+	struct FramePacket;
 
 	using EventFunc = std::function<void(IEvent&)>;
 
@@ -32,6 +33,9 @@ namespace Engine
 		static void Render();
 		static void Render(const struct CameraConstants& cameraConstants);
 
-		friend class Application;
+		// Splits Render into the game side gather & the graphics side render, for the render thread.
+		static void GatherFramePacket(FramePacket& framePacket);
+		// Doesn't touch the active scene, so it can run while the game thread updates it.
+		static void RenderFramePacket(const FramePacket& framePacket);
 	};
 }
\ No newline at end of file
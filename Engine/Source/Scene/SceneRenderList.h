@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Vector.h"
+
+#include <vector>
+
+namespace Engine
+{
+	class Mesh;
+	class MeshLODGroup;
+	class Material;
+	class Texture;
+
+	// A mesh that is ready to be submitted to the renderer.
+	struct MeshRenderItem
+	{
+		MathLib::Matrix4x4 objectToWorld;
+		Mesh* mesh = nullptr;
+		Material* material = nullptr;
+		int32_t entityID = -1;
+		// The mesh is selected from the LOD group, starting from the LOD of the last frame.
+		const MeshLODGroup* lodGroup = nullptr;
+		uint32_t lodIndex = 0;
+	};
+
+	// A sprite that is ready to be submitted to the renderer.
+	struct SpriteRenderItem
+	{
+		MathLib::Matrix4x4 objectToWorld;
+		MathLib::Vector4 color = MathLib::Vector4::One;
+		Texture* texture = nullptr;
+		int32_t entityID = -1;
+	};
+
+	/**
+	 * The list of renderable items gathered from the scene. Gathering
+	 * doesn't touch the graphics api, so it can run headless.
+	 */
+	struct SceneRenderList
+	{
+		std::vector<MeshRenderItem> meshes;
+		std::vector<SpriteRenderItem> sprites;
+
+		// Clears the items but keeps the capacity.
+		void Clear()
+		{
+			meshes.clear();
+			sprites.clear();
+		}
+
+		size_t GetNumItems() const { return meshes.size() + sprites.size(); }
+	};
+}
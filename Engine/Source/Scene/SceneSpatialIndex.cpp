@@ -0,0 +1,97 @@
+#include "EnginePCH.h"
+#include "SceneSpatialIndex.h"
+
+#include "FrustumCulling.h"
+#include "Profiler.h"
+
+namespace Engine
+{
+
+	SceneSpatialIndex::SceneSpatialIndex()
+		: m_hierarchy(),
+		m_entityProxies(),
+		m_updateIndex(0)
+	{
+	}
+
+	void SceneSpatialIndex::Clear()
+	{
+		m_hierarchy.Clear();
+		m_entityProxies.clear();
+	}
+
+	void SceneSpatialIndex::BeginUpdate()
+	{
+		m_updateIndex++;
+	}
+
+	void SceneSpatialIndex::SubmitEntity(Entity entity, const MathLib::Vector3& min, const MathLib::Vector3& max)
+	{
+		EntityProxy& entityProxy = m_entityProxies[(uint32_t)(entt::entity)entity];
+		if (entityProxy.lastUpdate == m_updateIndex)
+		{
+			entityProxy.min = Min(entityProxy.min, min);
+			entityProxy.max = Max(entityProxy.max, max);
+			return;
+		}
+		entityProxy.lastUpdate = m_updateIndex;
+		entityProxy.min = min;
+		entityProxy.max = max;
+	}
+
+	void SceneSpatialIndex::EndUpdate()
+	{
+		PROFILE_SCOPE(UpdateSpatialIndex, Scene);
+
+		for (auto it = m_entityProxies.begin(); it != m_entityProxies.end();)
+		{
+			EntityProxy& entityProxy = it->second;
+			if (entityProxy.lastUpdate != m_updateIndex)
+			{
+				// The entity was destroyed or no longer has bounds.
+				if (entityProxy.proxy != BoundingVolumeHierarchy::c_nullNode)
+				{
+					m_hierarchy.DestroyProxy(entityProxy.proxy);
+				}
+				it = m_entityProxies.erase(it);
+				continue;
+			}
+
+			if (entityProxy.proxy == BoundingVolumeHierarchy::c_nullNode)
+			{
+				entityProxy.proxy = m_hierarchy.CreateProxy(entityProxy.min, entityProxy.max, it->first);
+			}
+			else
+			{
+				m_hierarchy.MoveProxy(entityProxy.proxy, entityProxy.min, entityProxy.max);
+			}
+			++it;
+		}
+
+		if (m_hierarchy.NeedsRebuild())
+		{
+			PROFILE_SCOPE(RebuildSpatialIndex, Scene);
+			m_hierarchy.Rebuild();
+		}
+	}
+
+	void SceneSpatialIndex::QueryAABB(const MathLib::Rect3D& bounds, std::vector<Entity>& outEntities) const
+	{
+		std::vector<uint32_t> userData;
+		m_hierarchy.QueryAABB(bounds.GetMin(), bounds.GetMax(), userData);
+		for (uint32_t entity : userData)
+		{
+			outEntities.push_back(Entity(entity));
+		}
+	}
+
+	void SceneSpatialIndex::QueryFrustum(const CullingFrustum& frustum, std::vector<Entity>& outEntities) const
+	{
+		std::vector<uint32_t> userData;
+		m_hierarchy.QueryFrustum(frustum, userData);
+		for (uint32_t entity : userData)
+		{
+			outEntities.push_back(Entity(entity));
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "BoundingVolumeHierarchy.h"
+#include "Entity.h"
+#include "Shape3D.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+	struct CullingFrustum;
+
+	// The closest entity hit by a scene ray cast.
+	struct SceneRayCastHit
+	{
+		Entity entity;
+		MathLib::Vector3 point;
+		float distance = 0.0f;
+	};
+
+	/**
+	 * The spatial index of a scene, a bounding volume hierarchy over the world bounds
+	 * of its entities. It's kept up to date by the spatial index system, each update
+	 * resubmits the bounds of the entities & the entities that weren't submitted are removed.
+	 */
+	class SceneSpatialIndex
+	{
+	public:
+		explicit SceneSpatialIndex();
+
+		void Clear();
+
+		void BeginUpdate();
+		// Submits the world bounds of the entity, the bounds are merged if it's submitted more than once.
+		void SubmitEntity(Entity entity, const MathLib::Vector3& min, const MathLib::Vector3& max);
+		// Applies the submitted bounds to the hierarchy & rebuilds it when needed.
+		void EndUpdate();
+
+		uint32_t GetNumEntities() const { return m_hierarchy.GetNumProxies(); }
+		const BoundingVolumeHierarchy& GetHierarchy() const { return m_hierarchy; }
+
+		void QueryAABB(const MathLib::Rect3D& bounds, std::vector<Entity>& outEntities) const;
+		void QueryFrustum(const CullingFrustum& frustum, std::vector<Entity>& outEntities) const;
+
+		/**
+		 * Casts the ray through the entity bounds, nearest first. The func is called
+		 * as func(entity, maxDistance) & returns the new max distance.
+		 */
+		template<typename TFunc>
+		void RayCast(const MathLib::Ray3D& ray, const TFunc& func) const
+		{
+			m_hierarchy.RayCast(ray, [&func](uint32_t userData, float maxDistance) -> float
+				{
+					return func(Entity(userData), maxDistance);
+				});
+		}
+
+	private:
+		struct EntityProxy
+		{
+			int32_t proxy = BoundingVolumeHierarchy::c_nullNode;
+			uint32_t lastUpdate = 0;
+			MathLib::Vector3 min;
+			MathLib::Vector3 max;
+		};
+
+	private:
+		BoundingVolumeHierarchy m_hierarchy;
+		std::unordered_map<uint32_t, EntityProxy> m_entityProxies;
+		uint32_t m_updateIndex;
+	};
+}
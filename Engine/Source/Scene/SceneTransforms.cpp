@@ -0,0 +1,340 @@
+#include "EnginePCH.h"
+#include "SceneTransforms.h"
+
+#include "JobManager.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+namespace Engine
+{
+	// The minimum number of nodes a job updates, fewer nodes are updated on the calling thread.
+	static const uint32_t c_minNodesPerUpdateChunk = 1024;
+	// Larger subtrees are updated a depth level at a time, so that
+	// a single large hierarchy is split across the workers too.
+	static const uint32_t c_minNodesPerLargeSubtree = 8 * c_minNodesPerUpdateChunk;
+
+	SceneTransforms::SceneTransforms()
+		: m_nodes(),
+		m_numRoots(0),
+		m_subtreeBatches(),
+		m_subtreeLevels(),
+		m_entityNodes(),
+		m_localMatrices(),
+		m_worldMatrices(),
+		m_localVersions(),
+		m_transformTypes(),
+		m_prevTransformTypes(),
+		m_changedNodes(),
+		m_secondaryMatrices(),
+		m_secondaryNodes(),
+		m_secondaryIndices(),
+		m_isHierarchyDirty(true),
+		m_isFullUpdate(true)
+	{
+	}
+
+	void SceneTransforms::Clear()
+	{
+		m_nodes.clear();
+		m_numRoots = 0;
+		m_subtreeBatches.clear();
+		m_subtreeLevels.clear();
+		m_entityNodes.clear();
+		m_localMatrices.clear();
+		m_worldMatrices.clear();
+		m_localVersions.clear();
+		m_transformTypes.clear();
+		m_prevTransformTypes.clear();
+		m_changedNodes.clear();
+		m_secondaryMatrices.clear();
+		m_secondaryNodes.clear();
+		m_secondaryIndices.clear();
+		m_isHierarchyDirty = true;
+		m_isFullUpdate = true;
+	}
+
+	void SceneTransforms::BeginHierarchy()
+	{
+		m_nodes.clear();
+		m_numRoots = 0;
+		m_subtreeBatches.clear();
+		m_subtreeLevels.clear();
+		std::fill(m_entityNodes.begin(), m_entityNodes.end(), c_invalidNode);
+	}
+
+	void SceneTransforms::AddNode(Entity entity, Entity parent)
+	{
+		if (entity == Entity::None)
+		{
+			return;
+		}
+
+		Node node;
+		node.entity = entity;
+		node.parent = GetNode(parent);
+		node.level = node.parent != c_invalidNode ? m_nodes[node.parent].level + 1 : 0;
+
+		uint32_t index = GetIndex(entity);
+		if (index >= (uint32_t)m_entityNodes.size())
+		{
+			m_entityNodes.resize(index + 1, c_invalidNode);
+		}
+		m_entityNodes[index] = (uint32_t)m_nodes.size();
+		m_nodes.push_back(node);
+	}
+
+	void SceneTransforms::EndHierarchy()
+	{
+		// A subtree starts at each root & ends at the next one.
+		uint32_t numNodes = (uint32_t)m_nodes.size();
+		uint32_t subtreeBegin = 0;
+		for (uint32_t i = 1; i <= numNodes; i++)
+		{
+			if (i == numNodes || m_nodes[i].parent == c_invalidNode)
+			{
+				AddSubtree(subtreeBegin, i);
+				subtreeBegin = i;
+			}
+		}
+
+		m_localMatrices.resize(numNodes);
+		m_worldMatrices.resize(numNodes);
+		m_localVersions.resize(numNodes);
+		m_transformTypes.resize(numNodes);
+		m_prevTransformTypes.resize(numNodes);
+		m_changedNodes.resize(numNodes);
+		m_secondaryMatrices.clear();
+		m_secondaryNodes.clear();
+		m_secondaryIndices.assign(numNodes, c_invalidNode);
+		m_isHierarchyDirty = false;
+		// The nodes moved, so the kept matrices & versions belong to other entities.
+		m_isFullUpdate = true;
+	}
+
+	void SceneTransforms::AddSubtree(uint32_t begin, uint32_t end)
+	{
+		m_numRoots++;
+		if (end - begin < c_minNodesPerLargeSubtree)
+		{
+			// Appends the subtree to the last batch until the batch is big enough for a job.
+			if (!m_subtreeBatches.empty()
+				&& m_subtreeBatches.back().end == begin
+				&& m_subtreeBatches.back().end - m_subtreeBatches.back().begin < c_minNodesPerUpdateChunk)
+			{
+				m_subtreeBatches.back().end = end;
+			}
+			else
+			{
+				m_subtreeBatches.push_back({ begin, end });
+			}
+			return;
+		}
+
+		// The subtree's nodes are sorted by depth, so a level starts wherever the depth changes.
+		for (uint32_t i = begin; i < end; i++)
+		{
+			if (i == begin || m_nodes[i].level != m_nodes[i - 1].level)
+			{
+				m_subtreeLevels.push_back({ i, i });
+			}
+			m_subtreeLevels.back().end = i + 1;
+		}
+	}
+
+	void SceneTransforms::BeginUpdate()
+	{
+		m_prevTransformTypes.swap(m_transformTypes);
+		std::fill(m_transformTypes.begin(), m_transformTypes.end(), TransformType::None);
+		std::fill(m_changedNodes.begin(), m_changedNodes.end(), (uint8_t)0);
+		for (uint32_t node : m_secondaryNodes)
+		{
+			m_secondaryIndices[node] = c_invalidNode;
+		}
+		m_secondaryMatrices.clear();
+		m_secondaryNodes.clear();
+	}
+
+	void SceneTransforms::SetLocalTransform(Entity entity, const MathLib::Transform3D& transform)
+	{
+		SetLocalTransform(entity, transform, TransformType::Transform3D);
+	}
+
+	void SceneTransforms::SetLocalTransform(Entity entity, const MathLib::Transform2D& transform)
+	{
+		SetLocalTransform(entity, transform, TransformType::Transform2D);
+	}
+
+	template<typename TTransform>
+	void SceneTransforms::SetLocalTransform(Entity entity, const TTransform& transform, TransformType type)
+	{
+		uint32_t node = GetNode(entity);
+		if (node == c_invalidNode)
+		{
+			return;
+		}
+
+		// The local matrix is still the one from the last update, so it isn't rebuilt.
+		if (!m_isFullUpdate
+			&& m_transformTypes[node] == TransformType::None
+			&& m_prevTransformTypes[node] == type
+			&& m_localVersions[node] == transform.GetVersion())
+		{
+			m_transformTypes[node] = type;
+			return;
+		}
+		SetLocalMatrix(node, transform.GetLocalTransformMatrix(), type, transform.GetVersion());
+	}
+
+	void SceneTransforms::SetLocalMatrix(uint32_t node, const MathLib::Matrix4x4& localMatrix,
+		TransformType type, uint32_t version)
+	{
+		// The node has both transforms, the 3D matrix is kept as the secondary matrix.
+		TransformType prevType = m_transformTypes[node];
+		if (prevType != TransformType::None && prevType != type)
+		{
+			m_secondaryIndices[node] = (uint32_t)m_secondaryMatrices.size();
+			m_secondaryNodes.push_back(node);
+			if (type == TransformType::Transform3D)
+			{
+				m_secondaryMatrices.push_back(localMatrix);
+				return;
+			}
+			m_secondaryMatrices.push_back(m_localMatrices[node]);
+		}
+		m_localMatrices[node] = localMatrix;
+		m_localVersions[node] = version;
+		m_transformTypes[node] = type;
+		m_changedNodes[node] = 1;
+	}
+
+	void SceneTransforms::UpdateWorldMatrices()
+	{
+		PROFILE_SCOPE(UpdateWorldMatrices, Scene);
+
+		// The batches of subtrees don't depend on each other, so they're split across the workers.
+		uint32_t numBatches = (uint32_t)m_subtreeBatches.size();
+		uint32_t numChunks = std::min(numBatches, JobManager::GetNumWorkers() + 1);
+		uint32_t batchesPerChunk = numChunks > 0 ? (numBatches + numChunks - 1) / numChunks : 0;
+		auto updateBatches = [&](uint32_t chunk)
+		{
+			uint32_t chunkEnd = std::min(numBatches, (chunk + 1) * batchesPerChunk);
+			for (uint32_t i = chunk * batchesPerChunk; i < chunkEnd; i++)
+			{
+				UpdateWorldMatrices(m_subtreeBatches[i].begin, m_subtreeBatches[i].end);
+			}
+		};
+		if (numChunks > 1)
+		{
+			JobManager::ParallelFor(numChunks, updateBatches);
+		}
+		else if (numChunks > 0)
+		{
+			updateBatches(0);
+		}
+
+		// The nodes of a level only read the world matrices of the previous levels.
+		for (const NodeRange& level : m_subtreeLevels)
+		{
+			uint32_t numNodes = level.end - level.begin;
+			uint32_t numLevelChunks = (numNodes + c_minNodesPerUpdateChunk - 1) / c_minNodesPerUpdateChunk;
+			numLevelChunks = std::min(numLevelChunks, JobManager::GetNumWorkers() + 1);
+			if (numLevelChunks > 1)
+			{
+				uint32_t nodesPerChunk = (numNodes + numLevelChunks - 1) / numLevelChunks;
+				JobManager::ParallelFor(numLevelChunks, [&](uint32_t chunk)
+					{
+						uint32_t chunkBegin = level.begin + chunk * nodesPerChunk;
+						UpdateWorldMatrices(chunkBegin, std::min(level.end, chunkBegin + nodesPerChunk));
+					});
+			}
+			else
+			{
+				UpdateWorldMatrices(level.begin, level.end);
+			}
+		}
+
+		// The parents' world matrices are all up to date by now. These are rare,
+		// so they're recomputed every update instead of tracking their changes.
+		for (uint32_t i = 0; i < (uint32_t)m_secondaryNodes.size(); i++)
+		{
+			uint32_t parent = m_nodes[m_secondaryNodes[i]].parent;
+			if (parent != c_invalidNode)
+			{
+				m_secondaryMatrices[i] = m_secondaryMatrices[i] * m_worldMatrices[parent];
+			}
+		}
+		m_isFullUpdate = false;
+	}
+
+	void SceneTransforms::UpdateWorldMatrices(uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			TransformType type = m_transformTypes[i];
+			uint32_t parent = m_nodes[i].parent;
+			// The parent comes before the node, so its changed flag is already final.
+			if (!m_isFullUpdate
+				&& !m_changedNodes[i]
+				&& type == m_prevTransformTypes[i]
+				&& (parent == c_invalidNode || !m_changedNodes[parent]))
+			{
+				continue;
+			}
+			m_changedNodes[i] = 1;
+
+			MathLib::Matrix4x4& matrix = m_worldMatrices[i];
+			if (type == TransformType::None)
+			{
+				matrix = MathLib::Matrix4x4::Identity;
+			}
+			else if (parent != c_invalidNode)
+			{
+				// Matches the transforms' GetTransformMatrix, the 2D transforms apply the parent first.
+				const MathLib::Matrix4x4& parentMatrix = m_worldMatrices[parent];
+				matrix = type == TransformType::Transform2D
+					? parentMatrix * m_localMatrices[i] : m_localMatrices[i] * parentMatrix;
+			}
+			else
+			{
+				matrix = m_localMatrices[i];
+			}
+		}
+	}
+
+	const MathLib::Matrix4x4& SceneTransforms::GetWorldMatrix(Entity entity) const
+	{
+		uint32_t node = GetNode(entity);
+		if (node == c_invalidNode)
+		{
+			return MathLib::Matrix4x4::Identity;
+		}
+		return m_worldMatrices[node];
+	}
+
+	const MathLib::Matrix4x4& SceneTransforms::GetWorldMatrix(Entity entity, TransformType type) const
+	{
+		uint32_t node = GetNode(entity);
+		if (node == c_invalidNode)
+		{
+			return MathLib::Matrix4x4::Identity;
+		}
+		if (type == TransformType::Transform3D
+			&& m_secondaryIndices[node] != c_invalidNode)
+		{
+			return m_secondaryMatrices[m_secondaryIndices[node]];
+		}
+		return m_worldMatrices[node];
+	}
+
+	uint32_t SceneTransforms::GetNode(Entity entity) const
+	{
+		uint32_t index = GetIndex(entity);
+		if (entity == Entity::None
+			|| index >= (uint32_t)m_entityNodes.size())
+		{
+			return c_invalidNode;
+		}
+		return m_entityNodes[index];
+	}
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Entity.h"
+#include "Matrix.h"
+#include "Transform.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+
+	/**
+	 * The world matrices of a scene's entities. Kept out of the transform components so that
+	 * they only hold the local position, rotation & scale. The hierarchy is flattened into an
+	 * array of nodes, one root's subtree after another & each subtree sorted by depth, so a
+	 * parent's world matrix is always computed before its children's in a linear pass. The
+	 * subtrees don't depend on each other, so batches of them get updated by separate jobs.
+	 * An entity with both transforms gets a world matrix for each of them, its children are
+	 * relative to the 2D transform's. Only the nodes whose transform, transform type or parent
+	 * changed since the last update are recomputed, the transforms' versions tell which changed.
+	 * Only kept up to date while the entity hierarchy system is added.
+	 */
+	class SceneTransforms
+	{
+	public:
+		// Decides the order that the local matrix is combined with the parent's world matrix.
+		enum class TransformType : uint8_t
+		{
+			None,
+			Transform3D,
+			Transform2D
+		};
+
+		static constexpr uint32_t c_invalidNode = UINT32_MAX;
+
+	public:
+		explicit SceneTransforms();
+
+		void Clear();
+
+		// Marks the hierarchy to get rebuilt, should be called whenever an entity's parent changes.
+		void SetHierarchyDirty() { m_isHierarchyDirty = true; }
+		bool IsHierarchyDirty() const { return m_isHierarchyDirty; }
+
+		/**
+		 * Rebuilds the hierarchy, the nodes are added one root's subtree at a time, starting
+		 * with the root, then its children, then its grand children & so on. The parent is
+		 * Entity::None for the roots & must have already been added for the other nodes.
+		 */
+		void BeginHierarchy();
+		void AddNode(Entity entity, Entity parent);
+		void EndHierarchy();
+
+		/**
+		 * Updates the world matrices, the local transforms are set between begin & update.
+		 * The nodes without a local transform get the identity as their world matrix.
+		 * When a node gets both, the 2D transform becomes the one its children are relative to,
+		 * setting the 2D transforms first keeps the unchanged nodes from being recomputed.
+		 */
+		void BeginUpdate();
+		void SetLocalTransform(Entity entity, const MathLib::Transform3D& transform);
+		void SetLocalTransform(Entity entity, const MathLib::Transform2D& transform);
+		void UpdateWorldMatrices();
+
+		// Gets the entity's world matrix, the identity if it isn't in the hierarchy.
+		const MathLib::Matrix4x4& GetWorldMatrix(Entity entity) const;
+		// Gets the world matrix of the entity's transform of the type, for the entities with both transforms.
+		const MathLib::Matrix4x4& GetWorldMatrix(Entity entity, TransformType type) const;
+
+		uint32_t GetNumNodes() const { return (uint32_t)m_nodes.size(); }
+		uint32_t GetNumRoots() const { return m_numRoots; }
+
+		// Gets the index of the entity in the node lookup, the entity's version isn't included.
+		static uint32_t GetIndex(Entity entity) { return (uint32_t)entt::to_entity((entt::entity)entity); }
+
+	private:
+		struct Node
+		{
+			Entity entity;
+			uint32_t parent = c_invalidNode;
+			uint32_t level = 0;
+		};
+
+		// A range of nodes that only depend on nodes before the range.
+		struct NodeRange
+		{
+			uint32_t begin = 0;
+			uint32_t end = 0;
+		};
+
+		uint32_t GetNode(Entity entity) const;
+		void AddSubtree(uint32_t begin, uint32_t end);
+		template<typename TTransform>
+		void SetLocalTransform(Entity entity, const TTransform& transform, TransformType type);
+		void SetLocalMatrix(uint32_t node, const MathLib::Matrix4x4& localMatrix,
+			TransformType type, uint32_t version);
+		void UpdateWorldMatrices(uint32_t begin, uint32_t end);
+
+	private:
+		std::vector<Node> m_nodes;
+		uint32_t m_numRoots;
+		// The small subtrees grouped into batches that are updated as a whole.
+		std::vector<NodeRange> m_subtreeBatches;
+		// The depth levels of the large subtrees, each level is split across the workers.
+		std::vector<NodeRange> m_subtreeLevels;
+		// The node of each entity, indexed by the entity's index.
+		std::vector<uint32_t> m_entityNodes;
+
+		// Indexed by the node, the local matrices are kept so that an unchanged
+		// node only needs its parent's world matrix when the parent changed.
+		std::vector<MathLib::Matrix4x4> m_localMatrices;
+		std::vector<MathLib::Matrix4x4> m_worldMatrices;
+		// The version of the transform that the local matrix was built from.
+		std::vector<uint32_t> m_localVersions;
+		std::vector<TransformType> m_transformTypes;
+		std::vector<TransformType> m_prevTransformTypes;
+		// Set for the nodes whose world matrix changed this update, uint8_t so the jobs can write them.
+		std::vector<uint8_t> m_changedNodes;
+		// The 3D matrices of the nodes that also have a 2D matrix, these are rare so they're kept apart.
+		std::vector<MathLib::Matrix4x4> m_secondaryMatrices;
+		std::vector<uint32_t> m_secondaryNodes;
+		// Indexed by the node, the index of the node's secondary matrix.
+		std::vector<uint32_t> m_secondaryIndices;
+
+		bool m_isHierarchyDirty;
+		// The nodes got rebuilt, so every world matrix gets recomputed on the next update.
+		bool m_isFullUpdate;
+	};
+}
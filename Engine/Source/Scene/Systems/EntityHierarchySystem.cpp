@@ -3,96 +3,81 @@
 #include "EntityHierarchySystem.h"
 
 #include "Scene.h"
+#include "Components.h"
 #include "Matrix.h"
+#include "Profiler.h"
 
 namespace Engine
 {
 	namespace EHS::Internal
 	{
 
-		template<typename TRegistry = entt::registry>
-		void UpdateEntityHierarchies(Entity& rootEntity, EntityHierarchyComponent& rootComponent, TRegistry& registry)
+		// Flattens the hierarchies one root at a time, each subtree breadth first so it's sorted by depth.
+		void RebuildHierarchy(SceneTransforms& transforms, entt::registry& registry)
 		{
-			if (!rootComponent.HasChildren())
-			{
-				return;
-			}
+			PROFILE_SCOPE(RebuildHierarchy, Scene);
 
-			TEntityRef<TRegistry> rootEntityRef(rootEntity, registry);
-			MathLib::Matrix4x4 mat = MathLib::Matrix4x4::Identity;
+			auto entityView = registry.view<const EntityHierarchyComponent>();
+			std::vector<Entity> subtree;
+			transforms.BeginHierarchy();
+			for (auto root : entityView)
 			{
-				if (rootEntity.HasComponent<Transform3DComponent, TRegistry>(registry))
-				{
-					mat = rootEntity.GetComponent<Transform3DComponent>(registry).GetTransformMatrix();
-				}
-				if (rootEntity.HasComponent<Transform2DComponent, TRegistry>(registry))
+				if (entityView.get<const EntityHierarchyComponent>(root).HasParent(registry))
 				{
-					mat = rootEntity.GetComponent<Transform2DComponent, TRegistry>(registry).GetTransformMatrix();
+					continue;
 				}
-			}
-
-			int32_t size = (int32_t)rootComponent.GetChildren().size() - 1;
-			for (int32_t i = size; i >= 0; i--)
-			{
-				auto entity = rootComponent.GetChildren()[i];
-				TEntityRef<TRegistry> e(entity, registry);
 
-				if (e.template HasComponent<Transform3DComponent>())
+				subtree.clear();
+				subtree.push_back(Entity(root));
+				for (size_t i = 0; i < subtree.size(); i++)
 				{
-					Transform3DComponent& component
-						= e.template GetComponent<Transform3DComponent>();
-					component.SetParentTransformMatrix(mat);
-				}
-
-				if (e.template HasComponent<Transform2DComponent>())
-				{
-					Transform2DComponent& component
-						= e.template GetComponent<Transform2DComponent>();
-					component.SetParentTransformMatrix(mat);
-				}
-
-				if (e.template HasComponent<EntityHierarchyComponent>())
-				{
-					EntityHierarchyComponent& hierarchyComponent
-						= e.template GetComponent<EntityHierarchyComponent>();
-					UpdateEntityHierarchies<TRegistry>(entity, hierarchyComponent, registry);
+					const Entity entity = subtree[i];
+					const EntityHierarchyComponent& component = entityView.get<const EntityHierarchyComponent>((entt::entity)entity);
+					transforms.AddNode(entity, i > 0 ? component.GetParent() : Entity::None);
+					for (const Entity& child : component.GetChildren())
+					{
+						// The destroyed children aren't removed from their parent.
+						if (child.IsValid(registry))
+						{
+							subtree.push_back(child);
+						}
+					}
 				}
 			}
+			transforms.EndHierarchy();
 		}
+	}
+
+	void EntityHierarchySystem::InvokeOnUpdate(const UpdateSystemContext& context)
+	{
+		Scene& scene = context.scene;
+		entt::registry& registry = UpdateSystem::Internals::GetEntityRegistry(scene);
+		SceneTransforms& transforms = scene.GetTransforms();
 
-		void UpdateHierarchies(EntityRef& reference, EntityHierarchyComponent& component)
+		// Entities that get copied in don't invoke the hierarchy changed event, so the count is checked too.
+		if (transforms.IsHierarchyDirty()
+			|| transforms.GetNumNodes() != (uint32_t)registry.view<const EntityHierarchyComponent>().size())
 		{
-			const MathLib::Matrix4x4& identity = MathLib::Matrix4x4::Identity;
+			EHS::Internal::RebuildHierarchy(transforms, registry);
+		}
 
-			if (reference.HasComponent<Transform3DComponent>())
+		transforms.BeginUpdate();
+		// An entity with both transforms gets both world matrices, its children use the 2D one.
+		// The 2D transforms are set first, so that the 3D transform doesn't replace an unchanged 2D one.
+		{
+			auto entityView = registry.view<const Transform2DComponent>();
+			for (auto entity : entityView)
 			{
-				Transform3DComponent& transform3D = reference.GetComponent<Transform3DComponent>();
-				if (transform3D.GetParentTransformMatrix() != identity)
-				{
-					transform3D.SetParentTransformMatrix(identity);
-				}
+				transforms.SetLocalTransform(entity, entityView.get<const Transform2DComponent>(entity));
 			}
-			else if (reference.HasComponent<Transform2DComponent>())
-			{
-				Transform2DComponent& transform2D = reference.GetComponent<Transform2DComponent>();
-				if (transform2D.GetParentTransformMatrix() != identity)
-				{
-					transform2D.SetParentTransformMatrix(identity);
-				}
-			}
-
-			Entity rootEntity = reference.GetEntity();
-			UpdateEntityHierarchies(rootEntity, component, reference.GetRegistry());
 		}
-	}
-
-	void EntityHierarchySystem::OnUpdate(const UpdateSystemContext& context, EntityRef& entity, Components& components)
-	{
-		EntityHierarchyComponent& component = GetComponent<0>(components);
-		if (component.HasParent(entity.GetRegistry()))
 		{
-			return;
+			auto entityView = registry.view<const Transform3DComponent>();
+			for (auto entity : entityView)
+			{
+				transforms.SetLocalTransform(entity, entityView.get<const Transform3DComponent>(entity));
+			}
 		}
-		EHS::Internal::UpdateHierarchies(entity, component);
+		transforms.UpdateWorldMatrices();
 	}
 }
@@ -1,21 +1,19 @@
 #pragma once
 
-#include "EntityHierarchyComponent.h"
 #include "IUpdateSystem.h"
-#include "IEventSystem.h"
 
 namespace Engine
 {
 
 	/**
-	 * The entity hierarchy system. 
+	 * The entity hierarchy system, updates the world matrices of the scene's transforms.
+	 * The hierarchy is flattened into the roots' subtrees whenever it changes, so the world
+	 * matrices get computed in one pass from the roots down to their children, with the
+	 * independent subtrees updated in parallel.
 	 */
-	class EntityHierarchySystem : public IUpdateSystem<EntityHierarchyComponent>
+	class EntityHierarchySystem : public IUpdateSystemBase
 	{
-	protected:
-		/**
-		 * Updates the entity hierarchy system. 
-		 */
-		void OnUpdate(const UpdateSystemContext& context, EntityRef& entity, Components& components) override;
+	public:
+		void InvokeOnUpdate(const UpdateSystemContext& context) override;
 	};
-}
\ No newline at end of file
+}
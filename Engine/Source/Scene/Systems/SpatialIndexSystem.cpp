@@ -0,0 +1,78 @@
+#include "EnginePCH.h"
+#include "SpatialIndexSystem.h"
+
+#include "Scene.h"
+#include "Components.h"
+#include "Mesh.h"
+#include "FrustumCulling.h"
+
+namespace Engine
+{
+	// The sprites are unit quads centered on the origin.
+	static const MathLib::Vector3 c_spriteLocalExtents = MathLib::Vector3(0.5f, 0.5f, 0.0f);
+
+	void SpatialIndexSystem::InvokeOnUpdate(const UpdateSystemContext& context)
+	{
+		Scene& scene = context.scene;
+		entt::registry& registry = UpdateSystem::Internals::GetEntityRegistry(scene);
+		SceneSpatialIndex& spatialIndex = scene.GetSpatialIndex();
+		const SceneTransforms& transforms = scene.GetTransforms();
+
+		spatialIndex.BeginUpdate();
+
+		// Submits the meshes.
+		{
+			auto entityView = registry.view<const MeshComponent, const Transform3DComponent>();
+			for (auto entity : entityView)
+			{
+				const MeshComponent& mesh = entityView.get<const MeshComponent>(entity);
+				Mesh* baseMesh = mesh.GetBaseMesh();
+				if (!mesh.enabled
+					|| !baseMesh
+					|| !baseMesh->HasLocalBounds())
+				{
+					continue;
+				}
+
+				const MathLib::Rect3D& localBounds = baseMesh->GetLocalBounds();
+				MathLib::Vector3 center, extents;
+				Graphics::Culling::TransformBounds(
+					transforms.GetWorldMatrix(entity, SceneTransforms::TransformType::Transform3D),
+					localBounds.center, localBounds.size * 0.5f, center, extents);
+				spatialIndex.SubmitEntity(entity, center - extents, center + extents);
+			}
+		}
+
+		// Submits the sprites, a sprite with both transforms is drawn with each of them.
+		{
+			auto submitSprite = [&](entt::entity entity, SceneTransforms::TransformType type)
+			{
+				MathLib::Vector3 center, extents;
+				Graphics::Culling::TransformBounds(transforms.GetWorldMatrix(entity, type),
+					MathLib::Vector3::Zero, c_spriteLocalExtents, center, extents);
+				spatialIndex.SubmitEntity(entity, center - extents, center + extents);
+			};
+
+			auto entityView = registry.view<const SpriteComponent>();
+			for (auto entity : entityView)
+			{
+				const SpriteComponent& sprite = entityView.get<const SpriteComponent>(entity);
+				if (!sprite.enabled)
+				{
+					continue;
+				}
+
+				if (registry.any_of<Transform2DComponent>(entity))
+				{
+					submitSprite(entity, SceneTransforms::TransformType::Transform2D);
+				}
+				if (registry.any_of<Transform3DComponent>(entity))
+				{
+					submitSprite(entity, SceneTransforms::TransformType::Transform3D);
+				}
+			}
+		}
+
+		spatialIndex.EndUpdate();
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "IUpdateSystem.h"
+
+namespace Engine
+{
+
+	/**
+	 * Keeps the scene's spatial index up to date with the world bounds of the meshes
+	 * & sprites. Should be added after the entity hierarchy system, so that the bounds
+	 * use the updated world matrices.
+	 */
+	class SpatialIndexSystem : public IUpdateSystemBase
+	{
+	public:
+		void InvokeOnUpdate(const UpdateSystemContext& context) override;
+	};
+}
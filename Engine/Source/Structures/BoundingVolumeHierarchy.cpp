@@ -0,0 +1,499 @@
+#include "EnginePCH.h"
+#include "BoundingVolumeHierarchy.h"
+
+#include "FrustumCulling.h"
+
+namespace Engine
+{
+	// The number of bins the centroids are sorted into when rebuilding.
+	static const uint32_t c_numRebuildBins = 12;
+	// The fewest changes before the tree is worth rebuilding.
+	static const uint32_t c_minChangesBeforeRebuild = 64;
+
+	namespace
+	{
+		float GetSurfaceArea(const MathLib::Vector3& min, const MathLib::Vector3& max)
+		{
+			MathLib::Vector3 size = max - min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		float GetCombinedSurfaceArea(const BoundingVolumeHierarchyNode& a, const BoundingVolumeHierarchyNode& b)
+		{
+			return GetSurfaceArea(Min(a.min, b.min), Max(a.max, b.max));
+		}
+
+		bool Contains(const BoundingVolumeHierarchyNode& node, const MathLib::Vector3& min, const MathLib::Vector3& max)
+		{
+			return node.min.x <= min.x && node.min.y <= min.y && node.min.z <= min.z
+				&& node.max.x >= max.x && node.max.y >= max.y && node.max.z >= max.z;
+		}
+
+		bool Overlaps(const BoundingVolumeHierarchyNode& node, const MathLib::Vector3& min, const MathLib::Vector3& max)
+		{
+			return node.min.x <= max.x && node.min.y <= max.y && node.min.z <= max.z
+				&& node.max.x >= min.x && node.max.y >= min.y && node.max.z >= min.z;
+		}
+
+		float GetAxis(const MathLib::Vector3& vector, uint32_t axis)
+		{
+			return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+		}
+
+		/**
+		 * Visits the proxies, descending into the nodes that pass the test.
+		 */
+		template<typename TTestFunc>
+		void Query(const std::vector<BoundingVolumeHierarchyNode>& nodes, int32_t root,
+			const TTestFunc& test, std::vector<uint32_t>& outUserData)
+		{
+			if (root == BoundingVolumeHierarchy::c_nullNode)
+			{
+				return;
+			}
+
+			std::vector<int32_t> stack;
+			stack.reserve(64);
+			stack.push_back(root);
+			while (!stack.empty())
+			{
+				const BoundingVolumeHierarchyNode& node = nodes[stack.back()];
+				stack.pop_back();
+				if (!test(node))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					outUserData.push_back(node.userData);
+					continue;
+				}
+				stack.push_back(node.children[0]);
+				stack.push_back(node.children[1]);
+			}
+		}
+	}
+
+	BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+		: m_nodes(),
+		m_root(c_nullNode),
+		m_freeNode(c_nullNode),
+		m_numProxies(0),
+		m_numChangesSinceRebuild(0)
+	{
+	}
+
+	void BoundingVolumeHierarchy::Clear()
+	{
+		m_nodes.clear();
+		m_root = c_nullNode;
+		m_freeNode = c_nullNode;
+		m_numProxies = 0;
+		m_numChangesSinceRebuild = 0;
+	}
+
+	int32_t BoundingVolumeHierarchy::CreateProxy(const MathLib::Vector3& min, const MathLib::Vector3& max, uint32_t userData)
+	{
+		const MathLib::Vector3 margin(c_boundsMargin, c_boundsMargin, c_boundsMargin);
+
+		int32_t proxy = AllocateNode();
+		BoundingVolumeHierarchyNode& node = m_nodes[proxy];
+		node.min = min - margin;
+		node.max = max + margin;
+		node.userData = userData;
+
+		InsertLeaf(proxy);
+		m_numProxies++;
+		m_numChangesSinceRebuild++;
+		return proxy;
+	}
+
+	void BoundingVolumeHierarchy::DestroyProxy(int32_t proxy)
+	{
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		m_numProxies--;
+	}
+
+	bool BoundingVolumeHierarchy::MoveProxy(int32_t proxy, const MathLib::Vector3& min, const MathLib::Vector3& max)
+	{
+		BoundingVolumeHierarchyNode& node = m_nodes[proxy];
+		if (Contains(node, min, max))
+		{
+			return false;
+		}
+
+		// Refits the ancestors rather than reinserting the leaf, the rebuild restores the quality.
+		const MathLib::Vector3 margin(c_boundsMargin, c_boundsMargin, c_boundsMargin);
+		node.min = min - margin;
+		node.max = max + margin;
+		Refit(node.parent);
+		m_numChangesSinceRebuild++;
+		return true;
+	}
+
+	void BoundingVolumeHierarchy::Rebuild()
+	{
+		m_numChangesSinceRebuild = 0;
+		if (m_root == c_nullNode)
+		{
+			return;
+		}
+
+		// Frees the internal nodes, the leaves keep their ids.
+		std::vector<int32_t> leaves;
+		leaves.reserve(m_numProxies);
+		std::vector<int32_t> stack;
+		stack.push_back(m_root);
+		while (!stack.empty())
+		{
+			int32_t index = stack.back();
+			stack.pop_back();
+			const BoundingVolumeHierarchyNode& node = m_nodes[index];
+			if (node.IsLeaf())
+			{
+				leaves.push_back(index);
+				continue;
+			}
+			stack.push_back(node.children[0]);
+			stack.push_back(node.children[1]);
+			FreeNode(index);
+		}
+
+		m_root = Build(leaves, 0, (uint32_t)leaves.size());
+		m_nodes[m_root].parent = c_nullNode;
+	}
+
+	bool BoundingVolumeHierarchy::NeedsRebuild() const
+	{
+		return m_numChangesSinceRebuild >= std::max(c_minChangesBeforeRebuild, m_numProxies / 4);
+	}
+
+	uint32_t BoundingVolumeHierarchy::GetHeight() const
+	{
+		return m_root == c_nullNode ? 0 : GetHeight(m_root);
+	}
+
+	float BoundingVolumeHierarchy::GetCost() const
+	{
+		if (m_root == c_nullNode)
+		{
+			return 0.0f;
+		}
+
+		float rootArea = GetSurfaceArea(m_nodes[m_root].min, m_nodes[m_root].max);
+		float area = 0.0f;
+		std::vector<int32_t> stack;
+		stack.push_back(m_root);
+		while (!stack.empty())
+		{
+			const BoundingVolumeHierarchyNode& node = m_nodes[stack.back()];
+			stack.pop_back();
+			if (node.IsLeaf())
+			{
+				continue;
+			}
+			area += GetSurfaceArea(node.min, node.max);
+			stack.push_back(node.children[0]);
+			stack.push_back(node.children[1]);
+		}
+		return rootArea > 0.0f ? area / rootArea : 0.0f;
+	}
+
+	void BoundingVolumeHierarchy::QueryAABB(const MathLib::Vector3& min, const MathLib::Vector3& max,
+		std::vector<uint32_t>& outUserData) const
+	{
+		Query(m_nodes, m_root, [&min, &max](const BoundingVolumeHierarchyNode& node) -> bool
+			{
+				return Overlaps(node, min, max);
+			}, outUserData);
+	}
+
+	void BoundingVolumeHierarchy::QueryFrustum(const CullingFrustum& frustum, std::vector<uint32_t>& outUserData) const
+	{
+		Query(m_nodes, m_root, [&frustum](const BoundingVolumeHierarchyNode& node) -> bool
+			{
+				return frustum.IsVisible((node.min + node.max) * 0.5f, (node.max - node.min) * 0.5f);
+			}, outUserData);
+	}
+
+	BoundingVolumeHierarchy::RayCastContext BoundingVolumeHierarchy::CreateRayCastContext(const MathLib::Ray3D& ray)
+	{
+		// Dividing by a zero component gives an infinite slab, which is the expected result.
+		RayCastContext context;
+		context.origin = ray.startPoint;
+		context.inverseDirection = MathLib::Vector3(1.0f / ray.direction.x,
+			1.0f / ray.direction.y, 1.0f / ray.direction.z);
+		context.maxDistance = ray.IsInfinite() ? FLT_MAX : ray.distance;
+		return context;
+	}
+
+	bool BoundingVolumeHierarchy::IntersectsRay(const RayCastContext& context,
+		const BoundingVolumeHierarchyNode& node, float& outDistance)
+	{
+		float entry = 0.0f;
+		float exit = context.maxDistance;
+		for (uint32_t axis = 0; axis < 3; axis++)
+		{
+			float origin = GetAxis(context.origin, axis);
+			float inverseDirection = GetAxis(context.inverseDirection, axis);
+			float t0 = (GetAxis(node.min, axis) - origin) * inverseDirection;
+			float t1 = (GetAxis(node.max, axis) - origin) * inverseDirection;
+			if (t0 > t1)
+			{
+				std::swap(t0, t1);
+			}
+			// Written so that the nans from 0 * infinity are ignored.
+			entry = t0 > entry ? t0 : entry;
+			exit = t1 < exit ? t1 : exit;
+		}
+		outDistance = entry;
+		return entry <= exit;
+	}
+
+	int32_t BoundingVolumeHierarchy::AllocateNode()
+	{
+		int32_t index;
+		if (m_freeNode != c_nullNode)
+		{
+			index = m_freeNode;
+			m_freeNode = m_nodes[index].parent;
+		}
+		else
+		{
+			index = (int32_t)m_nodes.size();
+			m_nodes.emplace_back();
+		}
+
+		BoundingVolumeHierarchyNode& node = m_nodes[index];
+		node.parent = c_nullNode;
+		node.children[0] = c_nullNode;
+		node.children[1] = c_nullNode;
+		node.userData = 0;
+		return index;
+	}
+
+	void BoundingVolumeHierarchy::FreeNode(int32_t node)
+	{
+		m_nodes[node].parent = m_freeNode;
+		m_freeNode = node;
+	}
+
+	void BoundingVolumeHierarchy::InsertLeaf(int32_t leaf)
+	{
+		if (m_root == c_nullNode)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = c_nullNode;
+			return;
+		}
+
+		// Descends towards the sibling that increases the surface area the least.
+		int32_t index = m_root;
+		while (!m_nodes[index].IsLeaf())
+		{
+			const BoundingVolumeHierarchyNode& node = m_nodes[index];
+			const BoundingVolumeHierarchyNode& leafNode = m_nodes[leaf];
+			float area = GetSurfaceArea(node.min, node.max);
+			float combinedArea = GetCombinedSurfaceArea(node, leafNode);
+
+			// The cost of pairing the leaf with this node.
+			float cost = 2.0f * combinedArea;
+			// The cost that's added to the ancestors when descending further.
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			float childCosts[2];
+			for (uint32_t i = 0; i < 2; i++)
+			{
+				const BoundingVolumeHierarchyNode& child = m_nodes[node.children[i]];
+				float childCombinedArea = GetCombinedSurfaceArea(child, leafNode);
+				childCosts[i] = child.IsLeaf() ? childCombinedArea + inheritanceCost
+					: childCombinedArea - GetSurfaceArea(child.min, child.max) + inheritanceCost;
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+			{
+				break;
+			}
+			index = node.children[childCosts[1] < childCosts[0] ? 1 : 0];
+		}
+
+		// Creates a parent for the leaf & its sibling, allocating might move the nodes.
+		int32_t sibling = index;
+		int32_t oldParent = m_nodes[sibling].parent;
+		int32_t newParent = AllocateNode();
+		BoundingVolumeHierarchyNode& parentNode = m_nodes[newParent];
+		parentNode.parent = oldParent;
+		parentNode.children[0] = sibling;
+		parentNode.children[1] = leaf;
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		if (oldParent == c_nullNode)
+		{
+			m_root = newParent;
+		}
+		else
+		{
+			BoundingVolumeHierarchyNode& oldParentNode = m_nodes[oldParent];
+			oldParentNode.children[oldParentNode.children[0] == sibling ? 0 : 1] = newParent;
+		}
+		Refit(newParent);
+	}
+
+	void BoundingVolumeHierarchy::RemoveLeaf(int32_t leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = c_nullNode;
+			return;
+		}
+
+		// Replaces the parent with the leaf's sibling.
+		int32_t parent = m_nodes[leaf].parent;
+		const BoundingVolumeHierarchyNode& parentNode = m_nodes[parent];
+		int32_t grandParent = parentNode.parent;
+		int32_t sibling = parentNode.children[parentNode.children[0] == leaf ? 1 : 0];
+		FreeNode(parent);
+
+		m_nodes[sibling].parent = grandParent;
+		if (grandParent == c_nullNode)
+		{
+			m_root = sibling;
+			return;
+		}
+
+		BoundingVolumeHierarchyNode& grandParentNode = m_nodes[grandParent];
+		grandParentNode.children[grandParentNode.children[0] == parent ? 0 : 1] = sibling;
+		Refit(grandParent);
+	}
+
+	void BoundingVolumeHierarchy::Refit(int32_t node)
+	{
+		while (node != c_nullNode)
+		{
+			BoundingVolumeHierarchyNode& current = m_nodes[node];
+			const BoundingVolumeHierarchyNode& a = m_nodes[current.children[0]];
+			const BoundingVolumeHierarchyNode& b = m_nodes[current.children[1]];
+			current.min = Min(a.min, b.min);
+			current.max = Max(a.max, b.max);
+			node = current.parent;
+		}
+	}
+
+	int32_t BoundingVolumeHierarchy::Build(std::vector<int32_t>& leaves, uint32_t begin, uint32_t end)
+	{
+		uint32_t count = end - begin;
+		if (count == 1)
+		{
+			return leaves[begin];
+		}
+
+		// Bins the leaves along the longest axis of their centroids.
+		MathLib::Vector3 centroidMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		MathLib::Vector3 centroidMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (uint32_t i = begin; i < end; i++)
+		{
+			const BoundingVolumeHierarchyNode& leaf = m_nodes[leaves[i]];
+			MathLib::Vector3 centroid = (leaf.min + leaf.max) * 0.5f;
+			centroidMin = Min(centroidMin, centroid);
+			centroidMax = Max(centroidMax, centroid);
+		}
+		MathLib::Vector3 centroidSize = centroidMax - centroidMin;
+		uint32_t axis = centroidSize.x > centroidSize.y ? 0 : 1;
+		axis = GetAxis(centroidSize, 2) > GetAxis(centroidSize, axis) ? 2 : axis;
+		float axisMin = GetAxis(centroidMin, axis);
+		float axisSize = GetAxis(centroidSize, axis);
+
+		// Splits in the middle if the centroids are all in the same place.
+		uint32_t middle = begin + count / 2;
+		if (axisSize > 0.0f)
+		{
+			struct Bin
+			{
+				MathLib::Vector3 min = MathLib::Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+				MathLib::Vector3 max = MathLib::Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+				uint32_t count = 0;
+			};
+			Bin bins[c_numRebuildBins];
+			auto getBin = [&](int32_t leafIndex) -> uint32_t
+			{
+				const BoundingVolumeHierarchyNode& leaf = m_nodes[leafIndex];
+				float centroid = GetAxis((leaf.min + leaf.max) * 0.5f, axis);
+				uint32_t bin = (uint32_t)((centroid - axisMin) / axisSize * (float)c_numRebuildBins);
+				return std::min(bin, c_numRebuildBins - 1);
+			};
+			for (uint32_t i = begin; i < end; i++)
+			{
+				const BoundingVolumeHierarchyNode& leaf = m_nodes[leaves[i]];
+				Bin& bin = bins[getBin(leaves[i])];
+				bin.min = Min(bin.min, leaf.min);
+				bin.max = Max(bin.max, leaf.max);
+				bin.count++;
+			}
+
+			// Sweeps from the right to get the area of each right side, then from the left.
+			float rightCosts[c_numRebuildBins];
+			{
+				Bin right;
+				for (uint32_t i = c_numRebuildBins - 1; i > 0; i--)
+				{
+					right.min = Min(right.min, bins[i].min);
+					right.max = Max(right.max, bins[i].max);
+					right.count += bins[i].count;
+					rightCosts[i] = right.count > 0 ?
+						GetSurfaceArea(right.min, right.max) * (float)right.count : 0.0f;
+				}
+			}
+
+			float bestCost = FLT_MAX;
+			uint32_t bestSplit = 0;
+			Bin left;
+			for (uint32_t i = 0; i < c_numRebuildBins - 1; i++)
+			{
+				left.min = Min(left.min, bins[i].min);
+				left.max = Max(left.max, bins[i].max);
+				left.count += bins[i].count;
+				if (left.count <= 0 || left.count >= count)
+				{
+					continue;
+				}
+				float cost = GetSurfaceArea(left.min, left.max) * (float)left.count + rightCosts[i + 1];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = i;
+				}
+			}
+
+			if (bestCost < FLT_MAX)
+			{
+				auto split = std::partition(leaves.begin() + begin, leaves.begin() + end,
+					[&](int32_t leafIndex) { return getBin(leafIndex) <= bestSplit; });
+				middle = (uint32_t)(split - leaves.begin());
+			}
+		}
+
+		int32_t children[2] = { Build(leaves, begin, middle), Build(leaves, middle, end) };
+		int32_t index = AllocateNode();
+		BoundingVolumeHierarchyNode& node = m_nodes[index];
+		node.children[0] = children[0];
+		node.children[1] = children[1];
+		node.min = Min(m_nodes[children[0]].min, m_nodes[children[1]].min);
+		node.max = Max(m_nodes[children[0]].max, m_nodes[children[1]].max);
+		m_nodes[children[0]].parent = index;
+		m_nodes[children[1]].parent = index;
+		return index;
+	}
+
+	uint32_t BoundingVolumeHierarchy::GetHeight(int32_t node) const
+	{
+		const BoundingVolumeHierarchyNode& current = m_nodes[node];
+		if (current.IsLeaf())
+		{
+			return 1;
+		}
+		return 1 + std::max(GetHeight(current.children[0]), GetHeight(current.children[1]));
+	}
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Vector.h"
+#include "Geometry3D.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+	struct CullingFrustum;
+
+	struct BoundingVolumeHierarchyNode
+	{
+		MathLib::Vector3 min;
+		MathLib::Vector3 max;
+		int32_t parent;
+		// Both children are null for leaves.
+		int32_t children[2];
+		uint32_t userData;
+
+		bool IsLeaf() const { return children[0] < 0; }
+	};
+
+	/**
+	 * A dynamic axis aligned bounding volume hierarchy. Each proxy is a leaf with a
+	 * fattened box, so small movements don't change the tree. The leaves that move
+	 * outside of their box are refit in place, which gradually lowers the quality
+	 * of the tree until it gets rebuilt top down with the surface area heuristic.
+	 *
+	 * The proxies keep their ids across rebuilds.
+	 */
+	class BoundingVolumeHierarchy
+	{
+	public:
+		static const int32_t c_nullNode = -1;
+		// The distance the leaf boxes are extended by on each side.
+		static constexpr float c_boundsMargin = 0.1f;
+
+	public:
+		explicit BoundingVolumeHierarchy();
+
+		void Clear();
+
+		int32_t CreateProxy(const MathLib::Vector3& min, const MathLib::Vector3& max, uint32_t userData);
+		void DestroyProxy(int32_t proxy);
+		/**
+		 * Moves the proxy, returns true if the proxy moved
+		 * outside of its fattened box & the tree was refit.
+		 */
+		bool MoveProxy(int32_t proxy, const MathLib::Vector3& min, const MathLib::Vector3& max);
+
+		uint32_t GetUserData(int32_t proxy) const { return m_nodes[proxy].userData; }
+		const BoundingVolumeHierarchyNode& GetNode(int32_t node) const { return m_nodes[node]; }
+		int32_t GetRoot() const { return m_root; }
+		uint32_t GetNumProxies() const { return m_numProxies; }
+
+		/**
+		 * Rebuilds the internal nodes with a binned surface area heuristic.
+		 */
+		void Rebuild();
+		// Whether enough proxies were refit or inserted since the last rebuild.
+		bool NeedsRebuild() const;
+
+		// The height of the tree, a single leaf has a height of 1.
+		uint32_t GetHeight() const;
+		/**
+		 * The surface area heuristic cost of the tree, the sum of the
+		 * internal node areas relative to the root's area.
+		 */
+		float GetCost() const;
+
+		// Gets the user data of the proxies that overlap the box.
+		void QueryAABB(const MathLib::Vector3& min, const MathLib::Vector3& max, std::vector<uint32_t>& outUserData) const;
+		// Gets the user data of the proxies that are inside or intersect the frustum.
+		void QueryFrustum(const CullingFrustum& frustum, std::vector<uint32_t>& outUserData) const;
+
+		/**
+		 * Casts the ray through the tree, visiting the nearest nodes first. The func
+		 * is called for each proxy whose box the ray hits, as func(userData, maxDistance)
+		 * & returns the new max distance, such as the distance of the closest hit so far.
+		 * The distances are in units of the ray's direction, which should be normalized.
+		 */
+		template<typename TFunc>
+		void RayCast(const MathLib::Ray3D& ray, const TFunc& func) const
+		{
+			if (m_root == c_nullNode)
+			{
+				return;
+			}
+
+			RayCastContext context = CreateRayCastContext(ray);
+			struct StackEntry
+			{
+				int32_t node;
+				float distance;
+			};
+			std::vector<StackEntry> stack;
+			stack.reserve(64);
+
+			float distance;
+			if (!IntersectsRay(context, m_nodes[m_root], distance))
+			{
+				return;
+			}
+			stack.push_back({ m_root, distance });
+			while (!stack.empty())
+			{
+				StackEntry entry = stack.back();
+				stack.pop_back();
+				// The max distance might have shrunk since the node was pushed.
+				if (entry.distance > context.maxDistance)
+				{
+					continue;
+				}
+
+				const BoundingVolumeHierarchyNode& node = m_nodes[entry.node];
+				if (node.IsLeaf())
+				{
+					context.maxDistance = std::min(context.maxDistance,
+						(float)func(node.userData, context.maxDistance));
+					continue;
+				}
+
+				float distances[2];
+				bool hits[2];
+				for (uint32_t i = 0; i < 2; i++)
+				{
+					hits[i] = IntersectsRay(context, m_nodes[node.children[i]], distances[i]);
+				}
+				// Pushes the nearest child last, so that it's visited first.
+				uint32_t nearest = distances[1] < distances[0] ? 1 : 0;
+				uint32_t farthest = 1 - nearest;
+				if (hits[farthest])
+				{
+					stack.push_back({ node.children[farthest], distances[farthest] });
+				}
+				if (hits[nearest])
+				{
+					stack.push_back({ node.children[nearest], distances[nearest] });
+				}
+			}
+		}
+
+	private:
+		struct RayCastContext
+		{
+			MathLib::Vector3 origin;
+			MathLib::Vector3 inverseDirection;
+			float maxDistance;
+		};
+
+		static RayCastContext CreateRayCastContext(const MathLib::Ray3D& ray);
+		// Gets the distance that the ray enters the box.
+		static bool IntersectsRay(const RayCastContext& context,
+			const BoundingVolumeHierarchyNode& node, float& outDistance);
+
+		int32_t AllocateNode();
+		void FreeNode(int32_t node);
+
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+		// Recalculates the boxes of the node & its ancestors.
+		void Refit(int32_t node);
+
+		int32_t Build(std::vector<int32_t>& leaves, uint32_t begin, uint32_t end);
+		uint32_t GetHeight(int32_t node) const;
+
+	private:
+		std::vector<BoundingVolumeHierarchyNode> m_nodes;
+		int32_t m_root;
+		// The free nodes are linked through their parent.
+		int32_t m_freeNode;
+		uint32_t m_numProxies;
+		uint32_t m_numChangesSinceRebuild;
+	};
+}
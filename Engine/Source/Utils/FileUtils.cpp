@@ -30,7 +30,10 @@ namespace Engine
 			delete cwdBuffer;
 			return outBuffer;
 #elif PLATFORM_LINUX
-			getcwd(cwdBuffer, _MAX_PATH);
+			char linuxCwdBuffer[PATH_MAX];
+			cwdBuffer = getcwd(linuxCwdBuffer, PATH_MAX);
+			if (cwdBuffer == nullptr) return "";
+			return std::string(cwdBuffer);
 #endif
 			return "";
 	}
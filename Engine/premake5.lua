@@ -13,7 +13,7 @@ project "Engine"
 
 	filter { "system:Windows" }
 		pchheader "EnginePCH.h"
-	filter { "system:MacOSx" }
+	filter { "system:MacOSx or Linux" }
 		pchheader "%{prj.location}/Source/EnginePCH.h"
 	filter { }
 
@@ -43,6 +43,13 @@ project "Engine"
 			"%{prj.location}/Source/Platform/Metal/**.hpp",
 			"%{prj.location}/Source/Platform/Metal/**.mm"
 		}
+	-- Removes the null rendering api files from workspace
+	filter { "options:not graphicsapi=none" }
+		removefiles
+		{
+			"%{prj.location}/Source/Platform/Null/**.h",
+			"%{prj.location}/Source/Platform/Null/**.cpp"
+		}
 	filter { }
 
 	includedirs
@@ -91,6 +98,11 @@ project "Engine"
 		runtime "Release"
 	filter { }
 
+	-- Compiles the AVX2 paths when built with --simd=avx2.
+	filter { "options:simd=avx2" }
+		vectorextensions "AVX2"
+	filter { }
+
 	-- 	Additional Platform Defines (Win32)
 	filter { "platforms:Win32" }
 		defines
@@ -109,6 +121,12 @@ project "Engine"
 		{
 			"PLATFORM_MACOSX_X64"
 		}
+	-- Additional Platform Defines (Linux)
+	filter { "platforms:Linux" }
+		defines
+		{
+			"PLATFORM_LINUX_X64"
+		}
 	filter { }
 
 	include_apple_frameworks()
@@ -134,7 +152,7 @@ project "Engine"
 
 	--================================== BEGIN ENTT DEPENDENCY =============================--
 
-	filter { "action:vs*" }
+	filter { "action:vs* or gmake*" }
 		includedirs
 		{
 			"%{IncludeDirectories.entt}"
@@ -150,7 +168,7 @@ project "Engine"
 
 	--================================== BEGIN RAPIDJSON DEPENDENCY ========================--
 
-	filter { "action:vs*" }
+	filter { "action:vs* or gmake*" }
 		includedirs
 		{
 			"%{IncludeDirectories.rapidjson}"
@@ -171,7 +189,7 @@ project "Engine"
 		{
 			"%{IncludeDirectories.glfw}"
 		}
-	filter { "action:vs*" }
+	filter { "action:vs* or gmake*" }
 		includedirs
 		{
 			"%{IncludeDirectories.glfw}"
@@ -208,7 +226,7 @@ project "Engine"
 		{
 			"%{IncludeDirectories.ImGui}"
 		}
-	filter { "action:vs*" }
+	filter { "action:vs* or gmake*" }
 		includedirs
 		{
 			"%{IncludeDirectories.ImGui}"
@@ -290,7 +308,7 @@ project "Engine"
 
 
 	-- Only include these if the platform is vs2022
-	filter { "action:vs*" }
+	filter { "action:vs* or gmake*" }
 		includedirs
 		{
 			"%{IncludeDirectories.spdlog}"
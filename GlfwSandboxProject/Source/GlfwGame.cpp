@@ -18,6 +18,8 @@ namespace GlfwSandbox
 		void InitializeSystems()
 		{
 			Engine::SystemManager::AddSystem<CameraControllerSystem>();
+			// Updates the world matrices of the transforms that get rendered.
+			Engine::SystemManager::AddSystem<Engine::EntityHierarchySystem>();
 		}
 
 		void InitializeCameraEntity(Engine::Scene& scene)
@@ -125,12 +127,12 @@ namespace GlfwSandbox
 
 	void GlfwGame::OnUpdate(const Engine::Timestep& ts)
 	{
+		// Invokes Update on the systems, before the scene so the camera uses this frame's world matrices.
+		Engine::SystemUtility::InvokeOnUpdate(ts, true);
+
 		Engine::SceneManager::OnUpdate(ts);
 		Engine::SceneManager::OnRuntimeUpdate(ts);
 
-		// Invokes Update on the systems.
-		Engine::SystemUtility::InvokeOnUpdate(ts, true);
-
 		Engine::Scene& scene = Engine::SceneManager::GetActiveScene();
 
 		auto entity = scene.FindEntity<Engine::NameComponent>("HappyFace", FindByNameFuncPtr);
@@ -138,7 +140,7 @@ namespace GlfwSandbox
 		{
 			Engine::Transform3DComponent& transformComponent
 				= entity.GetComponent<Engine::Transform3DComponent>();
-			MathLib::Vector3 position = transformComponent.GetWorldPosition();
+			MathLib::Vector3 position = transformComponent.GetLocalPosition();
 			MathLib::Vector3 direction;
 			if (Engine::Input::IsKeyHeld(Engine::InputKeyCode::KEY_CODE_A))
 			{
@@ -233,6 +235,7 @@ namespace GlfwSandbox
 			MathLib::Vector2 scale = { 1.0f, 1.0f };
 			Engine::GraphicsRenderer2D::DrawRect(MathLib::Vector2(0.0f, 0.0f),
 				scale, m_subTexture);
+			Engine::GraphicsRenderer2D::Flush();
 		}
 		// Don't want to unbind this because then it will result in render target view being cleared. 
         // m_frameBuffer->UnBind();
@@ -12,6 +12,8 @@ namespace Engine
 			: Application("GlfwSandboxApp",
 				Engine::FileUtils::GetWorkingDirectory())
 		{
+			// Writes a trace of the last frames when a frame goes over budget.
+			GetFrameBudgetMonitor().SetEnabled(true);
 			AddLayer(new GlfwSandbox::GlfwGame());
 		}
 	};
@@ -0,0 +1,233 @@
+#include "MathPCH.h"
+#include "BatchTransform.h"
+
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "Vector.h"
+#include "SIMD.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <cmath>
+
+namespace MathLib
+{
+
+	namespace
+	{
+
+#if defined(__AVX2__)
+		using Lanes = __m256;
+		const size_t c_numLanes = 8;
+
+		inline Lanes LoadLanes(const float* values) { return _mm256_loadu_ps(values); }
+		inline void StoreLanes(float* outValues, Lanes v) { _mm256_storeu_ps(outValues, v); }
+		inline Lanes SplatLanes(float value) { return _mm256_set1_ps(value); }
+		inline Lanes MulAddLanes(Lanes a, Lanes b, Lanes c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#else
+		using Lanes = SIMD::Float4;
+		const size_t c_numLanes = 4;
+
+		inline Lanes LoadLanes(const float* values) { return SIMD::Load(values); }
+		inline void StoreLanes(float* outValues, Lanes v) { SIMD::Store(outValues, v); }
+		inline Lanes SplatLanes(float value) { return SIMD::Splat(value); }
+		inline Lanes MulAddLanes(Lanes a, Lanes b, Lanes c) { return SIMD::MulAdd(a, b, c); }
+#endif
+
+		/**
+		 * Sets out[j] = offset[j] + x * rows[0][j] + y * rows[1][j] + z * rows[2][j]
+		 * for each of the elements, the rows & offsets are splat across the lanes.
+		 */
+		void TransformSoA(const float (&rows)[3][3], const float (&offset)[3],
+			const float* const inValues[3], float* const outValues[3], size_t count)
+		{
+			Lanes rowLanes[3][3];
+			Lanes offsetLanes[3];
+			for (size_t j = 0; j < 3; j++)
+			{
+				rowLanes[0][j] = SplatLanes(rows[0][j]);
+				rowLanes[1][j] = SplatLanes(rows[1][j]);
+				rowLanes[2][j] = SplatLanes(rows[2][j]);
+				offsetLanes[j] = SplatLanes(offset[j]);
+			}
+
+			size_t i = 0;
+			for (; i + c_numLanes <= count; i += c_numLanes)
+			{
+				// Loads all of the components first so the output can overwrite the input.
+				Lanes x = LoadLanes(inValues[0] + i);
+				Lanes y = LoadLanes(inValues[1] + i);
+				Lanes z = LoadLanes(inValues[2] + i);
+				for (size_t j = 0; j < 3; j++)
+				{
+					Lanes result = MulAddLanes(x, rowLanes[0][j], offsetLanes[j]);
+					result = MulAddLanes(y, rowLanes[1][j], result);
+					result = MulAddLanes(z, rowLanes[2][j], result);
+					StoreLanes(outValues[j] + i, result);
+				}
+			}
+
+			for (; i < count; i++)
+			{
+				float x = inValues[0][i], y = inValues[1][i], z = inValues[2][i];
+				for (size_t j = 0; j < 3; j++)
+				{
+					outValues[j][i] = offset[j] + x * rows[0][j] + y * rows[1][j] + z * rows[2][j];
+				}
+			}
+		}
+
+		// The cross product of the x, y & z components, the w component is zero.
+		inline SIMD::Float4 Cross(SIMD::Float4 a, SIMD::Float4 b)
+		{
+			return SIMD::Sub(SIMD::Mul(SIMD::Shuffle<1, 2, 0, 3>(a), SIMD::Shuffle<2, 0, 1, 3>(b)),
+				SIMD::Mul(SIMD::Shuffle<2, 0, 1, 3>(a), SIMD::Shuffle<1, 2, 0, 3>(b)));
+		}
+
+		/**
+		 * Gets the rows of the quaternion's rotation matrix, each row is the identity
+		 * row plus two products of the quaternion's & the doubled quaternion's components.
+		 */
+		inline void GetRotationRows(SIMD::Float4 quat, SIMD::Float4 (&outRows)[3])
+		{
+			SIMD::Float4 quat2 = SIMD::Add(quat, quat);
+			outRows[0] = SIMD::MulAdd(SIMD::Mul(SIMD::Shuffle<1, 0, 0, 3>(quat), SIMD::Set(-1.0f, 1.0f, 1.0f, 0.0f)),
+				SIMD::Shuffle<1, 1, 2, 3>(quat2), SIMD::Set(1.0f, 0.0f, 0.0f, 0.0f));
+			outRows[0] = SIMD::MulAdd(SIMD::Mul(SIMD::Shuffle<2, 2, 1, 3>(quat), SIMD::Set(-1.0f, 1.0f, -1.0f, 0.0f)),
+				SIMD::Shuffle<2, 3, 3, 3>(quat2), outRows[0]);
+			outRows[1] = SIMD::MulAdd(SIMD::Mul(SIMD::Shuffle<1, 0, 1, 3>(quat), SIMD::Set(1.0f, -1.0f, 1.0f, 0.0f)),
+				SIMD::Shuffle<0, 0, 2, 3>(quat2), SIMD::Set(0.0f, 1.0f, 0.0f, 0.0f));
+			outRows[1] = SIMD::MulAdd(SIMD::Mul(SIMD::Shuffle<2, 2, 0, 3>(quat), SIMD::Set(-1.0f, -1.0f, 1.0f, 0.0f)),
+				SIMD::Shuffle<3, 2, 3, 3>(quat2), outRows[1]);
+			outRows[2] = SIMD::MulAdd(SIMD::Mul(SIMD::Shuffle<2, 2, 0, 3>(quat), SIMD::Set(1.0f, 1.0f, -1.0f, 0.0f)),
+				SIMD::Shuffle<0, 1, 0, 3>(quat2), SIMD::Set(0.0f, 0.0f, 1.0f, 0.0f));
+			outRows[2] = SIMD::MulAdd(SIMD::Mul(SIMD::Shuffle<1, 0, 1, 3>(quat), SIMD::Set(1.0f, -1.0f, -1.0f, 0.0f)),
+				SIMD::Shuffle<3, 3, 1, 3>(quat2), outRows[2]);
+		}
+
+		void GetRows(const Matrix4x4& matrix, float (&outRows)[3][3])
+		{
+			for (size_t r = 0; r < 3; r++)
+			{
+				for (size_t c = 0; c < 3; c++)
+				{
+					outRows[r][c] = matrix.matrix[r][c];
+				}
+			}
+		}
+	}
+
+	void TransformPoints(const Matrix4x4& matrix, const Vector3* inPoints,
+		Vector3* outPoints, size_t count)
+	{
+		SIMD::Float4 row0 = SIMD::Load(matrix.matrix[0]);
+		SIMD::Float4 row1 = SIMD::Load(matrix.matrix[1]);
+		SIMD::Float4 row2 = SIMD::Load(matrix.matrix[2]);
+		SIMD::Float4 row3 = SIMD::Load(matrix.matrix[3]);
+		for (size_t i = 0; i < count; i++)
+		{
+			const Vector3& point = inPoints[i];
+			SIMD::Float4 result = SIMD::MulAdd(SIMD::Splat(point.x), row0, row3);
+			result = SIMD::MulAdd(SIMD::Splat(point.y), row1, result);
+			result = SIMD::MulAdd(SIMD::Splat(point.z), row2, result);
+			SIMD::Store3(&outPoints[i].x, result);
+		}
+	}
+
+	void TransformPoints(const Matrix4x4& matrix, const float* const inPoints[3],
+		float* const outPoints[3], size_t count)
+	{
+		float rows[3][3];
+		GetRows(matrix, rows);
+		const float translation[3] = { matrix.matrix[3][0], matrix.matrix[3][1], matrix.matrix[3][2] };
+		TransformSoA(rows, translation, inPoints, outPoints, count);
+	}
+
+	void TransformDirections(const Matrix4x4& matrix, const float* const inDirections[3],
+		float* const outDirections[3], size_t count)
+	{
+		float rows[3][3];
+		GetRows(matrix, rows);
+		const float zero[3] = { 0.0f, 0.0f, 0.0f };
+		TransformSoA(rows, zero, inDirections, outDirections, count);
+	}
+
+	void TransformBounds(const Matrix4x4& matrix, const float* const inCenters[3],
+		const float* const inExtents[3], float* const outCenters[3],
+		float* const outExtents[3], size_t count)
+	{
+		// The extents of the enclosing box are the extents transformed by the absolute matrix.
+		float rows[3][3], absRows[3][3];
+		GetRows(matrix, rows);
+		for (size_t r = 0; r < 3; r++)
+		{
+			for (size_t c = 0; c < 3; c++)
+			{
+				absRows[r][c] = std::abs(rows[r][c]);
+			}
+		}
+		const float translation[3] = { matrix.matrix[3][0], matrix.matrix[3][1], matrix.matrix[3][2] };
+		const float zero[3] = { 0.0f, 0.0f, 0.0f };
+		TransformSoA(rows, translation, inCenters, outCenters, count);
+		TransformSoA(absRows, zero, inExtents, outExtents, count);
+	}
+
+	void MultiplyMatrices(const Matrix4x4* a, const Matrix4x4* b,
+		Matrix4x4* outMatrices, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			outMatrices[i] = a[i] * b[i];
+		}
+	}
+
+	void RotateVectors(const Quaternion* quats, const Vector3* inVectors,
+		Vector3* outVectors, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			// v + w * t + cross(q, t), where t = 2 * cross(q, v).
+			SIMD::Float4 quat = SIMD::Load(quats[i]);
+			SIMD::Float4 vector = SIMD::Load3(&inVectors[i].x);
+			SIMD::Float4 t = Cross(quat, vector);
+			t = SIMD::Add(t, t);
+			SIMD::Float4 result = SIMD::MulAdd(SIMD::Shuffle<3, 3, 3, 3>(quat), t, vector);
+			SIMD::Store3(&outVectors[i].x, SIMD::Add(result, Cross(quat, t)));
+		}
+	}
+
+	void RotateVectors(const Quaternion& quat, const float* const inVectors[3],
+		float* const outVectors[3], size_t count)
+	{
+		SIMD::Float4 rotationRows[3];
+		GetRotationRows(SIMD::Load(quat), rotationRows);
+		float rows[3][3];
+		for (size_t r = 0; r < 3; r++)
+		{
+			float row[4];
+			SIMD::Store(row, rotationRows[r]);
+			rows[r][0] = row[0];
+			rows[r][1] = row[1];
+			rows[r][2] = row[2];
+		}
+		const float zero[3] = { 0.0f, 0.0f, 0.0f };
+		TransformSoA(rows, zero, inVectors, outVectors, count);
+	}
+
+	void QuaternionsToMatrices(const Quaternion* quats, Matrix4x4* outMatrices, size_t count)
+	{
+		SIMD::Float4 lastRow = SIMD::Set(0.0f, 0.0f, 0.0f, 1.0f);
+		for (size_t i = 0; i < count; i++)
+		{
+			SIMD::Float4 rows[3];
+			GetRotationRows(SIMD::Load(quats[i]), rows);
+			Matrix4x4& matrix = outMatrices[i];
+			SIMD::Store(matrix.matrix[0], rows[0]);
+			SIMD::Store(matrix.matrix[1], rows[1]);
+			SIMD::Store(matrix.matrix[2], rows[2]);
+			SIMD::Store(matrix.matrix[3], lastRow);
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+namespace MathLib
+{
+	class Vector3;
+	class Matrix4x4;
+	class Quaternion;
+
+	/**
+	 * Bulk versions of the matrix & vector operations. The structure of arrays overloads
+	 * take the x, y & z components as three separate arrays & transform several elements
+	 * per instruction, eight when compiled for AVX2 & four otherwise. The input & output
+	 * arrays can be the same, the points are transformed as row vectors.
+	 */
+
+	// Transforms the points by the matrix with a w of 1.
+	void TransformPoints(const Matrix4x4& matrix, const Vector3* inPoints,
+		Vector3* outPoints, size_t count);
+	void TransformPoints(const Matrix4x4& matrix, const float* const inPoints[3],
+		float* const outPoints[3], size_t count);
+
+	// Transforms the directions by the matrix with a w of 0, so they aren't translated.
+	void TransformDirections(const Matrix4x4& matrix, const float* const inDirections[3],
+		float* const outDirections[3], size_t count);
+
+	/**
+	 * Transforms the axis aligned boxes by the matrix, the results are
+	 * the axis aligned boxes that enclose the transformed boxes.
+	 */
+	void TransformBounds(const Matrix4x4& matrix, const float* const inCenters[3],
+		const float* const inExtents[3], float* const outCenters[3],
+		float* const outExtents[3], size_t count);
+
+	// Sets each of the out matrices to a[i] * b[i].
+	void MultiplyMatrices(const Matrix4x4* a, const Matrix4x4* b,
+		Matrix4x4* outMatrices, size_t count);
+
+	// Rotates each of the vectors by its quaternion, the same as Vector3::Rotate.
+	void RotateVectors(const Quaternion* quats, const Vector3* inVectors,
+		Vector3* outVectors, size_t count);
+	// Rotates all of the vectors by the quaternion.
+	void RotateVectors(const Quaternion& quat, const float* const inVectors[3],
+		float* const outVectors[3], size_t count);
+
+	// Converts each of the quaternions, the same as Matrix4x4::CreateFromQuaternion.
+	void QuaternionsToMatrices(const Quaternion* quats, Matrix4x4* outMatrices, size_t count);
+}
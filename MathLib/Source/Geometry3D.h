@@ -61,8 +61,9 @@ namespace MathLib
 			: normal(normal) { }
 		Plane3D(const Vector3& normal, float distanceFromZero)
 			: normal(normal), distanceFromZero(distanceFromZero) { }
+		// The points on the plane satisfy Dot(point, normal) + distanceFromZero = 0.
 		Plane3D(const Vector3& normal, const Vector3& position)
-			: normal(normal), distanceFromZero(position.Length()) { }
+			: normal(normal), distanceFromZero(-Vector3::Dot(normal, position)) { }
 
 		bool Intersects(const LineSegment3D& segment) const;
 		bool Intersects(const LineSegment3D& segment, Vector3& interesectedPoint) const;
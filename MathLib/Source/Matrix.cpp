@@ -416,16 +416,6 @@ namespace MathLib
 		*this = Matrix4x4::Identity;
 	}
 
-	Matrix4x4::Matrix4x4(const float mat[4][4])
-	{
-		std::memcpy(matrix, mat, sizeof(float) * 16);
-	}
-
-	Matrix4x4::Matrix4x4(const Matrix4x4& mat)
-	{
-		std::memcpy(matrix, mat.matrix, sizeof(float) * 16);
-	}
-
 	Vector3 Matrix4x4::GetScale() const
 	{
 		return Vector3(
@@ -457,102 +447,146 @@ namespace MathLib
 			Vector3(matrix[2][0], matrix[2][1], matrix[2][2]));
 	}
 
-	void Matrix4x4::Invert()
+	namespace
 	{
-		Vector3 scale = GetScale();
+		// The 2x2 matrices are stored in a vector as (m00, m01, m10, m11).
 
-		// Creates the inverted scale matrix.
-		Matrix4x4 invertedScaleMat = Matrix4x4::Identity;
-		invertedScaleMat[0][0] = 1.0f / (scale.x * scale.x);
-		invertedScaleMat[1][1] = 1.0f / (scale.y * scale.y);
-		invertedScaleMat[2][2] = 1.0f / (scale.z * scale.z);
+		// Gets a * b.
+		SIMD::Float4 Multiply2x2(SIMD::Float4 a, SIMD::Float4 b)
+		{
+			return SIMD::Add(SIMD::Mul(a, SIMD::Shuffle<0, 3, 0, 3>(b)),
+				SIMD::Mul(SIMD::Shuffle<1, 0, 3, 2>(a), SIMD::Shuffle<2, 1, 2, 1>(b)));
+		}
 
-		// Creates the transposed rotation matrix w/ scale.
-		Matrix4x4 transposedSelf = *this;
-		transposedSelf[3][0] = 0.0f;
-		transposedSelf[3][1] = 0.0f;
-		transposedSelf[3][2] = 0.0f;
-		transposedSelf[3][3] = 1.0f;
-		transposedSelf.Transpose();
+		// Gets adjugate(a) * b.
+		SIMD::Float4 AdjugateMultiply2x2(SIMD::Float4 a, SIMD::Float4 b)
+		{
+			return SIMD::Sub(SIMD::Mul(SIMD::Shuffle<3, 3, 0, 0>(a), b),
+				SIMD::Mul(SIMD::Shuffle<1, 1, 2, 2>(a), SIMD::Shuffle<2, 3, 0, 1>(b)));
+		}
 
-		// Creates the inverted translation matrix.
-		Matrix4x4 invertedTranslationMatrix = Identity;
-		invertedTranslationMatrix[3][0] = -matrix[3][0];
-		invertedTranslationMatrix[3][1] = -matrix[3][1];
-		invertedTranslationMatrix[3][2] = -matrix[3][2];
-		invertedTranslationMatrix[3][3] = 1.0f;
+		// Gets a * adjugate(b).
+		SIMD::Float4 MultiplyAdjugate2x2(SIMD::Float4 a, SIMD::Float4 b)
+		{
+			return SIMD::Sub(SIMD::Mul(a, SIMD::Shuffle<3, 0, 3, 0>(b)),
+				SIMD::Mul(SIMD::Shuffle<1, 0, 3, 2>(a), SIMD::Shuffle<2, 1, 2, 1>(b)));
+		}
 
-		// Sets this to the inverted translation matrix * the inverted scale rotation matrix.
-		*this = invertedTranslationMatrix * (transposedSelf * invertedScaleMat);
+		SIMD::Float4 Cross(SIMD::Float4 a, SIMD::Float4 b)
+		{
+			return SIMD::Sub(
+				SIMD::Mul(SIMD::Shuffle<1, 2, 0, 3>(a), SIMD::Shuffle<2, 0, 1, 3>(b)),
+				SIMD::Mul(SIMD::Shuffle<2, 0, 1, 3>(a), SIMD::Shuffle<1, 2, 0, 3>(b)));
+		}
 	}
 
-	void Matrix4x4::Transpose()
+	void Matrix4x4::Invert()
 	{
-		const std::uint8_t COLS = 4, ROWS = 4;
-
-		float temporaryMat[COLS][ROWS];
-		for (std::uint8_t r = 0; r < COLS; r++)
+		// Splits the matrix into the 2x2 blocks | A B |, the inverse is 1 / |M| * | X Y |
+		//                                       | C D |                         | Z W |
+		// where each of the blocks is built from the adjugates of the others.
+		SIMD::Float4 row0 = SIMD::Load(matrix[0]);
+		SIMD::Float4 row1 = SIMD::Load(matrix[1]);
+		SIMD::Float4 row2 = SIMD::Load(matrix[2]);
+		SIMD::Float4 row3 = SIMD::Load(matrix[3]);
+
+		SIMD::Float4 a = SIMD::Shuffle<0, 1, 0, 1>(row0, row1);
+		SIMD::Float4 b = SIMD::Shuffle<2, 3, 2, 3>(row0, row1);
+		SIMD::Float4 c = SIMD::Shuffle<0, 1, 0, 1>(row2, row3);
+		SIMD::Float4 d = SIMD::Shuffle<2, 3, 2, 3>(row2, row3);
+
+		// The determinants of the blocks as (|A|, |B|, |C|, |D|).
+		float blockDeterminants[4];
+		SIMD::Store(blockDeterminants, SIMD::Sub(
+			SIMD::Mul(SIMD::Shuffle<0, 2, 0, 2>(row0, row2), SIMD::Shuffle<1, 3, 1, 3>(row1, row3)),
+			SIMD::Mul(SIMD::Shuffle<1, 3, 1, 3>(row0, row2), SIMD::Shuffle<0, 2, 0, 2>(row1, row3))));
+		SIMD::Float4 determinantA = SIMD::Splat(blockDeterminants[0]);
+		SIMD::Float4 determinantB = SIMD::Splat(blockDeterminants[1]);
+		SIMD::Float4 determinantC = SIMD::Splat(blockDeterminants[2]);
+		SIMD::Float4 determinantD = SIMD::Splat(blockDeterminants[3]);
+
+		SIMD::Float4 adjugateDC = AdjugateMultiply2x2(d, c);
+		SIMD::Float4 adjugateAB = AdjugateMultiply2x2(a, b);
+
+		// |M| = |A| * |D| + |B| * |C| - trace(adjugate(A)B * adjugate(D)C).
+		float determinant = blockDeterminants[0] * blockDeterminants[3]
+			+ blockDeterminants[1] * blockDeterminants[2]
+			- SIMD::Dot4(adjugateAB, SIMD::Shuffle<0, 2, 1, 3>(adjugateDC));
+		if (determinant == 0.0f)
 		{
-			for (int c = 0; c < COLS; c++)
-			{
-				temporaryMat[r][c] = matrix[c][r];
-			}
+			return;
 		}
-		std::memcpy(matrix, temporaryMat, sizeof(float) * COLS * ROWS);
-	}
 
-	float* Matrix4x4::operator[](int index) const
-	{
-		return const_cast<float*>(matrix[index]);
-	}
+		// The adjugates of the inverse's blocks.
+		SIMD::Float4 x = SIMD::Sub(SIMD::Mul(determinantD, a), Multiply2x2(b, adjugateDC));
+		SIMD::Float4 w = SIMD::Sub(SIMD::Mul(determinantA, d), Multiply2x2(c, adjugateAB));
+		SIMD::Float4 y = SIMD::Sub(SIMD::Mul(determinantB, c), MultiplyAdjugate2x2(d, adjugateAB));
+		SIMD::Float4 z = SIMD::Sub(SIMD::Mul(determinantC, b), MultiplyAdjugate2x2(a, adjugateDC));
+
+		// The signs of the adjugate are folded into the reciprocal.
+		float reciprocal = 1.0f / determinant;
+		SIMD::Float4 scale = SIMD::Set(reciprocal, -reciprocal, -reciprocal, reciprocal);
+		x = SIMD::Mul(x, scale);
+		y = SIMD::Mul(y, scale);
+		z = SIMD::Mul(z, scale);
+		w = SIMD::Mul(w, scale);
+
+		// Undoes the adjugates & stores the blocks as rows.
+		SIMD::Store(matrix[0], SIMD::Shuffle<3, 1, 3, 1>(x, y));
+		SIMD::Store(matrix[1], SIMD::Shuffle<2, 0, 2, 0>(x, y));
+		SIMD::Store(matrix[2], SIMD::Shuffle<3, 1, 3, 1>(z, w));
+		SIMD::Store(matrix[3], SIMD::Shuffle<2, 0, 2, 0>(z, w));
+	}
+
+	void Matrix4x4::InvertAffine()
+	{
+		// The inverse of the upper 3x3 is its adjugate over its determinant, the columns of
+		// the adjugate are the cross products of the rows. The translation is -t * inverse.
+		SIMD::Float4 row0 = SIMD::Load(matrix[0]);
+		SIMD::Float4 row1 = SIMD::Load(matrix[1]);
+		SIMD::Float4 row2 = SIMD::Load(matrix[2]);
+		SIMD::Float4 translation = SIMD::Load(matrix[3]);
+
+		SIMD::Float4 column0 = Cross(row1, row2);
+		SIMD::Float4 column1 = Cross(row2, row0);
+		SIMD::Float4 column2 = Cross(row0, row1);
+		float determinant = SIMD::Dot3(row0, column0);
+		if (determinant == 0.0f)
+		{
+			return;
+		}
 
-	Matrix4x4 operator*(const Matrix4x4& a, const Matrix4x4& b)
-	{
-		const std::uint8_t ROWS = 4, COLS = 4;
+		SIMD::Float4 column3 = SIMD::Splat(0.0f);
+		SIMD::Transpose(column0, column1, column2, column3);
+		SIMD::Float4 reciprocal = SIMD::Splat(1.0f / determinant);
+		row0 = SIMD::Mul(column0, reciprocal);
+		row1 = SIMD::Mul(column1, reciprocal);
+		row2 = SIMD::Mul(column2, reciprocal);
 
-		Matrix4x4 output{};
-		std::uint32_t num = ROWS * COLS;
-		for (std::uint8_t r = 0; r < ROWS; r++)
-		{
-			float total = 0.0f;
-			for (std::uint8_t c = 0; c < num; c++)
-			{
-				total += a[r][c % COLS] * b[c % COLS][c / COLS];
+		float t[4];
+		SIMD::Store(t, translation);
+		SIMD::Float4 invertedTranslation = SIMD::Mul(SIMD::Splat(t[0]), row0);
+		invertedTranslation = SIMD::MulAdd(SIMD::Splat(t[1]), row1, invertedTranslation);
+		invertedTranslation = SIMD::MulAdd(SIMD::Splat(t[2]), row2, invertedTranslation);
+		invertedTranslation = SIMD::Sub(SIMD::Set(0.0f, 0.0f, 0.0f, 1.0f), invertedTranslation);
 
-				if ((c + 1) % COLS == 0
-					&& c > 0)
-				{
-					output[r][c / COLS] = total;
-					total = 0.0f;
-				}
-			}
-		}
-		return output;
+		SIMD::Store(matrix[0], row0);
+		SIMD::Store(matrix[1], row1);
+		SIMD::Store(matrix[2], row2);
+		SIMD::Store(matrix[3], invertedTranslation);
 	}
 
-	Matrix4x4& Matrix4x4::operator*=(const Matrix4x4& mat)
+	void Matrix4x4::Transpose()
 	{
-		const std::uint8_t ROWS = 4, COLS = 4;
-
-		std::uint8_t num = ROWS * COLS;
-		float oldMatrixData[ROWS][COLS];
-		std::memcpy(oldMatrixData, matrix,
-			num * sizeof(float));
-		for (std::uint8_t r = 0; r < ROWS; r++)
-		{
-			float total = 0.0f;
-			for (std::uint8_t c = 0; c < num; c++)
-			{
-				total += oldMatrixData[r][c % COLS] * mat[c % COLS][c / COLS];
-				if (c % COLS == 0
-					&& c > 0)
-				{
-					matrix[r / ROWS][c / COLS] = total;
-					total = 0.0f;
-				}
-			}
-		}
-		return *this;
+		SIMD::Float4 row0 = SIMD::Load(matrix[0]);
+		SIMD::Float4 row1 = SIMD::Load(matrix[1]);
+		SIMD::Float4 row2 = SIMD::Load(matrix[2]);
+		SIMD::Float4 row3 = SIMD::Load(matrix[3]);
+		SIMD::Transpose(row0, row1, row2, row3);
+		SIMD::Store(matrix[0], row0);
+		SIMD::Store(matrix[1], row1);
+		SIMD::Store(matrix[2], row2);
+		SIMD::Store(matrix[3], row3);
 	}
 
 	bool operator==(const Matrix4x4& a, const Matrix4x4& b)
@@ -617,6 +651,20 @@ namespace MathLib
         return cpy;
     }
 
+	Matrix4x4 InvertAffine(const Matrix4x4& matrix)
+	{
+		Matrix4x4 cpy(matrix);
+		cpy.InvertAffine();
+		return cpy;
+	}
+
+    Matrix4x4 Matrix4x4::InvertAffine(const Matrix4x4& matrix)
+    {
+        Matrix4x4 cpy(matrix);
+        cpy.InvertAffine();
+        return cpy;
+    }
+
 #pragma endregion
 
 }
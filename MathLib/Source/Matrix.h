@@ -2,7 +2,9 @@
 
 #include "Vector.h"
 #include "Quaternion.h"
+#include "SIMD.h"
 
+#include <cstring>
 
 namespace MathLib
 {
@@ -53,7 +55,7 @@ namespace MathLib
 
 		explicit Matrix4x4();
 		explicit Matrix4x4(const float mat[4][4]);
-		Matrix4x4(const Matrix4x4& mat);
+		Matrix4x4(const Matrix4x4& mat) = default;
 
 		Vector3 GetScale() const;
 		Vector3 GetTranslation() const;
@@ -65,7 +67,10 @@ namespace MathLib
 		Vector3 GetZAxis() const;
 
 		void Transpose();
+		// Inverts any invertible matrix, including projections. A singular matrix is left unchanged.
 		void Invert();
+		// Inverts a matrix without projection, the last column must be (0, 0, 0, 1).
+		void InvertAffine();
 
 		float* operator[](int index) const;
 		friend Matrix4x4 operator*(const Matrix4x4& a, const Matrix4x4& b);
@@ -78,9 +83,11 @@ namespace MathLib
 
 		friend Matrix4x4 Transpose(const Matrix4x4& matrix);
 		friend Matrix4x4 Invert(const Matrix4x4& matrix);
+		friend Matrix4x4 InvertAffine(const Matrix4x4& matrix);
         
         static Matrix4x4 Transpose(const Matrix4x4& matrix);
         static Matrix4x4 Invert(const Matrix4x4& matrix);
+        static Matrix4x4 InvertAffine(const Matrix4x4& matrix);
 
 		static Matrix4x4 CreateRotationX(float rotation, bool inDegrees = true);
 		static Matrix4x4 CreateRotationY(float rotation, bool inDegrees = true);
@@ -103,4 +110,58 @@ namespace MathLib
 
 		static const Matrix4x4 Identity;
 	};
+
+#pragma region matrix4x4
+
+	inline Matrix4x4::Matrix4x4(const float mat[4][4])
+	{
+		std::memcpy(matrix, mat, sizeof(float) * 16);
+	}
+
+	inline float* Matrix4x4::operator[](int index) const
+	{
+		return const_cast<float*>(matrix[index]);
+	}
+
+	inline Matrix4x4 operator*(const Matrix4x4& a, const Matrix4x4& b)
+	{
+		// Each row of the output is the row of a transformed by b.
+		SIMD::Float4 row0 = SIMD::Load(b.matrix[0]);
+		SIMD::Float4 row1 = SIMD::Load(b.matrix[1]);
+		SIMD::Float4 row2 = SIMD::Load(b.matrix[2]);
+		SIMD::Float4 row3 = SIMD::Load(b.matrix[3]);
+
+		float output[4][4];
+		for (int r = 0; r < 4; r++)
+		{
+			SIMD::Float4 result = SIMD::Mul(SIMD::Splat(a.matrix[r][0]), row0);
+			result = SIMD::MulAdd(SIMD::Splat(a.matrix[r][1]), row1, result);
+			result = SIMD::MulAdd(SIMD::Splat(a.matrix[r][2]), row2, result);
+			result = SIMD::MulAdd(SIMD::Splat(a.matrix[r][3]), row3, result);
+			SIMD::Store(output[r], result);
+		}
+		return Matrix4x4(output);
+	}
+
+	inline Matrix4x4& Matrix4x4::operator*=(const Matrix4x4& mat)
+	{
+		return *this = *this * mat;
+	}
+
+	inline Vector4 operator*(const Vector4& a, const Matrix4x4& b)
+	{
+		// Row vector, the same as mul(a, b) in the shaders.
+		SIMD::Float4 result = SIMD::Mul(SIMD::Splat(a.x), SIMD::Load(b.matrix[0]));
+		result = SIMD::MulAdd(SIMD::Splat(a.y), SIMD::Load(b.matrix[1]), result);
+		result = SIMD::MulAdd(SIMD::Splat(a.z), SIMD::Load(b.matrix[2]), result);
+		result = SIMD::MulAdd(SIMD::Splat(a.w), SIMD::Load(b.matrix[3]), result);
+		return SIMD::ToVector4(result);
+	}
+
+	inline Vector4 operator*(const Matrix4x4& a, const Vector4& b)
+	{
+		return b * a;
+	}
+
+#pragma endregion
 }
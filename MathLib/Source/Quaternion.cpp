@@ -13,11 +13,6 @@ namespace MathLib
 		*this = Identity;
 	}
 
-	Quaternion::Quaternion(float x, float y, float z, float w) 
-		: x(x), y(y), z(z), w(w)
-	{
-	}
-
 	Quaternion::Quaternion(const Vector3& axis, float angle, bool inDegrees)
 	{
 		x = axis.x * Sin(angle * 0.5f, inDegrees);
@@ -26,11 +21,6 @@ namespace MathLib
 		w = Cos(angle * 0.5f, inDegrees);
 	}
 
-	float Quaternion::LengthSquared() const
-	{
-		return x * x + y * y + z * z + w * w;
-	}
-
 	float Quaternion::Length() const
 	{
 		return Sqrt(LengthSquared());
@@ -83,16 +73,6 @@ namespace MathLib
 		z *= -1.0f;
 	}
 
-	float Dot(const Quaternion& a, const Quaternion& b)
-	{
-        return Quaternion::Dot(a, b);
-	}
-
-    float Quaternion::Dot(const Quaternion &a, const Quaternion &b)
-    {
-        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
-    }
-
 	Vector3 ToEuler(const Quaternion& quaternion)
 	{
         return Quaternion::ToEuler(quaternion);
@@ -113,26 +93,34 @@ namespace MathLib
         return quat.ToEuler(inDegrees);
     }
 
-	Quaternion Concatenate(const Quaternion& a, const Quaternion& b)
+	namespace
 	{
-		Vector3 vecQuatA(a.x, a.y, a.z);
-		Vector3 vecQuatB(b.x, b.y, b.z);
-		Vector3 val = a.w * vecQuatB + b.w * vecQuatA + Cross(vecQuatA, vecQuatB);
-		return Quaternion(
-			val.x, val.y, val.z, a.w * b.w - Dot(vecQuatA, vecQuatB));
+
+		SIMD::Float4 NormalizedLerp(SIMD::Float4 a, SIMD::Float4 b, float weightA, float weightB)
+		{
+			SIMD::Float4 result = SIMD::MulAdd(b, SIMD::Splat(weightB), SIMD::Mul(a, SIMD::Splat(weightA)));
+			return SIMD::Div(result, SIMD::Splat(Sqrt(SIMD::Dot4(result, result))));
+		}
+
+		/**
+		 * Fits the alpha of a normalized lerp to the angle of a slerp, the
+		 * polynomial is from "Approximating slerp" by Arseny Kapoulkine.
+		 */
+		float GetApproximateSlerpAlpha(float cosTheta, float alpha)
+		{
+			float a = 1.0904f + cosTheta * (-3.2452f + cosTheta * (3.55645f - cosTheta * 1.43519f));
+			float b = 0.848013f + cosTheta * (-1.06021f + cosTheta * 0.215638f);
+			float k = a * (alpha - 0.5f) * (alpha - 0.5f) + b;
+			return alpha + alpha * (alpha - 0.5f) * (alpha - 1.0f) * k;
+		}
 	}
 
 	Quaternion Lerp(const Quaternion& a, const Quaternion& b, float alpha)
 	{
-		float dotResult = Dot(a, b);
-		float bias = dotResult >= 0.0f ? 1.0f : -1.0f;
-		Quaternion outQuat(
-			b.x * alpha + a.x * bias * (1.0f - alpha),
-			b.y * alpha + a.y * bias * (1.0f - alpha),
-			b.z * alpha + a.z * bias * (1.0f - alpha),
-			b.w * alpha + a.w * bias * (1.0f - alpha));
-		outQuat.Normalize();
-		return outQuat;
+		SIMD::Float4 quatA = SIMD::Load(a);
+		SIMD::Float4 quatB = SIMD::Load(b);
+		float bias = SIMD::Dot4(quatA, quatB) >= 0.0f ? 1.0f : -1.0f;
+		return SIMD::ToQuaternion(NormalizedLerp(quatA, quatB, bias * (1.0f - alpha), alpha));
 	}
 
 	Quaternion LerpClamped(const Quaternion& a, const Quaternion& b, float alpha)
@@ -142,37 +130,38 @@ namespace MathLib
 
 	Quaternion Slerp(const Quaternion& a, const Quaternion& b, float alpha)
 	{
-		float halfCosTheta = Dot(a, b);
-		if (abs(halfCosTheta) >= 1.0f)
+		return Slerp(a, b, alpha, false);
+	}
+
+	Quaternion Slerp(const Quaternion& a, const Quaternion& b, float alpha, bool approximate)
+	{
+		SIMD::Float4 quatA = SIMD::Load(a);
+		SIMD::Float4 quatB = SIMD::Load(b);
+		float cosTheta = SIMD::Dot4(quatA, quatB);
+		// Takes the shorter path.
+		if (cosTheta < 0.0f)
 		{
-			return a;
+			quatB = SIMD::Negate(quatB);
+			cosTheta = -cosTheta;
 		}
-		Quaternion outB = b;
-		if (halfCosTheta < 0.0f)
+
+		if (approximate)
 		{
-			outB.x *= -1.0f;
-			outB.y *= -1.0f;
-			outB.z *= -1.0f;
-			outB.w *= -1.0f;
-			halfCosTheta *= -1.0f;
+			float approximateAlpha = GetApproximateSlerpAlpha(cosTheta, alpha);
+			return SIMD::ToQuaternion(NormalizedLerp(quatA, quatB, 1.0f - approximateAlpha, approximateAlpha));
 		}
-		float halfTheta = ACos(halfCosTheta, false);
-		float sinHalfTheta = Sqrt(1.0f - halfCosTheta * halfCosTheta);
-		if (sinHalfTheta < EPSILON)
+
+		// The sine of the angle gets too small to divide by, but then the lerp is close enough.
+		float sinTheta = Sqrt(Max(1.0f - cosTheta * cosTheta, 0.0f));
+		if (sinTheta < EPSILON)
 		{
-			return Quaternion(
-				(a.x * 0.5f + outB.x * 0.5f),
-				(a.y * 0.5f + outB.y * 0.5f),
-				(a.z * 0.5f + outB.z * 0.5f),
-				(a.w * 0.5f + outB.w * 0.5f));
+			return SIMD::ToQuaternion(NormalizedLerp(quatA, quatB, 1.0f - alpha, alpha));
 		}
-		float ratioA = Sin((1.0f - alpha) * halfTheta, false) / sinHalfTheta;
-		float ratioB = Sin(alpha * halfTheta, false) / sinHalfTheta;
-		return Quaternion(
-			a.x * ratioA + outB.x * ratioB,
-			a.y * ratioA + outB.y * ratioB,
-			a.z * ratioA + outB.z * ratioB,
-			a.w * ratioA + outB.w * ratioB);
+		float theta = ACos(cosTheta, false);
+		float weightA = Sin((1.0f - alpha) * theta, false) / sinTheta;
+		float weightB = Sin(alpha * theta, false) / sinTheta;
+		return SIMD::ToQuaternion(SIMD::MulAdd(quatB, SIMD::Splat(weightB),
+			SIMD::Mul(quatA, SIMD::Splat(weightA))));
 	}
 
 	Quaternion Conjugate(const Quaternion& q)
@@ -241,12 +230,8 @@ namespace MathLib
 
     Quaternion Quaternion::Normalize(const Quaternion& quat)
     {
-        float length = quat.Length();
-        return Quaternion(
-            quat.x / length,
-            quat.y / length,
-            quat.z / length,
-            quat.w / length);
+        return SIMD::ToQuaternion(
+            SIMD::Div(SIMD::Load(quat), SIMD::Splat(quat.Length())));
     }
 
 	bool operator==(const Quaternion& a, const Quaternion& b)
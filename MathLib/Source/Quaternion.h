@@ -1,5 +1,7 @@
 #pragma once
 
+#include "SIMD.h"
+
 namespace MathLib
 {
 
@@ -34,9 +36,16 @@ namespace MathLib
 		friend Vector3 ToEuler(const Quaternion& quat, bool inDegrees);
 		
 		friend Quaternion Concatenate(const Quaternion& a, const Quaternion& b);
+		// The normalized lerp, takes the shorter path but doesn't rotate at a constant speed.
 		friend Quaternion Lerp(const Quaternion& a, const Quaternion& b, float alpha);
 		friend Quaternion LerpClamped(const Quaternion& a, const Quaternion& b, float alpha);
 		friend Quaternion Slerp(const Quaternion& a, const Quaternion& b, float alpha);
+		/**
+		 * The spherical lerp, the approximation corrects the alpha of a normalized lerp
+		 * with a polynomial instead of the inverse cosine & sines, it's within about
+		 * 0.001 of the exact slerp.
+		 */
+		friend Quaternion Slerp(const Quaternion& a, const Quaternion& b, float alpha, bool approximate);
 		friend Quaternion Conjugate(const Quaternion& q);
 		
 		friend bool operator==(const Quaternion& a, const Quaternion& b);
@@ -58,4 +67,57 @@ namespace MathLib
 
 		static const Quaternion Identity;
 	};
+
+	inline Quaternion::Quaternion(float x, float y, float z, float w)
+		: x(x), y(y), z(z), w(w)
+	{
+	}
+
+	namespace SIMD
+	{
+
+		inline Float4 Load(const Quaternion& quat)
+		{
+			return Load(&quat.x);
+		}
+
+		inline Quaternion ToQuaternion(Float4 v)
+		{
+			Quaternion quat(0.0f, 0.0f, 0.0f, 0.0f);
+			Store(&quat.x, v);
+			return quat;
+		}
+	}
+
+	inline float Quaternion::LengthSquared() const
+	{
+		SIMD::Float4 v = SIMD::Load(*this);
+		return SIMD::Dot4(v, v);
+	}
+
+	inline float Quaternion::Dot(const Quaternion& a, const Quaternion& b)
+	{
+		return SIMD::Dot4(SIMD::Load(a), SIMD::Load(b));
+	}
+
+	inline float Dot(const Quaternion& a, const Quaternion& b)
+	{
+		return Quaternion::Dot(a, b);
+	}
+
+	inline Quaternion Concatenate(const Quaternion& a, const Quaternion& b)
+	{
+		// xyz = a.w * b.xyz + b.w * a.xyz + cross(a.xyz, b.xyz), w = a.w * b.w - dot(a.xyz, b.xyz).
+		SIMD::Float4 quatA = SIMD::Load(a);
+		SIMD::Float4 quatB = SIMD::Load(b);
+		SIMD::Float4 flipW = SIMD::Set(1.0f, 1.0f, 1.0f, -1.0f);
+		SIMD::Float4 result = SIMD::Mul(SIMD::Shuffle<3, 3, 3, 3>(quatA), quatB);
+		result = SIMD::MulAdd(SIMD::Shuffle<0, 1, 2, 0>(quatA),
+			SIMD::Mul(SIMD::Shuffle<3, 3, 3, 0>(quatB), flipW), result);
+		result = SIMD::MulAdd(SIMD::Mul(SIMD::Shuffle<1, 2, 0, 1>(quatA),
+			SIMD::Shuffle<2, 0, 1, 1>(quatB)), flipW, result);
+		result = SIMD::Sub(result, SIMD::Mul(SIMD::Shuffle<2, 0, 1, 2>(quatA),
+			SIMD::Shuffle<1, 2, 0, 2>(quatB)));
+		return SIMD::ToQuaternion(result);
+	}
 }
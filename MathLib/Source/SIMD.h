@@ -0,0 +1,323 @@
+#pragma once
+
+// Selects the SIMD instruction set at compile time, SSE on x86 & x64, NEON on ARM64
+// & a scalar fallback everywhere else. Define MATHLIB_NO_SIMD to force the fallback.
+// The instruction set must match in every project that includes the math headers.
+#if !defined(MATHLIB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATHLIB_SIMD_SSE 1
+#include <emmintrin.h>
+// The dot product instruction is only used when the compiler targets SSE4.1, e.g. /arch:AVX or -msse4.1.
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define MATHLIB_SIMD_SSE4 1
+#include <smmintrin.h>
+#endif
+#elif !defined(MATHLIB_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#define MATHLIB_SIMD_NEON 1
+#include <arm_neon.h>
+#include <cstdint>
+#else
+#define MATHLIB_SIMD_SCALAR 1
+#endif
+
+namespace MathLib::SIMD
+{
+
+#if MATHLIB_SIMD_SSE
+	using Float4 = __m128;
+#elif MATHLIB_SIMD_NEON
+	using Float4 = float32x4_t;
+#else
+	struct Float4
+	{
+		float v[4];
+	};
+#endif
+
+	// Loads four floats, the values don't need to be aligned.
+	inline Float4 Load(const float* values)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_loadu_ps(values);
+#elif MATHLIB_SIMD_NEON
+		return vld1q_f32(values);
+#else
+		return Float4{ { values[0], values[1], values[2], values[3] } };
+#endif
+	}
+
+	// Loads three floats without reading past them, the w component is zero.
+	inline Float4 Load3(const float* values)
+	{
+#if MATHLIB_SIMD_SSE
+		__m128 xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(values));
+		return _mm_movelh_ps(xy, _mm_load_ss(values + 2));
+#elif MATHLIB_SIMD_NEON
+		return vcombine_f32(vld1_f32(values), vld1_lane_f32(values + 2, vdup_n_f32(0.0f), 0));
+#else
+		return Float4{ { values[0], values[1], values[2], 0.0f } };
+#endif
+	}
+
+	inline void Store(float* outValues, Float4 v)
+	{
+#if MATHLIB_SIMD_SSE
+		_mm_storeu_ps(outValues, v);
+#elif MATHLIB_SIMD_NEON
+		vst1q_f32(outValues, v);
+#else
+		outValues[0] = v.v[0];
+		outValues[1] = v.v[1];
+		outValues[2] = v.v[2];
+		outValues[3] = v.v[3];
+#endif
+	}
+
+	// Stores the x, y & z components without writing past them.
+	inline void Store3(float* outValues, Float4 v)
+	{
+#if MATHLIB_SIMD_SSE
+		_mm_storel_pi(reinterpret_cast<__m64*>(outValues), v);
+		_mm_store_ss(outValues + 2, _mm_movehl_ps(v, v));
+#elif MATHLIB_SIMD_NEON
+		vst1_f32(outValues, vget_low_f32(v));
+		vst1q_lane_f32(outValues + 2, v, 2);
+#else
+		outValues[0] = v.v[0];
+		outValues[1] = v.v[1];
+		outValues[2] = v.v[2];
+#endif
+	}
+
+	inline Float4 Set(float x, float y, float z, float w)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_set_ps(w, z, y, x);
+#elif MATHLIB_SIMD_NEON
+		const float values[4] = { x, y, z, w };
+		return vld1q_f32(values);
+#else
+		return Float4{ { x, y, z, w } };
+#endif
+	}
+
+	// Sets every component to the value.
+	inline Float4 Splat(float value)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_set1_ps(value);
+#elif MATHLIB_SIMD_NEON
+		return vdupq_n_f32(value);
+#else
+		return Float4{ { value, value, value, value } };
+#endif
+	}
+
+	inline float GetX(Float4 v)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_cvtss_f32(v);
+#elif MATHLIB_SIMD_NEON
+		return vgetq_lane_f32(v, 0);
+#else
+		return v.v[0];
+#endif
+	}
+
+	/**
+	 * Rearranges the components, the result is (v[X], v[Y], v[Z], v[W]).
+	 */
+	template<int X, int Y, int Z, int W>
+	inline Float4 Shuffle(Float4 v)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+#elif MATHLIB_SIMD_NEON
+		Float4 result = vdupq_n_f32(vgetq_lane_f32(v, X));
+		result = vsetq_lane_f32(vgetq_lane_f32(v, Y), result, 1);
+		result = vsetq_lane_f32(vgetq_lane_f32(v, Z), result, 2);
+		return vsetq_lane_f32(vgetq_lane_f32(v, W), result, 3);
+#else
+		return Float4{ { v.v[X], v.v[Y], v.v[Z], v.v[W] } };
+#endif
+	}
+
+	/**
+	 * Combines the components of two vectors, the result is (a[X], a[Y], b[Z], b[W]).
+	 */
+	template<int X, int Y, int Z, int W>
+	inline Float4 Shuffle(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+#elif MATHLIB_SIMD_NEON
+		Float4 result = vdupq_n_f32(vgetq_lane_f32(a, X));
+		result = vsetq_lane_f32(vgetq_lane_f32(a, Y), result, 1);
+		result = vsetq_lane_f32(vgetq_lane_f32(b, Z), result, 2);
+		return vsetq_lane_f32(vgetq_lane_f32(b, W), result, 3);
+#else
+		return Float4{ { a.v[X], a.v[Y], b.v[Z], b.v[W] } };
+#endif
+	}
+
+	inline Float4 Add(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_add_ps(a, b);
+#elif MATHLIB_SIMD_NEON
+		return vaddq_f32(a, b);
+#else
+		return Float4{ { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+#endif
+	}
+
+	inline Float4 Sub(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_sub_ps(a, b);
+#elif MATHLIB_SIMD_NEON
+		return vsubq_f32(a, b);
+#else
+		return Float4{ { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } };
+#endif
+	}
+
+	inline Float4 Mul(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_mul_ps(a, b);
+#elif MATHLIB_SIMD_NEON
+		return vmulq_f32(a, b);
+#else
+		return Float4{ { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+#endif
+	}
+
+	inline Float4 Div(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_div_ps(a, b);
+#elif MATHLIB_SIMD_NEON
+		return vdivq_f32(a, b);
+#else
+		return Float4{ { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } };
+#endif
+	}
+
+	// Gets a * b + c, the rounding can differ from the separate operations on NEON.
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)
+	{
+#if MATHLIB_SIMD_NEON
+		return vfmaq_f32(c, a, b);
+#else
+		return Add(Mul(a, b), c);
+#endif
+	}
+
+	inline Float4 Negate(Float4 v)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_xor_ps(v, _mm_set1_ps(-0.0f));
+#elif MATHLIB_SIMD_NEON
+		return vnegq_f32(v);
+#else
+		return Float4{ { -v.v[0], -v.v[1], -v.v[2], -v.v[3] } };
+#endif
+	}
+
+	inline Float4 Min(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_min_ps(a, b);
+#elif MATHLIB_SIMD_NEON
+		return vminq_f32(a, b);
+#else
+		return Float4{ { a.v[0] < b.v[0] ? a.v[0] : b.v[0], a.v[1] < b.v[1] ? a.v[1] : b.v[1],
+			a.v[2] < b.v[2] ? a.v[2] : b.v[2], a.v[3] < b.v[3] ? a.v[3] : b.v[3] } };
+#endif
+	}
+
+	inline Float4 Max(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_max_ps(a, b);
+#elif MATHLIB_SIMD_NEON
+		return vmaxq_f32(a, b);
+#else
+		return Float4{ { a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1],
+			a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3] } };
+#endif
+	}
+
+	// Gets a bit per component that's set when a <= b, the bits of the nan components aren't set.
+	inline int LessEqualMask(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE
+		return _mm_movemask_ps(_mm_cmple_ps(a, b));
+#elif MATHLIB_SIMD_NEON
+		const uint32_t bits[4] = { 1, 2, 4, 8 };
+		return (int)vaddvq_u32(vandq_u32(vcleq_f32(a, b), vld1q_u32(bits)));
+#else
+		return (a.v[0] <= b.v[0] ? 1 : 0) | (a.v[1] <= b.v[1] ? 2 : 0)
+			| (a.v[2] <= b.v[2] ? 4 : 0) | (a.v[3] <= b.v[3] ? 8 : 0);
+#endif
+	}
+
+	inline float Dot4(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE4
+		return _mm_cvtss_f32(_mm_dp_ps(a, b, 0xFF));
+#elif MATHLIB_SIMD_SSE
+		__m128 products = _mm_mul_ps(a, b);
+		__m128 sums = _mm_add_ps(products, _mm_movehl_ps(products, products));
+		sums = _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(sums);
+#elif MATHLIB_SIMD_NEON
+		return vaddvq_f32(vmulq_f32(a, b));
+#else
+		return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3];
+#endif
+	}
+
+	// The dot product of the x, y & z components.
+	inline float Dot3(Float4 a, Float4 b)
+	{
+#if MATHLIB_SIMD_SSE4
+		return _mm_cvtss_f32(_mm_dp_ps(a, b, 0x7F));
+#elif MATHLIB_SIMD_SSE
+		__m128 products = _mm_mul_ps(a, b);
+		__m128 sums = _mm_add_ss(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(1, 1, 1, 1)));
+		sums = _mm_add_ss(sums, _mm_movehl_ps(products, products));
+		return _mm_cvtss_f32(sums);
+#elif MATHLIB_SIMD_NEON
+		return vaddvq_f32(vsetq_lane_f32(0.0f, vmulq_f32(a, b), 3));
+#else
+		return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2];
+#endif
+	}
+
+	// Transposes the rows in place, the rows become the columns.
+	inline void Transpose(Float4& row0, Float4& row1, Float4& row2, Float4& row3)
+	{
+#if MATHLIB_SIMD_SSE
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+#elif MATHLIB_SIMD_NEON
+		float32x4_t low02 = vzip1q_f32(row0, row2);
+		float32x4_t high02 = vzip2q_f32(row0, row2);
+		float32x4_t low13 = vzip1q_f32(row1, row3);
+		float32x4_t high13 = vzip2q_f32(row1, row3);
+		row0 = vzip1q_f32(low02, low13);
+		row1 = vzip2q_f32(low02, low13);
+		row2 = vzip1q_f32(high02, high13);
+		row3 = vzip2q_f32(high02, high13);
+#else
+		Float4 rows[4] = { row0, row1, row2, row3 };
+		for (int r = 0; r < 4; r++)
+		{
+			row0.v[r] = rows[r].v[0];
+			row1.v[r] = rows[r].v[1];
+			row2.v[r] = rows[r].v[2];
+			row3.v[r] = rows[r].v[3];
+		}
+#endif
+	}
+}
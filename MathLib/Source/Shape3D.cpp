@@ -1,6 +1,7 @@
 #include "MathPCH.h"
 #include "Shape3D.h"
 #include "Geometry3D.h"
+#include "Matrix.h"
 #include "MathLib.h"
 
 namespace MathLib
@@ -503,4 +504,330 @@ namespace MathLib
 	{
 		return circle.Intersects(segment, position);
 	}
-}
\ No newline at end of file
+
+	// ------------------------------------ OBB 3D Implementation ----------------------------
+
+	// Keeps the axes that are nearly parallel from giving a zero separating axis.
+	static const float c_parallelAxisEpsilon = 1e-6f;
+
+	OBB3D::OBB3D(const Vector3& center, const Vector3& size, const Quaternion& rotation)
+		: center(center), size(size), rotation(rotation)
+	{
+	}
+
+	OBB3D::OBB3D(const Rect3D& rect)
+		: center(rect.center), size(rect.size), rotation(Quaternion::Identity)
+	{
+	}
+
+	void OBB3D::GetAxes(Vector3 (&outAxes)[3]) const
+	{
+		// The rows of the rotation matrix, the same as rotating the unit axes.
+		float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+		outAxes[0] = Vector3(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y));
+		outAxes[1] = Vector3(2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x));
+		outAxes[2] = Vector3(2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y));
+	}
+
+	bool OBB3D::IsPointWithin(const Vector3& point) const
+	{
+		Vector3 axes[3];
+		GetAxes(axes);
+		Vector3 offset = point - center;
+		return Abs(Dot(offset, axes[0])) <= size.x * 0.5f
+			&& Abs(Dot(offset, axes[1])) <= size.y * 0.5f
+			&& Abs(Dot(offset, axes[2])) <= size.z * 0.5f;
+	}
+
+	bool IsPointWithin(const OBB3D& box, const Vector3& point)
+	{
+		return box.IsPointWithin(point);
+	}
+
+	// ------------------------------------ Capsule 3D Implementation ------------------------
+
+	// The line segments shorter than this are treated as points.
+	static const float c_minSegmentLengthSquared = 1e-12f;
+
+	Capsule3D::Capsule3D(const Vector3& point1, const Vector3& point2, float radius)
+		: point1(point1), point2(point2), radius(radius)
+	{
+	}
+
+	Vector3 Capsule3D::GetClosestPoint(const Vector3& point) const
+	{
+		Vector3 direction = point2 - point1;
+		float lengthSquared = direction.LengthSquared();
+		if (lengthSquared <= c_minSegmentLengthSquared)
+		{
+			return point1;
+		}
+		float t = Clamp01(Dot(point - point1, direction) / lengthSquared);
+		return point1 + direction * t;
+	}
+
+	bool Capsule3D::IsPointWithin(const Vector3& point) const
+	{
+		return (point - GetClosestPoint(point)).LengthSquared() <= radius * radius;
+	}
+
+	bool IsPointWithin(const Capsule3D& capsule, const Vector3& point)
+	{
+		return capsule.IsPointWithin(point);
+	}
+
+	// Gets the squared distance between the closest points of the line segments p1-q1 & p2-q2.
+	static float GetSegmentsDistanceSquared(const Vector3& p1, const Vector3& q1,
+		const Vector3& p2, const Vector3& q2)
+	{
+		Vector3 direction1 = q1 - p1;
+		Vector3 direction2 = q2 - p2;
+		Vector3 offset = p1 - p2;
+		float lengthSquared1 = direction1.LengthSquared();
+		float lengthSquared2 = direction2.LengthSquared();
+		float projected2 = Dot(direction2, offset);
+
+		// The closest points are at p1 + direction1 * s & p2 + direction2 * t.
+		float s = 0.0f, t = 0.0f;
+		if (lengthSquared1 <= c_minSegmentLengthSquared)
+		{
+			if (lengthSquared2 > c_minSegmentLengthSquared)
+			{
+				t = Clamp01(projected2 / lengthSquared2);
+			}
+		}
+		else
+		{
+			float projected1 = Dot(direction1, offset);
+			if (lengthSquared2 <= c_minSegmentLengthSquared)
+			{
+				s = Clamp01(-projected1 / lengthSquared1);
+			}
+			else
+			{
+				float directionsDot = Dot(direction1, direction2);
+				float denominator = lengthSquared1 * lengthSquared2 - directionsDot * directionsDot;
+				// Parallel segments pick an arbitrary s.
+				if (denominator > 0.0f)
+				{
+					s = Clamp01((directionsDot * projected2 - projected1 * lengthSquared2) / denominator);
+				}
+				t = (directionsDot * s + projected2) / lengthSquared2;
+				if (t < 0.0f)
+				{
+					t = 0.0f;
+					s = Clamp01(-projected1 / lengthSquared1);
+				}
+				else if (t > 1.0f)
+				{
+					t = 1.0f;
+					s = Clamp01((directionsDot - projected1) / lengthSquared1);
+				}
+			}
+		}
+		return (p1 + direction1 * s - (p2 + direction2 * t)).LengthSquared();
+	}
+
+	// ------------------------------------ Frustum 3D Implementation ------------------------
+
+	Frustum3D Frustum3D::FromViewProjection(const Matrix4x4& viewProjection, float nearDepth)
+	{
+		// Row vectors get transformed by pos * viewProjection, so clip.x = dot((pos, 1), column 0).
+		const auto& m = viewProjection.matrix;
+		auto getPlane = [&m](size_t column, float columnScale, float wScale) -> Plane3D
+		{
+			Vector3 normal(m[0][column] * columnScale + m[0][3] * wScale,
+				m[1][column] * columnScale + m[1][3] * wScale,
+				m[2][column] * columnScale + m[2][3] * wScale);
+			float distance = m[3][column] * columnScale + m[3][3] * wScale;
+			float length = normal.Length();
+			return Plane3D(normal / length, distance / length);
+		};
+
+		Frustum3D frustum;
+		frustum.planes[0] = getPlane(0, 1.0f, 1.0f);
+		frustum.planes[1] = getPlane(0, -1.0f, 1.0f);
+		frustum.planes[2] = getPlane(1, 1.0f, 1.0f);
+		frustum.planes[3] = getPlane(1, -1.0f, 1.0f);
+		frustum.planes[4] = getPlane(2, 1.0f, -nearDepth);
+		frustum.planes[5] = getPlane(2, -1.0f, 1.0f);
+		return frustum;
+	}
+
+	bool Frustum3D::IsPointWithin(const Vector3& point) const
+	{
+		for (const Plane3D& plane : planes)
+		{
+			if (Dot(plane.normal, point) + plane.distanceFromZero < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool IsPointWithin(const Frustum3D& frustum, const Vector3& point)
+	{
+		return frustum.IsPointWithin(point);
+	}
+
+	// ------------------------------------ Shape Overlap Implementation ---------------------
+
+	bool Intersects(const Sphere3D& a, const Sphere3D& b)
+	{
+		float radius = a.radius + b.radius;
+		return (a.center - b.center).LengthSquared() <= radius * radius;
+	}
+
+	bool Intersects(const Sphere3D& sphere, const Rect3D& rect)
+	{
+		Vector3 closestPoint = Min(Max(sphere.center, rect.GetMin()), rect.GetMax());
+		return (sphere.center - closestPoint).LengthSquared() <= sphere.radius * sphere.radius;
+	}
+
+	bool Intersects(const Rect3D& a, const Rect3D& b)
+	{
+		Vector3 offset = a.center - b.center;
+		Vector3 size = (a.size + b.size) * 0.5f;
+		return Abs(offset.x) <= size.x
+			&& Abs(offset.y) <= size.y
+			&& Abs(offset.z) <= size.z;
+	}
+
+	bool Intersects(const OBB3D& a, const OBB3D& b)
+	{
+		// The separating axis test, the axes are the boxes' axes & the cross products between them.
+		Vector3 aAxes[3], bAxes[3];
+		a.GetAxes(aAxes);
+		b.GetAxes(bAxes);
+		const float aExtents[3] = { a.size.x * 0.5f, a.size.y * 0.5f, a.size.z * 0.5f };
+		const float bExtents[3] = { b.size.x * 0.5f, b.size.y * 0.5f, b.size.z * 0.5f };
+
+		// The rotation from b to a & the offset between the centers in a's space.
+		float rotation[3][3], absRotation[3][3];
+		for (size_t i = 0; i < 3; i++)
+		{
+			for (size_t j = 0; j < 3; j++)
+			{
+				rotation[i][j] = Dot(aAxes[i], bAxes[j]);
+				absRotation[i][j] = Abs(rotation[i][j]) + c_parallelAxisEpsilon;
+			}
+		}
+		Vector3 centerOffset = b.center - a.center;
+		const float offset[3] = { Dot(centerOffset, aAxes[0]),
+			Dot(centerOffset, aAxes[1]), Dot(centerOffset, aAxes[2]) };
+
+		for (size_t i = 0; i < 3; i++)
+		{
+			float bRadius = bExtents[0] * absRotation[i][0] + bExtents[1] * absRotation[i][1]
+				+ bExtents[2] * absRotation[i][2];
+			if (Abs(offset[i]) > aExtents[i] + bRadius)
+			{
+				return false;
+			}
+		}
+
+		for (size_t j = 0; j < 3; j++)
+		{
+			float aRadius = aExtents[0] * absRotation[0][j] + aExtents[1] * absRotation[1][j]
+				+ aExtents[2] * absRotation[2][j];
+			float distance = offset[0] * rotation[0][j] + offset[1] * rotation[1][j]
+				+ offset[2] * rotation[2][j];
+			if (Abs(distance) > aRadius + bExtents[j])
+			{
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < 3; i++)
+		{
+			size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+			for (size_t j = 0; j < 3; j++)
+			{
+				size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+				float aRadius = aExtents[i1] * absRotation[i2][j] + aExtents[i2] * absRotation[i1][j];
+				float bRadius = bExtents[j1] * absRotation[i][j2] + bExtents[j2] * absRotation[i][j1];
+				float distance = offset[i2] * rotation[i1][j] - offset[i1] * rotation[i2][j];
+				if (Abs(distance) > aRadius + bRadius)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool Intersects(const OBB3D& box, const Sphere3D& sphere)
+	{
+		// Clamps the sphere's center to the box in the box's space.
+		Vector3 axes[3];
+		box.GetAxes(axes);
+		Vector3 offset = sphere.center - box.center;
+		Vector3 localCenter(Dot(offset, axes[0]), Dot(offset, axes[1]), Dot(offset, axes[2]));
+		Vector3 extents = box.size * 0.5f;
+		Vector3 closestPoint = Min(Max(localCenter, -extents), extents);
+		return (localCenter - closestPoint).LengthSquared() <= sphere.radius * sphere.radius;
+	}
+
+	bool Intersects(const OBB3D& box, const Rect3D& rect)
+	{
+		return Intersects(box, OBB3D(rect));
+	}
+
+	bool Intersects(const Capsule3D& a, const Capsule3D& b)
+	{
+		float radius = a.radius + b.radius;
+		return GetSegmentsDistanceSquared(a.point1, a.point2, b.point1, b.point2) <= radius * radius;
+	}
+
+	bool Intersects(const Capsule3D& capsule, const Sphere3D& sphere)
+	{
+		float radius = capsule.radius + sphere.radius;
+		return (sphere.center - capsule.GetClosestPoint(sphere.center)).LengthSquared() <= radius * radius;
+	}
+
+	bool Intersects(const Frustum3D& frustum, const Sphere3D& sphere)
+	{
+		for (const Plane3D& plane : frustum.planes)
+		{
+			if (Dot(plane.normal, sphere.center) + plane.distanceFromZero < -sphere.radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Intersects(const Frustum3D& frustum, const Rect3D& rect)
+	{
+		// The box is outside when the corner that's furthest along the normal is behind the plane.
+		Vector3 extents = rect.size * 0.5f;
+		for (const Plane3D& plane : frustum.planes)
+		{
+			float radius = Abs(plane.normal.x) * extents.x + Abs(plane.normal.y) * extents.y
+				+ Abs(plane.normal.z) * extents.z;
+			if (Dot(plane.normal, rect.center) + plane.distanceFromZero < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Intersects(const Frustum3D& frustum, const OBB3D& box)
+	{
+		Vector3 axes[3];
+		box.GetAxes(axes);
+		Vector3 extents = box.size * 0.5f;
+		for (const Plane3D& plane : frustum.planes)
+		{
+			float radius = Abs(Dot(plane.normal, axes[0])) * extents.x
+				+ Abs(Dot(plane.normal, axes[1])) * extents.y + Abs(Dot(plane.normal, axes[2])) * extents.z;
+			if (Dot(plane.normal, box.center) + plane.distanceFromZero < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
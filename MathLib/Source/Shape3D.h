@@ -1,12 +1,14 @@
 #pragma once
 
 #include "Vector.h"
+#include "Quaternion.h"
+#include "Geometry3D.h"
+
+#include <cstddef>
 
 namespace MathLib
 {
-	struct Plane3D;
-	struct LineSegment3D;
-	struct Ray3D;
+	class Matrix4x4;
 
 	struct Rect3D
 	{
@@ -111,4 +113,84 @@ namespace MathLib
 		friend bool Intersects(const Triangle3D& sphere, const Ray3D& ray, Vector3& intersectedPoint);
 		friend bool Intersects(const Triangle3D& sphere, const Ray3D& ray);
 	};
-}
\ No newline at end of file
+
+	// A box rotated about its center, the size is along the box's own axes.
+	struct OBB3D
+	{
+		Vector3 center = Vector3::Zero;
+		Vector3 size = Vector3::One;
+		Quaternion rotation = Quaternion::Identity;
+
+		explicit OBB3D() = default;
+		explicit OBB3D(const Vector3& center, const Vector3& size, const Quaternion& rotation);
+		explicit OBB3D(const Rect3D& rect);
+
+		// Gets the directions of the box's x, y & z axes.
+		void GetAxes(Vector3 (&outAxes)[3]) const;
+
+		bool IsPointWithin(const Vector3& point) const;
+
+		friend bool IsPointWithin(const OBB3D& box, const Vector3& point);
+	};
+
+	// The points within the radius of the line segment between the two points.
+	struct Capsule3D
+	{
+		Vector3 point1 = Vector3::Zero;
+		Vector3 point2 = Vector3::UnitY;
+		float radius = 0.5f;
+
+		explicit Capsule3D() = default;
+		explicit Capsule3D(const Vector3& point1, const Vector3& point2, float radius);
+
+		// Gets the point on the capsule's line segment that's closest to the point.
+		Vector3 GetClosestPoint(const Vector3& point) const;
+
+		bool IsPointWithin(const Vector3& point) const;
+
+		friend bool IsPointWithin(const Capsule3D& capsule, const Vector3& point);
+	};
+
+	/**
+	 * The left, right, bottom, top, near & far planes of a view frustum. The plane
+	 * normals are normalized & point inwards, so the points inside of the frustum
+	 * satisfy Dot(point, normal) + distanceFromZero >= 0 for each of the planes.
+	 */
+	struct Frustum3D
+	{
+		static const size_t c_numPlanes = 6;
+
+		Plane3D planes[c_numPlanes];
+
+		explicit Frustum3D() = default;
+
+		/**
+		 * Extracts the planes from the clip space bounds, -w <= x <= w, -w <= y <= w &
+		 * nearDepth * w <= z <= w. The near depth is 0 for CreatePersp & -1 for CreateOrtho.
+		 */
+		static Frustum3D FromViewProjection(const Matrix4x4& viewProjection, float nearDepth = 0.0f);
+
+		bool IsPointWithin(const Vector3& point) const;
+
+		friend bool IsPointWithin(const Frustum3D& frustum, const Vector3& point);
+	};
+
+	// Overlap tests between the shapes, the shapes that touch overlap.
+	bool Intersects(const Sphere3D& a, const Sphere3D& b);
+	bool Intersects(const Sphere3D& sphere, const Rect3D& rect);
+	bool Intersects(const Rect3D& a, const Rect3D& b);
+	bool Intersects(const OBB3D& a, const OBB3D& b);
+	bool Intersects(const OBB3D& box, const Sphere3D& sphere);
+	bool Intersects(const OBB3D& box, const Rect3D& rect);
+	bool Intersects(const Capsule3D& a, const Capsule3D& b);
+	bool Intersects(const Capsule3D& capsule, const Sphere3D& sphere);
+
+	/**
+	 * Whether the shapes are inside or intersect the frustum. The shapes are tested against
+	 * each plane separately, so a shape near a corner of the frustum can be counted
+	 * as intersecting even though it's outside, which is fine for culling.
+	 */
+	bool Intersects(const Frustum3D& frustum, const Sphere3D& sphere);
+	bool Intersects(const Frustum3D& frustum, const Rect3D& rect);
+	bool Intersects(const Frustum3D& frustum, const OBB3D& box);
+}
@@ -0,0 +1,390 @@
+#include "MathPCH.h"
+#include "ShapePacket3D.h"
+
+#include "Vector.h"
+#include "Shape3D.h"
+#include "Geometry3D.h"
+#include "SIMD.h"
+#include "MathLib.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#include <cfloat>
+#include <cmath>
+
+namespace MathLib
+{
+
+	namespace
+	{
+
+#if defined(__AVX__)
+		using Lanes = __m256;
+
+		inline Lanes LoadLanes(const float* values) { return _mm256_loadu_ps(values); }
+		inline void StoreLanes(float* outValues, Lanes v) { _mm256_storeu_ps(outValues, v); }
+		inline Lanes SplatLanes(float value) { return _mm256_set1_ps(value); }
+		inline Lanes AddLanes(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+		inline Lanes SubLanes(Lanes a, Lanes b) { return _mm256_sub_ps(a, b); }
+		inline Lanes MulLanes(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+		inline Lanes DivLanes(Lanes a, Lanes b) { return _mm256_div_ps(a, b); }
+		// Returns b when a component is nan.
+		inline Lanes MinLanes(Lanes a, Lanes b) { return _mm256_min_ps(a, b); }
+		inline Lanes MaxLanes(Lanes a, Lanes b) { return _mm256_max_ps(a, b); }
+		inline uint32_t LessEqualMask(Lanes a, Lanes b) { return (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)); }
+#else
+		// Two halves of four lanes.
+		struct Lanes
+		{
+			SIMD::Float4 low;
+			SIMD::Float4 high;
+		};
+
+		inline Lanes LoadLanes(const float* values) { return { SIMD::Load(values), SIMD::Load(values + 4) }; }
+		inline void StoreLanes(float* outValues, Lanes v) { SIMD::Store(outValues, v.low); SIMD::Store(outValues + 4, v.high); }
+		inline Lanes SplatLanes(float value) { return { SIMD::Splat(value), SIMD::Splat(value) }; }
+		inline Lanes AddLanes(Lanes a, Lanes b) { return { SIMD::Add(a.low, b.low), SIMD::Add(a.high, b.high) }; }
+		inline Lanes SubLanes(Lanes a, Lanes b) { return { SIMD::Sub(a.low, b.low), SIMD::Sub(a.high, b.high) }; }
+		inline Lanes MulLanes(Lanes a, Lanes b) { return { SIMD::Mul(a.low, b.low), SIMD::Mul(a.high, b.high) }; }
+		inline Lanes DivLanes(Lanes a, Lanes b) { return { SIMD::Div(a.low, b.low), SIMD::Div(a.high, b.high) }; }
+		// Returns b when a component is nan, except on NEON.
+		inline Lanes MinLanes(Lanes a, Lanes b) { return { SIMD::Min(a.low, b.low), SIMD::Min(a.high, b.high) }; }
+		inline Lanes MaxLanes(Lanes a, Lanes b) { return { SIMD::Max(a.low, b.low), SIMD::Max(a.high, b.high) }; }
+		inline uint32_t LessEqualMask(Lanes a, Lanes b)
+		{
+			return (uint32_t)(SIMD::LessEqualMask(a.low, b.low) | (SIMD::LessEqualMask(a.high, b.high) << 4));
+		}
+#endif
+
+		struct Lanes3
+		{
+			Lanes x, y, z;
+		};
+
+		inline Lanes3 SplatLanes(const Vector3& v)
+		{
+			return { SplatLanes(v.x), SplatLanes(v.y), SplatLanes(v.z) };
+		}
+
+		inline Lanes3 SubLanes(const Lanes3& a, const Lanes3& b)
+		{
+			return { SubLanes(a.x, b.x), SubLanes(a.y, b.y), SubLanes(a.z, b.z) };
+		}
+
+		inline Lanes DotLanes(const Lanes3& a, const Lanes3& b)
+		{
+			return AddLanes(AddLanes(MulLanes(a.x, b.x), MulLanes(a.y, b.y)), MulLanes(a.z, b.z));
+		}
+
+		inline Lanes3 CrossLanes(const Lanes3& a, const Lanes3& b)
+		{
+			return { SubLanes(MulLanes(a.y, b.z), MulLanes(a.z, b.y)),
+				SubLanes(MulLanes(a.z, b.x), MulLanes(a.x, b.z)),
+				SubLanes(MulLanes(a.x, b.y), MulLanes(a.y, b.x)) };
+		}
+
+		inline Lanes AbsLanes(Lanes v)
+		{
+			return MaxLanes(v, SubLanes(SplatLanes(0.0f), v));
+		}
+
+		// The triangles with a smaller determinant are parallel to the ray.
+		const float c_minTriangleDeterminant = 1e-8f;
+
+		float GetMaxDistance(const Ray3D& ray)
+		{
+			return ray.IsInfinite() ? FLT_MAX : ray.distance;
+		}
+
+		/**
+		 * A shape is outside of a plane when its center is further behind the plane
+		 * than the shape's radius along the plane's normal & inside when its center
+		 * is at least the radius in front of the plane.
+		 */
+		template<typename TGetRadiusFunc>
+		uint32_t ClassifyLanes(const Frustum3D& frustum, const Lanes3& centers,
+			const TGetRadiusFunc& getRadius, uint32_t& outContainedMask)
+		{
+			Lanes zero = SplatLanes(0.0f);
+			uint32_t mask = UINT32_MAX;
+			outContainedMask = UINT32_MAX;
+			for (const Plane3D& plane : frustum.planes)
+			{
+				Lanes distance = AddLanes(DotLanes(SplatLanes(plane.normal), centers),
+					SplatLanes(plane.distanceFromZero));
+				Lanes radius = getRadius(plane.normal);
+				mask &= LessEqualMask(SubLanes(zero, radius), distance);
+				outContainedMask &= LessEqualMask(radius, distance);
+			}
+			return mask;
+		}
+	}
+
+	Rect3DPacket::Rect3DPacket()
+		: laneMask(0)
+	{
+		for (size_t lane = 0; lane < c_numPacketLanes; lane++)
+		{
+			Clear(lane);
+		}
+	}
+
+	void Rect3DPacket::Set(size_t lane, const Vector3& min, const Vector3& max)
+	{
+		minX[lane] = min.x;
+		minY[lane] = min.y;
+		minZ[lane] = min.z;
+		maxX[lane] = max.x;
+		maxY[lane] = max.y;
+		maxZ[lane] = max.z;
+		laneMask |= 1u << lane;
+	}
+
+	void Rect3DPacket::Set(size_t lane, const Rect3D& rect)
+	{
+		Set(lane, rect.GetMin(), rect.GetMax());
+	}
+
+	void Rect3DPacket::Clear(size_t lane)
+	{
+		// Keeps the unused lanes finite.
+		Set(lane, Vector3::Zero, Vector3::Zero);
+		laneMask &= ~(1u << lane);
+	}
+
+	Sphere3DPacket::Sphere3DPacket()
+		: laneMask(0)
+	{
+		for (size_t lane = 0; lane < c_numPacketLanes; lane++)
+		{
+			Clear(lane);
+		}
+	}
+
+	void Sphere3DPacket::Set(size_t lane, const Vector3& center, float radius)
+	{
+		centerX[lane] = center.x;
+		centerY[lane] = center.y;
+		centerZ[lane] = center.z;
+		this->radius[lane] = radius;
+		laneMask |= 1u << lane;
+	}
+
+	void Sphere3DPacket::Set(size_t lane, const Sphere3D& sphere)
+	{
+		Set(lane, sphere.center, sphere.radius);
+	}
+
+	void Sphere3DPacket::Clear(size_t lane)
+	{
+		Set(lane, Vector3::Zero, 0.0f);
+		laneMask &= ~(1u << lane);
+	}
+
+	OBB3DPacket::OBB3DPacket()
+		: laneMask(0)
+	{
+		for (size_t lane = 0; lane < c_numPacketLanes; lane++)
+		{
+			Clear(lane);
+		}
+	}
+
+	void OBB3DPacket::Set(size_t lane, const OBB3D& box)
+	{
+		Vector3 axes[3];
+		box.GetAxes(axes);
+		const float extents[3] = { box.size.x * 0.5f, box.size.y * 0.5f, box.size.z * 0.5f };
+		centerX[lane] = box.center.x;
+		centerY[lane] = box.center.y;
+		centerZ[lane] = box.center.z;
+		for (size_t i = 0; i < 3; i++)
+		{
+			axisX[i][lane] = axes[i].x * extents[i];
+			axisY[i][lane] = axes[i].y * extents[i];
+			axisZ[i][lane] = axes[i].z * extents[i];
+		}
+		laneMask |= 1u << lane;
+	}
+
+	void OBB3DPacket::Clear(size_t lane)
+	{
+		Set(lane, OBB3D(Vector3::Zero, Vector3::Zero, Quaternion::Identity));
+		laneMask &= ~(1u << lane);
+	}
+
+	Triangle3DPacket::Triangle3DPacket()
+		: laneMask(0)
+	{
+		for (size_t lane = 0; lane < c_numPacketLanes; lane++)
+		{
+			Clear(lane);
+		}
+	}
+
+	void Triangle3DPacket::Set(size_t lane, const Vector3& point1, const Vector3& point2, const Vector3& point3)
+	{
+		pointX[lane] = point1.x;
+		pointY[lane] = point1.y;
+		pointZ[lane] = point1.z;
+		edge1X[lane] = point2.x - point1.x;
+		edge1Y[lane] = point2.y - point1.y;
+		edge1Z[lane] = point2.z - point1.z;
+		edge2X[lane] = point3.x - point1.x;
+		edge2Y[lane] = point3.y - point1.y;
+		edge2Z[lane] = point3.z - point1.z;
+		laneMask |= 1u << lane;
+	}
+
+	void Triangle3DPacket::Set(size_t lane, const Triangle3D& triangle)
+	{
+		Set(lane, triangle.point1, triangle.point2, triangle.point3);
+	}
+
+	void Triangle3DPacket::Clear(size_t lane)
+	{
+		Set(lane, Vector3::Zero, Vector3::Zero, Vector3::Zero);
+		laneMask &= ~(1u << lane);
+	}
+
+	uint32_t Intersects(const Ray3D& ray, const Rect3DPacket& rects)
+	{
+		float distances[c_numPacketLanes];
+		return Intersects(ray, rects, distances);
+	}
+
+	uint32_t Intersects(const Ray3D& ray, const Rect3DPacket& rects, float (&outDistances)[c_numPacketLanes])
+	{
+		const float* mins[3] = { rects.minX, rects.minY, rects.minZ };
+		const float* maxs[3] = { rects.maxX, rects.maxY, rects.maxZ };
+		const float origin[3] = { ray.startPoint.x, ray.startPoint.y, ray.startPoint.z };
+		const float direction[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+
+		Lanes entry = SplatLanes(0.0f);
+		Lanes exit = SplatLanes(GetMaxDistance(ray));
+		uint32_t mask = rects.laneMask;
+		for (size_t axis = 0; axis < 3; axis++)
+		{
+			Lanes originLanes = SplatLanes(origin[axis]);
+			Lanes minLanes = LoadLanes(mins[axis]);
+			Lanes maxLanes = LoadLanes(maxs[axis]);
+			float inverseDirection = 1.0f / direction[axis];
+			if (!(std::abs(inverseDirection) <= FLT_MAX))
+			{
+				// The ray is parallel to the slab, which would give 0 * inf = nan when starting on a face.
+				mask &= LessEqualMask(minLanes, originLanes) & LessEqualMask(originLanes, maxLanes);
+				continue;
+			}
+			Lanes inverseLanes = SplatLanes(inverseDirection);
+			Lanes t0 = MulLanes(SubLanes(minLanes, originLanes), inverseLanes);
+			Lanes t1 = MulLanes(SubLanes(maxLanes, originLanes), inverseLanes);
+			entry = MaxLanes(MinLanes(t0, t1), entry);
+			exit = MinLanes(MaxLanes(t0, t1), exit);
+		}
+		StoreLanes(outDistances, entry);
+		return LessEqualMask(entry, exit) & mask;
+	}
+
+	uint32_t Intersects(const Ray3D& ray, const Triangle3DPacket& triangles)
+	{
+		float distances[c_numPacketLanes];
+		return Intersects(ray, triangles, distances);
+	}
+
+	uint32_t Intersects(const Ray3D& ray, const Triangle3DPacket& triangles, float (&outDistances)[c_numPacketLanes])
+	{
+		Lanes3 direction = SplatLanes(ray.direction);
+		Lanes3 point = { LoadLanes(triangles.pointX), LoadLanes(triangles.pointY), LoadLanes(triangles.pointZ) };
+		Lanes3 edge1 = { LoadLanes(triangles.edge1X), LoadLanes(triangles.edge1Y), LoadLanes(triangles.edge1Z) };
+		Lanes3 edge2 = { LoadLanes(triangles.edge2X), LoadLanes(triangles.edge2Y), LoadLanes(triangles.edge2Z) };
+
+		// Solves origin + t * direction = point + u * edge1 + v * edge2 with Cramer's rule.
+		Lanes3 p = CrossLanes(direction, edge2);
+		Lanes determinant = DotLanes(edge1, p);
+		Lanes inverseDeterminant = DivLanes(SplatLanes(1.0f), determinant);
+		Lanes3 offset = SubLanes(SplatLanes(ray.startPoint), point);
+		Lanes u = MulLanes(DotLanes(offset, p), inverseDeterminant);
+		Lanes3 q = CrossLanes(offset, edge1);
+		Lanes v = MulLanes(DotLanes(direction, q), inverseDeterminant);
+		Lanes t = MulLanes(DotLanes(edge2, q), inverseDeterminant);
+		StoreLanes(outDistances, t);
+
+		// The parallel triangles give infinities or nans, which fail the comparisons.
+		Lanes zero = SplatLanes(0.0f);
+		uint32_t mask = LessEqualMask(SplatLanes(c_minTriangleDeterminant * c_minTriangleDeterminant),
+			MulLanes(determinant, determinant));
+		mask &= LessEqualMask(zero, u);
+		mask &= LessEqualMask(zero, v);
+		mask &= LessEqualMask(AddLanes(u, v), SplatLanes(1.0f));
+		mask &= LessEqualMask(zero, t);
+		mask &= LessEqualMask(t, SplatLanes(GetMaxDistance(ray)));
+		return mask & triangles.laneMask;
+	}
+
+	uint32_t Intersects(const Frustum3D& frustum, const Sphere3DPacket& spheres)
+	{
+		uint32_t containedMask;
+		return Intersects(frustum, spheres, containedMask);
+	}
+
+	uint32_t Intersects(const Frustum3D& frustum, const Sphere3DPacket& spheres, uint32_t& outContainedMask)
+	{
+		Lanes3 centers = { LoadLanes(spheres.centerX), LoadLanes(spheres.centerY), LoadLanes(spheres.centerZ) };
+		Lanes radius = LoadLanes(spheres.radius);
+		uint32_t mask = ClassifyLanes(frustum, centers,
+			[radius](const Vector3&) { return radius; }, outContainedMask);
+		outContainedMask &= spheres.laneMask;
+		return mask & spheres.laneMask;
+	}
+
+	uint32_t Intersects(const Frustum3D& frustum, const Rect3DPacket& rects)
+	{
+		uint32_t containedMask;
+		return Intersects(frustum, rects, containedMask);
+	}
+
+	uint32_t Intersects(const Frustum3D& frustum, const Rect3DPacket& rects, uint32_t& outContainedMask)
+	{
+		Lanes half = SplatLanes(0.5f);
+		Lanes3 mins = { LoadLanes(rects.minX), LoadLanes(rects.minY), LoadLanes(rects.minZ) };
+		Lanes3 maxs = { LoadLanes(rects.maxX), LoadLanes(rects.maxY), LoadLanes(rects.maxZ) };
+		Lanes3 centers = { MulLanes(AddLanes(mins.x, maxs.x), half),
+			MulLanes(AddLanes(mins.y, maxs.y), half), MulLanes(AddLanes(mins.z, maxs.z), half) };
+		Lanes3 extents = SubLanes(maxs, centers);
+		uint32_t mask = ClassifyLanes(frustum, centers,
+			[&extents](const Vector3& normal)
+			{
+				Lanes3 absNormal = SplatLanes(Vector3(Abs(normal.x), Abs(normal.y), Abs(normal.z)));
+				return DotLanes(absNormal, extents);
+			}, outContainedMask);
+		outContainedMask &= rects.laneMask;
+		return mask & rects.laneMask;
+	}
+
+	uint32_t Intersects(const Frustum3D& frustum, const OBB3DPacket& boxes)
+	{
+		uint32_t containedMask;
+		return Intersects(frustum, boxes, containedMask);
+	}
+
+	uint32_t Intersects(const Frustum3D& frustum, const OBB3DPacket& boxes, uint32_t& outContainedMask)
+	{
+		Lanes3 centers = { LoadLanes(boxes.centerX), LoadLanes(boxes.centerY), LoadLanes(boxes.centerZ) };
+		Lanes3 axes[3];
+		for (size_t i = 0; i < 3; i++)
+		{
+			axes[i] = { LoadLanes(boxes.axisX[i]), LoadLanes(boxes.axisY[i]), LoadLanes(boxes.axisZ[i]) };
+		}
+		uint32_t mask = ClassifyLanes(frustum, centers,
+			[&axes](const Vector3& normal)
+			{
+				Lanes3 normalLanes = SplatLanes(normal);
+				return AddLanes(AddLanes(AbsLanes(DotLanes(normalLanes, axes[0])),
+					AbsLanes(DotLanes(normalLanes, axes[1]))), AbsLanes(DotLanes(normalLanes, axes[2])));
+			}, outContainedMask);
+		outContainedMask &= boxes.laneMask;
+		return mask & boxes.laneMask;
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MathLib
+{
+	class Vector3;
+	struct Rect3D;
+	struct Sphere3D;
+	struct OBB3D;
+	struct Triangle3D;
+	struct Ray3D;
+	struct Frustum3D;
+
+	/**
+	 * Packets of shapes stored as structures of arrays, so that a ray or a frustum gets tested
+	 * against all of the packet's shapes at once, with one AVX instruction per step when
+	 * compiled for AVX & two SSE or NEON instructions otherwise. The results are returned as
+	 * a mask with a bit per lane, the unused lanes never intersect.
+	 */
+	const size_t c_numPacketLanes = 8;
+
+	// Axis aligned boxes stored by their min & max.
+	struct alignas(32) Rect3DPacket
+	{
+		float minX[c_numPacketLanes];
+		float minY[c_numPacketLanes];
+		float minZ[c_numPacketLanes];
+		float maxX[c_numPacketLanes];
+		float maxY[c_numPacketLanes];
+		float maxZ[c_numPacketLanes];
+		// A bit per lane that's been set.
+		uint32_t laneMask;
+
+		// Every lane starts out unused.
+		explicit Rect3DPacket();
+
+		void Set(size_t lane, const Vector3& min, const Vector3& max);
+		void Set(size_t lane, const Rect3D& rect);
+		// Marks the lane as unused.
+		void Clear(size_t lane);
+	};
+
+	// Spheres stored by their center & radius.
+	struct alignas(32) Sphere3DPacket
+	{
+		float centerX[c_numPacketLanes];
+		float centerY[c_numPacketLanes];
+		float centerZ[c_numPacketLanes];
+		float radius[c_numPacketLanes];
+		// A bit per lane that's been set.
+		uint32_t laneMask;
+
+		// Every lane starts out unused.
+		explicit Sphere3DPacket();
+
+		void Set(size_t lane, const Vector3& center, float radius);
+		void Set(size_t lane, const Sphere3D& sphere);
+		// Marks the lane as unused.
+		void Clear(size_t lane);
+	};
+
+	// Oriented boxes stored by their center & their axes scaled by half of the size.
+	struct alignas(32) OBB3DPacket
+	{
+		float centerX[c_numPacketLanes];
+		float centerY[c_numPacketLanes];
+		float centerZ[c_numPacketLanes];
+		float axisX[3][c_numPacketLanes];
+		float axisY[3][c_numPacketLanes];
+		float axisZ[3][c_numPacketLanes];
+		// A bit per lane that's been set.
+		uint32_t laneMask;
+
+		// Every lane starts out unused.
+		explicit OBB3DPacket();
+
+		void Set(size_t lane, const OBB3D& box);
+		// Marks the lane as unused.
+		void Clear(size_t lane);
+	};
+
+	// Triangles stored by their first point & the edges to the other two.
+	struct alignas(32) Triangle3DPacket
+	{
+		float pointX[c_numPacketLanes];
+		float pointY[c_numPacketLanes];
+		float pointZ[c_numPacketLanes];
+		float edge1X[c_numPacketLanes];
+		float edge1Y[c_numPacketLanes];
+		float edge1Z[c_numPacketLanes];
+		float edge2X[c_numPacketLanes];
+		float edge2Y[c_numPacketLanes];
+		float edge2Z[c_numPacketLanes];
+		// A bit per lane that's been set.
+		uint32_t laneMask;
+
+		// Every lane starts out unused.
+		explicit Triangle3DPacket();
+
+		void Set(size_t lane, const Vector3& point1, const Vector3& point2, const Vector3& point3);
+		void Set(size_t lane, const Triangle3D& triangle);
+		// Marks the lane as unused.
+		void Clear(size_t lane);
+	};
+
+	/**
+	 * The slab test, the distances are where the ray enters each of the boxes, zero
+	 * when it starts inside. The distances are in multiples of the ray's direction &
+	 * only hits within the ray's distance are counted unless the ray is infinite.
+	 */
+	uint32_t Intersects(const Ray3D& ray, const Rect3DPacket& rects);
+	uint32_t Intersects(const Ray3D& ray, const Rect3DPacket& rects, float (&outDistances)[c_numPacketLanes]);
+
+	/**
+	 * The Moller-Trumbore test, both sides of the triangles are hit. The distances
+	 * are in multiples of the ray's direction & only hits within the ray's distance
+	 * are counted unless the ray is infinite.
+	 */
+	uint32_t Intersects(const Ray3D& ray, const Triangle3DPacket& triangles);
+	uint32_t Intersects(const Ray3D& ray, const Triangle3DPacket& triangles, float (&outDistances)[c_numPacketLanes]);
+
+	/**
+	 * Classifies the shapes against the frustum, the same as the scalar frustum tests. The returned
+	 * mask has the shapes that are inside or intersect the frustum & the contained mask has the
+	 * shapes that are entirely inside of it, so their children don't need to be tested.
+	 */
+	uint32_t Intersects(const Frustum3D& frustum, const Sphere3DPacket& spheres);
+	uint32_t Intersects(const Frustum3D& frustum, const Sphere3DPacket& spheres, uint32_t& outContainedMask);
+	uint32_t Intersects(const Frustum3D& frustum, const Rect3DPacket& rects);
+	uint32_t Intersects(const Frustum3D& frustum, const Rect3DPacket& rects, uint32_t& outContainedMask);
+	uint32_t Intersects(const Frustum3D& frustum, const OBB3DPacket& boxes);
+	uint32_t Intersects(const Frustum3D& frustum, const OBB3DPacket& boxes, uint32_t& outContainedMask);
+}
@@ -2,16 +2,26 @@
 #include "Transform.h"
 #include "MathLib.h"
 
+#include <atomic>
+
 namespace MathLib
 {
 	using Mat3x3 = MathLib::Matrix3x3;
 	using Mat4x4 = MathLib::Matrix4x4;
 
+	// Shared by all the transforms, so a replaced transform never gets the version of the one it replaced.
+	static std::atomic<uint32_t> s_nextVersion(1);
+
+	static uint32_t NextVersion()
+	{
+		return s_nextVersion.fetch_add(1, std::memory_order_relaxed);
+	}
+
 	Transform2D::Transform2D()
 		: m_position(Vector2::Zero),
 		m_rotation(0.0f),
 		m_scale(1.0f, 1.0f),
-		m_parentTransformMatrix(Matrix4x4::Identity)
+		m_version(NextVersion())
 	{
 	}
 
@@ -20,7 +30,7 @@ namespace MathLib
 		: m_position(pos),
 		m_rotation(rot),
 		m_scale(scale),
-		m_parentTransformMatrix(Matrix4x4::Identity)
+		m_version(NextVersion())
 	{
 	}
 
@@ -28,7 +38,7 @@ namespace MathLib
 		: m_position(transform.GetLocalPosition().x, transform.GetLocalPosition().y),
 		m_rotation(transform.GetLocalEulerAngles(false).z),
 		m_scale(transform.GetLocalScale().x, transform.GetLocalScale().y),
-		m_parentTransformMatrix(transform.GetParentTransformMatrix())
+		m_version(NextVersion())
 	{
 
 	}
@@ -38,19 +48,15 @@ namespace MathLib
 		m_position = MathLib::Vector2{ transform.GetLocalPosition().x, transform.GetLocalPosition().y };
 		m_rotation = transform.GetLocalEulerAngles().z;
 		m_scale = MathLib::Vector2{ transform.GetLocalScale().x, transform.GetLocalScale().y };
-		m_parentTransformMatrix = transform.GetParentTransformMatrix();
+		m_version = NextVersion();
 		return *this;
 	}
 
-	void Transform2D::SetParentTransformMatrix(const Matrix4x4& mat)
-	{
-		m_parentTransformMatrix = mat;
-	}
-
 	void Transform2D::SetLocalPosition(float x, float y)
 	{
 		m_position.x = x;
 		m_position.y = y;
+		m_version = NextVersion();
 	}
 
 	void Transform2D::SetLocalPosition(const Vector2& position)
@@ -72,6 +78,7 @@ namespace MathLib
 	{
 		m_scale.x = x;
 		m_scale.y = y;
+		m_version = NextVersion();
 	}
 
 	void Transform2D::SetLocalScale(const Vector2& scale)
@@ -87,6 +94,7 @@ namespace MathLib
 	void Transform2D::SetLocalRotation(float rotation, bool inDegrees)
 	{
 		m_rotation = inDegrees ? MathLib::DEG2RAD * rotation : rotation;
+		m_version = NextVersion();
 	}
 
 	float Transform2D::GetLocalRotation() const
@@ -101,9 +109,10 @@ namespace MathLib
 
 	void Transform2D::LookAt(const MathLib::Vector2& position)
 	{
-		Vector2 dir = Normalize(position - GetWorldPosition());
+		Vector2 dir = Normalize(position - m_position);
 		float angle = MathLib::ATan2(dir.y, dir.x);
 		m_rotation = angle;
+		m_version = NextVersion();
 	}
 
 	Vector2 Transform2D::GetLocalForward() const
@@ -113,32 +122,9 @@ namespace MathLib
 		return Normalize(Vector2(x, y));
 	}
 
-	Vector2 Transform2D::GetWorldPosition() const
+	Matrix4x4 Transform2D::GetTransformMatrix(const Matrix4x4& parentTransformMatrix) const
 	{
-		Vector3 worldPosition = m_parentTransformMatrix.GetTranslation();
-		return Vector2(worldPosition.x, worldPosition.y)
-			+ m_position;
-	}
-
-	Vector2 Transform2D::GetWorldForward() const
-	{
-		Vector3 parentForward = m_parentTransformMatrix.GetZAxis();
-		Vector2 forwardAdded = Vector2(parentForward.x, parentForward.y)
-			+ GetLocalForward();
-		forwardAdded.Normalize();
-		return forwardAdded;
-	}
-
-	Vector2 Transform2D::GetWorldScale() const
-	{
-		Vector3 scaleVec3 = m_parentTransformMatrix.GetScale();
-		return Vector2(scaleVec3.x, scaleVec3.y)
-			* m_scale;
-	}
-
-	Matrix4x4 Transform2D::GetTransformMatrix() const
-	{
-		return m_parentTransformMatrix * GetLocalTransformMatrix();
+		return parentTransformMatrix * GetLocalTransformMatrix();
 	}
 
 	Matrix4x4 Transform2D::GetLocalTransformMatrix() const
@@ -151,10 +137,9 @@ namespace MathLib
 
 	Transform3D::Transform3D()
 		: m_position(0.0f, 0.0f, 0.0f),
+		m_rotation(Quaternion::Identity),
 		m_scale(1.0f, 1.0f, 1.0f),
-		m_rotator(),
-		m_parentTransformMatrix(Mat4x4::Identity),
-		m_hasParentTransformMatrix(false)
+		m_version(NextVersion())
 	{
 	}
 
@@ -162,19 +147,17 @@ namespace MathLib
 	Transform3D::Transform3D(const Vector3& pos,
 		const Quaternion& rot, const Vector3& scale)
 		: m_position(pos),
+		m_rotation(rot),
 		m_scale(scale),
-		m_rotator(rot),
-		m_parentTransformMatrix(Mat4x4::Identity),
-		m_hasParentTransformMatrix(false)
+		m_version(NextVersion())
 	{
 	}
 
 	Transform3D::Transform3D(const Transform2D& transform)
 		: m_position(transform.GetLocalPosition(), 0.0f),
+		m_rotation(Quaternion::FromEuler(0.0f, 0.0f, transform.GetLocalRotation(false), false)),
 		m_scale(transform.GetLocalScale(), 1.0f),
-		m_rotator(0.0f, 0.0f, transform.GetLocalRotation(false)),
-		m_parentTransformMatrix(transform.GetParentTransformMatrix()),
-		m_hasParentTransformMatrix(false)
+		m_version(NextVersion())
 	{
 	}
 
@@ -182,18 +165,11 @@ namespace MathLib
 	{
 		m_position = MathLib::Vector3{ transform.GetLocalPosition(), 0.0f };
 		m_scale = MathLib::Vector3{ transform.GetLocalScale(), 1.0f };
-		m_rotator.eulers = MathLib::Vector3{ 0.0f, 0.0f, transform.GetLocalRotation(false) };
-		m_rotator.quaternion = Quaternion::FromEuler(m_rotator.eulers, false);
-		m_parentTransformMatrix = transform.GetParentTransformMatrix();
+		m_rotation = Quaternion::FromEuler(0.0f, 0.0f, transform.GetLocalRotation(false), false);
+		m_version = NextVersion();
 		return *this;
 	}
 
-	void Transform3D::SetParentTransformMatrix(const Matrix4x4& matrix)
-	{
-		m_hasParentTransformMatrix = matrix != MathLib::Matrix4x4::Identity;
-		m_parentTransformMatrix = matrix;
-	}
-
 	void Transform3D::SetLocalPosition(const Vector3& pos)
 	{
 		SetLocalPosition(pos.x, pos.y, pos.z);
@@ -204,6 +180,7 @@ namespace MathLib
 		m_position.x = x;
 		m_position.y = y;
 		m_position.z = z;
+		m_version = NextVersion();
 	}
 
 	const Vector3& Transform3D::GetLocalPosition() const
@@ -216,6 +193,7 @@ namespace MathLib
 		m_scale.x = x;
 		m_scale.y = y;
 		m_scale.z = z;
+		m_version = NextVersion();
 	}
 
 	void Transform3D::SetLocalScale(float s)
@@ -233,15 +211,15 @@ namespace MathLib
 		return m_scale;
 	}
 
-	MathLib::Matrix4x4 Transform3D::GetTransformMatrix() const
+	Mat4x4 Transform3D::GetTransformMatrix(const Mat4x4& parentTransformMatrix) const
 	{
-		return GetLocalTransformMatrix() * m_parentTransformMatrix;
+		return GetLocalTransformMatrix() * parentTransformMatrix;
 	}
 
 	Mat4x4 Transform3D::GetLocalTransformMatrix() const
 	{
 		return Mat4x4::CreateScale(m_scale)
-			* Mat4x4::CreateFromQuaternion(m_rotator.quaternion)
+			* Mat4x4::CreateFromQuaternion(m_rotation)
 			* Mat4x4::CreateTranslation(m_position);
 	}
 	
@@ -252,38 +230,24 @@ namespace MathLib
 
 	void Transform3D::SetLocalEulerAngles(float yaw, float pitch, float roll, bool inDegrees)
 	{
-		m_rotator.eulers.x = inDegrees ? MathLib::DEG2RAD * pitch : pitch;
-		m_rotator.eulers.y = inDegrees ? MathLib::DEG2RAD * yaw : yaw;
-		m_rotator.eulers.z = inDegrees ? MathLib::DEG2RAD * roll : roll;
-		m_rotator.quaternion = Quaternion::FromEuler(m_rotator.eulers, false);
+		m_rotation = Quaternion::FromEuler(yaw, pitch, roll, inDegrees);
+		m_version = NextVersion();
 	}
 
 	const Vector3 Transform3D::GetLocalEulerAngles(bool inDegrees) const
 	{
-		if (!inDegrees) return m_rotator.eulers;
-		return Vector3(m_rotator.eulers.x * MathLib::RAD2DEG,
-			m_rotator.eulers.y * MathLib::RAD2DEG, m_rotator.eulers.z * MathLib::RAD2DEG);
+		return m_rotation.ToEuler(inDegrees);
 	}
 
 	void Transform3D::SetLocalRotation(const Quaternion& quat)
 	{
-		m_rotator.quaternion = quat;
-		m_rotator.eulers = quat.ToEuler(false);
+		m_rotation = quat;
+		m_version = NextVersion();
 	}
 
 	const Quaternion& Transform3D::GetLocalRotation() const
 	{
-		return m_rotator.quaternion;
-	}
-
-	Vector3 Transform3D::GetWorldPosition() const
-	{
-		return m_parentTransformMatrix.GetTranslation() + m_position;
-	}
-
-	Vector3 Transform3D::GetWorldScale() const
-	{
-		return m_parentTransformMatrix.GetScale() * m_scale;
+		return m_rotation;
 	}
 
 	MathLib::Vector3 Transform3D::GetLocalForward() const
@@ -301,35 +265,11 @@ namespace MathLib
 		return Rotate(GetLocalRotation(), MathLib::Vector3::UnitZ);
 	}
 
-	Vector3 Transform3D::GetWorldForward() const
-	{
-		Vector3 combinedDirections =
-			m_parentTransformMatrix.GetZAxis() + GetLocalForward();
-		combinedDirections.Normalize();
-		return combinedDirections;
-	}
-
-	Vector3 Transform3D::GetWorldUp() const
-	{
-		Vector3 combinedDirections =
-			m_parentTransformMatrix.GetYAxis() + GetLocalUp();
-		combinedDirections.Normalize();
-		return combinedDirections;
-	}
-
-	Vector3 Transform3D::GetWorldRight() const
-	{
-		Vector3 combinedDirections =
-			m_parentTransformMatrix.GetXAxis() + GetLocalRight();
-		combinedDirections.Normalize();
-		return combinedDirections;
-	}
-
 	void Transform3D::LookAt(const MathLib::Vector3& position, const MathLib::Vector3& up)
 	{
 		Vector3 newForward = position - m_position;
 		newForward.Normalize();
-		Vector3 currentForward = GetWorldForward();
+		Vector3 currentForward = GetLocalForward();
 
 		Vector3 forwardNormal = Cross(newForward, currentForward);
 		float forwardAngle = ACos(Dot(newForward, currentForward), false);
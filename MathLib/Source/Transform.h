@@ -9,6 +9,11 @@ namespace MathLib
 {
 	class Transform3D;
 
+	/**
+	 * The local position, rotation & scale of a 2D object, the world matrix comes from
+	 * the parent's world matrix. Only stores the local values so the transforms of a
+	 * scene stay small & densely packed, the world matrices are kept separately.
+	 */
 	class Transform2D
 	{
 		using Mat3x3 = MathLib::Matrix3x3;
@@ -21,8 +26,6 @@ namespace MathLib
 
 		Transform2D& operator=(const Transform3D& transform);
 
-		void SetParentTransformMatrix(const Matrix4x4& mat);
-
 		void SetLocalPosition(float x, float y);
 		void SetLocalPosition(const Vector2& position);
 		
@@ -41,46 +44,27 @@ namespace MathLib
 
 		Vector2 GetLocalForward() const;
 
-		Vector2 GetWorldPosition() const;
-		Vector2 GetWorldForward() const;
-		Vector2 GetWorldScale() const;
-
-		Matrix4x4 GetTransformMatrix() const;
-		const Matrix4x4& GetParentTransformMatrix() const { return m_parentTransformMatrix; }
 		Matrix4x4 GetLocalTransformMatrix() const;
+		// Gets the world matrix of the transform from its parent's world matrix.
+		Matrix4x4 GetTransformMatrix(const Matrix4x4& parentTransformMatrix) const;
+
+		// Changes whenever the local values change, copies keep the version of the original.
+		uint32_t GetVersion() const { return m_version; }
 
 	private:
 		Vector2 m_position;
 		Vector2 m_scale;
 		float m_rotation;
-
-		Matrix4x4 m_parentTransformMatrix;
+		uint32_t m_version;
 	};
 
+	/**
+	 * The local position, rotation & scale of a 3D object, the world matrix comes from
+	 * the parent's world matrix. The rotation is only stored as a quaternion, the euler
+	 * angles are calculated from it.
+	 */
 	class Transform3D
 	{
-		struct TransformRotator
-		{
-			Quaternion quaternion = Quaternion::Identity;
-			Vector3 eulers = Vector3::Zero;
-
-			TransformRotator() {}
-
-			TransformRotator(const Quaternion& quat)
-				: quaternion(quat), eulers(quat.ToEuler(false))
-			{
-
-			}
-
-			TransformRotator(float yaw, float pitch, float roll, bool inDegrees = false)
-				: quaternion(Quaternion::FromEuler(yaw, pitch, roll, inDegrees)),
-				eulers(inDegrees ? pitch * DEG2RAD : pitch,
-					inDegrees ? yaw * DEG2RAD : yaw,
-					inDegrees ? roll * DEG2RAD : roll)
-			{
-			}
-		};
-
 		using Mat4x4 = MathLib::Matrix4x4;
 
 	public:
@@ -91,8 +75,6 @@ namespace MathLib
 
 		Transform3D& operator=(const Transform2D& transform);
 
-		void SetParentTransformMatrix(const Matrix4x4& matrix);
-
 		void SetLocalPosition(const Vector3& pos);
 		void SetLocalPosition(float x, float y, float z);
 		const Vector3& GetLocalPosition() const;
@@ -109,31 +91,24 @@ namespace MathLib
 		void SetLocalRotation(const Quaternion& quat);
 		const Quaternion& GetLocalRotation() const;
 
-		Vector3 GetWorldPosition() const;
-		Vector3 GetWorldScale() const;
-
 		Vector3 GetLocalForward() const;
 		Vector3 GetLocalUp() const;
 		Vector3 GetLocalRight() const;
 
-		Vector3 GetWorldForward() const;
-		Vector3 GetWorldUp() const;
-		Vector3 GetWorldRight() const;
-
 		void LookAt(const MathLib::Vector3& position, const MathLib::Vector3& up);
 		void LookAt(const MathLib::Vector3& position);
 
-		Mat4x4 GetTransformMatrix() const;
 		Mat4x4 GetLocalTransformMatrix() const;
+		// Gets the world matrix of the transform from its parent's world matrix.
+		Mat4x4 GetTransformMatrix(const Mat4x4& parentTransformMatrix) const;
 
-		const Mat4x4& GetParentTransformMatrix() const { return m_parentTransformMatrix; }
-		bool HasParentTransformMatrix() const { return m_hasParentTransformMatrix; }
+		// Changes whenever the local values change, copies keep the version of the original.
+		uint32_t GetVersion() const { return m_version; }
 
 	private:
 		MathLib::Vector3 m_position;
+		MathLib::Quaternion m_rotation;
 		MathLib::Vector3 m_scale;
-		TransformRotator m_rotator;
-		MathLib::Matrix4x4 m_parentTransformMatrix;
-		bool m_hasParentTransformMatrix;
+		uint32_t m_version;
 	};
 }
\ No newline at end of file
@@ -8,7 +8,6 @@ namespace MathLib
 {
 #pragma region vector2
 
-
 	const Vector2 Vector2::UnitX = Vector2(1.0f, 0.0f);
 
 	const Vector2 Vector2::UnitY = Vector2(0.0f, 1.0f);
@@ -17,7 +16,6 @@ namespace MathLib
 
 	const Vector2 Vector2::One = Vector2(1.0f, 1.0f);
 
-
 	Vector2::Vector2()
 		: x(0.0f), y(0.0f) { }
 
@@ -226,7 +224,6 @@ namespace MathLib
 
 #pragma region vector3
 
-
 	const Vector3 Vector3::UnitX = Vector3(1.0f, 0.0f, 0.0f);
 
 	const Vector3 Vector3::UnitY = Vector3(0.0f, 1.0f, 0.0f);
@@ -237,22 +234,6 @@ namespace MathLib
 	
 	const Vector3 Vector3::Zero = Vector3(0.0f, 0.0f, 0.0f);
 
-	Vector3::Vector3()
-		: x(0.0f), y(0.0f), z(0.0f) { }
-
-
-	Vector3::Vector3(float x, float y, float z)
-		: x(x), y(y), z(z) { }
-
-	Vector3::Vector3(const Vector2& vec, float z)
-		: x(vec.x), y(vec.y), z(z) { }
-
-	Vector3::Vector3(const Vector3& vec)
-		: x(vec.x), y(vec.y), z(vec.z) { }
-
-	Vector3::Vector3(const Vector4& vec)
-		: x(vec.x), y(vec.y), z(vec.z) { }
-
 	Vector3& Vector3::operator=(const Vector2& vec)
 	{
 		x = vec.x;
@@ -274,11 +255,6 @@ namespace MathLib
 		return Sqrt(LengthSquared());
 	}
 
-	float Vector3::LengthSquared() const
-	{
-		return x * x + y * y + z * z;
-	}
-
 	void Vector3::Normalize()
 	{
 		float length = Length();
@@ -287,29 +263,6 @@ namespace MathLib
 		z /= length;
 	}
 
-	float Dot(const Vector3& a, const Vector3& b)
-	{
-        return Vector3::Dot(a, b);
-	}
-
-    float Vector3::Dot(const Vector3& a, const Vector3& b)
-    {
-        return a.x * b.x + a.y * b.y + a.z * b.z;
-    }
-
-	Vector3 Cross(const Vector3& a, const Vector3& b)
-	{
-        return Vector3::Cross(a, b);
-	}
-
-    Vector3 Vector3::Cross(const Vector3& a, const Vector3& b)
-    {
-        return Vector3(
-            a.y * b.z - a.z * b.y,
-            a.z * b.x - a.x * b.z,
-            a.x * b.y - a.y * b.x);
-    }
-
 	Vector3 Reflect(const Vector3& vec, const Vector3& normal)
 	{
 		return vec - 2.0f * Dot(vec, normal) * normal;
@@ -387,28 +340,11 @@ namespace MathLib
 			|| !IsCloseEnough(a.z, b.z);
 	}
 
-	Vector3 operator+(const Vector3& a, const Vector3& b)
-	{
-		return Vector3(
-			a.x + b.x, a.y + b.y, a.z + b.z);
-	}
-
 	Vector3 operator+(const Vector3& a, const Vector2& b)
 	{
 		return Vector3(a.x + b.x, a.y + b.y, a.z);
 	}
 
-	Vector3 operator-(const Vector3& vec)
-	{
-		return Vector3(-vec.x, -vec.y, -vec.z);
-	}
-
-	Vector3 operator-(const Vector3& a, const Vector3& b)
-	{
-		return Vector3(
-			a.x - b.x, a.y - b.y, a.z - b.z);
-	}
-
 	Vector3 operator-(const Vector3& a, const Vector2& b)
 	{
 		return Vector3(a.x - b.x, a.y - b.y, a.z);
@@ -420,36 +356,6 @@ namespace MathLib
 			a.x * b.x, a.y * b.y, a.z * 0.0f);
 	}
 
-	Vector3 operator*(const Vector3& a, const Vector3& b)
-	{
-		return Vector3(
-			a.x * b.x, a.y * b.y, a.z * b.z);
-	}
-
-	Vector3 operator*(const Vector3& a, float scalar)
-	{
-		return Vector3(
-			a.x * scalar, a.y * scalar, a.z * scalar);
-	}
-
-	Vector3 operator*(float scalar, const Vector3& vec)
-	{
-		return Vector3(
-			vec.x * scalar, vec.y * scalar, vec.z * scalar);
-	}
-
-	Vector3 operator/(const Vector3& a, const Vector3& b)
-	{
-		return Vector3(
-			a.x / b.x, a.y / b.y, a.z / b.z);
-	}
-
-	Vector3 operator/(const Vector3& a, float scalar)
-	{
-		return Vector3(
-			a.x / scalar, a.y / scalar, a.z / scalar);
-	}
-
 	Vector3 operator*(const Vector3& vec, const Matrix3x3& mat)
 	{
 		return Vector3(
@@ -463,14 +369,6 @@ namespace MathLib
 		return vec * mat;
 	}
 
-	Vector3& Vector3::operator+=(const Vector3& v)
-	{
-		x += v.x;
-		y += v.y;
-		z += v.z;
-		return *this;
-	}
-
 	Vector3& Vector3::operator+=(const Vector2& v)
 	{
 		x += v.x;
@@ -478,14 +376,6 @@ namespace MathLib
 		return *this;
 	}
 
-	Vector3& Vector3::operator-=(const Vector3& v)
-	{
-		x -= v.x;
-		y -= v.y;
-		z -= v.z;
-		return *this;
-	}
-
 	Vector3& Vector3::operator-=(const Vector2& v)
 	{
 		x -= v.x;
@@ -493,38 +383,6 @@ namespace MathLib
 		return *this;
 	}
 
-	Vector3& Vector3::operator*=(const Vector3& v)
-	{
-		x *= v.x;
-		y *= v.y;
-		z *= v.z;
-		return *this;
-	}
-
-	Vector3& Vector3::operator*=(float scalar)
-	{
-		x *= scalar;
-		y *= scalar;
-		z *= scalar;
-		return *this;
-	}
-
-	Vector3& Vector3::operator/=(const Vector3& v)
-	{
-		x /= v.x;
-		y /= v.y;
-		z /= v.z;
-		return *this;
-	}
-
-	Vector3& Vector3::operator/=(float scalar)
-	{
-		x /= scalar;
-		y /= scalar;
-		z /= scalar;
-		return *this;
-	}
-
 #pragma endregion
 
 #pragma region vector4
@@ -536,25 +394,9 @@ namespace MathLib
 	const Vector4 Vector4::One = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
 	const Vector4 Vector4::Zero = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
 
-	Vector4::Vector4()
-		: x(0.0f), y(0.0f), z(0.0f), w(0.0f) { }
-
-
-	Vector4::Vector4(float x, float y, float z, float w)
-		: x(x), y(y), z(z), w(w) { }
-
 	
-	Vector4::Vector4(const Vector2& vec, float z, float w)
-		: x(vec.x), y(vec.y), z(z), w(w) { }
-
 	
-	Vector4::Vector4(const Vector3& vec, float w)
-		: x(vec.x), y(vec.y), z(vec.z), w(w) { }
-
 	
-	Vector4::Vector4(const Vector4& vec)
-		: x(vec.x), y(vec.y), z(vec.z), w(vec.w) { }
-
 
 	Vector4& Vector4::operator=(const Vector3& vec)
 	{
@@ -579,11 +421,6 @@ namespace MathLib
 		return Sqrt(LengthSquared());
 	}
 
-	float Vector4::LengthSquared() const
-	{
-		return x * x + y * y + z * z + w * w;
-	}
-
 	void Vector4::Normalize()
 	{
 		float length = Length();
@@ -603,11 +440,6 @@ namespace MathLib
 		return IsCloseEnough(vec.LengthSquared(), 1.0f);
 	}
 
-	float Dot(const Vector4& a, const Vector4& b)
-	{
-		return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
-	}
-
 	Vector4 Reflect(const Vector4& vec, const Vector4& normal)
 	{
 		return vec - 2.0f * Dot(vec, normal) * normal;
@@ -624,18 +456,6 @@ namespace MathLib
 		return Lerp(a, b, alpha);
 	}
 
-	Vector4 Min(const Vector4& a, const Vector4& b)
-	{
-		return Vector4(
-			Min(a.x, b.x), Min(a.y, b.y), Min(a.z, b.z), Min(a.w, b.w));
-	}
-
-	Vector4 Max(const Vector4& a, const Vector4& b)
-	{
-		return Vector4(
-			Max(a.x, b.x), Max(a.y, b.y), Max(a.z, b.z), Max(a.w, b.w));
-	}
-
 	Vector4 Normalize(const Vector4& in)
 	{
 		Vector4 out(in);
@@ -659,121 +479,6 @@ namespace MathLib
 			|| !IsCloseEnough(a.w, b.w);
 	}
 
-	Vector4 operator+(const Vector4& a, const Vector4& b)
-	{
-		return Vector4(
-			a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
-	}
-
-	Vector4 operator-(const Vector4& a, const Vector4& b)
-	{
-		return Vector4(
-			a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
-	}
-
-	Vector4 operator-(const Vector4& vec)
-	{
-		return Vector4(-vec.x, -vec.y, -vec.z, -vec.w);
-	}
-
-	Vector4 operator*(const Vector4& a, const Vector4& b)
-	{
-		return Vector4(
-			a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w);
-	}
-
-	Vector4 operator*(const Vector4& a, float scalar)
-	{
-		return Vector4(
-			a.x * scalar, a.y * scalar, a.z * scalar, a.w * scalar);
-	}
-
-	Vector4 operator*(float scalar, const Vector4& a)
-	{
-		return Vector4(
-			a.x * scalar, a.y * scalar, a.z * scalar, a.w * scalar);
-	}
-
-	Vector4 operator/(const Vector4& a, const Vector4& b)
-	{
-		return Vector4(
-			a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w);
-	}
-
-	Vector4 operator/(const Vector4& a, float scalar)
-	{
-		return Vector4(
-			a.x / scalar, a.y / scalar, a.z / scalar, a.w / scalar);
-	}
-
-	Vector4 operator*(const Vector4& a, const Matrix4x4& b)
-	{
-		return Vector4(
-			a.x * b[0][0] + a.y * b[0][1] + a.z * b[0][2] + a.w * b[0][3],
-			a.y * b[1][0] + a.y * b[1][1] + a.z * b[1][2] + a.w * b[1][3],
-			a.z * b[2][0] + a.y * b[2][1] + a.z * b[2][2] + a.w * b[2][3],
-			a.w * b[3][0] + a.y * b[3][1] + a.z * b[3][2] + a.w * b[3][3]);
-	}
-
-	Vector4 operator*(const Matrix4x4& a, const Vector4& b)
-	{
-		return b * a;
-	}
-
-	Vector4& Vector4::operator+=(const Vector4& v)
-	{
-		x += v.x;
-		y += v.y;
-		z += v.z;
-		w += v.w;
-		return *this;
-	}
-
-	Vector4& Vector4::operator-=(const Vector4& v)
-	{
-		x -= v.x;
-		y -= v.y;
-		z -= v.z;
-		w -= v.w;
-		return *this;
-	}
-
-	Vector4& Vector4::operator*=(const Vector4& v)
-	{
-		x *= v.x;
-		y *= v.y;
-		z *= v.z;
-		w *= v.w;
-		return *this;
-	}
-
-	Vector4& Vector4::operator*=(float scalar)
-	{
-		x *= scalar;
-		y *= scalar;
-		z *= scalar;
-		w *= scalar;
-		return *this;
-	}
-
-	Vector4& Vector4::operator/=(const Vector4& v)
-	{
-		x /= v.x;
-		y /= v.y;
-		z /= v.z;
-		w /= v.w;
-		return *this;
-	}
-
-	Vector4& Vector4::operator/=(float scalar)
-	{
-		x /= scalar;
-		y /= scalar;
-		z /= scalar;
-		w /= scalar;
-		return *this;
-	}
-
 #pragma endregion
 
 #pragma endregion
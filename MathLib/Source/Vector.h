@@ -1,13 +1,12 @@
 #pragma once
 
+#include "SIMD.h"
+
 #include <cstdint>
 
 namespace MathLib
 {
 
-	// TODO: Add SIMD/intrinsic support (Reason why we don't use SIMD as its different based on platform
-	// ARM, x64, etc...)
-
     class Quaternion;
 
 	class Vector2
@@ -91,7 +90,7 @@ namespace MathLib
 		Vector3();
 		Vector3(float x, float y, float z);
 		
-		Vector3(const Vector3& vec);
+		Vector3(const Vector3& vec) = default;
 		Vector3(const Vector2& vec, float z = 0.0f);
 		Vector3(const class Vector4& vec);
 
@@ -190,7 +189,7 @@ namespace MathLib
 		Vector4();
 		Vector4(float x, float y, float z, float w);
 		
-		Vector4(const Vector4& vec);
+		Vector4(const Vector4& vec) = default;
 		Vector4(const Vector3& vec, float w = 0.0f);
 		Vector4(const Vector2& vec, float z = 0.0f, float w = 0.0f);
 
@@ -243,4 +242,270 @@ namespace MathLib
 		static const Vector4 One;
 		static const Vector4 Zero;
 	};
+
+	// The hot operators are defined here so they're inlined into the callers. Vector4 is
+	// backed by the SIMD registers, Vector3 keeps its packed layout as it's used in the
+	// vertex & constant buffers, so its operators stay scalar for the compiler to vectorize.
+
+#pragma region vector3
+
+	inline Vector3::Vector3()
+		: x(0.0f), y(0.0f), z(0.0f) { }
+
+	inline Vector3::Vector3(float x, float y, float z)
+		: x(x), y(y), z(z) { }
+
+	inline Vector3::Vector3(const Vector2& vec, float z)
+		: x(vec.x), y(vec.y), z(z) { }
+
+	inline Vector3::Vector3(const Vector4& vec)
+		: x(vec.x), y(vec.y), z(vec.z) { }
+
+	inline float Vector3::LengthSquared() const
+	{
+		return x * x + y * y + z * z;
+	}
+
+	inline float Vector3::Dot(const Vector3& a, const Vector3& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	inline float Dot(const Vector3& a, const Vector3& b)
+	{
+		return Vector3::Dot(a, b);
+	}
+
+	inline Vector3 Vector3::Cross(const Vector3& a, const Vector3& b)
+	{
+		return Vector3(
+			a.y * b.z - a.z * b.y,
+			a.z * b.x - a.x * b.z,
+			a.x * b.y - a.y * b.x);
+	}
+
+	inline Vector3 Cross(const Vector3& a, const Vector3& b)
+	{
+		return Vector3::Cross(a, b);
+	}
+
+	inline Vector3 operator+(const Vector3& a, const Vector3& b)
+	{
+		return Vector3(
+			a.x + b.x, a.y + b.y, a.z + b.z);
+	}
+
+	inline Vector3 operator-(const Vector3& vec)
+	{
+		return Vector3(-vec.x, -vec.y, -vec.z);
+	}
+
+	inline Vector3 operator-(const Vector3& a, const Vector3& b)
+	{
+		return Vector3(
+			a.x - b.x, a.y - b.y, a.z - b.z);
+	}
+
+	inline Vector3 operator*(const Vector3& a, const Vector3& b)
+	{
+		return Vector3(
+			a.x * b.x, a.y * b.y, a.z * b.z);
+	}
+
+	inline Vector3 operator*(const Vector3& a, float scalar)
+	{
+		return Vector3(
+			a.x * scalar, a.y * scalar, a.z * scalar);
+	}
+
+	inline Vector3 operator*(float scalar, const Vector3& vec)
+	{
+		return Vector3(
+			vec.x * scalar, vec.y * scalar, vec.z * scalar);
+	}
+
+	inline Vector3 operator/(const Vector3& a, const Vector3& b)
+	{
+		return Vector3(
+			a.x / b.x, a.y / b.y, a.z / b.z);
+	}
+
+	inline Vector3 operator/(const Vector3& a, float scalar)
+	{
+		return Vector3(
+			a.x / scalar, a.y / scalar, a.z / scalar);
+	}
+
+	inline Vector3& Vector3::operator+=(const Vector3& v)
+	{
+		x += v.x;
+		y += v.y;
+		z += v.z;
+		return *this;
+	}
+
+	inline Vector3& Vector3::operator-=(const Vector3& v)
+	{
+		x -= v.x;
+		y -= v.y;
+		z -= v.z;
+		return *this;
+	}
+
+	inline Vector3& Vector3::operator*=(const Vector3& v)
+	{
+		x *= v.x;
+		y *= v.y;
+		z *= v.z;
+		return *this;
+	}
+
+	inline Vector3& Vector3::operator*=(float scalar)
+	{
+		x *= scalar;
+		y *= scalar;
+		z *= scalar;
+		return *this;
+	}
+
+	inline Vector3& Vector3::operator/=(const Vector3& v)
+	{
+		x /= v.x;
+		y /= v.y;
+		z /= v.z;
+		return *this;
+	}
+
+	inline Vector3& Vector3::operator/=(float scalar)
+	{
+		x /= scalar;
+		y /= scalar;
+		z /= scalar;
+		return *this;
+	}
+
+#pragma endregion
+
+#pragma region vector4
+
+	inline Vector4::Vector4()
+		: x(0.0f), y(0.0f), z(0.0f), w(0.0f) { }
+
+	inline Vector4::Vector4(float x, float y, float z, float w)
+		: x(x), y(y), z(z), w(w) { }
+
+	inline Vector4::Vector4(const Vector2& vec, float z, float w)
+		: x(vec.x), y(vec.y), z(z), w(w) { }
+
+	inline Vector4::Vector4(const Vector3& vec, float w)
+		: x(vec.x), y(vec.y), z(vec.z), w(w) { }
+
+	namespace SIMD
+	{
+
+		inline Float4 Load(const Vector4& vec)
+		{
+			return Load(&vec.x);
+		}
+
+		inline Vector4 ToVector4(Float4 v)
+		{
+			Vector4 vec;
+			Store(&vec.x, v);
+			return vec;
+		}
+	}
+
+	inline float Vector4::LengthSquared() const
+	{
+		SIMD::Float4 v = SIMD::Load(*this);
+		return SIMD::Dot4(v, v);
+	}
+
+	inline float Dot(const Vector4& a, const Vector4& b)
+	{
+		return SIMD::Dot4(SIMD::Load(a), SIMD::Load(b));
+	}
+
+	inline Vector4 Min(const Vector4& a, const Vector4& b)
+	{
+		return SIMD::ToVector4(SIMD::Min(SIMD::Load(a), SIMD::Load(b)));
+	}
+
+	inline Vector4 Max(const Vector4& a, const Vector4& b)
+	{
+		return SIMD::ToVector4(SIMD::Max(SIMD::Load(a), SIMD::Load(b)));
+	}
+
+	inline Vector4 operator+(const Vector4& a, const Vector4& b)
+	{
+		return SIMD::ToVector4(SIMD::Add(SIMD::Load(a), SIMD::Load(b)));
+	}
+
+	inline Vector4 operator-(const Vector4& a, const Vector4& b)
+	{
+		return SIMD::ToVector4(SIMD::Sub(SIMD::Load(a), SIMD::Load(b)));
+	}
+
+	inline Vector4 operator-(const Vector4& vec)
+	{
+		return SIMD::ToVector4(SIMD::Negate(SIMD::Load(vec)));
+	}
+
+	inline Vector4 operator*(const Vector4& a, const Vector4& b)
+	{
+		return SIMD::ToVector4(SIMD::Mul(SIMD::Load(a), SIMD::Load(b)));
+	}
+
+	inline Vector4 operator*(const Vector4& a, float scalar)
+	{
+		return SIMD::ToVector4(SIMD::Mul(SIMD::Load(a), SIMD::Splat(scalar)));
+	}
+
+	inline Vector4 operator*(float scalar, const Vector4& vec)
+	{
+		return vec * scalar;
+	}
+
+	inline Vector4 operator/(const Vector4& a, const Vector4& b)
+	{
+		return SIMD::ToVector4(SIMD::Div(SIMD::Load(a), SIMD::Load(b)));
+	}
+
+	inline Vector4 operator/(const Vector4& a, float scalar)
+	{
+		return SIMD::ToVector4(SIMD::Div(SIMD::Load(a), SIMD::Splat(scalar)));
+	}
+
+	inline Vector4& Vector4::operator+=(const Vector4& v)
+	{
+		return *this = *this + v;
+	}
+
+	inline Vector4& Vector4::operator-=(const Vector4& v)
+	{
+		return *this = *this - v;
+	}
+
+	inline Vector4& Vector4::operator*=(const Vector4& v)
+	{
+		return *this = *this * v;
+	}
+
+	inline Vector4& Vector4::operator*=(float scalar)
+	{
+		return *this = *this * scalar;
+	}
+
+	inline Vector4& Vector4::operator/=(const Vector4& v)
+	{
+		return *this = *this / v;
+	}
+
+	inline Vector4& Vector4::operator/=(float scalar)
+	{
+		return *this = *this / scalar;
+	}
+
+#pragma endregion
 }
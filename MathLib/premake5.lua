@@ -15,7 +15,7 @@ project "MathLib"
 		pchheader "MathPCH.h"
 	filter { }
 	
-	filter { "system:MacOSx" }
+	filter { "system:MacOSx or Linux" }
 		pchheader "%{prj.location}/Source/MathPCH.h"
 	filter { }
 
@@ -32,4 +32,9 @@ project "MathLib"
 
 	filter "configurations:Release"
 		runtime "Release"
-		optimize "on"
\ No newline at end of file
+		optimize "on"
+
+	-- Compiles the AVX2 paths when built with --simd=avx2.
+	filter { "options:simd=avx2" }
+		vectorextensions "AVX2"
+	filter { }
@@ -2,8 +2,18 @@
 #include "MathLib.h"
 #include "Vector.h"
 #include "Matrix.h"
+#include "Quaternion.h"
 #include "Geometry3D.h"
 #include "Geometry2D.h"
+#include "Shape3D.h"
+#include "BatchTransform.h"
+#include "ShapePacket3D.h"
+#include "Transform.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
 
 using namespace MathLib;
 
@@ -110,13 +120,75 @@ bool RunVector2UnitTests()
 
 bool RunVector3UnitTests()
 {
-	return true;
+	bool isWorking = true;
+
+	// Arithmetic
+	{
+		Vector3 a(1.0f, -2.0f, 3.0f);
+		Vector3 b(4.0f, 5.0f, -6.0f);
+		isWorking &= a + b == Vector3(5.0f, 3.0f, -3.0f);
+		isWorking &= a - b == Vector3(-3.0f, -7.0f, 9.0f);
+		isWorking &= a * b == Vector3(4.0f, -10.0f, -18.0f);
+		isWorking &= 2.0f * a == Vector3(2.0f, -4.0f, 6.0f);
+		isWorking &= -a / 2.0f == Vector3(-0.5f, 1.0f, -1.5f);
+		isWorking &= IsCloseEnough(Dot(a, b), -24.0f);
+		isWorking &= Cross(Vector3::UnitX, Vector3::UnitY) == Vector3::UnitZ;
+		isWorking &= Cross(a, b) == Vector3(-3.0f, 18.0f, 13.0f);
+	}
+
+	// Quaternion concatenation, compared with the vector form of the product.
+	{
+		Quaternion a = Normalize(Quaternion(0.2f, -0.4f, 0.1f, 0.9f));
+		Quaternion b = Normalize(Quaternion(-0.7f, 0.3f, 0.5f, 0.4f));
+		Vector3 vecA(a.x, a.y, a.z);
+		Vector3 vecB(b.x, b.y, b.z);
+		Vector3 expected = a.w * vecB + b.w * vecA + Cross(vecA, vecB);
+		isWorking &= Concatenate(a, b) == Quaternion(
+			expected.x, expected.y, expected.z, a.w * b.w - Dot(vecA, vecB));
+		isWorking &= Concatenate(a, Quaternion::Identity) == a;
+		isWorking &= IsCloseEnough(Concatenate(a, b).Length(), 1.0f);
+	}
+	return isWorking;
 }
 
 bool RunVector4UnitTests()
 {
-	// TODO: start on vector4 unit tests
-	return true;
+	bool isWorking = true;
+
+	// Vectors are transformed as row vectors, so the translation is in the last row.
+	{
+		Matrix4x4 matrix = Matrix4x4::CreateScale(2.0f, 2.0f, 2.0f)
+			* Matrix4x4::CreateTranslation(1.0f, 2.0f, 3.0f);
+		Vector4 point = Vector4(1.0f, 1.0f, 1.0f, 1.0f) * matrix;
+		isWorking &= point == Vector4(3.0f, 4.0f, 5.0f, 1.0f);
+		Vector4 direction = Vector4(1.0f, 1.0f, 1.0f, 0.0f) * matrix;
+		isWorking &= direction == Vector4(2.0f, 2.0f, 2.0f, 0.0f);
+	}
+
+	// Arithmetic
+	{
+		Vector4 a(1.0f, -2.0f, 3.0f, -4.0f);
+		Vector4 b(5.0f, 6.0f, -7.0f, 8.0f);
+		isWorking &= a + b == Vector4(6.0f, 4.0f, -4.0f, 4.0f);
+		isWorking &= a - b == Vector4(-4.0f, -8.0f, 10.0f, -12.0f);
+		isWorking &= a * b == Vector4(5.0f, -12.0f, -21.0f, -32.0f);
+		isWorking &= a * 2.0f == Vector4(2.0f, -4.0f, 6.0f, -8.0f);
+		isWorking &= b / 2.0f == Vector4(2.5f, 3.0f, -3.5f, 4.0f);
+		isWorking &= -a == Vector4(-1.0f, 2.0f, -3.0f, 4.0f);
+		isWorking &= Min(a, b) == Vector4(1.0f, -2.0f, -7.0f, -4.0f);
+		isWorking &= Max(a, b) == Vector4(5.0f, 6.0f, 3.0f, 8.0f);
+		isWorking &= IsCloseEnough(Dot(a, b), -60.0f);
+		isWorking &= IsCloseEnough(a.LengthSquared(), 30.0f);
+
+		Vector4 c = a;
+		c += b;
+		c *= 2.0f;
+		c -= a;
+		c /= Vector4(1.0f, 2.0f, 4.0f, 4.0f);
+		isWorking &= c == Vector4(11.0f, 5.0f, -2.75f, 3.0f);
+	}
+	// TODO: start on the rest of the vector4 unit tests
+	return isWorking;
 }
 
 bool RunMatrix3UnitTests()
@@ -172,6 +244,30 @@ bool RunMatrix4UnitTests()
 	{
 		Matrix4x4 multipliedMatrix = matrix * Matrix4x4::Identity;
 		isWorking &= multipliedMatrix == matrix;
+
+		Matrix4x4 a = Matrix4x4::CreateEuler(30.0f, -45.0f, 10.0f)
+			* Matrix4x4::CreateTranslation(1.0f, 2.0f, 3.0f);
+		Matrix4x4 b = Matrix4x4::CreatePersp(60.0f, 0.5f, 0.1f, 100.0f);
+		float expected[4][4] = {};
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				for (int i = 0; i < 4; i++)
+				{
+					expected[r][c] += a[r][i] * b[i][c];
+				}
+			}
+		}
+		isWorking &= a * b == Matrix4x4(expected);
+
+		Matrix4x4 concatenated = a;
+		concatenated *= b;
+		isWorking &= concatenated == Matrix4x4(expected);
+
+		// Transforming by the product is the same as transforming by each matrix.
+		Vector4 point(0.5f, -1.0f, 2.0f, 1.0f);
+		isWorking &= point * (a * b) == (point * a) * b;
 	}
 
 	// Transpose Matrix
@@ -189,7 +285,285 @@ bool RunMatrix4UnitTests()
 		transposedCurrent.Transpose();
 		isWorking &= transposedCurrent == matrix;
 	}
-	// TODO: 
+
+	// Inverse
+	{
+		Matrix4x4 view = Matrix4x4::CreateLookAt(Vector3(1.0f, 2.0f, 3.0f),
+			Vector3(-4.0f, 5.0f, -6.0f), Vector3::UnitY);
+		Matrix4x4 projection = Matrix4x4::CreatePersp(70.0f, 0.75f, 0.1f, 500.0f);
+		Matrix4x4 ortho = Matrix4x4::CreateOrtho(16.0f, 9.0f, 0.1f, 100.0f);
+		// Non-uniform scale under a rotation shears the child.
+		Matrix4x4 sheared = Matrix4x4::CreateRotationZ(30.0f)
+			* Matrix4x4::CreateScale(1.0f, 3.0f, 0.5f)
+			* Matrix4x4::CreateRotationY(-60.0f)
+			* Matrix4x4::CreateTranslation(-2.0f, 7.0f, 0.5f);
+
+		const Matrix4x4 matrices[] = { view, projection, ortho, view * projection, sheared, matrix };
+		for (const Matrix4x4& m : matrices)
+		{
+			isWorking &= m * Invert(m) == Matrix4x4::Identity;
+			isWorking &= Invert(m) * m == Matrix4x4::Identity;
+			isWorking &= Invert(Invert(m)) == m;
+		}
+
+		// The affine inverse matches the general inverse.
+		const Matrix4x4 affineMatrices[] = { view, sheared, matrix };
+		for (const Matrix4x4& m : affineMatrices)
+		{
+			isWorking &= InvertAffine(m) == Invert(m);
+			isWorking &= m * InvertAffine(m) == Matrix4x4::Identity;
+		}
+
+		// Singular matrices are left unchanged.
+		Matrix4x4 singular = Matrix4x4::CreateScale(1.0f, 0.0f, 1.0f);
+		isWorking &= Invert(singular) == singular;
+		isWorking &= InvertAffine(singular) == singular;
+
+		// A point unprojected through the inverse view projection lands on its ray.
+		Vector3 point(3.0f, -1.0f, 20.0f);
+		Vector4 clip = Vector4(point, 1.0f) * (view * projection);
+		Vector4 unprojected = clip * Invert(view * projection);
+		isWorking &= Vector3(unprojected / unprojected.w) == point;
+	}
+	return isWorking;
+}
+
+bool RunQuaternionUnitTests()
+{
+	bool isWorking = true;
+
+	Quaternion a = Quaternion::FromEuler(30.0f, -20.0f, 45.0f);
+	Quaternion b = Quaternion::FromEuler(-120.0f, 60.0f, 10.0f);
+	// Both signs of a quaternion are the same rotation.
+	auto isSameRotation = [](const Quaternion& q, const Quaternion& expected, float tolerance) -> bool
+	{
+		float sign = Dot(q, expected) >= 0.0f ? 1.0f : -1.0f;
+		return std::abs(q.x - sign * expected.x) < tolerance && std::abs(q.y - sign * expected.y) < tolerance
+			&& std::abs(q.z - sign * expected.z) < tolerance && std::abs(q.w - sign * expected.w) < tolerance;
+	};
+
+	// The end points, the results are unit length.
+	{
+		isWorking &= isSameRotation(Lerp(a, b, 0.0f), a, 0.0001f);
+		isWorking &= isSameRotation(Lerp(a, b, 1.0f), b, 0.0001f);
+		isWorking &= isSameRotation(Slerp(a, b, 0.0f), a, 0.0001f);
+		isWorking &= isSameRotation(Slerp(a, b, 1.0f), b, 0.0001f);
+		isWorking &= isSameRotation(Slerp(a, b, 0.0f, true), a, 0.0001f);
+		isWorking &= isSameRotation(Slerp(a, b, 1.0f, true), b, 0.0001f);
+		isWorking &= IsCloseEnough(Lerp(a, b, 0.3f).Length(), 1.0f);
+		isWorking &= IsCloseEnough(Slerp(a, b, 0.3f).Length(), 1.0f);
+		isWorking &= IsCloseEnough(Slerp(a, b, 0.3f, true).Length(), 1.0f);
+	}
+
+	// The slerp rotates at a constant speed & takes the shorter path, even with a negated end.
+	{
+		float halfAngle = std::acos(std::abs(Dot(a, b)));
+		for (float alpha = 0.0f; alpha <= 1.0f; alpha += 0.125f)
+		{
+			Quaternion exact = Slerp(a, b, alpha);
+			isWorking &= std::abs(std::abs(Dot(a, exact)) - std::cos(alpha * halfAngle)) < 0.0001f;
+			isWorking &= isSameRotation(Slerp(a, Quaternion(-b.x, -b.y, -b.z, -b.w), alpha), exact, 0.0001f);
+			isWorking &= isSameRotation(Slerp(a, b, alpha, true), exact, 0.001f);
+		}
+		// Nearly equal quaternions.
+		isWorking &= isSameRotation(Slerp(a, a, 0.5f), a, 0.0001f);
+	}
+	return isWorking;
+}
+
+bool RunBatchTransformUnitTests()
+{
+	bool isWorking = true;
+
+	// Not a multiple of the lane count, so the remaining elements are tested too.
+	const size_t count = 19;
+	Matrix4x4 matrix = Matrix4x4::CreateScale(1.0f, 2.0f, -0.5f)
+		* Matrix4x4::CreateEuler(20.0f, 45.0f, -30.0f)
+		* Matrix4x4::CreateTranslation(3.0f, -1.0f, 2.0f);
+
+	std::vector<Vector3> points(count);
+	std::vector<float> x(count), y(count), z(count);
+	std::vector<float> extentsX(count), extentsY(count), extentsZ(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		points[i] = Vector3((float)i - 9.0f, (float)(i % 5) * 0.5f, 2.0f - (float)(i % 3));
+		x[i] = points[i].x;
+		y[i] = points[i].y;
+		z[i] = points[i].z;
+		extentsX[i] = 0.5f + (float)i * 0.1f;
+		extentsY[i] = 1.0f;
+		extentsZ[i] = (float)(i % 4);
+	}
+
+	// Points, the structure of arrays are transformed in place.
+	{
+		std::vector<Vector3> transformed(count);
+		TransformPoints(matrix, points.data(), transformed.data(), count);
+		std::vector<float> outX(x), outY(y), outZ(z);
+		float* const inOut[3] = { outX.data(), outY.data(), outZ.data() };
+		TransformPoints(matrix, inOut, inOut, count);
+		for (size_t i = 0; i < count; i++)
+		{
+			Vector3 expected = Vector4(points[i], 1.0f) * matrix;
+			isWorking &= transformed[i] == expected;
+			isWorking &= Vector3(outX[i], outY[i], outZ[i]) == expected;
+		}
+	}
+
+	// Directions
+	{
+		std::vector<float> outX(count), outY(count), outZ(count);
+		const float* const in[3] = { x.data(), y.data(), z.data() };
+		float* const out[3] = { outX.data(), outY.data(), outZ.data() };
+		TransformDirections(matrix, in, out, count);
+		for (size_t i = 0; i < count; i++)
+		{
+			Vector3 expected = Vector4(points[i], 0.0f) * matrix;
+			isWorking &= Vector3(outX[i], outY[i], outZ[i]) == expected;
+		}
+	}
+
+	// Bounds, the transformed corners of each box are inside & touch the enclosing box.
+	{
+		std::vector<float> centerX(count), centerY(count), centerZ(count);
+		std::vector<float> outExtentsX(count), outExtentsY(count), outExtentsZ(count);
+		const float* const inCenters[3] = { x.data(), y.data(), z.data() };
+		const float* const inExtents[3] = { extentsX.data(), extentsY.data(), extentsZ.data() };
+		float* const outCenters[3] = { centerX.data(), centerY.data(), centerZ.data() };
+		float* const outExtents[3] = { outExtentsX.data(), outExtentsY.data(), outExtentsZ.data() };
+		TransformBounds(matrix, inCenters, inExtents, outCenters, outExtents, count);
+		for (size_t i = 0; i < count; i++)
+		{
+			Vector3 extents(extentsX[i], extentsY[i], extentsZ[i]);
+			Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+			for (uint32_t corner = 0; corner < 8; corner++)
+			{
+				Vector3 offset((corner & 1) ? extents.x : -extents.x,
+					(corner & 2) ? extents.y : -extents.y, (corner & 4) ? extents.z : -extents.z);
+				Vector3 transformed = Vector4(points[i] + offset, 1.0f) * matrix;
+				min = Min(min, transformed);
+				max = Max(max, transformed);
+			}
+			isWorking &= Vector3(centerX[i], centerY[i], centerZ[i]) == (min + max) * 0.5f;
+			isWorking &= Vector3(outExtentsX[i], outExtentsY[i], outExtentsZ[i]) == (max - min) * 0.5f;
+		}
+	}
+
+	// Matrices
+	{
+		std::vector<Matrix4x4> a(count), b(count), multiplied(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			a[i] = Matrix4x4::CreateRotationY((float)i * 10.0f) * Matrix4x4::CreateTranslation((float)i, 0.0f, 1.0f);
+			b[i] = Matrix4x4::CreateScale((float)i + 1.0f, 1.0f, 2.0f) * matrix;
+		}
+		MultiplyMatrices(a.data(), b.data(), multiplied.data(), count);
+		for (size_t i = 0; i < count; i++)
+		{
+			isWorking &= multiplied[i] == a[i] * b[i];
+		}
+	}
+
+	// Quaternions
+	{
+		std::vector<Quaternion> quats(count);
+		std::vector<Vector3> rotated(count);
+		std::vector<Matrix4x4> matrices(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			quats[i] = Quaternion::FromEuler((float)i * 20.0f, -(float)i * 7.0f, 90.0f - (float)i * 11.0f);
+		}
+		RotateVectors(quats.data(), points.data(), rotated.data(), count);
+		QuaternionsToMatrices(quats.data(), matrices.data(), count);
+		std::vector<float> outX(count), outY(count), outZ(count);
+		const float* const in[3] = { x.data(), y.data(), z.data() };
+		float* const out[3] = { outX.data(), outY.data(), outZ.data() };
+		RotateVectors(quats[5], in, out, count);
+		for (size_t i = 0; i < count; i++)
+		{
+			isWorking &= rotated[i] == Vector3::Rotate(quats[i], points[i]);
+			isWorking &= matrices[i] == Matrix4x4::CreateFromQuaternion(quats[i]);
+			isWorking &= Vector3(outX[i], outY[i], outZ[i]) == Vector3::Rotate(quats[5], points[i]);
+		}
+	}
+	return isWorking;
+}
+
+bool RunTransformUnitTests()
+{
+	bool isWorking = true;
+
+	// The transforms only store the local position, rotation & scale.
+	isWorking &= sizeof(Transform3D) <= 48;
+	isWorking &= sizeof(Transform2D) <= 24;
+
+	{
+		Transform3D transform;
+		isWorking &= transform.GetLocalTransformMatrix() == Matrix4x4::Identity;
+
+		transform.SetLocalPosition(1.0f, 2.0f, 3.0f);
+		isWorking &= transform.GetLocalTransformMatrix() == Matrix4x4::CreateTranslation(1.0f, 2.0f, 3.0f);
+
+		transform.SetLocalScale(2.0f, 1.0f, 0.5f);
+		transform.SetLocalEulerAngles(30.0f, 45.0f, -10.0f);
+		Matrix4x4 expectedLocal = Matrix4x4::CreateScale(2.0f, 1.0f, 0.5f)
+			* Matrix4x4::CreateFromQuaternion(Quaternion::FromEuler(30.0f, 45.0f, -10.0f))
+			* Matrix4x4::CreateTranslation(1.0f, 2.0f, 3.0f);
+		isWorking &= transform.GetLocalTransformMatrix() == expectedLocal;
+
+		// The euler angles are calculated from the rotation.
+		Vector3 eulers = transform.GetLocalEulerAngles();
+		isWorking &= IsCloseEnough(eulers.x, 45.0f, 0.001f);
+		isWorking &= IsCloseEnough(eulers.y, 30.0f, 0.001f);
+		isWorking &= IsCloseEnough(eulers.z, -10.0f, 0.001f);
+
+		Matrix4x4 parent = Matrix4x4::CreateRotationY(90.0f) * Matrix4x4::CreateTranslation(-4.0f, 0.0f, 1.0f);
+		isWorking &= transform.GetTransformMatrix(parent) == expectedLocal * parent;
+		isWorking &= transform.GetTransformMatrix(Matrix4x4::Identity) == expectedLocal;
+	}
+
+	{
+		Transform2D transform;
+		transform.SetLocalPosition(3.0f, -2.0f);
+		Matrix4x4 expectedLocal = Matrix4x4::CreateTranslation(3.0f, -2.0f, 0.0f);
+		isWorking &= transform.GetLocalTransformMatrix() == expectedLocal;
+
+		Matrix4x4 parent = Matrix4x4::CreateTranslation(1.0f, 1.0f, 0.0f);
+		isWorking &= transform.GetTransformMatrix(parent) == parent * expectedLocal;
+
+		transform.SetLocalScale(2.0f, 3.0f);
+		expectedLocal = Matrix4x4::CreateScale(2.0f, 3.0f, 1.0f) * expectedLocal;
+		isWorking &= transform.GetTransformMatrix(parent) == parent * expectedLocal;
+
+		// Converting to 3D keeps the rotation around z.
+		transform.SetLocalRotation(60.0f);
+		Transform3D transform3D(transform);
+		isWorking &= IsCloseEnough(transform3D.GetLocalEulerAngles().z, 60.0f, 0.001f);
+		isWorking &= IsCloseEnough(Transform2D(transform3D).GetLocalRotation(true), 60.0f, 0.001f);
+	}
+
+	// The version changes with the local values, so the scene knows which world matrices to update.
+	{
+		Transform3D transform;
+		Transform3D copy = transform;
+		isWorking &= copy.GetVersion() == transform.GetVersion();
+		isWorking &= Transform3D().GetVersion() != transform.GetVersion();
+
+		uint32_t version = transform.GetVersion();
+		transform.SetLocalPosition(1.0f, 0.0f, 0.0f);
+		isWorking &= transform.GetVersion() != version;
+		version = transform.GetVersion();
+		transform.LookAt(Vector3(0.0f, 0.0f, 5.0f));
+		isWorking &= transform.GetVersion() != version;
+
+		Transform2D transform2D;
+		version = transform2D.GetVersion();
+		transform2D.SetLocalRotation(15.0f);
+		isWorking &= transform2D.GetVersion() != version;
+		version = transform2D.GetVersion();
+		transform2D = transform;
+		isWorking &= transform2D.GetVersion() != version;
+	}
 	return isWorking;
 }
 
@@ -301,5 +675,273 @@ bool Run3DIntersectionUnitTests()
 		ray.direction = -ray.direction;
 		isValid &= Intersects(plane, ray, intersectedPoint);
 	}
+
+	// Ray intersects with a triangle away from the origin.
+	{
+		Vector3 intersectedPoint;
+		Triangle3D triangle(Vector3(0.0f, 0.0f, 5.0f), Vector3(1.0f, 0.0f, 5.0f), Vector3(0.0f, 1.0f, 5.0f));
+
+		Ray3D ray(Vector3(0.2f, 0.2f, 0.0f), MathLib::Vector3::UnitZ);
+		isValid &= Intersects(triangle, ray, intersectedPoint);
+		isValid &= IsCloseEnough(intersectedPoint.z, 5.0f);
+
+		ray.startPoint = Vector3(2.0f, 2.0f, 0.0f);
+		isValid &= !Intersects(triangle, ray, intersectedPoint);
+	}
+	return isValid;
+}
+
+bool RunShapeOverlapUnitTests()
+{
+	bool isValid = true;
+
+	// Spheres & axis aligned boxes, the touching shapes overlap.
+	{
+		Sphere3D sphere(Vector3::Zero, 1.0f);
+		isValid &= Intersects(sphere, Sphere3D(Vector3(1.5f, 0.0f, 0.0f), 0.5f));
+		isValid &= !Intersects(sphere, Sphere3D(Vector3(1.6f, 0.0f, 0.0f), 0.5f));
+
+		Rect3D rect(Vector3::Zero, 2.0f);
+		isValid &= Intersects(Sphere3D(Vector3(2.0f, 0.0f, 0.0f), 1.0f), rect);
+		isValid &= !Intersects(Sphere3D(Vector3(2.0f, 2.0f, 0.0f), 1.0f), rect);
+		isValid &= Intersects(Sphere3D(Vector3(0.5f, 0.0f, 0.0f), 0.1f), rect);
+
+		isValid &= Intersects(rect, Rect3D(Vector3(2.0f, 1.0f, 0.0f), 2.0f));
+		isValid &= !Intersects(rect, Rect3D(Vector3(2.0f, 2.5f, 0.0f), 2.0f));
+	}
+
+	// Oriented boxes.
+	{
+		OBB3D box(Vector3::Zero, Vector3::One, Quaternion::Identity);
+		OBB3D rotated(Vector3(1.2f, 0.0f, 0.0f), Vector3::One, Quaternion(Vector3::UnitZ, 45.0f));
+		isValid &= Intersects(box, rotated);
+		rotated.center.x = 1.25f;
+		isValid &= !Intersects(box, rotated);
+		isValid &= Intersects(box, Rect3D(Vector3(0.9f, 0.9f, 0.9f), 1.0f));
+		isValid &= !Intersects(box, Rect3D(Vector3(1.1f, 0.0f, 0.0f), 1.0f));
+
+		// Only separated by the cross product of the edges.
+		OBB3D edgeA(Vector3::Zero, Vector3::One, Quaternion(Vector3::UnitZ, 45.0f));
+		OBB3D edgeB(Vector3(0.0f, 1.45f, 0.0f), Vector3::One, Quaternion(Vector3::UnitX, 45.0f));
+		isValid &= Intersects(edgeA, OBB3D(Vector3(0.0f, 1.35f, 0.0f), Vector3::One, Quaternion(Vector3::UnitX, 45.0f)));
+		isValid &= !Intersects(edgeA, edgeB);
+
+		OBB3D diamond(Vector3::Zero, Vector3(2.0f, 2.0f, 2.0f), Quaternion(Vector3::UnitZ, 45.0f));
+		isValid &= diamond.IsPointWithin(Vector3(1.4f, 0.0f, 0.0f));
+		isValid &= !diamond.IsPointWithin(Vector3(1.0f, 1.0f, 0.0f));
+		isValid &= Intersects(diamond, Sphere3D(Vector3(2.0f, 0.0f, 0.0f), 0.6f));
+		isValid &= !Intersects(diamond, Sphere3D(Vector3(2.0f, 0.0f, 0.0f), 0.5f));
+	}
+
+	// Capsules.
+	{
+		Capsule3D capsule(Vector3::Zero, Vector3(0.0f, 2.0f, 0.0f), 0.5f);
+		isValid &= capsule.IsPointWithin(Vector3(0.4f, 1.0f, 0.0f));
+		isValid &= capsule.IsPointWithin(Vector3(0.0f, 2.4f, 0.0f));
+		isValid &= !capsule.IsPointWithin(Vector3(0.0f, -0.6f, 0.0f));
+
+		isValid &= Intersects(capsule, Capsule3D(Vector3(1.0f, 1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f), 0.5f));
+		isValid &= !Intersects(capsule, Capsule3D(Vector3(1.0f, 1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f), 0.4f));
+		// Parallel & degenerate capsules.
+		isValid &= Intersects(capsule, Capsule3D(Vector3(0.9f, 1.0f, 0.0f), Vector3(0.9f, 5.0f, 0.0f), 0.5f));
+		isValid &= !Intersects(capsule, Capsule3D(Vector3(0.0f, 3.2f, 0.0f), Vector3(0.0f, 5.0f, 0.0f), 0.5f));
+		isValid &= Intersects(capsule, Capsule3D(Vector3(0.0f, 2.9f, 0.0f), Vector3(0.0f, 2.9f, 0.0f), 0.5f));
+
+		isValid &= Intersects(capsule, Sphere3D(Vector3(1.0f, 0.5f, 0.0f), 0.5f));
+		isValid &= !Intersects(capsule, Sphere3D(Vector3(1.0f, -1.0f, 0.0f), 0.5f));
+	}
+
+	// Perspective frustum, looking down z from 10 units back.
+	{
+		Matrix4x4 viewProjection = Matrix4x4::CreateTranslation(0.0f, 0.0f, 10.0f)
+			* Matrix4x4::CreatePersp(90.0f, 1.0f, 1.0f, 100.0f);
+		Frustum3D frustum = Frustum3D::FromViewProjection(viewProjection);
+		isValid &= frustum.IsPointWithin(Vector3(0.0f, 0.0f, 40.0f));
+		isValid &= !frustum.IsPointWithin(Vector3(0.0f, 0.0f, -9.5f));
+		isValid &= !frustum.IsPointWithin(Vector3(0.0f, 0.0f, 91.0f));
+		isValid &= !frustum.IsPointWithin(Vector3(60.0f, 0.0f, 40.0f));
+		isValid &= frustum.IsPointWithin(Vector3(0.0f, -49.0f, 40.0f));
+		for (const Plane3D& plane : frustum.planes)
+		{
+			isValid &= IsCloseEnough(plane.normal.Length(), 1.0f);
+		}
+
+		isValid &= Intersects(frustum, Sphere3D(Vector3(60.0f, 0.0f, 40.0f), 8.0f));
+		isValid &= !Intersects(frustum, Sphere3D(Vector3(60.0f, 0.0f, 40.0f), 7.0f));
+		isValid &= Intersects(frustum, Rect3D(Vector3(60.0f, 0.0f, 40.0f), 10.5f));
+		isValid &= !Intersects(frustum, Rect3D(Vector3(60.0f, 0.0f, 40.0f), 9.5f));
+		isValid &= !Intersects(frustum, Rect3D(Vector3(0.0f, 0.0f, -20.0f), 2.0f));
+		// The rotated box has an axis along the side plane's normal.
+		isValid &= Intersects(frustum, OBB3D(Vector3(60.0f, 0.0f, 40.0f), Vector3(14.5f, 19.0f, 14.5f),
+			Quaternion(Vector3::UnitY, 45.0f)));
+		isValid &= !Intersects(frustum, OBB3D(Vector3(60.0f, 0.0f, 40.0f), Vector3(13.5f, 19.0f, 13.5f),
+			Quaternion(Vector3::UnitY, 45.0f)));
+	}
+
+	// Orthographic frustum, CreateOrtho looks down -z with a depth from -1 to 1.
+	{
+		Frustum3D frustum = Frustum3D::FromViewProjection(
+			Matrix4x4::CreateOrtho(10.0f, 10.0f, 1.0f, 100.0f), -1.0f);
+		isValid &= frustum.IsPointWithin(Vector3(4.0f, 4.0f, -50.0f));
+		isValid &= !frustum.IsPointWithin(Vector3(0.0f, 0.0f, -0.5f));
+		isValid &= !frustum.IsPointWithin(Vector3(0.0f, 0.0f, 50.0f));
+		isValid &= !frustum.IsPointWithin(Vector3(6.0f, 0.0f, -50.0f));
+		isValid &= Intersects(frustum, Sphere3D(Vector3(6.0f, 0.0f, -50.0f), 1.0f));
+	}
+	return isValid;
+}
+
+bool RunShapePacketUnitTests()
+{
+	bool isValid = true;
+
+	// One ray against a packet of boxes.
+	{
+		Rect3DPacket packet;
+		Rect3D rects[c_numPacketLanes] =
+		{
+			Rect3D(Vector3(0.0f, 0.0f, 5.0f), 2.0f),
+			Rect3D(Vector3(0.0f, 0.0f, -5.0f), 2.0f),
+			Rect3D(Vector3(4.0f, 0.0f, 5.0f), 2.0f),
+			Rect3D(Vector3(0.0f, 0.0f, 0.0f), 2.0f),
+			Rect3D(Vector3(0.5f, 0.5f, 20.0f), 1.0f, 1.0f, 4.0f),
+			Rect3D(Vector3(0.0f, 3.0f, 5.0f), 2.0f),
+			Rect3D(Vector3(0.0f, 0.0f, 50.0f), 2.0f),
+			Rect3D(Vector3(0.0f, -0.5f, 8.0f), 1.0f, 3.0f, 1.0f)
+		};
+		for (size_t i = 0; i < c_numPacketLanes; i++)
+		{
+			packet.Set(i, rects[i]);
+		}
+
+		Ray3D ray(Vector3(0.0f, 0.0f, -1.0f), Normalize(Vector3(0.01f, 0.02f, 1.0f)));
+		float distances[c_numPacketLanes];
+		isValid &= Intersects(ray, packet, distances) == 0x99;
+		isValid &= IsCloseEnough(distances[0], 5.0f / ray.direction.z);
+		isValid &= IsCloseEnough(distances[7], 8.5f / ray.direction.z);
+		// Starts inside of the box.
+		isValid &= distances[3] == 0.0f;
+
+		// The directions with zero components, the faces are included.
+		ray.direction = Vector3::UnitZ;
+		isValid &= Intersects(ray, packet) == 0xD9;
+		ray.startPoint = Vector3(1.0f, 0.0f, 0.0f);
+		isValid &= Intersects(ray, packet) == 0x59;
+		ray.startPoint = Vector3(1.1f, 0.0f, 0.0f);
+		isValid &= Intersects(ray, packet) == 0x00;
+
+		// The ray's distance limits the hits.
+		ray = Ray3D(Vector3(0.0f, 0.0f, -1.0f), Vector3::UnitZ * 2.0f, 3.0f);
+		isValid &= Intersects(ray, packet, distances) == 0x09;
+		isValid &= IsCloseEnough(distances[0], 2.5f);
+
+		// The unused lanes never hit.
+		packet.Clear(0);
+		packet.Clear(3);
+		ray = Ray3D(Vector3(0.0f, 0.0f, -1.0f), Vector3::UnitZ);
+		isValid &= Intersects(ray, packet) == 0xD0;
+		isValid &= Intersects(ray, Rect3DPacket()) == 0;
+	}
+
+	// One ray against a packet of triangles, compared against the scalar test.
+	{
+		Triangle3DPacket packet;
+		Triangle3D triangles[c_numPacketLanes] =
+		{
+			Triangle3D(Vector3(0.0f, 0.0f, 5.0f), Vector3(1.0f, 0.0f, 5.0f), Vector3(0.0f, 1.0f, 5.0f)),
+			Triangle3D(Vector3(0.0f, 0.0f, -5.0f), Vector3(1.0f, 0.0f, -5.0f), Vector3(0.0f, 1.0f, -5.0f)),
+			Triangle3D(Vector3(2.0f, 0.0f, 5.0f), Vector3(3.0f, 0.0f, 5.0f), Vector3(2.0f, 1.0f, 5.0f)),
+			Triangle3D(Vector3(-1.0f, -1.0f, 8.0f), Vector3(0.0f, 2.0f, 8.0f), Vector3(2.0f, -1.0f, 9.0f)),
+			Triangle3D(Vector3(0.0f, -1.0f, 0.0f), Vector3(0.0f, 1.0f, 10.0f), Vector3(0.0f, 1.0f, 0.0f)),
+			Triangle3D(Vector3(1.0f, 1.0f, 3.0f), Vector3(0.0f, 1.0f, 3.0f), Vector3(1.0f, 0.0f, 3.0f)),
+			Triangle3D(Vector3(0.0f, 0.0f, 2.0f), Vector3(1.0f, 1.0f, 2.0f), Vector3(2.0f, 2.0f, 2.0f)),
+			Triangle3D(Vector3(-1.0f, 0.0f, 30.0f), Vector3(1.0f, 0.0f, 30.0f), Vector3(0.0f, 1.0f, 30.0f))
+		};
+		for (size_t i = 0; i < c_numPacketLanes; i++)
+		{
+			packet.Set(i, triangles[i]);
+		}
+
+		Ray3D ray(Vector3(0.2f, 0.2f, 0.0f), Vector3::UnitZ);
+		float distances[c_numPacketLanes];
+		uint32_t mask = Intersects(ray, packet, distances);
+		isValid &= mask == 0x89;
+		for (size_t i = 0; i < c_numPacketLanes; i++)
+		{
+			// Skips the triangles that are parallel to the ray or degenerate.
+			if (i != 4 && i != 6)
+			{
+				Vector3 intersectedPoint;
+				isValid &= ((mask >> i) & 1) == (uint32_t)triangles[i].Intersects(ray, intersectedPoint);
+			}
+		}
+		isValid &= IsCloseEnough(distances[0], 5.0f);
+		isValid &= IsCloseEnough(distances[3], 8.0f + 0.8f / 3.0f);
+		isValid &= IsCloseEnough(distances[7], 30.0f);
+
+		// The ray's distance limits the hits.
+		ray.distance = 10.0f;
+		isValid &= Intersects(ray, packet) == 0x09;
+
+		// The unused lanes never hit.
+		packet.Clear(0);
+		isValid &= Intersects(ray, packet) == 0x08;
+		isValid &= Intersects(ray, Triangle3DPacket()) == 0;
+	}
+
+	// Packets of shapes against a frustum, compared against the scalar tests.
+	{
+		Frustum3D frustum = Frustum3D::FromViewProjection(
+			Matrix4x4::CreatePersp(60.0f, 1.0f, 1.0f, 100.0f));
+		const size_t numPackets = 8;
+		for (size_t packetIndex = 0; packetIndex < numPackets; packetIndex++)
+		{
+			Sphere3DPacket spheres;
+			Rect3DPacket rects;
+			OBB3DPacket boxes;
+			Sphere3D sphereShapes[c_numPacketLanes];
+			Rect3D rectShapes[c_numPacketLanes];
+			OBB3D boxShapes[c_numPacketLanes];
+			for (size_t lane = 0; lane < c_numPacketLanes; lane++)
+			{
+				float i = (float)(packetIndex * c_numPacketLanes + lane);
+				Vector3 center(std::sin(i * 1.3f) * 60.0f, std::cos(i * 0.7f) * 60.0f, 50.0f + std::sin(i * 0.3f) * 60.0f);
+				Vector3 size(2.0f + std::abs(std::sin(i)) * 20.0f, 2.0f + std::abs(std::cos(i)) * 20.0f, 5.0f);
+				sphereShapes[lane] = Sphere3D(center, size.x);
+				rectShapes[lane] = Rect3D(center, size.x, size.y, size.z);
+				boxShapes[lane] = OBB3D(center, size, Quaternion(Normalize(Vector3(1.0f, i, 2.0f)), i * 20.0f));
+				spheres.Set(lane, sphereShapes[lane]);
+				rects.Set(lane, rectShapes[lane]);
+				boxes.Set(lane, boxShapes[lane]);
+			}
+
+			uint32_t sphereContained, rectContained, boxContained;
+			uint32_t sphereMask = Intersects(frustum, spheres, sphereContained);
+			uint32_t rectMask = Intersects(frustum, rects, rectContained);
+			uint32_t boxMask = Intersects(frustum, boxes, boxContained);
+			for (size_t lane = 0; lane < c_numPacketLanes; lane++)
+			{
+				isValid &= ((sphereMask >> lane) & 1) == (uint32_t)Intersects(frustum, sphereShapes[lane]);
+				isValid &= ((rectMask >> lane) & 1) == (uint32_t)Intersects(frustum, rectShapes[lane]);
+				isValid &= ((boxMask >> lane) & 1) == (uint32_t)Intersects(frustum, boxShapes[lane]);
+			}
+			// The contained shapes are also intersecting.
+			isValid &= (sphereContained & ~sphereMask) == 0;
+			isValid &= (rectContained & ~rectMask) == 0;
+			isValid &= (boxContained & ~boxMask) == 0;
+		}
+
+		// Classifies the boxes that are inside, intersecting & outside.
+		Rect3DPacket rects;
+		rects.Set(0, Rect3D(Vector3(0.0f, 0.0f, 50.0f), 2.0f));
+		rects.Set(1, Rect3D(Vector3(0.0f, 0.0f, 100.0f), 2.0f));
+		rects.Set(2, Rect3D(Vector3(0.0f, 0.0f, -50.0f), 2.0f));
+		uint32_t containedMask;
+		isValid &= Intersects(frustum, rects, containedMask) == 0x03;
+		isValid &= containedMask == 0x01;
+		isValid &= Intersects(frustum, Sphere3DPacket()) == 0;
+		isValid &= Intersects(frustum, OBB3DPacket(), containedMask) == 0;
+		isValid &= containedMask == 0;
+	}
 	return isValid;
 }
@@ -7,6 +7,11 @@ bool RunVector4UnitTests();
 
 bool RunMatrix3UnitTests();
 bool RunMatrix4UnitTests();
+bool RunQuaternionUnitTests();
+bool RunBatchTransformUnitTests();
+bool RunTransformUnitTests();
 
 bool Run3DIntersectionUnitTests();
-bool Run2DIntersectionUnitTests();
\ No newline at end of file
+bool RunShapeOverlapUnitTests();
+bool Run2DIntersectionUnitTests();
+bool RunShapePacketUnitTests();
@@ -6,13 +6,88 @@
 #include "MathUnitTests.h"
 #include "EngineAssert.h"
 #include "StringUtils.h"
+#include "RenderQueue.h"
+#include "RenderThread.h"
+#include "FrustumCulling.h"
+#include "SceneRenderList.h"
+#include "BoundingVolumeHierarchy.h"
+#include "Scene.h"
+#include "Components.h"
+#include "SpatialIndexSystem.h"
+#include "EntityHierarchySystem.h"
+#include "EngineTime.h"
+#include "ClusteredLighting.h"
+#include "FramePacket.h"
+#include "MeshLODGroup.h"
+#include "LevelOfDetail.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+
+#if defined(GRAPHICS_API_NULL)
+#include "GraphicsRenderer.h"
+#include "GraphicsRenderer2D.h"
+#include "GraphicsRenderer3D.h"
+#include "ConstantBuffer.h"
+#include "CommandList.h"
+#include "JobManager.h"
+#include "Texture.h"
+#include "Mesh.h"
+#include "Material.h"
+#include "NullRenderingAPI.h"
+#endif
 
 bool RunWideStringUnitTests();
+bool RunRenderQueueUnitTests();
+bool RunRenderThreadUnitTests();
+bool RunFrustumCullingUnitTests();
+bool RunBoundingVolumeHierarchyUnitTests();
+bool RunScenePickingUnitTests();
+bool RunEntityHierarchyUnitTests();
+bool RunClusteredLightingUnitTests();
+#if defined(GRAPHICS_API_NULL)
+bool RunCommandListUnitTests();
+bool RunMeshLODUnitTests();
+bool RunSceneRenderUnitTests();
+bool RunSpriteBatchUnitTests();
+bool RunMeshInstancingUnitTests();
+bool RunRenderStateUnitTests();
+#endif
 
 int main()
 {
     JKORN_ENGINE_ASSERT(RunWideStringUnitTests() == true,
 		"Wide String Unit Tests.");
+    JKORN_ENGINE_ASSERT(RunRenderQueueUnitTests() == true,
+		"Render Queue Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunRenderThreadUnitTests() == true,
+		"Render Thread Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunFrustumCullingUnitTests() == true,
+		"Frustum Culling Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunBoundingVolumeHierarchyUnitTests() == true,
+		"Bounding Volume Hierarchy Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunScenePickingUnitTests() == true,
+		"Scene Picking Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunEntityHierarchyUnitTests() == true,
+		"Entity Hierarchy Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunClusteredLightingUnitTests() == true,
+		"Clustered Lighting Unit Tests Failed.");
+#if defined(GRAPHICS_API_NULL)
+    JKORN_ENGINE_ASSERT(RunCommandListUnitTests() == true,
+		"Command List Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunMeshLODUnitTests() == true,
+		"Mesh LOD Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunSceneRenderUnitTests() == true,
+		"Scene Render Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunSpriteBatchUnitTests() == true,
+		"Sprite Batch Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunMeshInstancingUnitTests() == true,
+		"Mesh Instancing Unit Tests Failed.");
+    JKORN_ENGINE_ASSERT(RunRenderStateUnitTests() == true,
+		"Render State Unit Tests Failed.");
+#endif
 
     JKORN_ENGINE_ASSERT(RunVector2UnitTests() == true,
 		"Vector2 UnitTest Failed.");
@@ -24,10 +99,20 @@ int main()
 		"Matrix3x3 UnitTest Failed.");
     JKORN_ENGINE_ASSERT(RunMatrix4UnitTests() == true,
 		"Matrix4x4 UnitTest Failed.");
+    JKORN_ENGINE_ASSERT(RunQuaternionUnitTests() == true,
+		"Quaternion UnitTest Failed.");
+    JKORN_ENGINE_ASSERT(RunBatchTransformUnitTests() == true,
+		"Batch Transform UnitTest Failed.");
+    JKORN_ENGINE_ASSERT(RunTransformUnitTests() == true,
+		"Transform UnitTest Failed.");
     JKORN_ENGINE_ASSERT(Run2DIntersectionUnitTests() == true,
 		"2D Intersection UnitTests Failed");
     JKORN_ENGINE_ASSERT(Run3DIntersectionUnitTests() == true,
 		"2D Intersection UnitTests Failed");
+    JKORN_ENGINE_ASSERT(RunShapeOverlapUnitTests() == true,
+		"Shape Overlap UnitTests Failed");
+    JKORN_ENGINE_ASSERT(RunShapePacketUnitTests() == true,
+		"Shape Packet UnitTests Failed");
 
 	std::printf("Unit Tests Passed!\n");
 	return 0;
@@ -52,3 +137,1078 @@ bool RunWideStringUnitTests()
 	}
 	return isValid;
 }
+
+bool RunRenderQueueUnitTests()
+{
+	bool isValid = true;
+	{
+		// Opaque objects are sorted by state first & then front to back.
+		uint64_t nearKey = Engine::RenderQueue::CreateSortKey(
+			Engine::RenderQueueLayer_Opaque, 1, 1, 1, 1.0f);
+		uint64_t farKey = Engine::RenderQueue::CreateSortKey(
+			Engine::RenderQueueLayer_Opaque, 1, 1, 1, 100.0f);
+		uint64_t otherShaderKey = Engine::RenderQueue::CreateSortKey(
+			Engine::RenderQueueLayer_Opaque, 2, 1, 1, 0.5f);
+		isValid &= nearKey < farKey;
+		isValid &= farKey < otherShaderKey;
+	}
+
+	{
+		// Transparent objects are drawn after the opaque objects & back to front.
+		uint64_t opaqueKey = Engine::RenderQueue::CreateSortKey(
+			Engine::RenderQueueLayer_Opaque, 4095, 4095, 1, 1000.0f);
+		uint64_t nearKey = Engine::RenderQueue::CreateSortKey(
+			Engine::RenderQueueLayer_Transparent, 1, 1, 1, 1.0f);
+		uint64_t farKey = Engine::RenderQueue::CreateSortKey(
+			Engine::RenderQueueLayer_Transparent, 2, 1, 1, 100.0f);
+		isValid &= opaqueKey < farKey;
+		isValid &= farKey < nearKey;
+	}
+
+	{
+		// The radix sort matches a stable sort of the keys.
+		Engine::RenderQueue renderQueue;
+		const uint64_t keys[] = { 5, 0xFF00000000000000ull, 3, 5, 0x100, 1, 0xFF00000000000000ull, 0 };
+		const uint32_t sortedIndices[] = { 7, 5, 2, 0, 3, 4, 1, 6 };
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			renderQueue.Submit(keys[i], i);
+		}
+		renderQueue.Sort();
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			isValid &= renderQueue.GetEntries()[i].itemIndex == sortedIndices[i];
+		}
+	}
+
+	{
+		// Ids are handed out in the order they're first seen.
+		Engine::RenderQueue renderQueue;
+		int a, b;
+		isValid &= renderQueue.GetID(nullptr) == 0;
+		isValid &= renderQueue.GetID(&a) == 1;
+		isValid &= renderQueue.GetID(&b) == 2;
+		isValid &= renderQueue.GetID(&a) == 1;
+	}
+	return isValid;
+}
+
+bool RunRenderThreadUnitTests()
+{
+	bool isValid = true;
+	for (uint32_t frameLatency = 0; frameLatency <= Engine::RenderThread::c_maxFrameLatency; frameLatency++)
+	{
+		const uint64_t numFrames = 16;
+
+		// Only touched by the render thread until it's stopped.
+		std::vector<uint64_t> renderedFrames;
+		bool packetsMatch = true;
+
+		Engine::RenderThread renderThread(frameLatency);
+		isValid &= renderThread.GetFrameLatency() == frameLatency;
+		renderThread.Start([&](const Engine::FramePacket& framePacket)
+			{
+				renderedFrames.push_back(framePacket.frameIndex);
+				packetsMatch &= framePacket.pointLights.size() == framePacket.frameIndex % 4;
+				// Destroying an asset while rendering doesn't wait on itself.
+				Engine::RenderThread::FlushActive();
+			});
+
+		for (uint64_t i = 0; i < numFrames; i++)
+		{
+			// The packet is cleared for each frame.
+			Engine::FramePacket& framePacket = renderThread.BeginFrame();
+			isValid &= framePacket.frameIndex == i;
+			isValid &= framePacket.pointLights.empty();
+			framePacket.pointLights.resize(i % 4);
+			renderThread.EndFrame();
+
+			// Destroying an asset waits for the frames in flight.
+			if (i == numFrames / 2)
+			{
+				Engine::RenderThread::FlushActive();
+				isValid &= renderThread.GetNumFramesRendered() == i + 1;
+			}
+		}
+		renderThread.Stop();
+
+		// The frames are rendered in the order they were submitted.
+		isValid &= packetsMatch;
+		isValid &= renderThread.GetNumFramesRendered() == numFrames;
+		isValid &= renderedFrames.size() == numFrames;
+		for (uint64_t i = 0; i < renderedFrames.size(); i++)
+		{
+			isValid &= renderedFrames[i] == i;
+		}
+	}
+	return isValid;
+}
+
+bool RunFrustumCullingUnitTests()
+{
+	bool isValid = true;
+	// A camera at the origin looking down +z.
+	Engine::CullingFrustum frustum = Engine::CullingFrustum::FromViewProjection(
+		MathLib::Matrix4x4::CreatePersp(90.0f, 1.0f, 0.1f, 100.0f));
+	{
+		MathLib::Vector3 extents(1.0f, 1.0f, 1.0f);
+		isValid &= frustum.IsVisible(MathLib::Vector3(0.0f, 0.0f, 10.0f), extents);
+		// Intersects the right plane.
+		isValid &= frustum.IsVisible(MathLib::Vector3(10.5f, 0.0f, 10.0f), extents);
+		isValid &= !frustum.IsVisible(MathLib::Vector3(20.0f, 0.0f, 10.0f), extents);
+		isValid &= !frustum.IsVisible(MathLib::Vector3(0.0f, -20.0f, 10.0f), extents);
+		isValid &= !frustum.IsVisible(MathLib::Vector3(0.0f, 0.0f, -10.0f), extents);
+		isValid &= !frustum.IsVisible(MathLib::Vector3(0.0f, 0.0f, 200.0f), extents);
+	}
+
+	{
+		// Only the frustum copied with its near plane culls in front of the near plane.
+		MathLib::Frustum3D mathFrustum = MathLib::Frustum3D::FromViewProjection(
+			MathLib::Matrix4x4::CreatePersp(90.0f, 1.0f, 0.1f, 100.0f));
+		Engine::CullingFrustum nearFrustum = Engine::CullingFrustum::FromFrustum(mathFrustum);
+		MathLib::Vector3 extents(0.01f, 0.01f, 0.01f);
+		isValid &= frustum.IsVisible(MathLib::Vector3(0.0f, 0.0f, 0.05f), extents);
+		isValid &= !nearFrustum.IsVisible(MathLib::Vector3(0.0f, 0.0f, 0.05f), extents);
+		isValid &= nearFrustum.IsVisible(MathLib::Vector3(0.0f, 0.0f, 10.0f), extents);
+		isValid &= !nearFrustum.IsVisible(MathLib::Vector3(0.0f, 0.0f, 200.0f), extents);
+	}
+
+	{
+		// The bounds of a rotated box enclose its corners.
+		MathLib::Vector3 center, extents;
+		Engine::Graphics::Culling::TransformBounds(
+			MathLib::Matrix4x4::CreateRotationZ(45.0f) * MathLib::Matrix4x4::CreateTranslation(1.0f, 2.0f, 3.0f),
+			MathLib::Vector3(0.0f, 0.0f, 0.0f), MathLib::Vector3(1.0f, 1.0f, 1.0f), center, extents);
+		isValid &= std::abs(center.x - 1.0f) < 0.0001f && std::abs(center.y - 2.0f) < 0.0001f
+			&& std::abs(center.z - 3.0f) < 0.0001f;
+		isValid &= std::abs(extents.x - 1.41421f) < 0.001f && std::abs(extents.y - 1.41421f) < 0.001f
+			&& std::abs(extents.z - 1.0f) < 0.0001f;
+	}
+
+	{
+		// The visible sprites keep their order.
+		Engine::SceneRenderList renderList;
+		for (int32_t i = 0; i < 10000; i++)
+		{
+			Engine::SpriteRenderItem item;
+			item.objectToWorld = MathLib::Matrix4x4::CreateTranslation(
+				(i % 2) == 0 ? 0.0f : 50.0f, 0.0f, 10.0f);
+			item.entityID = i;
+			renderList.sprites.push_back(item);
+		}
+		// Meshes without bounds are never culled.
+		renderList.meshes.resize(3);
+
+		uint32_t numCulled = Engine::Graphics::Culling::CullRenderList(renderList, frustum);
+		isValid &= numCulled == 5000;
+		isValid &= renderList.meshes.size() == 3;
+		isValid &= renderList.sprites.size() == 5000;
+		for (uint32_t i = 0; i < renderList.sprites.size(); i++)
+		{
+			isValid &= renderList.sprites[i].entityID == (int32_t)i * 2;
+		}
+	}
+	return isValid;
+}
+
+bool RunBoundingVolumeHierarchyUnitTests()
+{
+	bool isValid = true;
+
+	// A grid of unit boxes, the user data is the index of the box.
+	const uint32_t gridSize = 16;
+	std::vector<MathLib::Vector3> boxMins;
+	Engine::BoundingVolumeHierarchy hierarchy;
+	std::vector<int32_t> proxies;
+	for (uint32_t i = 0; i < gridSize * gridSize; i++)
+	{
+		MathLib::Vector3 min((float)(i % gridSize) * 2.0f, (float)(i / gridSize) * 2.0f, 0.0f);
+		boxMins.push_back(min);
+		proxies.push_back(hierarchy.CreateProxy(min, min + MathLib::Vector3::One, i));
+	}
+	isValid &= hierarchy.GetNumProxies() == gridSize * gridSize;
+
+	auto queryMatches = [&]() -> bool
+	{
+		// Overlaps the boxes from (2, 2) to (4, 4).
+		std::vector<uint32_t> results;
+		hierarchy.QueryAABB(MathLib::Vector3(4.5f, 4.5f, 0.5f), MathLib::Vector3(8.5f, 8.5f, 1.5f), results);
+		std::sort(results.begin(), results.end());
+		std::vector<uint32_t> expected;
+		for (uint32_t y = 2; y <= 4; y++)
+		{
+			for (uint32_t x = 2; x <= 4; x++)
+			{
+				expected.push_back(y * gridSize + x);
+			}
+		}
+		return results == expected;
+	};
+
+	auto closestHit = [&](const MathLib::Ray3D& ray) -> int32_t
+	{
+		// Tests against the exact boxes, so the fattened boxes aren't hits.
+		int32_t closest = -1;
+		hierarchy.RayCast(ray, [&](uint32_t userData, float maxDistance) -> float
+			{
+				const MathLib::Vector3& min = boxMins[userData];
+				float distance = min.z - ray.startPoint.z;
+				bool hit = ray.startPoint.x >= min.x && ray.startPoint.x <= min.x + 1.0f
+					&& ray.startPoint.y >= min.y && ray.startPoint.y <= min.y + 1.0f;
+				if (hit && distance >= 0.0f && distance < maxDistance)
+				{
+					closest = (int32_t)userData;
+					return distance;
+				}
+				return maxDistance;
+			});
+		return closest;
+	};
+
+	isValid &= queryMatches();
+	isValid &= closestHit(MathLib::Ray3D(MathLib::Vector3(6.5f, 2.5f, -5.0f), MathLib::Vector3::UnitZ)) == 19;
+	isValid &= closestHit(MathLib::Ray3D(MathLib::Vector3(5.5f, 2.5f, -5.0f), MathLib::Vector3::UnitZ)) == -1;
+
+	// Small movements stay within the fattened boxes.
+	isValid &= !hierarchy.MoveProxy(proxies[0], boxMins[0] + MathLib::Vector3(0.05f, 0.0f, 0.0f),
+		boxMins[0] + MathLib::Vector3(1.05f, 1.0f, 1.0f));
+
+	// Moves every box up by one, refitting & then rebuilding keeps the results.
+	for (uint32_t i = 0; i < proxies.size(); i++)
+	{
+		boxMins[i] = boxMins[i] + MathLib::Vector3(0.0f, 0.0f, 1.0f);
+		isValid &= hierarchy.MoveProxy(proxies[i], boxMins[i], boxMins[i] + MathLib::Vector3::One);
+	}
+	isValid &= queryMatches();
+	isValid &= hierarchy.NeedsRebuild();
+	hierarchy.Rebuild();
+	isValid &= !hierarchy.NeedsRebuild();
+	isValid &= queryMatches();
+	isValid &= closestHit(MathLib::Ray3D(MathLib::Vector3(6.5f, 2.5f, -5.0f), MathLib::Vector3::UnitZ)) == 19;
+	// A balanced tree of 256 leaves has a height of 9.
+	isValid &= hierarchy.GetHeight() <= 12;
+
+	// The destroyed proxies are no longer found.
+	for (uint32_t i = 0; i < proxies.size(); i += 2)
+	{
+		hierarchy.DestroyProxy(proxies[i]);
+	}
+	isValid &= hierarchy.GetNumProxies() == gridSize * gridSize / 2;
+	{
+		std::vector<uint32_t> results;
+		hierarchy.QueryAABB(MathLib::Vector3(-100.0f, -100.0f, -100.0f), MathLib::Vector3(100.0f, 100.0f, 100.0f), results);
+		isValid &= results.size() == gridSize * gridSize / 2;
+		for (uint32_t userData : results)
+		{
+			isValid &= (userData % 2) == 1;
+		}
+	}
+	return isValid;
+}
+
+bool RunScenePickingUnitTests()
+{
+	bool isValid = true;
+
+	// Sprites facing the camera, two in a line & one off to the side.
+	Engine::Scene scene(L"PickingScene");
+	auto createSprite = [&scene](const MathLib::Vector3& position) -> Engine::Entity
+	{
+		Engine::EntityRef entity = scene.CreateEntity("Sprite");
+		entity.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(position);
+		entity.AddComponent<Engine::SpriteComponent>(true);
+		return entity.GetEntity();
+	};
+	Engine::Entity front = createSprite(MathLib::Vector3(0.0f, 0.0f, 5.0f));
+	Engine::Entity back = createSprite(MathLib::Vector3(0.0f, 0.0f, 10.0f));
+	Engine::Entity side = createSprite(MathLib::Vector3(3.0f, 0.0f, 5.0f));
+	// A sprite that only has a 2D transform, it's on the z = 0 plane.
+	Engine::Entity sprite2D;
+	{
+		Engine::EntityRef entity = scene.CreateEntity("Sprite2D");
+		entity.AddComponent<Engine::Transform2DComponent>().SetLocalPosition(-3.0f, 0.0f);
+		entity.AddComponent<Engine::SpriteComponent>(true);
+		sprite2D = entity.GetEntity();
+	}
+
+	Engine::EntityHierarchySystem hierarchySystem;
+	Engine::SpatialIndexSystem spatialIndexSystem;
+	Engine::Timestep ts(1.0f / 60.0f);
+	Engine::UpdateSystemContext updateContext(scene, ts, false);
+	hierarchySystem.InvokeOnUpdate(updateContext);
+	spatialIndexSystem.InvokeOnUpdate(updateContext);
+	isValid &= scene.GetSpatialIndex().GetNumEntities() == 4;
+
+	Engine::SceneRayCastHit hit;
+	isValid &= scene.RayCast(MathLib::Ray3D(MathLib::Vector3(0.1f, 0.2f, -10.0f), MathLib::Vector3::UnitZ), hit);
+	isValid &= hit.entity == front;
+	isValid &= std::abs(hit.distance - 15.0f) < 0.001f;
+
+	isValid &= scene.RayCast(MathLib::Ray3D(MathLib::Vector3(2.8f, -0.3f, -10.0f), MathLib::Vector3::UnitZ), hit);
+	isValid &= hit.entity == side;
+	isValid &= !scene.RayCast(MathLib::Ray3D(MathLib::Vector3(1.5f, 0.0f, -10.0f), MathLib::Vector3::UnitZ), hit);
+	isValid &= scene.RayCast(MathLib::Ray3D(MathLib::Vector3(-2.8f, 0.1f, -10.0f), MathLib::Vector3::UnitZ), hit);
+	isValid &= hit.entity == sprite2D;
+	isValid &= std::abs(hit.distance - 10.0f) < 0.001f;
+
+	// The disabled sprites are removed from the spatial index.
+	scene.CreateEntityRef(front).GetComponent<Engine::SpriteComponent>().enabled = false;
+	spatialIndexSystem.InvokeOnUpdate(updateContext);
+	isValid &= scene.GetSpatialIndex().GetNumEntities() == 3;
+	isValid &= scene.RayCast(MathLib::Ray3D(MathLib::Vector3(0.1f, 0.2f, -10.0f), MathLib::Vector3::UnitZ), hit);
+	isValid &= hit.entity == back;
+	isValid &= std::abs(hit.distance - 20.0f) < 0.001f;
+	return isValid;
+}
+
+bool RunEntityHierarchyUnitTests()
+{
+	bool isValid = true;
+
+	Engine::Scene scene(L"HierarchyScene");
+	// Routes the hierarchy changed events to the scene, so the hierarchy gets rebuilt.
+	Engine::EventInvoker::Global().SetEventFunc([&scene](Engine::IEvent& event) { scene.OnEvent(event); });
+
+	Engine::EntityRef parent = scene.CreateEntity("Parent");
+	parent.AddComponent<Engine::Transform3DComponent>(MathLib::Vector3(1.0f, 0.0f, 0.0f),
+		MathLib::Quaternion::FromEuler(90.0f, 0.0f, 0.0f), MathLib::Vector3::One);
+	Engine::EntityRef child = scene.CreateEntity("Child", parent.GetEntity());
+	child.AddComponent<Engine::Transform3DComponent>(MathLib::Vector3(0.0f, 2.0f, 0.0f),
+		MathLib::Quaternion::Identity, MathLib::Vector3(2.0f, 2.0f, 2.0f));
+	Engine::EntityRef grandChild = scene.CreateEntity("GrandChild", child.GetEntity());
+	grandChild.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3(0.0f, 0.0f, 1.0f));
+	Engine::EntityRef sprite = scene.CreateEntity("Sprite", parent.GetEntity());
+	sprite.AddComponent<Engine::Transform2DComponent>().SetLocalPosition(3.0f, 4.0f);
+
+	Engine::EntityHierarchySystem hierarchySystem;
+	Engine::Timestep ts(1.0f / 60.0f);
+	Engine::UpdateSystemContext updateContext(scene, ts, false);
+	const Engine::SceneTransforms& transforms = scene.GetTransforms();
+
+	// The world matrices are the local matrices combined with the parents' world matrices.
+	auto isHierarchyValid = [&]() -> bool
+	{
+		MathLib::Matrix4x4 parentWorld = parent.GetComponent<Engine::Transform3DComponent>().GetLocalTransformMatrix();
+		MathLib::Matrix4x4 childWorld = child.GetComponent<Engine::Transform3DComponent>().GetTransformMatrix(parentWorld);
+		MathLib::Matrix4x4 grandChildWorld = grandChild.GetComponent<Engine::Transform3DComponent>().GetTransformMatrix(childWorld);
+		MathLib::Matrix4x4 spriteWorld = sprite.GetComponent<Engine::Transform2DComponent>().GetTransformMatrix(parentWorld);
+
+		bool isMatching = transforms.GetWorldMatrix(parent.GetEntity()) == parentWorld;
+		isMatching &= transforms.GetWorldMatrix(child.GetEntity()) == childWorld;
+		isMatching &= transforms.GetWorldMatrix(grandChild.GetEntity()) == grandChildWorld;
+		isMatching &= transforms.GetWorldMatrix(sprite.GetEntity()) == spriteWorld;
+		return isMatching;
+	};
+
+	hierarchySystem.InvokeOnUpdate(updateContext);
+	isValid &= isHierarchyValid();
+	// The parent's rotation turns the child's scaled offset.
+	MathLib::Vector3 grandChildPosition = transforms.GetWorldMatrix(grandChild.GetEntity()).GetTranslation();
+	isValid &= std::abs(grandChildPosition.y - 2.0f) < 0.001f;
+	isValid &= std::abs(MathLib::Vector3(grandChildPosition.x - 1.0f, 0.0f, grandChildPosition.z).Length() - 2.0f) < 0.001f;
+
+	// Moving the parent moves the children on the next update.
+	parent.GetComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3(-5.0f, 0.0f, 0.0f));
+	hierarchySystem.InvokeOnUpdate(updateContext);
+	isValid &= isHierarchyValid();
+
+	// An entity without a parent uses its local matrix.
+	grandChild.GetComponent<Engine::EntityHierarchyComponent>().SetParent(Engine::Entity::None, grandChild.GetRegistry());
+	hierarchySystem.InvokeOnUpdate(updateContext);
+	isValid &= transforms.GetWorldMatrix(grandChild.GetEntity())
+		== MathLib::Matrix4x4::CreateTranslation(MathLib::Vector3(0.0f, 0.0f, 1.0f));
+	isValid &= transforms.GetWorldMatrix(Engine::Entity::None) == MathLib::Matrix4x4::Identity;
+
+	// Reparenting moves the entity back into the parent's subtree.
+	grandChild.GetComponent<Engine::EntityHierarchyComponent>().SetParent(sprite.GetEntity(), grandChild.GetRegistry());
+	hierarchySystem.InvokeOnUpdate(updateContext);
+	isValid &= transforms.GetNumRoots() == 1;
+	isValid &= transforms.GetWorldMatrix(grandChild.GetEntity())
+		== grandChild.GetComponent<Engine::Transform3DComponent>().GetTransformMatrix(
+			transforms.GetWorldMatrix(sprite.GetEntity()));
+
+	// An entity with both transforms gets a world matrix for each, its children use the 2D one.
+	{
+		Engine::Transform3DComponent& sprite3D = sprite.AddComponent<Engine::Transform3DComponent>();
+		sprite3D.SetLocalPosition(MathLib::Vector3(0.0f, 0.0f, 5.0f));
+		hierarchySystem.InvokeOnUpdate(updateContext);
+		const MathLib::Matrix4x4& parentWorld = transforms.GetWorldMatrix(parent.GetEntity());
+		MathLib::Matrix4x4 sprite2DWorld = sprite.GetComponent<Engine::Transform2DComponent>().GetTransformMatrix(parentWorld);
+		isValid &= transforms.GetWorldMatrix(sprite.GetEntity()) == sprite2DWorld;
+		isValid &= transforms.GetWorldMatrix(sprite.GetEntity(),
+			Engine::SceneTransforms::TransformType::Transform2D) == sprite2DWorld;
+		isValid &= transforms.GetWorldMatrix(sprite.GetEntity(),
+			Engine::SceneTransforms::TransformType::Transform3D) == sprite3D.GetTransformMatrix(parentWorld);
+		isValid &= transforms.GetWorldMatrix(grandChild.GetEntity())
+			== grandChild.GetComponent<Engine::Transform3DComponent>().GetTransformMatrix(sprite2DWorld);
+		sprite.RemoveComponent<Engine::Transform3DComponent>();
+	}
+
+	// A subtree large enough to be updated a level at a time, with a deep chain & a wide level.
+	{
+		const uint32_t c_chainLength = 64;
+		const uint32_t c_numSiblings = 10000;
+		Engine::EntityRef root = scene.CreateEntity("Root");
+		root.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3(0.0f, 1.0f, 0.0f));
+
+		Engine::Entity link = root.GetEntity();
+		for (uint32_t i = 0; i < c_chainLength; i++)
+		{
+			Engine::EntityRef entity = scene.CreateEntity("Link", link);
+			entity.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3(1.0f, 0.0f, 0.0f));
+			link = entity.GetEntity();
+		}
+		std::vector<Engine::Entity> siblings;
+		for (uint32_t i = 0; i < c_numSiblings; i++)
+		{
+			Engine::EntityRef entity = scene.CreateEntity("Sibling", root.GetEntity());
+			entity.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3(0.0f, 0.0f, (float)i));
+			siblings.push_back(entity.GetEntity());
+		}
+		hierarchySystem.InvokeOnUpdate(updateContext);
+
+		isValid &= transforms.GetWorldMatrix(link).GetTranslation()
+			== MathLib::Vector3((float)c_chainLength, 1.0f, 0.0f);
+		for (uint32_t i = 0; i < c_numSiblings; i++)
+		{
+			isValid &= transforms.GetWorldMatrix(siblings[i]).GetTranslation()
+				== MathLib::Vector3(0.0f, 1.0f, (float)i);
+		}
+	}
+
+	// Many small subtrees that get batched together.
+	{
+		const uint32_t c_numRoots = 4000;
+		std::vector<Engine::Entity> leaves;
+		for (uint32_t i = 0; i < c_numRoots; i++)
+		{
+			Engine::EntityRef root = scene.CreateEntity("SmallRoot");
+			root.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3((float)i, 0.0f, 0.0f));
+			Engine::EntityRef leaf = scene.CreateEntity("Leaf", root.GetEntity());
+			leaf.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3(0.0f, 0.0f, 2.0f));
+			leaves.push_back(leaf.GetEntity());
+		}
+		hierarchySystem.InvokeOnUpdate(updateContext);
+
+		isValid &= transforms.GetNumRoots() == c_numRoots + 2;
+		for (uint32_t i = 0; i < c_numRoots; i++)
+		{
+			isValid &= transforms.GetWorldMatrix(leaves[i]).GetTranslation()
+				== MathLib::Vector3((float)i, 0.0f, 2.0f);
+		}
+	}
+
+	Engine::EventInvoker::Global().SetEventFunc(nullptr);
+	return isValid;
+}
+
+bool RunClusteredLightingUnitTests()
+{
+	bool isValid = true;
+
+	// A grid of lights in front of a camera at (0, 0, -10) looking down +z.
+	std::vector<Engine::FramePacketPointLight> pointLights;
+	for (uint32_t i = 0; i < 256; i++)
+	{
+		Engine::FramePacketPointLight light;
+		light.position = MathLib::Vector3((float)(i % 8) * 3.0f - 10.5f,
+			(float)((i / 8) % 8) * 3.0f - 10.5f, (float)(i / 64) * 12.0f - 4.0f);
+		light.pointLight = Engine::PointLightComponent(0.5f, 1.0f + (float)(i % 5), 1.0f);
+		pointLights.push_back(light);
+	}
+	// A light far off to the side of the camera.
+	pointLights.push_back({ MathLib::Vector3(500.0f, 0.0f, 10.0f), Engine::PointLightComponent(1.0f, 2.0f, 1.0f) });
+
+	MathLib::Matrix4x4 view = MathLib::Matrix4x4::Invert(
+		MathLib::Matrix4x4::CreateTranslation(0.0f, 0.0f, -10.0f));
+	const MathLib::Matrix4x4 viewProjections[] =
+	{
+		view * MathLib::Matrix4x4::CreatePersp(90.0f, 1.0f, 0.1f, 100.0f),
+		view * MathLib::Matrix4x4::CreateOrtho(30.0f, 30.0f, 0.1f, 100.0f)
+	};
+
+	Engine::LightClusterList lightClusters;
+	for (const MathLib::Matrix4x4& viewProjection : viewProjections)
+	{
+		Engine::Graphics::Lighting::AssignLightsToClusters(viewProjection, pointLights, lightClusters);
+		isValid &= lightClusters.clusters.size() == Engine::LightClusterList::c_numClusters;
+		isValid &= std::find(lightClusters.lightIndices.begin(), lightClusters.lightIndices.end(),
+			(uint32_t)pointLights.size() - 1) == lightClusters.lightIndices.end();
+
+		// Every visible point within the radius of a light finds the light in its cluster.
+		for (float z = -9.5f; z < 40.0f; z += 0.75f)
+		{
+			for (float y = -14.0f; y <= 14.0f; y += 0.7f)
+			{
+				for (float x = -14.0f; x <= 14.0f; x += 0.7f)
+				{
+					MathLib::Vector3 point(x, y, z);
+					MathLib::Vector4 clip = MathLib::Vector4(point, 1.0f) * viewProjection;
+					if (clip.w <= 0.0f || std::abs(clip.x) > clip.w || std::abs(clip.y) > clip.w)
+					{
+						continue;
+					}
+					uint32_t clusterIndex = lightClusters.FindCluster(viewProjection, point);
+					const Engine::LightCluster& cluster = lightClusters.clusters[clusterIndex];
+					auto begin = lightClusters.lightIndices.begin() + cluster.offset;
+					for (uint32_t i = 0; i < (uint32_t)pointLights.size(); i++)
+					{
+						MathLib::Vector3 offset = pointLights[i].position - point;
+						float radius = pointLights[i].pointLight.outerRadius;
+						if (MathLib::Vector3::Dot(offset, offset) < radius * radius)
+						{
+							isValid &= std::find(begin, begin + cluster.count, i) != begin + cluster.count;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// The perspective clusters hold far fewer lights than shading every light.
+	Engine::Graphics::Lighting::AssignLightsToClusters(viewProjections[0], pointLights, lightClusters);
+	isValid &= lightClusters.lightIndices.size()
+		< pointLights.size() * Engine::LightClusterList::c_numClusters / 20;
+	return isValid;
+}
+
+#if defined(GRAPHICS_API_NULL)
+
+bool RunCommandListUnitTests()
+{
+	bool isValid = Engine::GraphicsRenderer::Init(nullptr);
+	if (!isValid)
+	{
+		return false;
+	}
+	Engine::GraphicsRenderer3D::Init();
+	Engine::JobManager::Init();
+
+	Engine::Mesh& mesh = Engine::GraphicsRenderer3D::GetCubeMesh();
+	Engine::NullCommandLog& commandLog = Engine::NullRenderingAPI::GetActiveCommandLog();
+
+	{
+		// The lists are recorded in parallel & submitted in the order of the lists.
+		const uint32_t numLists = 8;
+		Engine::CommandList commandLists[numLists];
+		Engine::JobManager::ParallelFor(numLists, [&](uint32_t list)
+			{
+				for (uint32_t i = 0; i <= list; i++)
+				{
+					commandLists[list].DrawMesh(mesh, nullptr,
+						MathLib::Matrix4x4::Identity, (int32_t)i);
+				}
+			});
+
+		commandLog.Clear();
+		commandLog.SetRecordCommands(true);
+		for (uint32_t i = 0; i < numLists; i++)
+		{
+			// The draws with the same mesh & material get merged.
+			isValid &= commandLists[i].GetNumCommands() == 1;
+			commandLists[i].Submit();
+		}
+
+		uint32_t numDraws = 0;
+		for (const Engine::NullCommand& command : commandLog.GetCommands())
+		{
+			if (command.type == Engine::NullCommand_DrawIndexedInstanced)
+			{
+				// The slot of an instanced draw is its number of instances.
+				isValid &= command.slot == numDraws + 1;
+				numDraws++;
+			}
+		}
+		isValid &= numDraws == numLists;
+	}
+
+	{
+		// Draws aren't merged across other commands.
+		Engine::CommandList commandList;
+		commandList.DrawMesh(mesh, nullptr, MathLib::Matrix4x4::Identity);
+		commandList.DrawSprite(MathLib::Matrix4x4::Identity, MathLib::Vector4::One, nullptr);
+		commandList.DrawSprite(MathLib::Matrix4x4::Identity, MathLib::Vector4::One, nullptr);
+		commandList.DrawMesh(mesh, nullptr, MathLib::Matrix4x4::Identity);
+		isValid &= commandList.GetNumCommands() == 3;
+		isValid &= commandList.GetCommands()[1].dataCount == 2;
+
+		commandList.Clear();
+		isValid &= commandList.GetNumCommands() == 0;
+	}
+
+	Engine::JobManager::Release();
+	Engine::GraphicsRenderer3D::Release();
+	Engine::GraphicsRenderer::Release();
+	return isValid;
+}
+
+bool RunMeshLODUnitTests()
+{
+	bool isValid = Engine::GraphicsRenderer::Init(nullptr);
+	if (!isValid)
+	{
+		return false;
+	}
+	Engine::GraphicsRenderer3D::Init();
+
+	// The cube has a bounding sphere radius of ~0.866.
+	Engine::Mesh& mesh = Engine::GraphicsRenderer3D::GetCubeMesh();
+	Engine::MeshLODGroup lodGroup;
+	lodGroup.AddLOD(&mesh, 0.5f);
+	lodGroup.AddLOD(&mesh, 0.2f);
+	lodGroup.AddLOD(&mesh, 0.05f);
+	isValid &= lodGroup.GetNumLODs() == 3;
+	isValid &= std::abs(lodGroup.GetBoundsRadius() - 0.866f) < 0.001f;
+
+	{
+		// The LOD only changes once the screen size passes the threshold by the hysteresis.
+		isValid &= lodGroup.SelectLOD(0.6f, 0) == 0;
+		isValid &= lodGroup.SelectLOD(0.47f, 0) == 0;
+		isValid &= lodGroup.SelectLOD(0.44f, 0) == 1;
+		isValid &= lodGroup.SelectLOD(0.52f, 1) == 1;
+		isValid &= lodGroup.SelectLOD(0.56f, 1) == 0;
+		isValid &= lodGroup.SelectLOD(0.01f, 2) == 3;
+		isValid &= lodGroup.SelectLOD(0.054f, 3) == 3;
+		isValid &= lodGroup.SelectLOD(0.056f, 3) == 2;
+		isValid &= lodGroup.SelectLOD(0.3f, 3) == 1;
+	}
+
+	// A camera at the origin looking down +z, the projected size halves as the distance doubles.
+	MathLib::Matrix4x4 viewProjection = MathLib::Matrix4x4::CreatePersp(90.0f, 1.0f, 0.1f, 1000.0f);
+	isValid &= std::abs(Engine::Graphics::LevelOfDetail::GetScreenSize(viewProjection,
+		MathLib::Vector3(0.0f, 0.0f, 10.0f), 1.0f) - 0.1f) < 0.0001f;
+	isValid &= Engine::Graphics::LevelOfDetail::GetScreenSize(viewProjection,
+		MathLib::Vector3(0.0f, 0.0f, 0.5f), 1.0f) > 1.0f;
+
+	{
+		const float distances[] = { 1.5f, 3.0f, 10.0f, 100.0f };
+		std::vector<Engine::MeshRenderItem> meshes;
+		for (float distance : distances)
+		{
+			Engine::MeshRenderItem& item = meshes.emplace_back();
+			item.objectToWorld = MathLib::Matrix4x4::CreateTranslation(0.0f, 0.0f, distance);
+			item.lodGroup = &lodGroup;
+		}
+		Engine::Graphics::LevelOfDetail::SelectMeshLODs(meshes, viewProjection);
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			isValid &= meshes[i].lodIndex == i;
+			isValid &= meshes[i].mesh == (i < 3 ? &mesh : nullptr);
+		}
+	}
+
+	{
+		// The scene keeps the selected LOD & doesn't draw the groups that are too small.
+		Engine::Scene scene(L"LODScene");
+		Engine::EntityRef nearEntity = scene.CreateEntity("Near");
+		nearEntity.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3(0.0f, 0.0f, 3.0f));
+		nearEntity.AddComponent<Engine::MeshComponent>(&lodGroup, nullptr);
+		Engine::EntityRef farEntity = scene.CreateEntity("Far");
+		farEntity.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(MathLib::Vector3(0.0f, 0.0f, 100.0f));
+		farEntity.AddComponent<Engine::MeshComponent>(&lodGroup, nullptr);
+
+		Engine::EntityHierarchySystem hierarchySystem;
+		Engine::Timestep ts(1.0f / 60.0f);
+		Engine::UpdateSystemContext updateContext(scene, ts, false);
+		hierarchySystem.InvokeOnUpdate(updateContext);
+
+		Engine::CameraConstants cameraConstants;
+		cameraConstants.c_viewProjection = viewProjection;
+		Engine::FramePacket framePacket;
+		scene.GatherFramePacket(cameraConstants, framePacket);
+		isValid &= framePacket.renderList.meshes.size() == 1;
+		isValid &= framePacket.meshLODs.size() == 2;
+		isValid &= nearEntity.GetComponent<Engine::MeshComponent>().lodIndex == 0;
+		scene.StoreMeshLODs(framePacket);
+		isValid &= framePacket.renderList.meshes[0].entityID == (int32_t)(entt::entity)nearEntity.GetEntity();
+		isValid &= nearEntity.GetComponent<Engine::MeshComponent>().lodIndex == 1;
+		isValid &= farEntity.GetComponent<Engine::MeshComponent>().lodIndex == 3;
+	}
+
+	Engine::GraphicsRenderer3D::Release();
+	Engine::GraphicsRenderer::Release();
+	return isValid;
+}
+
+bool RunSceneRenderUnitTests()
+{
+	bool isValid = Engine::GraphicsRenderer::Init(nullptr);
+	if (!isValid)
+	{
+		return false;
+	}
+	Engine::GraphicsRenderer3D::Init();
+	Engine::JobManager::Init();
+
+	Engine::NullCommandLog& commandLog = Engine::NullRenderingAPI::GetActiveCommandLog();
+	commandLog.SetRecordCommands(true);
+
+	{
+		// The commands can be recorded from the job workers.
+		commandLog.Clear();
+		const uint32_t numJobs = 8;
+		const uint32_t numCommandsPerJob = 1000;
+		Engine::JobManager::ParallelFor(numJobs, [&](uint32_t job)
+			{
+				for (uint32_t i = 0; i < numCommandsPerJob; i++)
+				{
+					commandLog.Record(Engine::NullCommand_Draw, nullptr, 1);
+				}
+			});
+		isValid &= commandLog.GetNumDrawCalls() == numJobs * numCommandsPerJob;
+		isValid &= commandLog.GetNumBytes(Engine::NullCommand_Draw) == numJobs * numCommandsPerJob;
+		isValid &= commandLog.GetCommands().size() == numJobs * numCommandsPerJob;
+	}
+
+	{
+		// Three cubes in front of the camera with the default material.
+		Engine::Scene scene(L"RenderScene");
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			Engine::EntityRef entity = scene.CreateEntity("Cube");
+			entity.AddComponent<Engine::Transform3DComponent>().SetLocalPosition(
+				MathLib::Vector3((float)i - 1.0f, 0.0f, 5.0f));
+			entity.AddComponent<Engine::MeshComponent>(&Engine::GraphicsRenderer3D::GetCubeMesh(), nullptr);
+		}
+
+		Engine::EntityHierarchySystem hierarchySystem;
+		Engine::Timestep ts(1.0f / 60.0f);
+		Engine::UpdateSystemContext updateContext(scene, ts, false);
+		hierarchySystem.InvokeOnUpdate(updateContext);
+
+		Engine::CameraConstants cameraConstants;
+		cameraConstants.c_viewProjection = MathLib::Matrix4x4::CreatePersp(90.0f, 1.0f, 0.1f, 100.0f);
+		Engine::FramePacket framePacket;
+		scene.GatherFramePacket(cameraConstants, framePacket);
+		isValid &= framePacket.renderList.meshes.size() == 3;
+
+		// The first frame binds the shader & the camera, lighting, material & internal material constants.
+		// The second frame binds & uploads nothing new, the third one binds again after the present.
+		const uint32_t numShaderBinds[] = { 1, 0, 1 };
+		const uint32_t numConstantBufferBinds[] = { 4, 0, 4 };
+		Engine::ConstantBuffer* cameraBuffer = nullptr;
+		for (uint32_t frame = 0; frame < 3; frame++)
+		{
+			if (frame == 2)
+			{
+				Engine::GraphicsRenderer::Present();
+			}
+			commandLog.Clear();
+			Engine::GraphicsRenderer::ResetRenderStateStats();
+			scene.RenderFramePacket(framePacket, &cameraBuffer);
+
+			// The cubes share a mesh & material, so they're drawn with one instanced draw.
+			isValid &= commandLog.GetNumDrawCalls() == 1;
+			isValid &= commandLog.GetNumCommands(Engine::NullCommand_DrawIndexedInstanced) == 1;
+			for (const Engine::NullCommand& command : commandLog.GetCommands())
+			{
+				if (command.type == Engine::NullCommand_DrawIndexedInstanced)
+				{
+					isValid &= command.slot == 3;
+				}
+			}
+
+			// The skipped binds never reach the rendering api.
+			const Engine::GraphicsRenderStateStats& stats = Engine::GraphicsRenderer::GetRenderStateStats();
+			isValid &= stats.numShaderBinds == numShaderBinds[frame];
+			isValid &= stats.numShaderBinds + stats.numShaderBindsSkipped == 1;
+			isValid &= commandLog.GetNumCommands(Engine::NullCommand_BindShader) == numShaderBinds[frame];
+			isValid &= stats.numConstantBufferBinds == numConstantBufferBinds[frame];
+			isValid &= stats.numConstantBufferBinds + stats.numConstantBufferBindsSkipped == 4;
+			isValid &= commandLog.GetNumCommands(Engine::NullCommand_BindConstantBuffer) == numConstantBufferBinds[frame];
+
+			// The constants are the same every frame, so only the first frame uploads any of them.
+			if (frame > 0)
+			{
+				isValid &= stats.numConstantBufferUploads == 0;
+				isValid &= stats.numConstantBufferUploadsSkipped == 4;
+				isValid &= commandLog.GetNumCommands(Engine::NullCommand_SetConstantBufferData) == 0;
+			}
+			// The instances are uploaded with every draw.
+			isValid &= commandLog.GetNumCommands(Engine::NullCommand_SetVertexBufferData) == 1;
+		}
+		delete cameraBuffer;
+	}
+
+	Engine::JobManager::Release();
+	Engine::GraphicsRenderer3D::Release();
+	Engine::GraphicsRenderer::Release();
+	return isValid;
+}
+
+bool RunSpriteBatchUnitTests()
+{
+	bool isValid = Engine::GraphicsRenderer::Init(nullptr);
+	if (!isValid)
+	{
+		return false;
+	}
+	Engine::GraphicsRenderer2D::Init();
+
+	Engine::NullCommandLog& commandLog = Engine::NullRenderingAPI::GetActiveCommandLog();
+	commandLog.SetRecordCommands(true);
+	const Engine::GraphicsRenderer2DStats& stats = Engine::GraphicsRenderer2D::GetStats();
+
+	{
+		// The sprites are only drawn once the batch gets flushed, all in one draw.
+		const uint32_t numSprites = 100;
+		commandLog.Clear();
+		Engine::GraphicsRenderer2D::ResetStats();
+		for (uint32_t i = 0; i < numSprites; i++)
+		{
+			Engine::GraphicsRenderer2D::DrawRect(MathLib::Matrix4x4::CreateTranslation((float)i, 0.0f, 0.0f),
+				MathLib::Vector4::One, nullptr, (int32_t)i);
+		}
+		isValid &= stats.numDrawCalls == 0;
+		Engine::GraphicsRenderer2D::Flush();
+		isValid &= stats.numSprites == numSprites;
+		isValid &= stats.numDrawCalls == 1;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_Draw) == 1;
+		for (const Engine::NullCommand& command : commandLog.GetCommands())
+		{
+			if (command.type == Engine::NullCommand_Draw)
+			{
+				// Each sprite is two triangles.
+				isValid &= command.count == numSprites * 6;
+			}
+		}
+
+		// An empty batch isn't drawn.
+		Engine::GraphicsRenderer2D::Flush();
+		isValid &= stats.numDrawCalls == 1;
+	}
+
+	{
+		// A full batch gets drawn before the next sprite is added.
+		Engine::GraphicsRenderer2D::ResetStats();
+		for (uint32_t i = 0; i <= Engine::GraphicsRenderer2D::c_maxBatchSprites; i++)
+		{
+			Engine::GraphicsRenderer2D::DrawRect(MathLib::Matrix4x4::Identity,
+				MathLib::Vector4::One, nullptr);
+		}
+		isValid &= stats.numDrawCalls == 1;
+		Engine::GraphicsRenderer2D::Flush();
+		isValid &= stats.numDrawCalls == 2;
+	}
+
+	{
+		// The batch gets drawn when a texture past the last texture slot is added.
+		std::vector<Engine::Texture*> textures;
+		for (uint32_t i = 0; i <= Engine::GraphicsRenderer2D::c_maxBatchTextures; i++)
+		{
+			textures.push_back(Engine::Texture::Create(4, 4, Engine::TextureSpecifications()));
+		}
+
+		commandLog.Clear();
+		Engine::GraphicsRenderer2D::ResetStats();
+		for (uint32_t i = 0; i < Engine::GraphicsRenderer2D::c_maxBatchTextures; i++)
+		{
+			Engine::GraphicsRenderer2D::DrawRect(MathLib::Matrix4x4::Identity,
+				MathLib::Vector4::One, textures[i]);
+		}
+		// A texture that's already in the batch reuses its slot.
+		Engine::GraphicsRenderer2D::DrawRect(MathLib::Matrix4x4::Identity,
+			MathLib::Vector4::One, textures[0]);
+		isValid &= stats.numDrawCalls == 0;
+
+		Engine::GraphicsRenderer2D::DrawRect(MathLib::Matrix4x4::Identity,
+			MathLib::Vector4::One, textures[Engine::GraphicsRenderer2D::c_maxBatchTextures]);
+		isValid &= stats.numDrawCalls == 1;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_BindTexture)
+			== Engine::GraphicsRenderer2D::c_maxBatchTextures;
+
+		Engine::GraphicsRenderer2D::Flush();
+		isValid &= stats.numDrawCalls == 2;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_BindTexture)
+			== Engine::GraphicsRenderer2D::c_maxBatchTextures + 1;
+
+		uint32_t numDraws = 0;
+		for (const Engine::NullCommand& command : commandLog.GetCommands())
+		{
+			if (command.type == Engine::NullCommand_Draw)
+			{
+				const uint32_t numBatchSprites = numDraws == 0 ? Engine::GraphicsRenderer2D::c_maxBatchTextures + 1 : 1;
+				isValid &= command.count == numBatchSprites * 6;
+				numDraws++;
+			}
+		}
+		isValid &= numDraws == 2;
+
+		for (Engine::Texture* texture : textures)
+		{
+			delete texture;
+		}
+	}
+
+	Engine::GraphicsRenderer2D::Release();
+	Engine::GraphicsRenderer::Release();
+	return isValid;
+}
+
+bool RunMeshInstancingUnitTests()
+{
+	bool isValid = Engine::GraphicsRenderer::Init(nullptr);
+	if (!isValid)
+	{
+		return false;
+	}
+	Engine::GraphicsRenderer3D::Init();
+
+	Engine::Mesh& mesh = Engine::GraphicsRenderer3D::GetCubeMesh();
+	Engine::NullCommandLog& commandLog = Engine::NullRenderingAPI::GetActiveCommandLog();
+	commandLog.SetRecordCommands(true);
+
+	const uint32_t c_maxInstancesPerDraw = Engine::GraphicsRenderer3D::c_maxInstancesPerDraw;
+	std::vector<Engine::GraphicsInstanceData> instances(2 * c_maxInstancesPerDraw + 100);
+	for (uint32_t i = 0; i < (uint32_t)instances.size(); i++)
+	{
+		instances[i].objectToWorld = MathLib::Matrix4x4::CreateTranslation((float)i, 0.0f, 0.0f);
+		instances[i].entityID = (int32_t)i;
+	}
+
+	{
+		// The instances are drawn with one draw call.
+		commandLog.Clear();
+		Engine::GraphicsRenderer3D::DrawMeshInstanced(mesh, instances.data(), 5);
+		isValid &= commandLog.GetNumDrawCalls() == 1;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_DrawIndexedInstanced) == 1;
+		isValid &= commandLog.GetNumBytes(Engine::NullCommand_SetVertexBufferData)
+			== 5 * sizeof(Engine::GraphicsInstanceData);
+		for (const Engine::NullCommand& command : commandLog.GetCommands())
+		{
+			if (command.type == Engine::NullCommand_DrawIndexedInstanced)
+			{
+				// The slot of an instanced draw is its number of instances.
+				isValid &= command.slot == 5;
+			}
+		}
+	}
+
+	{
+		// The instances that don't fit into the instance buffer are split into more draws.
+		commandLog.Clear();
+		Engine::GraphicsRenderer::ResetRenderStateStats();
+		Engine::GraphicsRenderer3D::DrawMeshInstanced(mesh, instances.data(), (uint32_t)instances.size());
+		isValid &= commandLog.GetNumDrawCalls() == 3;
+
+		const uint32_t numInstancesPerDraw[] = { c_maxInstancesPerDraw, c_maxInstancesPerDraw, 100 };
+		uint32_t numDraws = 0;
+		for (const Engine::NullCommand& command : commandLog.GetCommands())
+		{
+			if (command.type == Engine::NullCommand_DrawIndexedInstanced)
+			{
+				isValid &= numDraws < 3 && command.slot == numInstancesPerDraw[numDraws];
+				numDraws++;
+			}
+		}
+		isValid &= numDraws == 3;
+
+		// The material is only bound once for all of the draws.
+		const Engine::GraphicsRenderStateStats& stats = Engine::GraphicsRenderer::GetRenderStateStats();
+		isValid &= stats.numShaderBinds + stats.numShaderBindsSkipped == 1;
+	}
+
+	{
+		// A shader without the instance parameters draws the instances one at a time.
+		Engine::Material material({ { "c_materialColor", Engine::LayoutType_Vector4 } });
+		std::unique_ptr<Engine::Shader> shader(Engine::Shader::LoadFromFile(
+			L"Shaders/Unlit-VertUvPosShader.hlsl", Engine::Mesh::c_defaultLayout));
+		material.SetShader(shader.get());
+
+		commandLog.Clear();
+		Engine::GraphicsRenderer3D::DrawMeshInstanced(mesh, material, instances.data(), 3);
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_DrawIndexed) == 3;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_DrawIndexedInstanced) == 0;
+	}
+
+	Engine::GraphicsRenderer3D::Release();
+	Engine::GraphicsRenderer::Release();
+	return isValid;
+}
+
+bool RunRenderStateUnitTests()
+{
+	bool isValid = Engine::GraphicsRenderer::Init(nullptr);
+	if (!isValid)
+	{
+		return false;
+	}
+
+	Engine::NullCommandLog& commandLog = Engine::NullRenderingAPI::GetActiveCommandLog();
+	commandLog.SetRecordCommands(true);
+	const Engine::GraphicsRenderStateStats& stats = Engine::GraphicsRenderer::GetRenderStateStats();
+
+	{
+		std::unique_ptr<Engine::Shader> shader(Engine::Shader::LoadFromFile(
+			L"Shaders/Unlit-VertUvPosShader.hlsl", Engine::Mesh::c_defaultLayout));
+		std::unique_ptr<Engine::Shader> otherShader(Engine::Shader::LoadFromFile(
+			L"Shaders/Unlit-VertUvPosShader.hlsl", Engine::Mesh::c_defaultLayout));
+		std::unique_ptr<Engine::Texture> texture(Engine::Texture::Create(
+			4, 4, Engine::TextureSpecifications()));
+		MathLib::Vector4 constants = MathLib::Vector4::One;
+		Engine::ConstantBuffer* constantBufferPtr = nullptr;
+		Engine::ConstantBuffer::Create(&constantBufferPtr, &constants, sizeof(constants));
+		std::unique_ptr<Engine::ConstantBuffer> constantBuffer(constantBufferPtr);
+
+		commandLog.Clear();
+		Engine::GraphicsRenderer::InvalidateRenderState();
+		Engine::GraphicsRenderer::ResetRenderStateStats();
+
+		// A second identical bind is skipped.
+		shader->Bind();
+		shader->Bind();
+		otherShader->Bind();
+		isValid &= stats.numShaderBinds == 2;
+		isValid &= stats.numShaderBindsSkipped == 1;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_BindShader) == 2;
+
+		texture->Bind(0);
+		texture->Bind(0);
+		texture->Bind(1);
+		isValid &= stats.numTextureBinds == 2;
+		isValid &= stats.numTextureBindsSkipped == 1;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_BindTexture) == 2;
+
+		// The constant buffers are cached per slot & shader stage, except for the compute shaders.
+		constantBuffer->Bind(0, Engine::ConstantBufferFlags::VERTEX_SHADER);
+		constantBuffer->Bind(0, Engine::ConstantBufferFlags::VERTEX_SHADER);
+		constantBuffer->Bind(0, Engine::ConstantBufferFlags::PIXEL_SHADER);
+		constantBuffer->Bind(1, Engine::ConstantBufferFlags::COMPUTE_SHADER);
+		constantBuffer->Bind(1, Engine::ConstantBufferFlags::COMPUTE_SHADER);
+		isValid &= stats.numConstantBufferBinds == 4;
+		isValid &= stats.numConstantBufferBindsSkipped == 1;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_BindConstantBuffer) == 4;
+
+		// The data the buffer was created with counts as uploaded.
+		constantBuffer->SetData(&constants, sizeof(constants));
+		isValid &= stats.numConstantBufferUploads == 0;
+		isValid &= stats.numConstantBufferUploadsSkipped == 1;
+		constants.x = 2.0f;
+		constantBuffer->SetData(&constants, sizeof(constants));
+		constantBuffer->SetData(&constants, sizeof(constants));
+		isValid &= stats.numConstantBufferUploads == 1;
+		isValid &= stats.numConstantBufferUploadsSkipped == 2;
+		isValid &= commandLog.GetNumCommands(Engine::NullCommand_SetConstantBufferData) == 1;
+
+		// Presenting forgets the bound state, but the uploaded data stays in the buffer.
+		Engine::GraphicsRenderer::Present();
+		commandLog.Clear();
+		Engine::GraphicsRenderer::ResetRenderStateStats();
+		otherShader->Bind();
+		texture->Bind(1);
+		constantBuffer->Bind(0, Engine::ConstantBufferFlags::PIXEL_SHADER);
+		constantBuffer->SetData(&constants, sizeof(constants));
+		isValid &= stats.numShaderBinds == 1;
+		isValid &= stats.numTextureBinds == 1;
+		isValid &= stats.numConstantBufferBinds == 1;
+		isValid &= stats.numShaderBindsSkipped + stats.numTextureBindsSkipped
+			+ stats.numConstantBufferBindsSkipped == 0;
+		isValid &= stats.numConstantBufferUploads == 0;
+		isValid &= stats.numConstantBufferUploadsSkipped == 1;
+	}
+
+	Engine::GraphicsRenderer::Release();
+	return isValid;
+}
+
+#endif
@@ -38,6 +38,11 @@ project "UnitTests"
 		runtime "Release"
 	filter { }
 
+	-- Compiles the AVX2 paths when built with --simd=avx2.
+	filter { "options:simd=avx2" }
+		vectorextensions "AVX2"
+	filter { }
+
 	--================================= BEGIN ENGINE DEPENDENCIES ===========================--
 
 	includedirs
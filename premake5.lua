@@ -4,6 +4,18 @@ include "Dependencies.lua"
 
 build_system = os.target()
 
+-- The AVX2 paths of the math library are opt-in, the builds have to run on a cpu that supports them.
+newoption {
+	trigger = "simd",
+	value = "EXTENSION",
+	description = "Choose the vector extensions the engine is built with",
+	allowed = {
+		{ "default", "The compiler's default (SSE2 on x86_64)" },
+		{ "avx2", "AVX2 (Haswell or newer)" }
+	},
+	default = "default"
+}
+
 if build_system == "windows" then
 	-- Defines the graphics api options
 	newoption {
@@ -37,6 +49,21 @@ if build_system == "macosx" then
 
 end
 
+if build_system == "linux" then
+
+	-- Linux only runs headless for now, there is no vulkan/opengl backend yet.
+	newoption {
+		trigger = "graphicsapi",
+		value = "API",
+		description = "Choose a particular graphics API",
+		allowed = {
+			{ "none", "No Graphics" }
+		},
+		default = "none"
+	}
+
+end
+
 workspace "jkornEngine"
 	
 	-- TODO: Remove this functionality
@@ -72,6 +99,15 @@ workspace "jkornEngine"
 
 	end
 
+	if build_system == "linux" then
+
+		platforms
+		{
+			"Linux"
+		}
+
+	end
+
 	filter { "platforms:Win64" }
 		system "Windows"
 		architecture "x86_64"
@@ -108,6 +144,21 @@ workspace "jkornEngine"
 			"PLATFORM_MACOSX"
 		}
 
+	filter { "platforms:Linux" }
+		system "Linux"
+		architecture "x86_64"
+
+		defines
+		{
+			"PLATFORM_LINUX",
+			"PLATFORM_LINUX_X64"
+		}
+
+		links
+		{
+			"pthread"
+		}
+
 	filter { "configurations:Debug" }
 		defines 
 		{
@@ -133,6 +184,12 @@ workspace "jkornEngine"
 		{
 			"GRAPHICS_API_METAL"
 		}
+	-- Headless runs use the null rendering api, which records the calls instead of drawing.
+	filter { "options:graphicsapi=none" }
+		defines
+		{
+			"GRAPHICS_API_NULL"
+		}
 	filter { }
 
 	-- Compiler Flags for Clang (https://clang.llvm.org/docs/UsersManual.html#c_ms)
@@ -170,4 +227,5 @@ group ""
 group "Misc"
 	include "GlfwSandboxProject"
 	include "UnitTests"
+	include "Benchmarks"
 group ""
\ No newline at end of file